@@ -0,0 +1,90 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include "edje_bench.h"
+#include "Eina.h"
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "Edje.h"
+
+typedef struct _Edje_Benchmark_Case Edje_Benchmark_Case;
+struct _Edje_Benchmark_Case
+{
+   const char *bench_case;
+   void (*build)(Eina_Benchmark *bench);
+   Eina_Bool run_by_default;
+};
+
+static const Edje_Benchmark_Case etc[] = {
+   { "Recalc", edje_bench_recalc, EINA_TRUE },
+   { "Signal", edje_bench_signal, EINA_TRUE },
+   { "Message", edje_bench_message, EINA_TRUE },
+   { NULL, NULL, EINA_FALSE }
+};
+
+Evas *
+edje_bench_evas_new(void)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * 500 * 500 * 4);
+   einfo->info.dest_buffer_row_bytes = 500 * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   return evas;
+}
+
+void
+edje_bench_evas_free(Evas *e)
+{
+   Evas_Engine_Info_Buffer *einfo;
+
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(e);
+   free(einfo->info.dest_buffer);
+   evas_free(e);
+}
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+   unsigned int i;
+
+   edje_init();
+
+   for (i = 0; etc[i].bench_case; ++i)
+     {
+        if (argc == 2 && strcasecmp(etc[i].bench_case, argv[1]))
+          continue;
+
+        test = eina_benchmark_new(etc[i].bench_case, "default");
+        if (!test)
+          continue;
+
+        etc[i].build(test);
+
+        eina_benchmark_run(test);
+
+        eina_benchmark_free(test);
+     }
+
+   edje_shutdown();
+
+   return 0;
+}
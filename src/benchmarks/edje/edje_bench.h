@@ -0,0 +1,16 @@
+#ifndef EDJE_BENCH_H_
+#define EDJE_BENCH_H_
+
+#include "eina_benchmark.h"
+#include "Evas.h"
+
+#define EDJE_BENCH_EDJ PACKAGE_BUILD_DIR"/src/benchmarks/edje/edje_bench.edj"
+
+Evas *edje_bench_evas_new(void);
+void edje_bench_evas_free(Evas *e);
+
+void edje_bench_message(Eina_Benchmark *bench);
+void edje_bench_recalc(Eina_Benchmark *bench);
+void edje_bench_signal(Eina_Benchmark *bench);
+
+#endif
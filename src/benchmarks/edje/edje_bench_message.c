@@ -0,0 +1,89 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Evas.h"
+#include "Edje.h"
+#include "edje_bench.h"
+
+#define MESSAGE_ROUNDS 100
+
+static int _pongs = 0;
+
+static void
+_ping_cb(void *data, Evas_Object *obj EINA_UNUSED,
+         const char *emission EINA_UNUSED, const char *source EINA_UNUSED)
+{
+   edje_object_signal_emit(data, "bench,pong", "bench");
+}
+
+static void
+_pong_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+         const char *emission EINA_UNUSED, const char *source EINA_UNUSED)
+{
+   _pongs++;
+}
+
+/* request objects in a ring, each one answering a ping with a pong to its
+ * neighbour and flushing its own queue, as widgets do when they need their
+ * state applied right away. */
+static void
+_message_exchange(int request)
+{
+   Evas_Object **objs;
+   Edje_Message_Int msg = { 1 };
+   Evas *e;
+   int i, r;
+
+   objs = calloc(request, sizeof (Evas_Object *));
+   if (!objs) return;
+   e = edje_bench_evas_new();
+
+   for (i = 0; i < request; i++)
+     {
+        objs[i] = edje_object_add(e);
+        if (!edje_object_file_set(objs[i], EDJE_BENCH_EDJ, "item"))
+          {
+             fprintf(stderr, "can not load group 'item' from '%s'\n",
+                     EDJE_BENCH_EDJ);
+             goto end;
+          }
+        edje_object_signal_callback_add(objs[i], "bench,pong", "bench",
+                                        _pong_cb, NULL);
+     }
+   for (i = 0; i < request; i++)
+     edje_object_signal_callback_add(objs[i], "bench,ping", "bench",
+                                     _ping_cb, objs[(i + 1) % request]);
+
+   _pongs = 0;
+   for (r = 0; r < MESSAGE_ROUNDS; r++)
+     {
+        for (i = 0; i < request; i++)
+          {
+             edje_object_signal_emit(objs[i], "bench,ping", "bench");
+             edje_object_message_send(objs[i], EDJE_MESSAGE_INT, 1, &msg);
+          }
+        for (i = 0; i < request; i++)
+          edje_object_message_signal_process(objs[i]);
+        edje_message_signal_process();
+     }
+
+   if (_pongs != request * MESSAGE_ROUNDS)
+     fprintf(stderr, "%i pongs received for %i pings\n",
+             _pongs, request * MESSAGE_ROUNDS);
+
+ end:
+   for (i = 0; i < request; i++)
+     if (objs[i]) evas_object_del(objs[i]);
+   free(objs);
+   edje_bench_evas_free(e);
+}
+
+void edje_bench_message(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "object exchange",
+                           EINA_BENCHMARK(_message_exchange), 100, 1001, 100);
+}
@@ -0,0 +1,138 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Evas.h"
+#include "Edje.h"
+#include "edje_bench.h"
+
+#define RECALC_UPDATES 2000
+#define LAYOUT_ROUNDS 100
+
+/* The title of a layout of request parts changes again and again. Only
+ * the title and its underline depend on it, so with the part dependency
+ * graph the cost of each update should not grow with the part count. When
+ * full is set, every update recalcs the whole layout as a reference. */
+static void
+_recalc_run(int request, Eina_Bool full)
+{
+   Evas_Object *o;
+   Evas *e;
+   char buf[32];
+   int i;
+
+   e = edje_bench_evas_new();
+
+   o = edje_object_add(e);
+   snprintf(buf, sizeof (buf), "recalc/%i", request);
+   if (!edje_object_file_set(o, EDJE_BENCH_EDJ, buf))
+     {
+        fprintf(stderr, "can not load group '%s' from '%s'\n",
+                buf, EDJE_BENCH_EDJ);
+        goto end;
+     }
+   evas_object_resize(o, 500, 500);
+   evas_object_show(o);
+   evas_smart_objects_calculate(e);
+
+   for (i = 0; i < RECALC_UPDATES; i++)
+     {
+        snprintf(buf, sizeof (buf), "title %i", i);
+        edje_object_part_text_set(o, "title", buf);
+        if (full) edje_object_calc_force(o);
+        else evas_smart_objects_calculate(e);
+     }
+
+ end:
+   evas_object_del(o);
+   edje_bench_evas_free(e);
+}
+
+static void
+_recalc_part(int request)
+{
+   _recalc_run(request, EINA_FALSE);
+}
+
+static void
+_recalc_full(int request)
+{
+   _recalc_run(request, EINA_TRUE);
+}
+
+/* A list of request identical items is resized back and forth, as when
+ * its window is. With the layout cache only the first item computes the
+ * part geometry for each width, the others reuse it. */
+static void
+_layout_run(int request, Eina_Bool cache)
+{
+   Evas_Object **items;
+   Eina_Bool enabled;
+   Evas *e;
+   int i, j;
+
+   enabled = edje_layout_cache_get();
+   edje_layout_cache_set(cache);
+
+   e = edje_bench_evas_new();
+   items = calloc(request, sizeof (Evas_Object *));
+   if (!items) goto end;
+
+   for (i = 0; i < request; i++)
+     {
+        items[i] = edje_object_add(e);
+        if (!edje_object_file_set(items[i], EDJE_BENCH_EDJ, "item"))
+          {
+             fprintf(stderr, "can not load group 'item' from '%s'\n",
+                     EDJE_BENCH_EDJ);
+             goto end;
+          }
+        edje_object_part_text_set(items[i], "label", "Item");
+        evas_object_move(items[i], 0, i * 40);
+        evas_object_show(items[i]);
+     }
+
+   for (j = 0; j < LAYOUT_ROUNDS; j++)
+     {
+        for (i = 0; i < request; i++)
+          evas_object_resize(items[i], 300 + (j % 2) * 20, 40);
+        evas_smart_objects_calculate(e);
+     }
+
+ end:
+   if (items)
+     {
+        for (i = 0; i < request; i++)
+          if (items[i]) evas_object_del(items[i]);
+        free(items);
+     }
+   edje_bench_evas_free(e);
+   edje_layout_cache_set(enabled);
+}
+
+static void
+_layout_cached(int request)
+{
+   _layout_run(request, EINA_TRUE);
+}
+
+static void
+_layout_uncached(int request)
+{
+   _layout_run(request, EINA_FALSE);
+}
+
+void edje_bench_recalc(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "single part update",
+                           EINA_BENCHMARK(_recalc_part), 16, 257, 16);
+   eina_benchmark_register(bench, "full recalc",
+                           EINA_BENCHMARK(_recalc_full), 16, 257, 16);
+   eina_benchmark_register(bench, "identical items",
+                           EINA_BENCHMARK(_layout_cached), 16, 257, 16);
+   eina_benchmark_register(bench, "identical items, no layout cache",
+                           EINA_BENCHMARK(_layout_uncached), 16, 257, 16);
+}
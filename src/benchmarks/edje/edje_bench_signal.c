@@ -0,0 +1,126 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Evas.h"
+#include "Edje.h"
+#include "edje_bench.h"
+
+#define SIGNAL_EMITS 20000
+#define SIGNAL_BATCH 100
+
+static void
+_signal_cb(void *data, Evas_Object *obj EINA_UNUSED,
+           const char *emission EINA_UNUSED, const char *source EINA_UNUSED)
+{
+   (*(int *)data)++;
+}
+
+/* Emit a stream of signals, half of them aimed at one of the request
+ * glob patterns, the other half matching none of them, as pointer motion
+ * does. */
+static void
+_signal_emit_all(Evas_Object *o, int request)
+{
+   char **sigs;
+   int i;
+
+   sigs = malloc(sizeof (char *) * request);
+   if (!sigs) return;
+   for (i = 0; i < request; i++)
+     {
+        char buf[32];
+
+        snprintf(buf, sizeof (buf), "elm,state,%i,%i,on", i / 16, i % 16);
+        sigs[i] = strdup(buf);
+     }
+
+   for (i = 0; i < SIGNAL_EMITS; i++)
+     {
+        if (i & 1)
+          edje_object_signal_emit(o, "mouse,move", "elm");
+        else
+          edje_object_signal_emit(o, sigs[(i / 2) % request], "elm");
+        if (!((i + 1) % SIGNAL_BATCH))
+          edje_object_message_signal_process(o);
+     }
+   edje_object_message_signal_process(o);
+
+   for (i = 0; i < request; i++)
+     free(sigs[i]);
+   free(sigs);
+}
+
+/* request glob programs in the group. */
+static void
+_signal_programs(int request)
+{
+   Evas_Object *o;
+   Evas *e;
+   char buf[32];
+
+   e = edje_bench_evas_new();
+
+   o = edje_object_add(e);
+   snprintf(buf, sizeof (buf), "signal/%i", request);
+   if (!edje_object_file_set(o, EDJE_BENCH_EDJ, buf))
+     {
+        fprintf(stderr, "can not load group '%s' from '%s'\n",
+                buf, EDJE_BENCH_EDJ);
+        goto end;
+     }
+
+   _signal_emit_all(o, request);
+
+ end:
+   evas_object_del(o);
+   edje_bench_evas_free(e);
+}
+
+/* request glob callbacks on an object without programs. */
+static void
+_signal_callbacks(int request)
+{
+   Evas_Object *o;
+   Evas *e;
+   char buf[32];
+   int hits = 0;
+   int i;
+
+   e = edje_bench_evas_new();
+
+   o = edje_object_add(e);
+   if (!edje_object_file_set(o, EDJE_BENCH_EDJ, "item"))
+     {
+        fprintf(stderr, "can not load group 'item' from '%s'\n",
+                EDJE_BENCH_EDJ);
+        goto end;
+     }
+   for (i = 0; i < request; i++)
+     {
+        snprintf(buf, sizeof (buf), "elm,state,%i,%i,*", i / 16, i % 16);
+        edje_object_signal_callback_add(o, buf, "elm", _signal_cb, &hits);
+     }
+
+   _signal_emit_all(o, request);
+
+   if (hits != SIGNAL_EMITS / 2)
+     fprintf(stderr, "%i callbacks called for %i matching signals\n",
+             hits, SIGNAL_EMITS / 2);
+
+ end:
+   evas_object_del(o);
+   edje_bench_evas_free(e);
+}
+
+void edje_bench_signal(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "glob programs",
+                           EINA_BENCHMARK(_signal_programs), 16, 257, 16);
+   eina_benchmark_register(bench, "glob callbacks",
+                           EINA_BENCHMARK(_signal_callbacks), 16, 257, 16);
+}
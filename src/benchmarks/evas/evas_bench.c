@@ -9,6 +9,7 @@
 #include "evas_bench.h"
 #include "Eina.h"
 #include "Evas.h"
+#include "Evas_Engine_Buffer.h"
 
 typedef struct _Evas_Benchmark_Case Evas_Benchmark_Case;
 struct _Evas_Benchmark_Case
@@ -21,9 +22,60 @@ struct _Evas_Benchmark_Case
 static const Evas_Benchmark_Case etc[] = {
    { "Loader", evas_bench_loader, EINA_TRUE },
    { "Saver", evas_bench_saver, EINA_TRUE },
+   { "Render", evas_bench_render, EINA_TRUE },
+   { "Filter", evas_bench_filter, EINA_TRUE },
+   { "Text", evas_bench_text, EINA_TRUE },
+   { "Textblock", evas_bench_textblock, EINA_TRUE },
+   { "Textgrid", evas_bench_textgrid, EINA_TRUE },
+   { "Map", evas_bench_map, EINA_TRUE },
+   { "Yuv", evas_bench_yuv, EINA_TRUE },
+   { "VG", evas_bench_vg, EINA_TRUE },
+   { "3D", evas_bench_3d, EINA_TRUE },
    { NULL, NULL, EINA_FALSE }
 };
 
+Evas *
+evas_bench_evas_new(int w, int h)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * w * h * 4);
+   einfo->info.dest_buffer_row_bytes = w * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, w, h);
+   evas_output_viewport_set(evas, 0, 0, w, h);
+
+   return evas;
+}
+
+void
+evas_bench_evas_free(Evas *e)
+{
+   Evas_Engine_Info_Buffer *einfo;
+
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(e);
+   free(einfo->info.dest_buffer);
+   evas_free(e);
+}
+
+void
+evas_bench_evas_render(Evas *e)
+{
+   Eina_List *updates;
+
+   updates = evas_render_updates(e);
+   evas_render_updates_free(updates);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -2,9 +2,23 @@
 #define EVAS_BENCH_H_
 
 #include "eina_benchmark.h"
+#include "Evas.h"
+
+Evas *evas_bench_evas_new(int w, int h);
+void evas_bench_evas_free(Evas *e);
+void evas_bench_evas_render(Evas *e);
 
 void evas_bench_loader(Eina_Benchmark *bench);
 void evas_bench_saver(Eina_Benchmark *bench);
+void evas_bench_render(Eina_Benchmark *bench);
+void evas_bench_filter(Eina_Benchmark *bench);
+void evas_bench_text(Eina_Benchmark *bench);
+void evas_bench_textblock(Eina_Benchmark *bench);
+void evas_bench_textgrid(Eina_Benchmark *bench);
+void evas_bench_map(Eina_Benchmark *bench);
+void evas_bench_yuv(Eina_Benchmark *bench);
+void evas_bench_vg(Eina_Benchmark *bench);
+void evas_bench_3d(Eina_Benchmark *bench);
 
 #endif
 
@@ -0,0 +1,178 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define PICK_GRID 32
+#define PICK_SIZE 400
+#define MORPH_FRAMES 10
+
+/* A bumpy sphere of 4 * request * request triangles. The bumps are scaled
+ * by the given amount, so frames can differ. */
+static void
+_sphere_frame_add(Evas_3D_Mesh *mesh, int frame, int request, float bumps)
+{
+   int stacks = request, slices = 2 * request;
+   int i, j, count = (stacks + 1) * (slices + 1);
+   float *pos, *tex, *p, *t;
+
+   pos = malloc(count * 3 * sizeof(float));
+   tex = malloc(count * 2 * sizeof(float));
+
+   for (i = 0, p = pos, t = tex; i <= stacks; i++)
+     for (j = 0; j <= slices; j++, p += 3, t += 2)
+       {
+          float theta = M_PI * i / stacks;
+          float phi = 2 * M_PI * j / slices;
+          float r = 1.0 + bumps * sinf(7 * theta) * cosf(5 * phi);
+
+          p[0] = r * sinf(theta) * cosf(phi);
+          p[1] = r * cosf(theta);
+          p[2] = r * sinf(theta) * sinf(phi);
+          t[0] = (float)j / slices;
+          t[1] = (float)i / stacks;
+       }
+
+   eo_do(mesh,
+         evas_3d_mesh_frame_add(frame),
+         evas_3d_mesh_frame_vertex_data_copy_set(frame, EVAS_3D_VERTEX_POSITION,
+                                                 3 * sizeof(float), pos),
+         evas_3d_mesh_frame_vertex_data_copy_set(frame, EVAS_3D_VERTEX_TEXCOORD,
+                                                 2 * sizeof(float), tex));
+
+   free(pos);
+   free(tex);
+}
+
+static Evas_3D_Mesh *
+_sphere_add(Evas *e, int request, Eina_Bool morph)
+{
+   Evas_3D_Mesh *mesh;
+   unsigned short *indices, *idx;
+   int stacks = request, slices = 2 * request;
+   int i, j;
+
+   mesh = eo_add(EVAS_3D_MESH_CLASS, e);
+   eo_do(mesh, evas_3d_mesh_vertex_count_set((stacks + 1) * (slices + 1)));
+
+   _sphere_frame_add(mesh, 0, request, 0.05);
+   if (morph)
+     _sphere_frame_add(mesh, MORPH_FRAMES, request, 0.2);
+
+   indices = malloc(stacks * slices * 6 * sizeof(unsigned short));
+   for (i = 0, idx = indices; i < stacks; i++)
+     for (j = 0; j < slices; j++, idx += 6)
+       {
+          unsigned short a = i * (slices + 1) + j;
+          unsigned short b = a + slices + 1;
+
+          idx[0] = a;
+          idx[1] = b;
+          idx[2] = a + 1;
+          idx[3] = a + 1;
+          idx[4] = b;
+          idx[5] = b + 1;
+       }
+
+   eo_do(mesh,
+         evas_3d_mesh_index_data_copy_set(EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT,
+                                          stacks * slices * 6, indices),
+         evas_3d_mesh_vertex_assembly_set(EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES));
+   free(indices);
+
+   return mesh;
+}
+
+/* Picks a grid of points over a generated mesh, changing the frame of the
+ * node between each pass when morph is set. */
+static void
+_3d_pick_run(int request, Eina_Bool morph)
+{
+   Evas_3D_Scene *scene;
+   Evas_3D_Node *root, *camera_node, *mesh_node;
+   Evas_3D_Camera *camera;
+   Evas_3D_Mesh *mesh;
+   Evas *e;
+   int i, x, y;
+
+   e = evas_bench_evas_new(500, 500);
+
+   scene = eo_add(EVAS_3D_SCENE_CLASS, e);
+   root = eo_add(EVAS_3D_NODE_CLASS, e,
+                 evas_3d_node_constructor(EVAS_3D_NODE_TYPE_NODE));
+
+   camera = eo_add(EVAS_3D_CAMERA_CLASS, e);
+   eo_do(camera,
+         evas_3d_camera_projection_perspective_set(30.0, 1.0, 1.0, 100.0));
+   camera_node = eo_add(EVAS_3D_NODE_CLASS, e,
+                        evas_3d_node_constructor(EVAS_3D_NODE_TYPE_CAMERA));
+   eo_do(camera_node,
+         evas_3d_node_camera_set(camera),
+         evas_3d_node_position_set(0.0, 0.0, 5.0),
+         evas_3d_node_look_at_set(EVAS_3D_SPACE_PARENT, 0.0, 0.0, 0.0,
+                                  EVAS_3D_SPACE_PARENT, 0.0, 1.0, 0.0));
+   eo_do(root, evas_3d_node_member_add(camera_node));
+
+   mesh = _sphere_add(e, request, morph);
+   mesh_node = eo_add(EVAS_3D_NODE_CLASS, e,
+                      evas_3d_node_constructor(EVAS_3D_NODE_TYPE_MESH));
+   eo_do(mesh_node, evas_3d_node_mesh_add(mesh));
+   eo_do(root, evas_3d_node_member_add(mesh_node));
+
+   eo_do(scene,
+         evas_3d_scene_root_node_set(root),
+         evas_3d_scene_camera_node_set(camera_node),
+         evas_3d_scene_size_set(PICK_SIZE, PICK_SIZE));
+
+   for (i = 0; i < MORPH_FRAMES; i++)
+     {
+        if (morph)
+          eo_do(mesh_node, evas_3d_node_mesh_frame_set(mesh, i));
+
+        for (y = 0; y < PICK_GRID; y++)
+          for (x = 0; x < PICK_GRID; x++)
+            {
+               Evas_Real s, t;
+
+               eo_do(scene,
+                     evas_3d_scene_pick((x + 0.5) * PICK_SIZE / PICK_GRID,
+                                        (y + 0.5) * PICK_SIZE / PICK_GRID,
+                                        NULL, NULL, &s, &t));
+            }
+     }
+
+   eo_del(mesh_node);
+   eo_del(mesh);
+   eo_del(camera_node);
+   eo_del(camera);
+   eo_del(root);
+   eo_del(scene);
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_3d_pick(int request)
+{
+   _3d_pick_run(request, EINA_FALSE);
+}
+
+static void
+evas_bench_3d_pick_morph(int request)
+{
+   _3d_pick_run(request, EINA_TRUE);
+}
+
+void evas_bench_3d(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "pick",
+                           EINA_BENCHMARK(evas_bench_3d_pick),
+                           30, 150, 30);
+   eina_benchmark_register(bench, "pick-morph",
+                           EINA_BENCHMARK(evas_bench_3d_pick_morph),
+                           30, 150, 30);
+}
@@ -0,0 +1,88 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define FILTER_FRAMES 10
+#define FILTER_SIZE 500
+#define FILTER_RADIUS 8
+
+/* Renders a size x size image FILTER_FRAMES times through the given filter
+ * program. The image content is marked as changed before every frame, so that
+ * the filter runs again instead of reusing its previous output. */
+static void
+_filter_run(int size, const char *code)
+{
+   Evas *e = evas_bench_evas_new(size, size);
+   Evas_Object *o;
+   unsigned int *data;
+   int x, y, i;
+
+   o = evas_object_image_filled_add(e);
+   evas_object_image_alpha_set(o, EINA_TRUE);
+   evas_object_image_size_set(o, size, size);
+   data = evas_object_image_data_get(o, EINA_TRUE);
+   for (y = 0; y < size; y++)
+     for (x = 0; x < size; x++)
+       data[y * size + x] = ((x ^ y) & 0x10) ? 0xff3060c0 : 0x80402010;
+   evas_object_image_data_set(o, data);
+   eo_do(o, evas_obj_image_filter_program_set(code));
+   evas_object_move(o, 0, 0);
+   evas_object_resize(o, size, size);
+   evas_object_show(o);
+
+   for (i = 0; i < FILTER_FRAMES; i++)
+     {
+        evas_object_image_data_update_add(o, 0, 0, size, size);
+        evas_render_updates_free(evas_render_updates(e));
+     }
+
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_filter_gaussian_radius(int request)
+{
+   char code[64];
+
+   snprintf(code, sizeof(code), "blur ({ %d, type = 'gaussian' })", request);
+   _filter_run(FILTER_SIZE, code);
+}
+
+static void
+evas_bench_filter_gaussian_alpha_radius(int request)
+{
+   char code[128];
+
+   snprintf(code, sizeof(code),
+            "a = buffer ({ 'alpha' }) blend ({ dst = a }) "
+            "blur ({ %d, src = a, type = 'gaussian' })", request);
+   _filter_run(FILTER_SIZE, code);
+}
+
+static void
+evas_bench_filter_gaussian_size(int request)
+{
+   char code[64];
+
+   snprintf(code, sizeof(code), "blur ({ %d, type = 'gaussian' })",
+            FILTER_RADIUS);
+   _filter_run(request, code);
+}
+
+void evas_bench_filter(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "gaussian-blur-radius",
+                           EINA_BENCHMARK(evas_bench_filter_gaussian_radius),
+                           1, 65, 4);
+   eina_benchmark_register(bench, "gaussian-blur-alpha-radius",
+                           EINA_BENCHMARK(evas_bench_filter_gaussian_alpha_radius),
+                           1, 65, 4);
+   eina_benchmark_register(bench, "gaussian-blur-size",
+                           EINA_BENCHMARK(evas_bench_filter_gaussian_size),
+                           100, 2100, 250);
+}
@@ -2,6 +2,8 @@
 # include "config.h"
 #endif
 
+#include <sys/select.h>
+
 #include "Evas.h"
 #include "Evas_Engine_Buffer.h"
 #include "evas_bench.h"
@@ -86,7 +88,171 @@ evas_bench_loader_tgv(int request)
    evas_free(e);
 }
 
+/* Loads a viewport of an image, or the whole image scaled down, request
+ * times. The image cache is flushed between loads, so each one decodes. */
+static void
+_loader_part_run(const char *name, int request, int scale_down,
+                 int x, int y, int w, int h)
+{
+   Evas *e = _setup_evas();
+   const char *file;
+   Evas_Object *o;
+   int i;
+
+   file = _test_image_get(name);
+   for (i = 0; i < request; i++)
+     {
+        o = evas_object_image_add(e);
+        if (scale_down > 1)
+          evas_object_image_load_scale_down_set(o, scale_down);
+        if ((w > 0) && (h > 0))
+          evas_object_image_load_region_set(o, x, y, w, h);
+        evas_object_image_file_set(o, file, NULL);
+        if (!evas_object_image_data_get(o, 0)) break;
+
+        evas_object_del(o);
+        evas_image_cache_flush(e);
+     }
+
+   evas_free(e);
+}
+
+/* A single large image, its macroblocks are decoded in parallel. Run with
+ * EVAS_WORKER_THREADS set from 1 to the number of cores to see the scaling. */
+static void
+evas_bench_loader_tgv_large(int request)
+{
+   _loader_part_run("Light-50.tgv", request, 1, 0, 0, 0, 0);
+}
+
+static void
+evas_bench_loader_png(int request)
+{
+   _loader_part_run("Light-50.png", request, 1, 0, 0, 0, 0);
+}
+
+static void
+evas_bench_loader_png_region(int request)
+{
+   _loader_part_run("Light-50.png", request, 1, 800, 320, 320, 240);
+}
+
+static void
+evas_bench_loader_png_scale_down(int request)
+{
+   _loader_part_run("Light-50.png", request, 4, 0, 0, 0, 0);
+}
+
+#define GRID_PAGE 12
+#define GRID_SCROLL 3
+
+typedef struct _Grid_Item Grid_Item;
+struct _Grid_Item
+{
+   Evas_Object *o;
+   int *pending;
+   Eina_Bool visible : 1;
+   Eina_Bool loaded : 1;
+};
+
+static void
+_grid_item_preloaded(void *data, Evas *e EINA_UNUSED,
+                     Evas_Object *o EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Grid_Item *it = data;
+
+   if (it->loaded) return;
+   it->loaded = EINA_TRUE;
+   if (it->visible) (*it->pending)--;
+}
+
+static void
+_grid_page_show(Grid_Item *items, int page, int pages, int *pending)
+{
+   int i;
+
+   for (i = page * GRID_PAGE; i < (page + 1) * GRID_PAGE; i++)
+     {
+        items[i].visible = EINA_TRUE;
+        if (!items[i].loaded) (*pending)++;
+        evas_object_image_preload_priority_set(items[i].o,
+                                               EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+     }
+   if (page + 1 >= pages) return;
+   for (i = (page + 1) * GRID_PAGE; i < (page + 2) * GRID_PAGE; i++)
+     evas_object_image_preload_priority_set(items[i].o,
+                                            EVAS_IMAGE_PRELOAD_PRIORITY_NEAR_VISIBLE);
+}
+
+static void
+_grid_page_wait(int *pending)
+{
+   int fd = evas_async_events_fd_get();
+
+   while (*pending > 0)
+     {
+        fd_set rfds;
+
+        FD_ZERO(&rfds);
+        FD_SET(fd, &rfds);
+        select(fd + 1, &rfds, NULL, NULL, NULL);
+        evas_async_events_process();
+     }
+}
+
+/* A grid of request pages of thumbnails is speculatively preloaded, then
+ * flung to its middle and scrolled a few pages further, waiting each time
+ * for the page on screen to be ready. The remaining preloads are cancelled
+ * when the grid goes away. */
+static void
+evas_bench_loader_preload_scroll(int request)
+{
+   Evas *e = _setup_evas();
+   Grid_Item *items;
+   const char *file;
+   int pending = 0;
+   int count = request * GRID_PAGE;
+   int page = request / 2;
+   int i;
+
+   file = _test_image_get("Light.jpg");
+   items = calloc(count, sizeof (Grid_Item));
+
+   for (i = 0; i < count; i++)
+     {
+        Grid_Item *it = &items[i];
+
+        it->pending = &pending;
+        it->o = evas_object_image_add(e);
+        /* Each thumbnail gets its own cache entry */
+        evas_object_image_load_size_set(it->o, 160 + i, 120 + i);
+        evas_object_image_file_set(it->o, file, NULL);
+        evas_object_event_callback_add(it->o, EVAS_CALLBACK_IMAGE_PRELOADED,
+                                       _grid_item_preloaded, it);
+        evas_object_image_preload_priority_set(it->o,
+                                               EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE);
+        evas_object_image_preload(it->o, EINA_FALSE);
+     }
+
+   for (i = 0; (i < GRID_SCROLL) && (page < request); i++, page++)
+     {
+        _grid_page_show(items, page, request, &pending);
+        _grid_page_wait(&pending);
+     }
+
+   for (i = 0; i < count; i++)
+     evas_object_del(items[i].o);
+   free(items);
+
+   evas_free(e);
+}
+
 void evas_bench_loader(Eina_Benchmark *bench)
 {
    eina_benchmark_register(bench, "tgv-loader", EINA_BENCHMARK(evas_bench_loader_tgv), 20, 2000, 100);
+   eina_benchmark_register(bench, "tgv-large", EINA_BENCHMARK(evas_bench_loader_tgv_large), 5, 50, 5);
+   eina_benchmark_register(bench, "png", EINA_BENCHMARK(evas_bench_loader_png), 5, 50, 5);
+   eina_benchmark_register(bench, "png-region", EINA_BENCHMARK(evas_bench_loader_png_region), 5, 50, 5);
+   eina_benchmark_register(bench, "png-scale-down", EINA_BENCHMARK(evas_bench_loader_png_scale_down), 5, 50, 5);
+   eina_benchmark_register(bench, "preload-scroll", EINA_BENCHMARK(evas_bench_loader_preload_scroll), 4, 40, 4);
 }
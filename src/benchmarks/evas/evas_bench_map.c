@@ -0,0 +1,83 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define MAP_FRAMES 100
+#define MAP_IMAGE_SIZE 256
+
+/* An image of request x request pixels on screen spins and zooms in and out,
+ * with a color multiplier, like a transition effect would do. */
+static void
+_map_run(int request, Eina_Bool smooth)
+{
+   Evas_Object *bg, *o;
+   Evas_Map *m;
+   unsigned int *data;
+   Evas *e;
+   int x, y, i;
+
+   e = evas_bench_evas_new(500, 500);
+
+   bg = evas_object_rectangle_add(e);
+   evas_object_color_set(bg, 32, 64, 96, 255);
+   evas_object_resize(bg, 500, 500);
+   evas_object_show(bg);
+
+   o = evas_object_image_filled_add(e);
+   evas_object_image_size_set(o, MAP_IMAGE_SIZE, MAP_IMAGE_SIZE);
+   evas_object_image_alpha_set(o, EINA_TRUE);
+   data = evas_object_image_data_get(o, EINA_TRUE);
+   for (y = 0; y < MAP_IMAGE_SIZE; y++)
+     for (x = 0; x < MAP_IMAGE_SIZE; x++)
+       data[(y * MAP_IMAGE_SIZE) + x] = ((x ^ y) & 0x10) ?
+         0xff000000 | (x << 16) | (y << 8) | ((x + y) >> 1) : 0x80402010;
+   evas_object_image_data_set(o, data);
+   evas_object_image_smooth_scale_set(o, smooth);
+   evas_object_move(o, 250 - (request / 2), 250 - (request / 2));
+   evas_object_resize(o, request, request);
+   evas_object_show(o);
+
+   m = evas_map_new(4);
+   evas_map_smooth_set(m, smooth);
+   evas_map_alpha_set(m, EINA_TRUE);
+   for (i = 0; i < MAP_FRAMES; i++)
+     {
+        double zoom = 0.75 + ((i % 20) / 40.0);
+
+        evas_map_util_points_populate_from_object(m, o);
+        evas_map_util_points_color_set(m, 255, 255 - i, 192 + (i % 64), 255);
+        evas_map_util_zoom(m, zoom, zoom, 250, 250);
+        evas_map_util_rotate(m, i * 3.6, 250, 250);
+        evas_object_map_set(o, m);
+        evas_object_map_enable_set(o, EINA_TRUE);
+        evas_bench_evas_render(e);
+     }
+   evas_map_free(m);
+
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_map_smooth(int request)
+{
+   _map_run(request, EINA_TRUE);
+}
+
+static void
+evas_bench_map_nearest(int request)
+{
+   _map_run(request, EINA_FALSE);
+}
+
+void evas_bench_map(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "transform-smooth",
+                           EINA_BENCHMARK(evas_bench_map_smooth),
+                           50, 450, 50);
+   eina_benchmark_register(bench, "transform-nearest",
+                           EINA_BENCHMARK(evas_bench_map_nearest),
+                           50, 450, 50);
+}
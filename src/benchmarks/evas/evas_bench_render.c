@@ -0,0 +1,97 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define RENDER_FRAMES 100
+#define RENDER_MEMBERS 100
+
+static Evas_Smart *
+_container_smart_get(void)
+{
+   static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION("evas_bench_container");
+   static Evas_Smart *smart = NULL;
+
+   if (!smart)
+     {
+        evas_object_smart_clipped_smart_set(&sc);
+        smart = evas_smart_class_new(&sc);
+     }
+   return smart;
+}
+
+/* Builds a static scene of count small rectangles, grouped in clipped smart
+ * containers like a widget tree would, and returns one of them. */
+static Evas_Object *
+_scene_build(Evas *e, int count)
+{
+   Evas_Object *container = NULL;
+   Evas_Object *o = NULL;
+   int i;
+
+   for (i = 0; i < count; i++)
+     {
+        if (!(i % RENDER_MEMBERS))
+          {
+             container = evas_object_smart_add(e, _container_smart_get());
+             evas_object_move(container, 0, 0);
+             evas_object_resize(container, 500, 500);
+             evas_object_show(container);
+          }
+
+        /* translucent, so the frame cost is not dominated by cutouts */
+        o = evas_object_rectangle_add(e);
+        evas_object_color_set(o, i & 0x7f, (i >> 8) & 0x7f, 64, 128);
+        evas_object_move(o, (i * 7) % 496, (i * 13) % 496);
+        evas_object_resize(o, 4, 4);
+        evas_object_smart_member_add(o, container);
+        evas_object_show(o);
+     }
+
+   return o;
+}
+
+static void
+evas_bench_render_setup(int request)
+{
+   Evas *e = evas_bench_evas_new(500, 500);
+
+   _scene_build(e, request);
+   evas_bench_evas_render(e);
+
+   evas_bench_evas_free(e);
+}
+
+/* One object moves and is raised per frame: the restack forces a new phase 1
+ * walk over the canvas while everything else stays untouched. */
+static void
+evas_bench_render_one_changed(int request)
+{
+   Evas *e = evas_bench_evas_new(500, 500);
+   Evas_Object *changing;
+   int i;
+
+   changing = _scene_build(e, request);
+   evas_bench_evas_render(e);
+
+   for (i = 0; i < RENDER_FRAMES; i++)
+     {
+        evas_object_move(changing, i % 496, (i * 3) % 496);
+        evas_object_raise(changing);
+        evas_bench_evas_render(e);
+     }
+
+   evas_bench_evas_free(e);
+}
+
+void evas_bench_render(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "scene-setup",
+                           EINA_BENCHMARK(evas_bench_render_setup),
+                           1000, 101000, 11000);
+   eina_benchmark_register(bench, "one-object-changed",
+                           EINA_BENCHMARK(evas_bench_render_one_changed),
+                           1000, 101000, 11000);
+}
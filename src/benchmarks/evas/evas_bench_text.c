@@ -0,0 +1,129 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define TEXT_FRAMES 20
+#define TEXT_CANVASES 4
+#define TEXT_FONT "DejaVuSans"
+
+/* Every canvas shows the same lines of text, in a few sizes, and all of them
+ * are changed each frame, like several windows of one process would. */
+static void
+_text_run(int request, int canvases)
+{
+   Evas *e[TEXT_CANVASES];
+   Evas_Object **o;
+   char buf[64];
+   int i, j, f;
+
+   o = malloc(sizeof (Evas_Object *) * request * canvases);
+   if (!o) return;
+
+   for (j = 0; j < canvases; j++)
+     {
+        e[j] = evas_bench_evas_new(500, 500);
+        for (i = 0; i < request; i++)
+          {
+             Evas_Object *t;
+
+             t = evas_object_text_add(e[j]);
+             evas_object_text_font_set(t, TEXT_FONT, 8 + (i % 4) * 2);
+             evas_object_move(t, (i * 37) % 400, (i * 11) % 480);
+             evas_object_color_set(t, 0, 0, 0, 255);
+             evas_object_show(t);
+             o[j * request + i] = t;
+          }
+     }
+
+   for (f = 0; f < TEXT_FRAMES; f++)
+     {
+        for (i = 0; i < request; i++)
+          {
+             snprintf(buf, sizeof (buf), "Line %i of frame %i: %c%c%c",
+                      i, f, 'A' + (i + f) % 26, 'a' + (i * 3 + f) % 26,
+                      '0' + f % 10);
+             for (j = 0; j < canvases; j++)
+               evas_object_text_text_set(o[j * request + i], buf);
+          }
+        for (j = 0; j < canvases; j++)
+          evas_bench_evas_render(e[j]);
+     }
+
+   for (j = 0; j < canvases; j++)
+     evas_bench_evas_free(e[j]);
+   free(o);
+}
+
+/* A scrolling list: rows show a handful of labels over and over, and every
+ * frame moves the labels one row up, so each row gets new text to shape. */
+static void
+_text_list_run(int request)
+{
+   static const char *labels[] = {
+      "Inbox", "Sent items", "Drafts", "Archive", "Trash", "Spam",
+      "Yesterday at 10:42", "Today at 09:15", "Unread (3)", "Mark as read"
+   };
+   const int nlabels = sizeof (labels) / sizeof (labels[0]);
+   Evas_Object **o;
+   Evas *e;
+   int i, f;
+
+   o = malloc(sizeof (Evas_Object *) * request);
+   if (!o) return;
+
+   e = evas_bench_evas_new(500, 500);
+   for (i = 0; i < request; i++)
+     {
+        o[i] = evas_object_text_add(e);
+        evas_object_text_font_set(o[i], TEXT_FONT, 10);
+        evas_object_move(o[i], 10, (i * 14) % 480);
+        evas_object_color_set(o[i], 0, 0, 0, 255);
+        evas_object_show(o[i]);
+     }
+
+   for (f = 0; f < TEXT_FRAMES; f++)
+     {
+        for (i = 0; i < request; i++)
+          evas_object_text_text_set(o[i], labels[(i + f) % nlabels]);
+        evas_bench_evas_render(e);
+     }
+
+   evas_bench_evas_free(e);
+   free(o);
+}
+
+static void
+evas_bench_text_one_canvas(int request)
+{
+   _text_run(request, 1);
+}
+
+static void
+evas_bench_text_many_canvases(int request)
+{
+   _text_run(request, TEXT_CANVASES);
+}
+
+static void
+evas_bench_text_list(int request)
+{
+   _text_list_run(request);
+}
+
+void evas_bench_text(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "one-canvas",
+                           EINA_BENCHMARK(evas_bench_text_one_canvas),
+                           10, 1010, 100);
+   eina_benchmark_register(bench, "many-canvases",
+                           EINA_BENCHMARK(evas_bench_text_many_canvases),
+                           10, 1010, 100);
+   eina_benchmark_register(bench, "list",
+                           EINA_BENCHMARK(evas_bench_text_list),
+                           100, 2100, 500);
+}
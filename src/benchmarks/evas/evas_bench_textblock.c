@@ -0,0 +1,99 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define TEXTBLOCK_EDITS 500
+#define TEXTBLOCK_STYLE \
+   "DEFAULT='font=DejaVuSans font_size=10 color=#000 wrap=word'"
+
+/* A log view: a textblock holding request lines, every edit is followed by
+ * a size query and a frame, like a scrolling view would do. */
+static void
+_textblock_run(int request, Eina_Bool append)
+{
+   Evas_Textblock_Style *st;
+   Evas_Textblock_Cursor *cur;
+   Eina_Strbuf *buf;
+   Evas_Object *o;
+   Evas_Coord w, h;
+   Evas *e;
+   char line[64];
+   int i;
+
+   e = evas_bench_evas_new(500, 500);
+   st = evas_textblock_style_new();
+   evas_textblock_style_set(st, TEXTBLOCK_STYLE);
+
+   o = evas_object_textblock_add(e);
+   evas_object_textblock_style_set(o, st);
+   evas_object_resize(o, 500, 500);
+   evas_object_show(o);
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < request; i++)
+     eina_strbuf_append_printf(buf, "%sLine %i: something happened here",
+                               i ? "<ps/>" : "", i);
+   evas_object_textblock_text_markup_set(o, eina_strbuf_string_get(buf));
+   eina_strbuf_free(buf);
+   evas_object_textblock_size_formatted_get(o, &w, &h);
+   evas_bench_evas_render(e);
+
+   cur = evas_object_textblock_cursor_new(o);
+   for (i = 0; i < TEXTBLOCK_EDITS; i++)
+     {
+        if (append)
+          {
+             evas_textblock_cursor_paragraph_last(cur);
+             snprintf(line, sizeof (line), "<ps/>Appended line %i", i);
+             evas_object_textblock_text_markup_prepend(cur, line);
+          }
+        else
+          {
+             int j;
+
+             /* Walk to the line from the previous edit, it's cheaper than
+              * starting over and still covers the whole textblock. */
+             if (!i) evas_textblock_cursor_paragraph_first(cur);
+             for (j = 0; j < request / TEXTBLOCK_EDITS; j++)
+               evas_textblock_cursor_paragraph_next(cur);
+             evas_textblock_cursor_paragraph_char_first(cur);
+             evas_textblock_cursor_text_prepend(cur, "Edited ");
+          }
+        evas_object_textblock_size_formatted_get(o, &w, &h);
+        evas_object_resize(o, 500, h);
+        evas_object_move(o, 0, 500 - h);
+        evas_bench_evas_render(e);
+     }
+   evas_textblock_cursor_free(cur);
+
+   evas_object_del(o);
+   evas_textblock_style_free(st);
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_textblock_append(int request)
+{
+   _textblock_run(request, EINA_TRUE);
+}
+
+static void
+evas_bench_textblock_edit(int request)
+{
+   _textblock_run(request, EINA_FALSE);
+}
+
+void evas_bench_textblock(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "append",
+                           EINA_BENCHMARK(evas_bench_textblock_append),
+                           10000, 110000, 20000);
+   eina_benchmark_register(bench, "edit",
+                           EINA_BENCHMARK(evas_bench_textblock_edit),
+                           10000, 110000, 20000);
+}
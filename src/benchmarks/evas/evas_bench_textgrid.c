@@ -0,0 +1,118 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define TEXTGRID_COLS 200
+#define TEXTGRID_ROWS 60
+#define TEXTGRID_LINES_PER_FRAME 8
+#define TEXTGRID_FONT "DejaVuSansMono"
+
+static void
+_line_write(Evas_Object *o, int y, int line)
+{
+   Evas_Textgrid_Cell *cells;
+   char buf[TEXTGRID_COLS + 1];
+   int i, len;
+
+   len = snprintf(buf, sizeof (buf),
+                  "[%6i] build: compiling src/lib/module_%i.c -> "
+                  "obj/module_%i.o (warnings: %i) ",
+                  line, line % 97, line % 97, line % 5);
+   cells = evas_object_textgrid_cellrow_get(o, y);
+   for (i = 0; i < TEXTGRID_COLS; i++)
+     {
+        cells[i].codepoint = (i < len) ? buf[i] : 0;
+        cells[i].fg = 1 + (line % 7);
+        cells[i].bg = (i < 9) ? 8 : 0;
+        cells[i].underline = 0;
+        cells[i].strikethrough = 0;
+     }
+   evas_object_textgrid_cellrow_set(o, y, cells);
+}
+
+/* A terminal streaming a build log: every new line scrolls the grid one row
+ * up and fills the bottom row, a frame is drawn every few lines. */
+static void
+_textgrid_run(int request, Eina_Bool scroll)
+{
+   Evas_Object *o;
+   Evas *e;
+   int cw, ch;
+   int i, y;
+
+   e = evas_bench_evas_new(16, 16);
+   o = evas_object_textgrid_add(e);
+   evas_object_textgrid_font_set(o, TEXTGRID_FONT, 10);
+   evas_object_textgrid_cell_size_get(o, &cw, &ch);
+   evas_object_del(o);
+   evas_bench_evas_free(e);
+   if ((cw <= 0) || (ch <= 0)) return;
+
+   e = evas_bench_evas_new(cw * TEXTGRID_COLS, ch * TEXTGRID_ROWS);
+   o = evas_object_textgrid_add(e);
+   evas_object_textgrid_font_set(o, TEXTGRID_FONT, 10);
+   evas_object_textgrid_size_set(o, TEXTGRID_COLS, TEXTGRID_ROWS);
+   for (i = 0; i < 8; i++)
+     evas_object_textgrid_palette_set(o, EVAS_TEXTGRID_PALETTE_STANDARD, i,
+                                      (i & 1) ? 255 : 0, (i & 2) ? 255 : 0,
+                                      (i & 4) ? 255 : 0, 255);
+   evas_object_textgrid_palette_set(o, EVAS_TEXTGRID_PALETTE_STANDARD, 8,
+                                    40, 40, 80, 255);
+   evas_object_resize(o, cw * TEXTGRID_COLS, ch * TEXTGRID_ROWS);
+   evas_object_show(o);
+
+   for (y = 0; y < TEXTGRID_ROWS; y++)
+     _line_write(o, y, y);
+   evas_object_textgrid_update_add(o, 0, 0, TEXTGRID_COLS, TEXTGRID_ROWS);
+   evas_bench_evas_render(e);
+
+   for (i = TEXTGRID_ROWS; i < TEXTGRID_ROWS + request; i++)
+     {
+        if (scroll)
+          {
+             evas_object_textgrid_rows_scroll(o, 0, TEXTGRID_ROWS, -1);
+             _line_write(o, TEXTGRID_ROWS - 1, i);
+          }
+        else
+          {
+             /* What a terminal has to do without rows_scroll(): move its
+              * lines itself and write the whole screen again. */
+             for (y = 0; y < TEXTGRID_ROWS; y++)
+               _line_write(o, y, i - TEXTGRID_ROWS + 1 + y);
+             evas_object_textgrid_update_add(o, 0, 0,
+                                             TEXTGRID_COLS, TEXTGRID_ROWS);
+          }
+        if (!(i % TEXTGRID_LINES_PER_FRAME))
+          evas_bench_evas_render(e);
+     }
+
+   evas_object_del(o);
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_textgrid_rewrite(int request)
+{
+   _textgrid_run(request, EINA_FALSE);
+}
+
+static void
+evas_bench_textgrid_scroll(int request)
+{
+   _textgrid_run(request, EINA_TRUE);
+}
+
+void evas_bench_textgrid(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "stream-rewrite",
+                           EINA_BENCHMARK(evas_bench_textgrid_rewrite),
+                           1000, 11000, 2000);
+   eina_benchmark_register(bench, "stream-scroll",
+                           EINA_BENCHMARK(evas_bench_textgrid_scroll),
+                           1000, 11000, 2000);
+}
@@ -0,0 +1,239 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define VG_FRAMES 50
+
+typedef enum _Vg_Fill
+{
+   VG_FILL_SOLID,
+   VG_FILL_LINEAR,
+   VG_FILL_RADIAL
+} Vg_Fill;
+
+/* request translucent rounded rectangles and circles over the whole canvas,
+ * like the icons and charts of a vector UI. The tree is touched on every
+ * frame so it is drawn again instead of coming from the raster cache. */
+static void
+_vg_run(int request, Vg_Fill fill)
+{
+   static const Efl_Gfx_Gradient_Stop stops[3] = {
+      { 0.0, 255, 0, 0, 255 },
+      { 0.5, 0, 128, 0, 128 },
+      { 1.0, 0, 0, 255, 255 }
+   };
+   Efl_VG *root, *grad = NULL;
+   Evas_Object *vg;
+   Evas *e;
+   int i;
+
+   /* measure the ector software rasterizer, not cairo */
+   setenv("ECTOR_BACKEND", "freetype", 0);
+   e = evas_bench_evas_new(500, 500);
+
+   vg = evas_object_vg_add(e);
+   evas_object_resize(vg, 500, 500);
+   evas_object_show(vg);
+   root = evas_object_vg_root_node_get(vg);
+
+   if (fill == VG_FILL_LINEAR)
+     {
+        grad = eo_add(EFL_VG_GRADIENT_LINEAR_CLASS, root);
+        evas_vg_gradient_linear_start_set(grad, 0, 0);
+        evas_vg_gradient_linear_end_set(grad, 120, 80);
+     }
+   else if (fill == VG_FILL_RADIAL)
+     {
+        grad = eo_add(EFL_VG_GRADIENT_RADIAL_CLASS, root);
+        evas_vg_gradient_radial_center_set(grad, 250, 250);
+        evas_vg_gradient_radial_focal_set(grad, 200, 220);
+        evas_vg_gradient_radial_radius_set(grad, 120);
+     }
+   if (grad)
+     {
+        evas_vg_gradient_stop_set(grad, stops, 3);
+        evas_vg_gradient_spread_set(grad, EFL_GFX_GRADIENT_SPREAD_REFLECT);
+     }
+
+   for (i = 0; i < request; i++)
+     {
+        Efl_VG *shape = evas_vg_shape_add(root);
+        int x = (i * 37) % 300, y = (i * 53) % 300;
+
+        if (i & 1)
+          evas_vg_shape_shape_append_circle(shape, x + 100, y + 100, 100);
+        else
+          evas_vg_shape_shape_append_rect(shape, x, y, 200, 150, 20, 20);
+        if (grad)
+          evas_vg_shape_fill_set(shape, grad);
+        else
+          evas_vg_node_color_set(shape, (i * 40) % 192, 96, 160, 192);
+     }
+
+   for (i = 0; i < VG_FRAMES; i++)
+     {
+        evas_vg_node_origin_set(root, 0, 0);
+        evas_bench_evas_render(e);
+     }
+
+   evas_object_del(vg);
+   evas_bench_evas_free(e);
+}
+
+/* request static icons of 48x48, the whole canvas is redrawn every frame
+ * while none of them changes. */
+static void
+_vg_icons_run(int request)
+{
+   Evas_Object **icons;
+   Evas *e;
+   int i;
+
+   setenv("ECTOR_BACKEND", "freetype", 0);
+   e = evas_bench_evas_new(500, 500);
+
+   icons = malloc(sizeof (Evas_Object *) * request);
+   for (i = 0; i < request; i++)
+     {
+        Efl_VG *root, *shape;
+
+        icons[i] = evas_object_vg_add(e);
+        evas_object_move(icons[i], (i * 48) % 452, ((i / 9) * 13) % 452);
+        evas_object_resize(icons[i], 48, 48);
+        evas_object_show(icons[i]);
+        root = evas_object_vg_root_node_get(icons[i]);
+
+        shape = evas_vg_shape_add(root);
+        evas_vg_shape_shape_append_rect(shape, 2, 2, 44, 44, 8, 8);
+        evas_vg_node_color_set(shape, 32, (i * 16) % 128, 96, 128);
+
+        shape = evas_vg_shape_add(root);
+        evas_vg_shape_shape_append_circle(shape, 24, 24, 14);
+        evas_vg_node_color_set(shape, 255, 255, 255, 255);
+        evas_vg_shape_stroke_color_set(shape, 0, 0, 0, 255);
+        evas_vg_shape_stroke_width_set(shape, 2);
+     }
+
+   for (i = 0; i < VG_FRAMES; i++)
+     {
+        evas_damage_rectangle_add(e, 0, 0, 500, 500);
+        evas_bench_evas_render(e);
+     }
+
+   for (i = 0; i < request; i++)
+     evas_object_del(icons[i]);
+   free(icons);
+   evas_bench_evas_free(e);
+}
+
+static void
+_vg_line_append(Efl_VG *shape, int i, int frame)
+{
+   int j;
+
+   evas_vg_shape_shape_reset(shape);
+   evas_vg_shape_shape_append_move_to(shape, 0, 250);
+   for (j = 1; j <= 25; j++)
+     evas_vg_shape_shape_append_cubic_to(shape, j * 20, 250 + ((i * 31 + j * 17 + frame) % 200) - 100,
+                                         j * 20 - 15, 250 - ((i + j) % 7) * 10,
+                                         j * 20 - 5, 250 + ((i + j) % 5) * 10);
+}
+
+/* request stroked chart lines, like a dashboard. Every frame recolors all of
+ * them, as a highlight would, and feeds new data to one of them. */
+static void
+_vg_strokes_run(int request)
+{
+   Efl_VG **lines;
+   Efl_VG *root;
+   Evas_Object *vg;
+   Evas *e;
+   int i;
+
+   setenv("ECTOR_BACKEND", "freetype", 0);
+   e = evas_bench_evas_new(500, 500);
+
+   vg = evas_object_vg_add(e);
+   evas_object_resize(vg, 500, 500);
+   evas_object_show(vg);
+   root = evas_object_vg_root_node_get(vg);
+
+   lines = malloc(sizeof (Efl_VG *) * request);
+   for (i = 0; i < request; i++)
+     {
+        lines[i] = evas_vg_shape_add(root);
+        _vg_line_append(lines[i], i, 0);
+        evas_vg_node_color_set(lines[i], 0, 0, 0, 0);
+        evas_vg_shape_stroke_width_set(lines[i], 2);
+        evas_vg_shape_stroke_join_set(lines[i], EFL_GFX_JOIN_ROUND);
+     }
+
+   for (i = 0; i < VG_FRAMES; i++)
+     {
+        int j;
+
+        for (j = 0; j < request; j++)
+          evas_vg_shape_stroke_color_set(lines[j], 0, (i & 1) ? 64 : 0,
+                                         (j * 40) % 192, 192);
+        _vg_line_append(lines[i % request], i % request, i);
+        evas_bench_evas_render(e);
+     }
+
+   free(lines);
+   evas_object_del(vg);
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_vg_solid(int request)
+{
+   _vg_run(request, VG_FILL_SOLID);
+}
+
+static void
+evas_bench_vg_linear(int request)
+{
+   _vg_run(request, VG_FILL_LINEAR);
+}
+
+static void
+evas_bench_vg_radial(int request)
+{
+   _vg_run(request, VG_FILL_RADIAL);
+}
+
+static void
+evas_bench_vg_icons(int request)
+{
+   _vg_icons_run(request);
+}
+
+static void
+evas_bench_vg_strokes(int request)
+{
+   _vg_strokes_run(request);
+}
+
+void evas_bench_vg(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "solid",
+                           EINA_BENCHMARK(evas_bench_vg_solid),
+                           10, 110, 20);
+   eina_benchmark_register(bench, "linear",
+                           EINA_BENCHMARK(evas_bench_vg_linear),
+                           10, 110, 20);
+   eina_benchmark_register(bench, "radial",
+                           EINA_BENCHMARK(evas_bench_vg_radial),
+                           10, 110, 20);
+   eina_benchmark_register(bench, "static-icons",
+                           EINA_BENCHMARK(evas_bench_vg_icons),
+                           200, 1200, 200);
+   eina_benchmark_register(bench, "strokes",
+                           EINA_BENCHMARK(evas_bench_vg_strokes),
+                           50, 550, 100);
+}
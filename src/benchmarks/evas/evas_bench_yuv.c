@@ -0,0 +1,136 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Evas.h"
+#include "evas_bench.h"
+
+#define YUV_FRAMES 50
+
+/* Builds the table of row pointers of a w x h frame, the way a video
+ * decoder hands it to an image object. */
+static unsigned char **
+_frame_new(Evas_Colorspace cspace, int w, int h, unsigned char **pixels)
+{
+   unsigned char **rows;
+   unsigned char *p;
+   int mb_h, base_h;
+   int i;
+
+   *pixels = p = malloc(w * h * 2);
+   for (i = 0; i < w * h * 2; i++)
+     p[i] = (i * 7) ^ (i >> 9);
+
+   rows = malloc(sizeof (unsigned char *) * h * 2);
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+         for (i = 0; i < h; i++)
+           rows[i] = p + (i * w);
+         for (i = 0; i < h / 2; i++)
+           {
+              rows[h + i] = p + (w * h) + (i * (w / 2));
+              rows[h + (h / 2) + i] = p + (w * h) + ((w * h) / 4) + (i * (w / 2));
+           }
+         break;
+      case EVAS_COLORSPACE_YCBCR422601_PL:
+         for (i = 0; i < h; i++)
+           rows[i] = p + (i * w * 2);
+         break;
+      case EVAS_COLORSPACE_YCBCR420NV12601_PL:
+         for (i = 0; i < h; i++)
+           rows[i] = p + (i * w);
+         for (i = 0; i < h / 2; i++)
+           rows[h + i] = p + (w * h) + (i * w);
+         break;
+      case EVAS_COLORSPACE_YCBCR420TM12601_PL:
+         /* one row per pair of 64x32 macroblock rows */
+         mb_h = h / 32;
+         base_h = (mb_h >> 1) + (mb_h & 0x1);
+         for (i = 0; i < base_h; i++)
+           {
+              rows[i] = p + (i * 2 * 64 * 32 * (w / 64));
+              rows[base_h + i] = p + (w * h) + (i * 64 * 32 * (w / 64));
+           }
+         break;
+      default:
+         break;
+     }
+
+   return rows;
+}
+
+/* A video frame of request pixels wide (16:9) is put in an image object
+ * and converted to RGB on every frame. */
+static void
+_yuv_run(int request, Evas_Colorspace cspace)
+{
+   unsigned char **rows, *pixels;
+   Evas_Object *o;
+   Evas *e;
+   int w, h, i;
+
+   w = request;
+   h = ((request * 9) / 16) & ~31;
+
+   e = evas_bench_evas_new(500, 500);
+   rows = _frame_new(cspace, w, h, &pixels);
+
+   o = evas_object_image_filled_add(e);
+   evas_object_image_colorspace_set(o, cspace);
+   evas_object_image_size_set(o, w, h);
+   evas_object_resize(o, 480, 270);
+   evas_object_show(o);
+
+   for (i = 0; i < YUV_FRAMES; i++)
+     {
+        evas_object_image_data_set(o, rows);
+        evas_object_image_data_update_add(o, 0, 0, w, h);
+        evas_bench_evas_render(e);
+     }
+
+   /* the image owns the row table once it is set */
+   evas_object_del(o);
+   free(pixels);
+   evas_bench_evas_free(e);
+}
+
+static void
+evas_bench_yuv_yv12(int request)
+{
+   _yuv_run(request, EVAS_COLORSPACE_YCBCR422P601_PL);
+}
+
+static void
+evas_bench_yuv_yuy2(int request)
+{
+   _yuv_run(request, EVAS_COLORSPACE_YCBCR422601_PL);
+}
+
+static void
+evas_bench_yuv_nv12(int request)
+{
+   _yuv_run(request, EVAS_COLORSPACE_YCBCR420NV12601_PL);
+}
+
+static void
+evas_bench_yuv_nv12_tiled(int request)
+{
+   _yuv_run(request, EVAS_COLORSPACE_YCBCR420TM12601_PL);
+}
+
+void evas_bench_yuv(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "yv12",
+                           EINA_BENCHMARK(evas_bench_yuv_yv12),
+                           320, 2240, 320);
+   eina_benchmark_register(bench, "yuy2",
+                           EINA_BENCHMARK(evas_bench_yuv_yuy2),
+                           320, 2240, 320);
+   eina_benchmark_register(bench, "nv12",
+                           EINA_BENCHMARK(evas_bench_yuv_nv12),
+                           320, 2240, 320);
+   eina_benchmark_register(bench, "nv12-tiled",
+                           EINA_BENCHMARK(evas_bench_yuv_nv12_tiled),
+                           320, 2240, 320);
+}
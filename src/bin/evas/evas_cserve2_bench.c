@@ -0,0 +1,515 @@
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Eina.h>
+
+#include "evas_cs2.h"
+
+/* Synthetic load for a running cserve2 server: a number of clients are
+ * forked, each one opening, loading and releasing images (and fonts) from
+ * the given list in turn, and the latency of every request that expects an
+ * answer is reported as percentiles once all clients are done. */
+
+static int socketfd = -1;
+static unsigned int _rid_count = 1;
+static int _evas_cserve2_bench_log_dom = -1;
+
+#ifndef UNIX_PATH_MAX
+#define UNIX_PATH_MAX sizeof(((struct sockaddr_un *)NULL)->sun_path)
+#endif
+
+#ifdef ERR
+#undef ERR
+#endif
+#define ERR(...) EINA_LOG_DOM_ERR(_evas_cserve2_bench_log_dom, __VA_ARGS__)
+#ifdef DBG
+#undef DBG
+#endif
+#define DBG(...) EINA_LOG_DOM_DBG(_evas_cserve2_bench_log_dom, __VA_ARGS__)
+
+typedef enum {
+   BENCH_OPEN,
+   BENCH_LOAD,
+   BENCH_FONT_LOAD,
+   BENCH_LAST
+} Bench_Op;
+
+static const char *_op_names[BENCH_LAST] = { "open", "load", "font load" };
+
+/* Shared with the clients: one latency slot per op and request, in
+ * microseconds, -1 when the request failed and -2 when it was not sent. */
+typedef struct _Bench_Results Bench_Results;
+struct _Bench_Results {
+   int clients;
+   int requests;
+   int lat[]; // [client][request][op]
+};
+
+static void
+_socket_path_set(char *path)
+{
+   char *env;
+   char buf[UNIX_PATH_MAX];
+
+   env = getenv("EVAS_CSERVE2_SOCKET");
+   if (env && env[0])
+     {
+        eina_strlcpy(path, env, UNIX_PATH_MAX);
+        return;
+     }
+
+   snprintf(buf, sizeof(buf), "/tmp/.evas-cserve2-%x.socket", (int)getuid());
+   strcpy(path, buf);
+}
+
+static Eina_Bool
+_server_connect(void)
+{
+   int s, len;
+   struct sockaddr_un remote;
+
+   if ((s = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+     {
+        ERR("socket");
+        return EINA_FALSE;
+     }
+
+   remote.sun_family = AF_UNIX;
+   _socket_path_set(remote.sun_path);
+   len = strlen(remote.sun_path) + sizeof(remote.sun_family);
+   if (connect(s, (struct sockaddr *)&remote, len) == -1)
+     {
+        close(s);
+        ERR("connect");
+        return EINA_FALSE;
+     }
+
+   socketfd = s;
+
+   DBG("connected to cserve2 server.");
+   return EINA_TRUE;
+}
+
+static void
+_server_disconnect(void)
+{
+   close(socketfd);
+   socketfd = -1;
+}
+
+static Eina_Bool
+_server_send(const void *data, int size)
+{
+   int sent = 0;
+   ssize_t ret;
+   const char *msg = data;
+
+   if (send(socketfd, &size, sizeof(size), MSG_NOSIGNAL) != sizeof(size))
+     return EINA_FALSE;
+
+   while (sent < size)
+     {
+        ret = send(socketfd, msg + sent, size - sent, MSG_NOSIGNAL);
+        if (ret < 0)
+          {
+             if ((errno == EAGAIN) || (errno == EINTR))
+               continue;
+             return EINA_FALSE;
+          }
+        sent += ret;
+     }
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_server_recv_all(void *buf, int size)
+{
+   int got = 0;
+   ssize_t n;
+
+   while (got < size)
+     {
+        n = recv(socketfd, (char *)buf + got, size - got, 0);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          return EINA_FALSE;
+        got += n;
+     }
+
+   return EINA_TRUE;
+}
+
+/* Blocks until the answer to rid arrives. Index lists pushed by the server
+ * in the meantime are skipped. */
+static Msg_Base *
+_server_answer_wait(unsigned int rid)
+{
+   Msg_Base *msg;
+   int size;
+
+   while (1)
+     {
+        if (!_server_recv_all(&size, sizeof(size)))
+          return NULL;
+        if ((size < (int) sizeof(Msg_Base)) || (size > 0x100000))
+          return NULL;
+
+        msg = malloc(size);
+        if (!msg || !_server_recv_all(msg, size))
+          {
+             free(msg);
+             return NULL;
+          }
+
+        if ((msg->type != CSERVE2_INDEX_LIST) && (msg->rid == rid))
+          return msg;
+
+        free(msg);
+     }
+}
+
+static long long
+_now_us(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Sends msg and returns the latency to its answer, or -1 on error. */
+static int
+_request_do(void *msg, int size, int expected)
+{
+   Msg_Base *answer;
+   unsigned int rid;
+   long long t0;
+   int ret = -1;
+
+   rid = ((Msg_Base *) msg)->rid;
+   t0 = _now_us();
+   if (!_server_send(msg, size))
+     return -1;
+
+   answer = _server_answer_wait(rid);
+   if (!answer)
+     return -1;
+
+   if (answer->type == expected)
+     ret = (int) (_now_us() - t0);
+   else if (answer->type == CSERVE2_ERROR)
+     DBG("request %u failed: %d", rid, ((Msg_Error *) answer)->error);
+   free(answer);
+
+   return ret;
+}
+
+static int
+_image_open(const char *path, unsigned int file_id, unsigned int image_id)
+{
+   Msg_Open msg;
+   int plen, size, ret;
+   char *buf;
+
+   plen = strlen(path) + 1;
+   size = sizeof(msg) + plen + 1;
+   buf = malloc(size);
+   if (!buf) return -1;
+
+   memset(&msg, 0, sizeof(msg));
+   msg.base.rid = _rid_count++;
+   msg.base.type = CSERVE2_OPEN;
+   msg.file_id = file_id;
+   msg.path_offset = 0;
+   msg.key_offset = plen;
+   msg.image_id = image_id;
+
+   memcpy(buf, &msg, sizeof(msg));
+   memcpy(buf + sizeof(msg), path, plen);
+   buf[sizeof(msg) + plen] = '\0';
+
+   ret = _request_do(buf, size, CSERVE2_OPENED);
+   free(buf);
+
+   return ret;
+}
+
+static int
+_image_load(unsigned int image_id)
+{
+   Msg_Load msg;
+
+   memset(&msg, 0, sizeof(msg));
+   msg.base.rid = _rid_count++;
+   msg.base.type = CSERVE2_LOAD;
+   msg.image_id = image_id;
+
+   return _request_do(&msg, sizeof(msg), CSERVE2_LOADED);
+}
+
+static void
+_image_release(unsigned int file_id, unsigned int image_id)
+{
+   Msg_Unload unload;
+   Msg_Close close_msg;
+
+   memset(&unload, 0, sizeof(unload));
+   unload.base.rid = _rid_count++;
+   unload.base.type = CSERVE2_UNLOAD;
+   unload.image_id = image_id;
+   _server_send(&unload, sizeof(unload));
+
+   memset(&close_msg, 0, sizeof(close_msg));
+   close_msg.base.rid = _rid_count++;
+   close_msg.base.type = CSERVE2_CLOSE;
+   close_msg.file_id = file_id;
+   _server_send(&close_msg, sizeof(close_msg));
+}
+
+static Msg_Font_Load *
+_font_msg_new(Message_Type type, const char *path, int *size)
+{
+   Msg_Font_Load *msg;
+   int plen;
+
+   plen = strlen(path) + 1;
+   *size = sizeof(*msg) + plen;
+   msg = calloc(1, *size);
+   if (!msg) return NULL;
+
+   msg->base.rid = _rid_count++;
+   msg->base.type = type;
+   msg->sourcelen = 0;
+   msg->pathlen = plen;
+   msg->rend_flags = 0;
+   msg->size = 12;
+   msg->dpi = 75;
+   memcpy(msg + 1, path, plen);
+
+   return msg;
+}
+
+static int
+_font_load(const char *path)
+{
+   Msg_Font_Load *msg;
+   int size, ret;
+
+   msg = _font_msg_new(CSERVE2_FONT_LOAD, path, &size);
+   if (!msg) return -1;
+   ret = _request_do(msg, size, CSERVE2_FONT_LOADED);
+   free(msg);
+
+   return ret;
+}
+
+static void
+_font_release(const char *path)
+{
+   Msg_Font_Load *msg;
+   int size;
+
+   msg = _font_msg_new(CSERVE2_FONT_UNLOAD, path, &size);
+   if (!msg) return;
+   _server_send(msg, size);
+   free(msg);
+}
+
+static void
+_client_run(Bench_Results *res, int client, char **images, int nimages,
+            char **fonts, int nfonts)
+{
+   int *lat;
+   int i;
+
+   if (!_server_connect())
+     {
+        ERR("Client %d could not connect to server.", client);
+        return;
+     }
+
+   for (i = 0; i < res->requests; i++)
+     {
+        // Clients walk the same lists out of phase, so they share entries
+        // without always hitting them at the same moment.
+        unsigned int id = i + 1;
+
+        lat = res->lat + ((client * res->requests) + i) * BENCH_LAST;
+
+        if (nimages)
+          {
+             const char *path = images[(i + client) % nimages];
+
+             lat[BENCH_OPEN] = _image_open(path, id, id);
+             if (lat[BENCH_OPEN] >= 0)
+               lat[BENCH_LOAD] = _image_load(id);
+             _image_release(id, id);
+          }
+
+        if (nfonts)
+          {
+             const char *path = fonts[(i + client) % nfonts];
+
+             lat[BENCH_FONT_LOAD] = _font_load(path);
+             _font_release(path);
+          }
+     }
+
+   _server_disconnect();
+}
+
+static int
+_int_cmp(const void *a, const void *b)
+{
+   return *(const int *) a - *(const int *) b;
+}
+
+static void
+_results_print(Bench_Results *res)
+{
+   int total = res->clients * res->requests;
+   int *values;
+   int op, k;
+
+   values = malloc(total * sizeof(int));
+   if (!values) return;
+
+   printf("%-10s %8s %8s %10s %10s %10s %10s\n", "request", "count",
+          "errors", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)");
+   for (op = 0; op < BENCH_LAST; op++)
+     {
+        int count = 0, errors = 0, issued = 0;
+
+        for (k = 0; k < total; k++)
+          {
+             int v = res->lat[k * BENCH_LAST + op];
+
+             if (v == -2) continue;
+             issued++;
+             if (v < 0) errors++;
+             else values[count++] = v;
+          }
+        if (!issued) continue;
+
+        if (!count)
+          {
+             printf("%-10s %8d %8d\n", _op_names[op], issued, errors);
+             continue;
+          }
+
+        qsort(values, count, sizeof(int), _int_cmp);
+        printf("%-10s %8d %8d %10d %10d %10d %10d\n", _op_names[op],
+               issued, errors,
+               values[(count - 1) * 50 / 100],
+               values[(count - 1) * 90 / 100],
+               values[(count - 1) * 99 / 100],
+               values[count - 1]);
+     }
+
+   free(values);
+}
+
+static void
+_usage(const char *prog)
+{
+   printf("Usage: %s [-c clients] [-n requests] [-f font]... image...\n"
+          "\n"
+          "  -c clients   number of concurrent clients (default 4)\n"
+          "  -n requests  requests per client (default 100)\n"
+          "  -f font      font file to load as well, may be repeated\n",
+          prog);
+}
+
+int
+main(int argc, char *argv[])
+{
+   Bench_Results *res;
+   char **fonts = NULL;
+   size_t size;
+   int clients = 4, requests = 100, nfonts = 0;
+   int c, k, failed = 0;
+
+   fonts = calloc(argc, sizeof(char *));
+   if (!fonts) return -1;
+
+   while ((c = getopt(argc, argv, "c:n:f:h")) != -1)
+     {
+        switch (c)
+          {
+           case 'c': clients = atoi(optarg); break;
+           case 'n': requests = atoi(optarg); break;
+           case 'f': fonts[nfonts++] = optarg; break;
+           default:
+             _usage(argv[0]);
+             free(fonts);
+             return (c == 'h') ? 0 : -1;
+          }
+     }
+
+   if ((clients <= 0) || (requests <= 0) || ((optind >= argc) && !nfonts))
+     {
+        _usage(argv[0]);
+        free(fonts);
+        return -1;
+     }
+
+   eina_init();
+   _evas_cserve2_bench_log_dom = eina_log_domain_register
+      ("evas_cserve2_bench", EINA_COLOR_BLUE);
+
+   size = sizeof(*res) + (size_t) clients * requests * BENCH_LAST * sizeof(int);
+   res = mmap(NULL, size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (res == MAP_FAILED)
+     {
+        ERR("Could not allocate results.");
+        eina_shutdown();
+        free(fonts);
+        return -1;
+     }
+   res->clients = clients;
+   res->requests = requests;
+   for (k = 0; k < clients * requests * BENCH_LAST; k++)
+     res->lat[k] = -2;
+
+   for (k = 0; k < clients; k++)
+     {
+        pid_t pid = fork();
+
+        if (pid < 0)
+          {
+             ERR("fork");
+             failed++;
+             continue;
+          }
+        if (!pid)
+          {
+             _client_run(res, k, argv + optind, argc - optind, fonts, nfonts);
+             _exit(0);
+          }
+     }
+
+   for (k = 0; k < clients - failed; k++)
+     wait(NULL);
+
+   _results_print(res);
+
+   munmap(res, size);
+   eina_shutdown();
+   free(fonts);
+
+   return 0;
+}
@@ -70,7 +70,10 @@ struct _File_Entry {
 
 struct _Image_Entry {
    ENTRY;
+   EINA_INLIST; // image_entries_lru, while unused
    Shm_Handle *shm;
+   size_t lru_size; // bytes charged to unused_mem_usage
+   Eina_Bool lru : 1;
 };
 
 struct _Font_Source {
@@ -83,6 +86,7 @@ struct _Font_Source {
 
 struct _Font_Entry {
    ENTRY;
+   EINA_INLIST; // font_shm_lru, while unused
    unsigned int rend_flags;
    unsigned int size;
    unsigned int dpi;
@@ -91,7 +95,9 @@ struct _Font_Entry {
    void *ft; // Font_Info
    Fash_Glyph2 *glyph_entries[3]; // Fast access to the Glyph_Entry objects
    unsigned int nglyphs;
+   size_t usage; // bytes charged to font_mem_usage
    Eina_Bool unused : 1;
+   Eina_Bool lru : 1;
    Shared_Mempool *mempool; // Contains the rendered glyphs
 #ifdef DEBUG_LOAD_TIME
    struct timeval rstart; // start of the glyphs load request
@@ -159,14 +165,19 @@ static Eina_Hash *font_entries = NULL; // maps font path + options --> entry
 
 static Eina_Hash *file_watch = NULL;
 
-static Eina_List *image_entries_lru = NULL;
+// maps object id --> slot + 1 in the matching shared array
+static Eina_Hash *file_data_slots = NULL;
+static Eina_Hash *image_data_slots = NULL;
+static Eina_Hash *font_data_slots = NULL;
 
-static Eina_List *font_shm_lru = NULL;
+static Eina_Inlist *image_entries_lru = NULL; // most recently unused first
 
-static int max_unused_mem_usage = 5 * 4 * 1024; /* in kbytes */
-static int unused_mem_usage = 0;
-static int max_font_usage = 10 * 4 * 1024; /* in kbytes */
-static int font_mem_usage = 0;
+static Eina_Inlist *font_shm_lru = NULL; // least recently unused first
+
+static size_t max_unused_mem_usage = 5 * 4 * 1024 * 1024; /* in bytes */
+static size_t unused_mem_usage = 0;
+static size_t max_font_usage = 10 * 4 * 1024 * 1024; /* in bytes */
+static size_t font_mem_usage = 0;
 
 #define MAX_PREEMPTIVE_LOAD_SIZE (320*320*4)
 #define ARRAY_REPACK_TRIGGER_PERCENT 25 // repack when array conains 25% holes
@@ -233,13 +244,39 @@ _shm_object_id_cmp_cb(const void *data1, const void *data2)
      return +1;
 }
 
+/* Arrays are only sorted up to their last repack, so looking up a newer
+ * object means a linear scan. Remember where each object was found; the
+ * slot is checked against the id, so a stale one just falls back to the
+ * search. The slots are forgotten when their array is repacked. */
+static void *
+_shared_data_find(Shared_Array *sa, Eina_Hash *slots, unsigned int id)
+{
+   Shm_Object *obj;
+   uintptr_t slot;
+   int elemid;
+
+   slot = (uintptr_t) eina_hash_find(slots, &id);
+   if (slot)
+     {
+        obj = cserve2_shared_array_item_data_get(sa, slot - 1);
+        if (obj && (obj->id == id))
+          return obj;
+     }
+
+   elemid = cserve2_shared_array_item_find(sa, &id, _shm_object_id_cmp_cb);
+   if (elemid < 0)
+     return NULL;
+
+   eina_hash_set(slots, &id, (void *) (uintptr_t) (elemid + 1));
+   return cserve2_shared_array_item_data_get(sa, elemid);
+}
+
 static File_Data *
 _file_data_find(unsigned int file_id)
 {
    File_Data *fd;
 
-   fd = cserve2_shared_array_item_data_find(_file_data_array, &file_id,
-                                            _shm_object_id_cmp_cb);
+   fd = _shared_data_find(_file_data_array, file_data_slots, file_id);
    if (fd && !fd->refcount)
      {
         ERR("Can not access object %u with refcount 0", file_id);
@@ -271,8 +308,7 @@ _image_data_find(unsigned int image_id)
 {
    Image_Data *idata;
 
-   idata = cserve2_shared_array_item_data_find(_image_data_array, &image_id,
-                                               _shm_object_id_cmp_cb);
+   idata = _shared_data_find(_image_data_array, image_data_slots, image_id);
    if (idata && !idata->refcount)
      {
         ERR("Can not access object %u with refcount 0", image_id);
@@ -304,8 +340,7 @@ _font_data_find(unsigned int fs_id)
 {
    Font_Data *fdata;
 
-   fdata = cserve2_shared_array_item_data_find(_font_data_array,
-                                               &fs_id, _shm_object_id_cmp_cb);
+   fdata = _shared_data_find(_font_data_array, font_data_slots, fs_id);
    if (!fdata)
      {
         ERR("Could not find font data %u", fs_id);
@@ -372,6 +407,7 @@ _repack()
           }
 
         cserve2_shared_array_del(_file_data_array);
+        eina_hash_free_buckets(file_data_slots);
         _freed_file_entry_count = 0;
         _file_data_array = sa;
         updated = EINA_TRUE;
@@ -398,6 +434,7 @@ skip_files:
           }
 
         cserve2_shared_array_del(_image_data_array);
+        eina_hash_free_buckets(image_data_slots);
         _freed_image_entry_count = 0;
         _image_data_array = sa;
         updated = EINA_TRUE;
@@ -424,6 +461,7 @@ skip_images:
           }
 
         cserve2_shared_array_del(_font_data_array);
+        eina_hash_free_buckets(font_data_slots);
         _freed_font_entry_count = 0;
         _font_data_array = sa;
         updated = EINA_TRUE;
@@ -511,6 +549,7 @@ _image_loaded_msg_create(Image_Entry *ientry, Image_Data *idata, int *size)
    msg->image.h = idata->h;
    msg->alpha = idata->alpha;
 
+   cserve2_shm_object_write_begin(&idata->seq);
    if (idata->shm_id)
      {
         const char *old = cserve2_shared_string_get(idata->shm_id);
@@ -524,6 +563,7 @@ _image_loaded_msg_create(Image_Entry *ientry, Image_Data *idata, int *size)
      idata->shm_id = cserve2_shared_string_add(shmpath);
 
    idata->valid = EINA_TRUE;
+   cserve2_shm_object_write_end(&idata->seq);
 
    buf = (char *)msg + sizeof(*msg);
    memcpy(buf, shmpath, path_len);
@@ -642,6 +682,7 @@ _open_request_response(Entry *entry, Slave_Msg_Image_Opened *resp, int *size)
         return NULL;
      }
 
+   cserve2_shm_object_write_begin(&fd->seq);
    fd->w = resp->w;
    fd->h = resp->h;
    fd->animated = resp->animated;
@@ -657,6 +698,7 @@ _open_request_response(Entry *entry, Slave_Msg_Image_Opened *resp, int *size)
      }
 
    fd->valid = EINA_TRUE;
+   cserve2_shm_object_write_end(&fd->seq);
 
    // If the image is too large, cancel pre-emptive load.
    if (fd->w * fd->h * 4 >= MAX_PREEMPTIVE_LOAD_SIZE)
@@ -899,6 +941,7 @@ _load_request_response(Image_Entry *ientry,
    _entry_load_finish(ASENTRY(ientry));
    ASENTRY(ientry)->request = NULL;
 
+   cserve2_shm_object_write_begin(&idata->seq);
    idata->alpha = resp->alpha;
    idata->alpha_sparse = resp->alpha_sparse;
    if (!idata->doload)
@@ -918,6 +961,7 @@ _load_request_response(Image_Entry *ientry,
      }
    else
      DBG("No scaling needed for image %u", idata->id);
+   cserve2_shm_object_write_end(&idata->seq);
 
    return _image_loaded_msg_create(ientry, idata, size);
 }
@@ -960,14 +1004,43 @@ _image_opts_id_get(unsigned int file_id, const Evas_Image_Load_Opts *opts,
    return (unsigned int) image_id;
 }
 
-static int
+static size_t
 _image_entry_size_get(Image_Entry *ientry)
 {
-   int size = sizeof(Image_Data);
-   /* XXX: get the overhead of the shm handler too */
+   size_t size = sizeof(Image_Entry) + sizeof(Image_Data);
    if (ientry->shm)
-     size += cserve2_shm_size_get(ientry->shm);
-   return size / 1024;
+     size += cserve2_shm_map_size_get(ientry->shm);
+   return size;
+}
+
+static void
+_image_lru_del(Image_Entry *ientry)
+{
+   if (!ientry->lru) return;
+
+   image_entries_lru = eina_inlist_remove(image_entries_lru,
+                                          EINA_INLIST_GET(ientry));
+   unused_mem_usage -= ientry->lru_size;
+   ientry->lru_size = 0;
+   ientry->lru = EINA_FALSE;
+}
+
+static void
+_image_lru_add(Image_Entry *ientry)
+{
+   if (ientry->lru)
+     {
+        image_entries_lru = eina_inlist_promote(image_entries_lru,
+                                                EINA_INLIST_GET(ientry));
+        return;
+     }
+
+   // Charge what the entry weighs now, so removal gives back exactly that
+   ientry->lru_size = _image_entry_size_get(ientry);
+   image_entries_lru = eina_inlist_prepend(image_entries_lru,
+                                           EINA_INLIST_GET(ientry));
+   unused_mem_usage += ientry->lru_size;
+   ientry->lru = EINA_TRUE;
 }
 
 static Eina_Bool
@@ -1068,11 +1141,7 @@ _image_entry_free(Image_Entry *ientry)
      cserve2_request_cancel_all(ientry->base.request,
                                 CSERVE2_REQUEST_CANCEL);
 
-   if (idata->unused)
-     {
-        image_entries_lru = eina_list_remove(image_entries_lru, ientry);
-        unused_mem_usage -= _image_entry_size_get(ientry);
-     }
+   _image_lru_del(ientry);
 
    fd = _file_data_find(idata->file_id);
    if (fd)
@@ -1091,8 +1160,10 @@ _image_entry_free(Image_Entry *ientry)
 
    if (ientry->shm)
      cserve2_shm_unref(ientry->shm);
+   cserve2_shm_object_write_begin(&idata->seq);
    cserve2_shared_string_del(idata->shm_id);
    idata->shm_id = 0;
+   cserve2_shm_object_write_end(&idata->seq);
    free(ientry);
 }
 
@@ -1147,12 +1218,14 @@ _file_data_free(File_Data *fd)
 {
    if (!fd) return;
    if (!fd->refcount) return;
+   cserve2_shm_object_write_begin(&fd->seq);
    if (--fd->refcount == 0)
      {
         cserve2_shared_string_del(fd->key);
         cserve2_shared_string_del(fd->path);
         cserve2_shared_string_del(fd->loader_data);
      }
+   cserve2_shm_object_write_end(&fd->seq);
 }
 
 static void
@@ -1217,10 +1290,10 @@ _font_entry_key_hash(const Font_Entry *key, int key_length EINA_UNUSED)
    return hash;
 }
 
-static int
+static size_t
 _font_entry_memory_usage_get(Font_Entry *fe)
 {
-   int size = sizeof(Font_Entry);
+   size_t size = sizeof(Font_Entry);
 
    if (!fe) return 0;
    if (!fe->mempool)
@@ -1232,26 +1305,40 @@ _font_entry_memory_usage_get(Font_Entry *fe)
    return size;
 }
 
+/* Charge the font's current footprint. The glyph mempool only grows as
+ * glyphs get rendered, so this is called again after every glyph load. */
+static void
+_font_entry_usage_update(Font_Entry *fe)
+{
+   size_t size = _font_entry_memory_usage_get(fe);
+
+   font_mem_usage = font_mem_usage - fe->usage + size;
+   fe->usage = size;
+}
+
 static void
 _font_entry_free(Font_Entry *fe)
 {
    Font_Data *fd;
-   int size, k;
+   int k;
 
    if (!fe) return;
-   size = _font_entry_memory_usage_get(fe);
 
-   DBG("Font memory usage down: %d -> %d / %d", font_mem_usage,
-       font_mem_usage - size, max_font_usage);
-   font_mem_usage -= size;
+   DBG("Font memory usage down: %zu -> %zu / %zu", font_mem_usage,
+       font_mem_usage - fe->usage, max_font_usage);
+   font_mem_usage -= fe->usage;
+   if (fe->lru)
+     font_shm_lru = eina_inlist_remove(font_shm_lru, EINA_INLIST_GET(fe));
 
    fd = _font_data_find(fe->font_data_id);
    if (fd)
      {
+        cserve2_shm_object_write_begin(&fd->seq);
         fd->refcount = 0;
         cserve2_shared_string_del(fd->glyph_index_shm);
         cserve2_shared_string_del(fd->file);
         cserve2_shared_string_del(fd->name);
+        cserve2_shm_object_write_end(&fd->seq);
      }
 
    for (k = 0; k < 3; k++)
@@ -1281,8 +1368,10 @@ _glyph_free_cb(void *data)
    gldata = _glyph_data_find(gl->fe->mempool, gl->gldata_id);
    if (gldata)
      {
+        cserve2_shm_object_write_begin(&gldata->seq);
         cserve2_shared_string_del(gldata->mempool_id);
         gldata->refcount--;
+        cserve2_shm_object_write_end(&gldata->seq);
      }
    free(gl);
 }
@@ -1300,48 +1389,36 @@ _font_source_free(Font_Source *fs)
    free(fs);
 }
 
+// Only unused fonts are kept in the LRU, oldest first
 static void
 _font_lru_update(Font_Entry *fe)
 {
-   Eina_List *l;
-   l = eina_list_data_find_list(font_shm_lru, fe);
-   if (l)
-     {
-        if (fe->unused)
-          font_shm_lru = eina_list_promote_list(font_shm_lru, l);
-        else
-          font_shm_lru = eina_list_demote_list(font_shm_lru, l);
-     }
+   if (fe->unused == fe->lru)
+     return;
+
+   if (fe->unused)
+     font_shm_lru = eina_inlist_append(font_shm_lru, EINA_INLIST_GET(fe));
    else
-     font_shm_lru = eina_list_append(font_shm_lru, fe);
+     font_shm_lru = eina_inlist_remove(font_shm_lru, EINA_INLIST_GET(fe));
+   fe->lru = fe->unused;
 }
 
 static void
 _font_lru_flush(void)
 {
-   Eina_List *l, *l_next;
+   DBG("Font memory usage [begin]: %zu / %zu", font_mem_usage, max_font_usage);
 
-   l = font_shm_lru;
-   l_next = eina_list_next(l);
-
-   DBG("Font memory usage [begin]: %d / %d", font_mem_usage, max_font_usage);
-
-   while (l && font_mem_usage > max_font_usage)
+   while (font_shm_lru && font_mem_usage > max_font_usage)
      {
         Font_Entry *fe;
 
-        fe = eina_list_data_get(l);
-        if (fe->unused)
-          {
-             font_shm_lru = eina_list_remove_list(font_shm_lru, l);
-             eina_hash_del_by_key(font_entries, fe);
-          }
-
-        l = l_next;
-        l_next = eina_list_next(l);
+        fe = EINA_INLIST_CONTAINER_GET(font_shm_lru, Font_Entry);
+        font_shm_lru = eina_inlist_remove(font_shm_lru, font_shm_lru);
+        fe->lru = EINA_FALSE;
+        eina_hash_del_by_key(font_entries, fe);
      }
 
-   DBG("Font memory usage [end]: %d / %d", font_mem_usage, max_font_usage);
+   DBG("Font memory usage [end]: %zu / %zu", font_mem_usage, max_font_usage);
 }
 
 void
@@ -1360,6 +1437,10 @@ cserve2_cache_init(void)
                                 EINA_FREE_CB(_font_entry_free),
                                 5);
 
+   file_data_slots = eina_hash_int32_new(NULL);
+   image_data_slots = eina_hash_int32_new(NULL);
+   font_data_slots = eina_hash_int32_new(NULL);
+
    _generation_id++;
    _file_data_array = cserve2_shared_array_new(FILE_DATA_ARRAY_TAG,
                                                _generation_id,
@@ -1389,6 +1470,10 @@ cserve2_cache_shutdown(void)
    cserve2_shared_array_del(_file_data_array);
    cserve2_shared_array_del(_image_data_array);
    cserve2_shared_array_del(_font_data_array);
+
+   eina_hash_free(file_data_slots);
+   eina_hash_free(image_data_slots);
+   eina_hash_free(font_data_slots);
 }
 
 static Reference *
@@ -1411,7 +1496,7 @@ static void
 _entry_unused_push(Image_Entry *ientry)
 {
    Image_Data *idata;
-   int size;
+   size_t size;
 
    idata = _image_data_find(ENTRYID(ientry));
    if (!idata) return;
@@ -1423,26 +1508,26 @@ _entry_unused_push(Image_Entry *ientry)
         eina_hash_del_by_key(image_entries, &idata->id);
         return;
      }
+   _image_lru_del(ientry);
    while (image_entries_lru &&
-          (size > (max_unused_mem_usage - unused_mem_usage)))
+          ((unused_mem_usage + size) > max_unused_mem_usage))
      {
-        Image_Entry *ie = eina_list_data_get(eina_list_last(image_entries_lru));
-        Eina_Bool ok = eina_hash_del_by_key(image_entries, &(ENTRYID(ie)));
-        if (!ok)
+        Image_Entry *ie = EINA_INLIST_CONTAINER_GET(image_entries_lru->last,
+                                                    Image_Entry);
+        _image_lru_del(ie);
+        if (!eina_hash_del_by_key(image_entries, &(ENTRYID(ie))))
           {
              DBG("Image %d was not found in the hash table!", ENTRYID(ie));
-             image_entries_lru = eina_list_remove(image_entries_lru, ie);
              _image_entry_free(ie);
           }
      }
    if (!image_entries_lru && (unused_mem_usage != 0))
      {
-        DBG("Invalid accounting of LRU size (was empty but size: %d)",
+        DBG("Invalid accounting of LRU size (was empty but size: %zu)",
             unused_mem_usage);
         unused_mem_usage = 0;
      }
-   image_entries_lru = eina_list_append(image_entries_lru, ientry);
-   unused_mem_usage += size;
+   _image_lru_add(ientry);
 }
 
 static void
@@ -1627,6 +1712,7 @@ _image_entry_new(Client *client, int rid,
    ientry = calloc(1, sizeof(*ientry));
    ientry->base.id = image_id;
    ientry->base.type = CSERVE2_IMAGE_DATA;
+   cserve2_shm_object_write_begin(&idata->seq);
    if (opts)
      {
         idata->opts.dpi = opts->dpi;
@@ -1652,6 +1738,7 @@ _image_entry_new(Client *client, int rid,
    idata->file_id = ref->entry->id;
    idata->refcount = 1;
    idata->id = image_id;
+   cserve2_shm_object_write_end(&idata->seq);
 
    _image_key_set(idata->file_id, opts, buf, buf_size);
    eina_hash_add(image_entries, &image_id, ientry);
@@ -1711,8 +1798,10 @@ _file_changed_cb(const char *path EINA_UNUSED, Eina_Bool deleted EINA_UNUSED, vo
         fd = _file_data_find(fentry_id);
         if (fd)
           {
+             cserve2_shm_object_write_begin(&fd->seq);
              fd->changed = EINA_TRUE;
              fd->valid = EINA_FALSE;
+             cserve2_shm_object_write_end(&fd->seq);
              _file_id_free(fd);
              eina_hash_set(file_entries, &fd->id, NULL);
           }
@@ -2143,15 +2232,17 @@ _glyphs_load_request_response(Glyphs_Request *req,
 
    fd = _font_data_find(fe->font_data_id);
 
-   DBG("Font memory usage [begin]: %d / %d", font_mem_usage, max_font_usage);
+   DBG("Font memory usage [begin]: %zu / %zu", font_mem_usage, max_font_usage);
 
    cserve2_shared_mempool_generation_id_set(mempool, _generation_id);
    index = cserve2_shared_mempool_index_get(mempool);
 
    if (!fd->glyph_index_shm)
      {
+        cserve2_shm_object_write_begin(&fd->seq);
         fd->glyph_index_shm = cserve2_shared_string_add
           (cserve2_shared_array_name_get(index));
+        cserve2_shm_object_write_end(&fd->seq);
      }
 
    shm_id = cserve2_shared_string_add(cserve2_shared_mempool_name_get(mempool));
@@ -2176,6 +2267,7 @@ _glyphs_load_request_response(Glyphs_Request *req,
              gl->fe = fe;
              gl->gldata_id = gldata->id;
 
+             cserve2_shm_object_write_begin(&gldata->seq);
              gldata->mempool_id = cserve2_shared_string_ref(shm_id);
              gldata->index = msg->glyphs[j].index;
              gldata->offset = msg->glyphs[j].offset;
@@ -2184,11 +2276,10 @@ _glyphs_load_request_response(Glyphs_Request *req,
              gldata->width = msg->glyphs[j].width;
              gldata->pitch = msg->glyphs[j].pitch;
              gldata->hint = hint;
+             cserve2_shm_object_write_end(&gldata->seq);
 
              fe->nglyphs++;
              fash_gl_add(fe->glyph_entries[hint], gldata->index, gl);
-
-             font_mem_usage += sizeof(*gl);
           }
         req->answer[req->nanswer++] = gl;
      }
@@ -2204,10 +2295,15 @@ _glyphs_load_request_response(Glyphs_Request *req,
 
    fe->mempool = mempool;
    if (!fd->mempool_shm)
-     fd->mempool_shm = cserve2_shared_string_add(
-              cserve2_shared_mempool_name_get(mempool));
+     {
+        cserve2_shm_object_write_begin(&fd->seq);
+        fd->mempool_shm = cserve2_shared_string_add(
+                 cserve2_shared_mempool_name_get(mempool));
+        cserve2_shm_object_write_end(&fd->seq);
+     }
 
-   DBG("Font memory usage [end]: %d / %d", font_mem_usage, max_font_usage);
+   _font_entry_usage_update(fe);
+   DBG("Font memory usage [end]: %zu / %zu", font_mem_usage, max_font_usage);
    _font_lru_flush();
 
    return _glyphs_loaded_msg_create(req, size);
@@ -2320,8 +2416,8 @@ _image_data_entry_stats_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EI
    if (idata->unused) msg->images.images_unused++;
 
    // accounting size
-   msg->images.images_size += _image_entry_size_get(ientry) * 1024;
-   if (idata->unused) msg->images.unused_size += _image_entry_size_get(ientry) * 1024;
+   msg->images.images_size += _image_entry_size_get(ientry);
+   if (idata->unused) msg->images.unused_size += _image_entry_size_get(ientry);
 
    fd = _file_data_find(idata->file_id);
    if (fd)
@@ -2618,6 +2714,7 @@ cserve2_cache_file_open(Client *client, unsigned int client_file_id,
         return -1;
      }
    memset(fd, 0, sizeof(*fd));
+   cserve2_shm_object_write_begin(&fd->seq);
    fd->valid = EINA_FALSE;
    fd->path = cserve2_shared_string_add(path);
    fd->key = cserve2_shared_string_add(key);
@@ -2633,6 +2730,7 @@ cserve2_cache_file_open(Client *client, unsigned int client_file_id,
    fd->lo.orientation = lo->orientation;
    fd->refcount = 1;
    fd->id = file_id;
+   cserve2_shm_object_write_end(&fd->seq);
 
    fentry = calloc(1, sizeof(File_Entry));
    ASENTRY(fentry)->type = CSERVE2_IMAGE_FILE;
@@ -2823,11 +2921,8 @@ do_scaling:
         return -1;
      }
 
-   if (orig_data->unused)
-     {
-        image_entries_lru = eina_list_remove(image_entries_lru, orig_entry);
-        image_entries_lru = eina_list_prepend(image_entries_lru, orig_entry);
-     }
+   if (orig_entry->lru)
+     _image_lru_add(orig_entry);
    return 0;
 }
 
@@ -2876,8 +2971,7 @@ cserve2_cache_image_entry_create(Client *client, int rid,
                  ientry->base.id);
              idata->unused = EINA_FALSE;
              idata->refcount++;
-             image_entries_lru = eina_list_remove(image_entries_lru, ientry);
-             unused_mem_usage -= _image_entry_size_get(ientry);
+             _image_lru_del(ientry);
           }
         _entry_load_reused(&ientry->base);
 
@@ -3057,6 +3151,7 @@ cserve2_cache_font_load(Client *client, const char *source, const char *name,
    client->fonts.referencing = eina_list_append(client->fonts.referencing, ref);
    fe->unused = EINA_FALSE;
    _font_lru_update(fe);
+   _font_entry_usage_update(fe);
 
    fs = _cserve2_font_source_find(fullname);
    if (!fs)
@@ -3083,6 +3178,7 @@ cserve2_cache_font_load(Client *client, const char *source, const char *name,
    // Copy descriptor to Shared Array
    fd_index = cserve2_shared_array_item_new(_font_data_array);
    fd = cserve2_shared_array_item_data_get(_font_data_array, fd_index);
+   cserve2_shm_object_write_begin(&fd->seq);
    fd->size = fe->size;
    fd->rend_flags = fe->rend_flags;
    fd->dpi = fe->dpi;
@@ -3091,6 +3187,7 @@ cserve2_cache_font_load(Client *client, const char *source, const char *name,
    fd->name = cserve2_shared_string_ref(fs->name);
    fd->file = cserve2_shared_string_ref(fs->file);
    fd->glyph_index_shm = 0;
+   cserve2_shm_object_write_end(&fd->seq);
 
    fe->src = fs;
    fe->font_data_id = fd->id;
@@ -42,6 +42,8 @@ ector_init(void)
         goto on_error;
      }
 
+   ector_software_rle_init();
+
    _ector_main_count = 1;
 
    eina_log_timing(_ector_log_dom_global, EINA_LOG_STATE_STOP, EINA_LOG_STATE_INIT);
@@ -74,6 +76,8 @@ ector_shutdown(void)
 
    eo_shutdown();
 
+   ector_software_rle_shutdown();
+
    eina_log_domain_unregister(_ector_log_dom_global);
 
    eina_shutdown();
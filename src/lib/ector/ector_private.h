@@ -145,4 +145,8 @@ struct _Ector_Renderer_Generic_Shape_Data
    } stroke;
 };
 
+// shared RLE data of the software shapes, set up by ector_init()
+void ector_software_rle_init(void);
+void ector_software_rle_shutdown(void);
+
 #endif
@@ -1,6 +1,12 @@
 #ifndef ECTOR_BLEND_PRIVATE_H
 #define ECTOR_BLEND_PRIVATE_H
 
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+# include <emmintrin.h>
+# include <stdint.h>
+# define ECTOR_SSE2 1
+#endif
+
 #ifndef MIN
 #define MIN( a, b )  ( (a) < (b) ? (a) : (b) )
 #endif
@@ -89,6 +95,131 @@ _ector_comp_func_source_over(uint *dest, uint *src, int length, uint const_alpha
     }
 }
 
+#ifdef ECTOR_SSE2
+
+/* 4 pixels unpacked to 16 bit channels, low and high pairs */
+#define ECTOR_SSE2_UNPACK(v, lo, hi) \
+   do { \
+        lo = _mm_unpacklo_epi8(v, _mm_setzero_si128()); \
+        hi = _mm_unpackhi_epi8(v, _mm_setzero_si128()); \
+   } while (0)
+
+/* ECTOR_MUL_256 on 16 bit channels: (x * a) >> 8 */
+static inline __m128i
+_ector_mul_256_sse2(__m128i x, __m128i a)
+{
+   return _mm_srli_epi16(_mm_mullo_epi16(x, a), 8);
+}
+
+/* ECTOR_MUL_256 of 4 pixels by one factor per pixel, given as 32 bit lanes */
+static inline __m128i
+_ector_mul_256_4_sse2(__m128i x, __m128i a)
+{
+   __m128i lo, hi;
+
+   a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+   ECTOR_SSE2_UNPACK(x, lo, hi);
+   lo = _ector_mul_256_sse2(lo, _mm_unpacklo_epi32(a, a));
+   hi = _ector_mul_256_sse2(hi, _mm_unpackhi_epi32(a, a));
+   return _mm_packus_epi16(lo, hi);
+}
+
+/* ECTOR_MUL4_SYM of 4 pixels by one color: ((x * c) + 255) >> 8 */
+static inline __m128i
+_ector_mul4_sym_sse2(__m128i x, __m128i c)
+{
+   const __m128i x255 = _mm_set1_epi16(0xff);
+   __m128i lo, hi;
+
+   ECTOR_SSE2_UNPACK(x, lo, hi);
+   lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, c), x255), 8);
+   hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, c), x255), 8);
+   return _mm_packus_epi16(lo, hi);
+}
+
+/* s + ECTOR_MUL_256(d, 255 - alpha(s)) for 4 pixels */
+static inline __m128i
+_ector_over_sse2(__m128i s, __m128i d)
+{
+   __m128i ia = _mm_sub_epi32(_mm_set1_epi32(0xff), _mm_srli_epi32(s, 24));
+
+   return _mm_add_epi32(s, _ector_mul_256_4_sse2(d, ia));
+}
+
+static inline void
+_ector_memfill_sse2(DATA32 *dest, uint value, int count)
+{
+   __m128i v = _mm_set1_epi32(value);
+
+   for (; count > 0 && ((uintptr_t)dest & 0xf); count--)
+     *dest++ = value;
+   for (; count >= 4; count -= 4, dest += 4)
+     _mm_store_si128((__m128i *)dest, v);
+   while (count--)
+     *dest++ = value;
+}
+
+/* dest = color + ECTOR_MUL_256(dest, ialpha), the solid span fill */
+static inline void
+_ector_comp_func_solid_sse2(uint *dest, int length, uint color, uint ialpha)
+{
+   const __m128i c = _mm_set1_epi32(color);
+   const __m128i a = _mm_set1_epi16(ialpha);
+   int i = 0;
+
+   for (; i + 4 <= length; i += 4)
+     {
+        __m128i d = _mm_loadu_si128((__m128i *)(dest + i));
+        __m128i lo, hi;
+
+        ECTOR_SSE2_UNPACK(d, lo, hi);
+        d = _mm_packus_epi16(_ector_mul_256_sse2(lo, a),
+                             _ector_mul_256_sse2(hi, a));
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_add_epi32(c, d));
+     }
+   for (; i < length; i++)
+     dest[i] = color + ECTOR_MUL_256(dest[i], ialpha);
+}
+
+/* _ector_comp_func_source_over_mul_c() and _ector_comp_func_source_over()
+ * in one, c is 0xffffffff when there is no color to multiply with. */
+static inline void
+_ector_comp_func_source_over_sse2(uint *dest, uint *src, DATA32 c, int length, uint const_alpha)
+{
+   const __m128i cv = _mm_unpacklo_epi8(_mm_set1_epi32(c), _mm_setzero_si128());
+   const __m128i ca = _mm_set1_epi32(const_alpha);
+   const Eina_Bool mul = (c != 0xffffffff);
+   int i = 0;
+
+   for (; i + 4 <= length; i += 4)
+     {
+        __m128i s = _mm_loadu_si128((__m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((__m128i *)(dest + i));
+        __m128i r;
+
+        if (mul) s = _ector_mul4_sym_sse2(s, cv);
+        if (const_alpha != 255) s = _ector_mul_256_4_sse2(s, ca);
+        r = _ector_over_sse2(s, d);
+        if (!mul && const_alpha == 255)
+          {
+             /* transparent source pixels leave dest untouched */
+             __m128i z = _mm_cmpeq_epi32(s, _mm_setzero_si128());
+
+             r = _mm_or_si128(_mm_and_si128(z, d), _mm_andnot_si128(z, r));
+          }
+        _mm_storeu_si128((__m128i *)(dest + i), r);
+     }
+   if (i >= length) return;
+   if (mul)
+     _ector_comp_func_source_over_mul_c(dest + i, src + i, c, length - i, const_alpha);
+   else
+     _ector_comp_func_source_over(dest + i, src + i, length - i, const_alpha);
+}
+
+#undef ECTOR_SSE2_UNPACK
+
+#endif
+
 static inline uint 
 INTERPOLATE_PIXEL_256(uint x, uint a, uint y, uint b) {
     uint t = (x & 0xff00ff) * a + (y & 0xff00ff) * b;
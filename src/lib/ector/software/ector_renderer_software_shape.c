@@ -19,8 +19,7 @@ struct _Ector_Renderer_Software_Shape_Data
    Ector_Software_Surface_Data         *surface;
    Ector_Renderer_Generic_Shape_Data   *shape;
    Ector_Renderer_Generic_Base_Data    *base;
-   Shape_Rle_Data                      *shape_data;
-   Shape_Rle_Data                      *outline_data;
+   Shape_Rle_Entry                     *rle;
 };
 
 typedef struct _Outline
@@ -68,6 +67,12 @@ _outline_move_to(Outline *outline, double x, double y)
         outline->contours_alloc += 5;
         ft_outline->contours = (short *) realloc(ft_outline->contours, outline->contours_alloc * sizeof(short));
      }
+   if (ft_outline->n_points == outline->points_alloc)
+     {
+        outline->points_alloc += 50;
+        ft_outline->points = (SW_FT_Vector *) realloc(ft_outline->points, outline->points_alloc * sizeof(SW_FT_Vector));
+        ft_outline->tags = (char *) realloc(ft_outline->tags, outline->points_alloc * sizeof(char));
+     }
    ft_outline->points[ft_outline->n_points].x = x;
    ft_outline->points[ft_outline->n_points].y = y;
    ft_outline->tags[ft_outline->n_points] = SW_FT_CURVE_TAG_ON;
@@ -145,7 +150,8 @@ static void  _outline_cubic_to(Outline *outline, double cx1, double cy1, double
 {
    SW_FT_Outline *ft_outline = &outline->ft_outline;
 
-   if (ft_outline->n_points == outline->points_alloc)
+   // a curve adds three points
+   if (ft_outline->n_points + 3 > outline->points_alloc)
      {
         outline->points_alloc += 50;
         ft_outline->points = (SW_FT_Vector *) realloc(ft_outline->points, outline->points_alloc * sizeof(SW_FT_Vector));
@@ -219,7 +225,7 @@ _ector_renderer_software_shape_ector_renderer_generic_base_prepare(Eo *obj, Ecto
      }
 
    eo_do(obj, efl_gfx_shape_path_get(&cmds, &pts));
-   if (!pd->shape_data && cmds)
+   if (!pd->rle && cmds)
      {
         Eina_Bool close_path = EINA_FALSE;
         Outline * outline = _outline_create();
@@ -265,14 +271,11 @@ _ector_renderer_software_shape_ector_renderer_generic_base_prepare(Eo *obj, Ecto
         _outline_end(outline);
         _outline_transform(outline, pd->base->m);
 
-        // generate the shape data.
-        pd->shape_data = ector_software_rasterizer_generate_rle_data(pd->surface->software, &outline->ft_outline);
-        if (!pd->outline_data)
-          {
-             ector_software_rasterizer_stroke_set(pd->surface->software, (pd->shape->stroke.width * pd->shape->stroke.scale), pd->shape->stroke.cap,
-                                                  pd->shape->stroke.join);
-             pd->outline_data = ector_software_rasterizer_generate_stroke_rle_data(pd->surface->software, &outline->ft_outline, close_path);
-          }
+        // the shape data is generated by the first draw needing it, along
+        // with the data of all the other shapes prepared until then.
+        pd->rle = ector_software_rle_get(&outline->ft_outline, close_path,
+                                         (pd->shape->stroke.width * pd->shape->stroke.scale),
+                                         pd->shape->stroke.cap, pd->shape->stroke.join);
 
         _outline_destroy(outline);
      }
@@ -283,8 +286,16 @@ _ector_renderer_software_shape_ector_renderer_generic_base_prepare(Eo *obj, Ecto
 static Eina_Bool
 _ector_renderer_software_shape_ector_renderer_generic_base_draw(Eo *obj EINA_UNUSED, Ector_Renderer_Software_Shape_Data *pd, Ector_Rop op, Eina_Array *clips, unsigned int mul_col)
 {
+   Shape_Rle_Data *shape_data = NULL, *outline_data = NULL;
    int x, y;
 
+   if (pd->rle)
+     {
+        ector_software_rle_wait(pd->rle);
+        shape_data = pd->rle->fill;
+        outline_data = pd->rle->stroke;
+     }
+
    // adjust the offset
    x = pd->surface->x + (int)pd->base->origin.x;
    y = pd->surface->y + (int)pd->base->origin.y;
@@ -296,21 +307,21 @@ _ector_renderer_software_shape_ector_renderer_generic_base_draw(Eo *obj EINA_UNU
    if (pd->shape->fill)
      {
         eo_do(pd->shape->fill, ector_renderer_software_base_fill());
-        ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, pd->shape_data);
+        ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, shape_data);
      }
    else
      {
         if (pd->base->color.a > 0)
           {
              ector_software_rasterizer_color_set(pd->surface->software, pd->base->color.r, pd->base->color.g, pd->base->color.b, pd->base->color.a);
-             ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, pd->shape_data);
+             ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, shape_data);
           }
      }
 
    if (pd->shape->stroke.fill)
      {
         eo_do(pd->shape->stroke.fill, ector_renderer_software_base_fill());
-        ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, pd->outline_data);
+        ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, outline_data);
      }
    else
      {
@@ -319,7 +330,7 @@ _ector_renderer_software_shape_ector_renderer_generic_base_draw(Eo *obj EINA_UNU
              ector_software_rasterizer_color_set(pd->surface->software,
                                                  pd->shape->stroke.color.r, pd->shape->stroke.color.g,
                                                  pd->shape->stroke.color.b, pd->shape->stroke.color.a);
-             ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, pd->outline_data);
+             ector_software_rasterizer_draw_rle_data(pd->surface->software, x, y, mul_col, op, outline_data);
           }
      }
 
@@ -338,10 +349,8 @@ static void
 _ector_renderer_software_shape_efl_gfx_shape_path_set(Eo *obj, Ector_Renderer_Software_Shape_Data *pd,
                                                       const Efl_Gfx_Path_Command *op, const double *points)
 {
-   if (pd->shape_data) ector_software_rasterizer_destroy_rle_data(pd->shape_data);
-   if (pd->outline_data) ector_software_rasterizer_destroy_rle_data(pd->outline_data);
-   pd->shape_data = NULL;
-   pd->outline_data = NULL;
+   ector_software_rle_release(pd->rle);
+   pd->rle = NULL;
 
    eo_do_super(obj, ECTOR_RENDERER_SOFTWARE_SHAPE_CLASS, efl_gfx_shape_path_set(op, points));
 }
@@ -352,12 +361,9 @@ _ector_renderer_software_shape_path_changed(void *data, Eo *obj EINA_UNUSED, con
                                             void *event_info EINA_UNUSED)
 {
    Ector_Renderer_Software_Shape_Data *pd = data;
-   
-   if (pd->shape_data) ector_software_rasterizer_destroy_rle_data(pd->shape_data);
-   if (pd->outline_data) ector_software_rasterizer_destroy_rle_data(pd->outline_data);
-   
-   pd->shape_data = NULL;
-   pd->outline_data = NULL;
+
+   ector_software_rle_release(pd->rle);
+   pd->rle = NULL;
 
    return EINA_TRUE;
 }
@@ -377,8 +383,7 @@ _ector_renderer_software_shape_eo_base_destructor(Eo *obj, Ector_Renderer_Softwa
 {
    Eo *parent;
 
-   if (pd->shape_data) ector_software_rasterizer_destroy_rle_data(pd->shape_data);
-   if (pd->outline_data) ector_software_rasterizer_destroy_rle_data(pd->outline_data);
+   ector_software_rle_release(pd->rle);
 
    eo_do(obj, parent = eo_parent_get());
    eo_data_xunref(parent, pd->surface, obj);
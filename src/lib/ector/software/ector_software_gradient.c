@@ -139,6 +139,70 @@ destroy_color_table(Ector_Renderer_Software_Gradient_Data *gdata)
 }
 
 
+#ifdef ECTOR_SSE2
+/* _gradient_clamp() on 4 table positions */
+static inline __m128i
+_gradient_clamp_sse2(const Ector_Renderer_Software_Gradient_Data *data, __m128i ipos)
+{
+   const __m128i max = _mm_set1_epi32(GRADIENT_STOPTABLE_SIZE - 1);
+   __m128i m;
+
+   if (data->gd->s == EFL_GFX_GRADIENT_SPREAD_REPEAT)
+     return _mm_and_si128(ipos, max);
+   if (data->gd->s == EFL_GFX_GRADIENT_SPREAD_REFLECT)
+     {
+        // limit - 1 - ipos is ipos ^ (limit - 1) in the upper half
+        const __m128i limit = _mm_set1_epi32(GRADIENT_STOPTABLE_SIZE * 2 - 1);
+
+        ipos = _mm_and_si128(ipos, limit);
+        m = _mm_cmpgt_epi32(ipos, max);
+        return _mm_xor_si128(ipos, _mm_and_si128(m, limit));
+     }
+   ipos = _mm_and_si128(ipos, _mm_cmpgt_epi32(ipos, _mm_set1_epi32(-1)));
+   m = _mm_cmpgt_epi32(ipos, max);
+   return _mm_or_si128(_mm_andnot_si128(m, ipos), _mm_and_si128(m, max));
+}
+
+static inline void
+_gradient_lookup_sse2(uint *buffer, const uint *table, __m128i ipos)
+{
+   int idx[4] __attribute__((aligned(16)));
+
+   _mm_store_si128((__m128i *)idx, ipos);
+   buffer[0] = table[idx[0]];
+   buffer[1] = table[idx[1]];
+   buffer[2] = table[idx[2]];
+   buffer[3] = table[idx[3]];
+}
+
+static void
+_fetch_linear_sse2(uint *buffer, int length, const Ector_Renderer_Software_Gradient_Data *g_data,
+                   int t_fixed, int inc_fixed)
+{
+   const __m128i half = _mm_set1_epi32(FIXPT_SIZE / 2);
+   const __m128i inc4 = _mm_set1_epi32(inc_fixed * 4);
+   __m128i t = _mm_setr_epi32(t_fixed, t_fixed + inc_fixed,
+                              t_fixed + 2 * inc_fixed, t_fixed + 3 * inc_fixed);
+   uint *end = buffer + length;
+
+   for (; buffer + 4 <= end; buffer += 4)
+     {
+        __m128i ipos = _mm_srai_epi32(_mm_add_epi32(t, half), FIXPT_BITS);
+
+        _gradient_lookup_sse2(buffer, g_data->color_table,
+                              _gradient_clamp_sse2(g_data, ipos));
+        t = _mm_add_epi32(t, inc4);
+     }
+   t_fixed = _mm_cvtsi128_si32(t);
+   while (buffer < end)
+     {
+        *buffer++ = _gradient_pixel_fixed(g_data, t_fixed);
+        t_fixed += inc_fixed;
+     }
+}
+
+#endif
+
 void
 fetch_linear_gradient(uint *buffer, Span_Data *data, int y, int x, int length)
 {
@@ -174,11 +238,11 @@ fetch_linear_gradient(uint *buffer, Span_Data *data, int y, int x, int length)
               // we can use fixed point math
               int t_fixed = (int)(t * FIXPT_SIZE);
               int inc_fixed = (int)(inc * FIXPT_SIZE);
-              // #ifdef BUILD_SSE3
-              // if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3)) {
-              //     _fetch_linear_sse3(buffer, length, g_data, t_fixed, inc_fixed);
-              // } else
-              // #endif
+#ifdef ECTOR_SSE2
+              if (ector_software_sse2)
+                _fetch_linear_sse2(buffer, length, g_data, t_fixed, inc_fixed);
+              else
+#endif
               {
                  while (buffer < end)
                    {
@@ -211,6 +275,68 @@ _radial_helper_generic(uint *buffer, int length, Ector_Renderer_Software_Gradien
       }
 }
 
+#ifdef ECTOR_SSE2
+/* Same as _radial_helper_generic(), with each lane stepping 4 pixels at a
+ * time and sqrt() done on floats. Rounding may pick the neighbouring table
+ * entry now and then. */
+static void
+_radial_helper_sse2(uint *buffer, int length, Ector_Renderer_Software_Gradient_Data *g_data, float det,
+                    float delta_det, float delta_delta_det, float b, float delta_b)
+{
+   const __m128 scale = _mm_set1_ps(GRADIENT_STOPTABLE_SIZE - 1);
+   const __m128 half = _mm_set1_ps(0.5f);
+   float dets[4] __attribute__((aligned(16)));
+   float delta_dets[4] __attribute__((aligned(16)));
+   float bs[4] __attribute__((aligned(16)));
+   const __m128 four = _mm_set1_ps(4);
+   __m128 v_det, v_delta_det, v_b, v_delta_delta_det4, v_delta_det4, v_delta_b4;
+   int i;
+
+   if (length < 8)
+     {
+        _radial_helper_generic(buffer, length, g_data, det, delta_det, delta_delta_det, b, delta_b);
+        return;
+     }
+
+   for (i = 0; i < 4; i++)
+     {
+        dets[i] = det;
+        delta_dets[i] = delta_det;
+        bs[i] = b;
+        det += delta_det;
+        delta_det += delta_delta_det;
+        b += delta_b;
+     }
+   v_det = _mm_load_ps(dets);
+   v_delta_det = _mm_load_ps(delta_dets);
+   v_b = _mm_load_ps(bs);
+   // det(n + 4) = det(n) + 4 * delta_det(n) + 6 * delta_delta_det
+   v_delta_delta_det4 = _mm_set1_ps(4 * delta_delta_det);
+   v_delta_det4 = _mm_set1_ps(6 * delta_delta_det);
+   v_delta_b4 = _mm_set1_ps(4 * delta_b);
+
+   for (i = 0; i + 4 <= length; i += 4, buffer += 4)
+     {
+        __m128 pos;
+
+        pos = _mm_sub_ps(_mm_sqrt_ps(v_det), v_b);
+        pos = _mm_add_ps(_mm_mul_ps(pos, scale), half);
+        _gradient_lookup_sse2(buffer, g_data->color_table,
+                              _gradient_clamp_sse2(g_data, _mm_cvttps_epi32(pos)));
+
+        v_det = _mm_add_ps(v_det, _mm_add_ps(_mm_mul_ps(four, v_delta_det), v_delta_det4));
+        v_delta_det = _mm_add_ps(v_delta_det, v_delta_delta_det4);
+        v_b = _mm_add_ps(v_b, v_delta_b4);
+     }
+
+   _mm_store_ps(dets, v_det);
+   _mm_store_ps(delta_dets, v_delta_det);
+   _mm_store_ps(bs, v_b);
+   _radial_helper_generic(buffer, length - i, g_data, dets[0], delta_dets[0], delta_delta_det, bs[0], delta_b);
+}
+#endif
+
+
 void
 fetch_radial_gradient(uint *buffer, Span_Data *data, int y, int x, int length)
 {
@@ -255,11 +381,11 @@ fetch_radial_gradient(uint *buffer, Span_Data *data, int y, int x, int length)
    float delta_det = (b_delta_b + delta_bb + 4 * g_data->radial.a * (rx_plus_ry + delta_rxrxryry)) * inv_a;
    const float delta_delta_det = (delta_b_delta_b + 4 * g_data->radial.a * delta_rx_plus_ry) * inv_a;
 
-   // #ifdef BUILD_SSE3
-   //    if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3)) {
-   //        _radial_helper_sse3(buffer, length, g_data, det, delta_det, delta_delta_det, b, delta_b);
-   //    } else
-   // #endif
+#ifdef ECTOR_SSE2
+   if (ector_software_sse2)
+     _radial_helper_sse2(buffer, length, g_data, det, delta_det, delta_delta_det, b, delta_b);
+   else
+#endif
    { // generic fallback
       _radial_helper_generic(buffer, length, g_data, det, delta_det, delta_delta_det, b, delta_b);
    }
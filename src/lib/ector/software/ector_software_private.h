@@ -119,6 +119,10 @@ struct _Ector_Software_Surface_Data
 };
 
 
+// set by ector_software_rasterizer_init(), SSE2 span kernels are used if true
+// and ECTOR_CPU_NO_SSE2 is not set
+extern Eina_Bool ector_software_sse2;
+
 void ector_software_rasterizer_init(Software_Rasterizer *rasterizer);
 void ector_software_rasterizer_done(Software_Rasterizer *rasterizer);
 
@@ -141,6 +145,29 @@ void ector_software_rasterizer_draw_rle_data(Software_Rasterizer *rasterizer, in
 
 void ector_software_rasterizer_destroy_rle_data(Shape_Rle_Data *rle);
 
+// RLE data shared by the shape renderers, see ector_software_rle.c
+typedef enum _Shape_Rle_State
+{
+  SHAPE_RLE_PENDING,
+  SHAPE_RLE_RUNNING,
+  SHAPE_RLE_DONE
+} Shape_Rle_State;
+
+typedef struct _Shape_Rle_Entry
+{
+   EINA_INLIST;
+   void             *key;
+   Shape_Rle_Data   *fill;
+   Shape_Rle_Data   *stroke;
+   int               ref;
+   Shape_Rle_State   state;
+} Shape_Rle_Entry;
+
+Shape_Rle_Entry *ector_software_rle_get(SW_FT_Outline *outline, Eina_Bool close_path,
+                                        double stroke_width, Efl_Gfx_Cap cap, Efl_Gfx_Join join);
+void ector_software_rle_wait(Shape_Rle_Entry *entry);
+void ector_software_rle_release(Shape_Rle_Entry *entry);
+
 
 
 // Gradient Api
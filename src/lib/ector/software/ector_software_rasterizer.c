@@ -10,6 +10,22 @@
 #include "ector_software_private.h"
 #include "ector_blend_private.h"
 
+Eina_Bool ector_software_sse2 = EINA_FALSE;
+
+static inline void
+_comp_func_solid(uint *dest, int length, uint color, uint ialpha)
+{
+#ifdef ECTOR_SSE2
+   if (ector_software_sse2)
+     {
+        _ector_comp_func_solid_sse2(dest, length, color, ialpha);
+        return;
+     }
+#endif
+   for (int i = 0; i < length; ++i)
+     dest[i] = color + ECTOR_MUL_256(dest[i], ialpha);
+}
+
 static void
 _blend_color_argb(int count, const SW_FT_Span *spans, void *user_data)
 {
@@ -29,14 +45,18 @@ _blend_color_argb(int count, const SW_FT_Span *spans, void *user_data)
              uint *target = buffer + (data->raster_buffer.width * spans->y + spans->x);
              if (spans->coverage == 255)
                {
-                  _ector_memfill(target, color, spans->len);
+#ifdef ECTOR_SSE2
+                  if (ector_software_sse2)
+                    _ector_memfill_sse2(target, color, spans->len);
+                  else
+#endif
+                    _ector_memfill(target, color, spans->len);
                }
              else
                {
                   uint c = ECTOR_MUL_256(color, spans->coverage);
                   int ialpha = 255 - spans->coverage;
-                  for (int i = 0; i < spans->len; ++i)
-                    target[i] = c + ECTOR_MUL_256(target[i], ialpha);
+                  _comp_func_solid(target, spans->len, c, ialpha);
                }
              ++spans;
           }
@@ -49,8 +69,7 @@ _blend_color_argb(int count, const SW_FT_Span *spans, void *user_data)
         uint c =  ECTOR_MUL_256(color, spans->coverage);
         int ialpha = (~c) >> 24;
 
-        for (int i = 0; i < spans->len; ++i)
-            target[i] = c + ECTOR_MUL_256(target[i], ialpha);
+        _comp_func_solid(target, spans->len, c, ialpha);
         ++spans;
      }
 }
@@ -82,6 +101,11 @@ _blend_gradient(int count, const SW_FT_Span *spans, void *user_data)
               int l = MIN(length, buffer_size);
               if (fetchfunc)
                 fetchfunc(buffer, data, spans->y, spans->x, l);
+#ifdef ECTOR_SSE2
+              if (ector_software_sse2)
+                _ector_comp_func_source_over_sse2(target, buffer, data->mul_col, l, spans->coverage);
+              else
+#endif
               if (data->mul_col == 0xffffffff)
                 _ector_comp_func_source_over(target, buffer, l, spans->coverage); // TODO use proper composition func
               else
@@ -314,6 +338,10 @@ void ector_software_rasterizer_init(Software_Rasterizer *rasterizer)
    SW_FT_Stroker_New(&rasterizer->stroker);
    SW_FT_Stroker_Set(rasterizer->stroker, 1<<6,SW_FT_STROKER_LINECAP_BUTT,SW_FT_STROKER_LINEJOIN_MITER,0);
 
+   // ECTOR_CPU_NO_SSE2 forces the C loops, as EVAS_CPU_NO_* does for evas
+   ector_software_sse2 = (!!(eina_cpu_features_get() & EINA_CPU_SSE2) &&
+                          !getenv("ECTOR_CPU_NO_SSE2"));
+
    //initialize the span data.
    rasterizer->fill_data.raster_buffer.buffer = NULL;
    rasterizer->fill_data.clip.enabled = EINA_FALSE;
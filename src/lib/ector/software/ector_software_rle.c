@@ -0,0 +1,475 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Ector.h>
+#include <software/Ector_Software.h>
+
+#include "ector_private.h"
+#include "ector_software_private.h"
+
+/* RLE data of the shape renderers.
+ *
+ * In prepare a shape only builds its transformed outline and gets an entry
+ * for it. Entries are keyed on the outline and the stroke parameters, so
+ * shapes with the same geometry share their fill and stroke RLE, and a shape
+ * that only changed its color finds its previous RLE again. New entries are
+ * queued, and the first draw needing one of them rasterizes the whole queue,
+ * spread over a few worker threads. With async rendering that work is done
+ * in the render thread instead of the main loop.
+ */
+
+// released entries kept around for shapes coming back to the same outline
+#define RLE_UNUSED_MAX 256
+#define RLE_WORKERS_MAX 8
+#define RLE_POOL_SIZE (1024 * 100)
+
+typedef struct _Shape_Rle_Key Shape_Rle_Key;
+struct _Shape_Rle_Key
+{
+   unsigned int size; // of the whole key, this header included
+   short        n_points;
+   short        n_contours;
+   double       stroke_width;
+   Efl_Gfx_Cap  cap;
+   Efl_Gfx_Join join;
+   Eina_Bool    close_path;
+   // followed by the points, the contours and the tags of the outline
+};
+
+typedef struct _Shape_Rle_Worker Shape_Rle_Worker;
+struct _Shape_Rle_Worker
+{
+   Software_Rasterizer ctx; // only the raster and the stroker are used
+   unsigned char       pool[RLE_POOL_SIZE];
+};
+
+static Eina_Lock _rle_lock;
+static Eina_Condition _rle_cond; // signaled when a queue is rasterized
+static Eina_Hash *_rle_hash = NULL;
+static Eina_Inlist *_rle_pending = NULL;
+static Eina_Inlist *_rle_unused = NULL;
+static unsigned int _rle_unused_count = 0;
+
+static struct {
+   Eina_Lock          lock;
+   Eina_Condition     cond;
+   Eina_Lock          run_lock; // one queue at a time
+   Eina_Thread        threads[RLE_WORKERS_MAX];
+   int                count;
+   Eina_Bool          started : 1;
+   Eina_Bool          exit : 1;
+
+   Shape_Rle_Entry  **batch;
+   int                size, next, left;
+
+   Shape_Rle_Worker  *worker; // of the thread running the queue
+} _rle_pool;
+
+static unsigned int
+_rle_key_length(const void *key)
+{
+   return ((const Shape_Rle_Key *)key)->size;
+}
+
+static int
+_rle_key_cmp(const void *key1, int key1_length,
+             const void *key2, int key2_length)
+{
+   if (key1_length != key2_length) return key1_length - key2_length;
+   return memcmp(key1, key2, key1_length);
+}
+
+static int
+_rle_key_hash(const void *key, int key_length)
+{
+   return eina_hash_superfast(key, key_length);
+}
+
+static Shape_Rle_Key *
+_rle_key_new(const SW_FT_Outline *outline, Eina_Bool close_path,
+             double stroke_width, Efl_Gfx_Cap cap, Efl_Gfx_Join join)
+{
+   Shape_Rle_Key *key;
+   unsigned int size;
+   char *p;
+
+   size = sizeof (Shape_Rle_Key) +
+     outline->n_points * (sizeof (SW_FT_Vector) + sizeof (char)) +
+     outline->n_contours * sizeof (short);
+
+   // calloc, the padding of the header is compared too
+   key = calloc(1, size);
+   if (!key) return NULL;
+
+   key->size = size;
+   key->n_points = outline->n_points;
+   key->n_contours = outline->n_contours;
+   key->stroke_width = stroke_width;
+   key->cap = cap;
+   key->join = join;
+   key->close_path = !!close_path;
+
+   p = (char *)(key + 1);
+   memcpy(p, outline->points, outline->n_points * sizeof (SW_FT_Vector));
+   p += outline->n_points * sizeof (SW_FT_Vector);
+   memcpy(p, outline->contours, outline->n_contours * sizeof (short));
+   p += outline->n_contours * sizeof (short);
+   memcpy(p, outline->tags, outline->n_points * sizeof (char));
+
+   return key;
+}
+
+static void
+_rle_key_outline(Shape_Rle_Key *key, SW_FT_Outline *outline)
+{
+   outline->n_points = key->n_points;
+   outline->n_contours = key->n_contours;
+   outline->points = (SW_FT_Vector *)(key + 1);
+   outline->contours = (short *)(outline->points + key->n_points);
+   outline->tags = (char *)(outline->contours + key->n_contours);
+   outline->flags = 0;
+}
+
+static void
+_rle_entry_free(void *data)
+{
+   Shape_Rle_Entry *entry = data;
+
+   ector_software_rasterizer_destroy_rle_data(entry->fill);
+   ector_software_rasterizer_destroy_rle_data(entry->stroke);
+   free(entry->key);
+   free(entry);
+}
+
+static void
+_rle_entry_generate(Shape_Rle_Worker *worker, Shape_Rle_Entry *entry)
+{
+   Shape_Rle_Key *key = entry->key;
+   SW_FT_Outline outline;
+
+   if (!worker) return;
+
+   _rle_key_outline(key, &outline);
+   entry->fill = ector_software_rasterizer_generate_rle_data(&worker->ctx, &outline);
+   ector_software_rasterizer_stroke_set(&worker->ctx, key->stroke_width,
+                                        key->cap, key->join);
+   entry->stroke = ector_software_rasterizer_generate_stroke_rle_data(&worker->ctx, &outline,
+                                                                      key->close_path);
+}
+
+static Shape_Rle_Worker *
+_rle_worker_new(void)
+{
+   Shape_Rle_Worker *worker;
+
+   worker = malloc(sizeof (Shape_Rle_Worker));
+   if (!worker) return NULL;
+
+   sw_ft_grays_raster.raster_new(&worker->ctx.raster);
+   if (!worker->ctx.raster)
+     {
+        free(worker);
+        return NULL;
+     }
+   sw_ft_grays_raster.raster_reset(worker->ctx.raster, worker->pool, RLE_POOL_SIZE);
+   SW_FT_Stroker_New(&worker->ctx.stroker);
+
+   return worker;
+}
+
+static void
+_rle_worker_free(Shape_Rle_Worker *worker)
+{
+   if (!worker) return;
+
+   sw_ft_grays_raster.raster_done(worker->ctx.raster);
+   SW_FT_Stroker_Done(worker->ctx.stroker);
+   free(worker);
+}
+
+static void *
+_rle_worker_main(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   Shape_Rle_Worker *worker;
+
+   // without a raster this thread takes no entry, the thread running the
+   // queue generates them instead
+   worker = _rle_worker_new();
+   if (!worker) return NULL;
+
+   eina_lock_take(&_rle_pool.lock);
+   while (!_rle_pool.exit)
+     {
+        if (_rle_pool.next < _rle_pool.size)
+          {
+             Shape_Rle_Entry *entry = _rle_pool.batch[_rle_pool.next++];
+
+             eina_lock_release(&_rle_pool.lock);
+             _rle_entry_generate(worker, entry);
+             eina_lock_take(&_rle_pool.lock);
+
+             if (!--_rle_pool.left)
+               eina_condition_broadcast(&_rle_pool.cond);
+          }
+        else
+          eina_condition_wait(&_rle_pool.cond);
+     }
+   eina_lock_release(&_rle_pool.lock);
+
+   _rle_worker_free(worker);
+   return NULL;
+}
+
+static void
+_rle_pool_start(void)
+{
+   const char *env;
+   int count, i;
+
+   _rle_pool.started = EINA_TRUE;
+
+   // number of threads generating a queue, the one running it included
+   env = getenv("ECTOR_WORKER_THREADS");
+   if (env) count = atoi(env) - 1;
+   else count = eina_cpu_count() - 1;
+   if (count > RLE_WORKERS_MAX) count = RLE_WORKERS_MAX;
+
+   for (i = 0; i < count; i++)
+     {
+        if (!eina_thread_create(&_rle_pool.threads[_rle_pool.count],
+                                EINA_THREAD_NORMAL, -1,
+                                _rle_worker_main, NULL))
+          break;
+        _rle_pool.count++;
+     }
+}
+
+static void
+_rle_batch_run(Shape_Rle_Entry **batch, int count)
+{
+   int i;
+
+   eina_lock_take(&_rle_pool.run_lock);
+
+   if (!_rle_pool.worker)
+     _rle_pool.worker = _rle_worker_new();
+   if ((count > 1) && (!_rle_pool.started))
+     _rle_pool_start();
+
+   // without a raster of its own this thread can not take its share, and
+   // none of the workers may have one either
+   if ((count == 1) || (!_rle_pool.count) || (!_rle_pool.worker))
+     {
+        for (i = 0; i < count; i++)
+          _rle_entry_generate(_rle_pool.worker, batch[i]);
+        eina_lock_release(&_rle_pool.run_lock);
+        return;
+     }
+
+   eina_lock_take(&_rle_pool.lock);
+   _rle_pool.batch = batch;
+   _rle_pool.size = count;
+   _rle_pool.next = 0;
+   _rle_pool.left = count;
+   eina_condition_broadcast(&_rle_pool.cond);
+
+   // take a share of the work, then wait for the workers to finish theirs
+   while (_rle_pool.left)
+     {
+        if (_rle_pool.next < _rle_pool.size)
+          {
+             Shape_Rle_Entry *entry = _rle_pool.batch[_rle_pool.next++];
+
+             eina_lock_release(&_rle_pool.lock);
+             _rle_entry_generate(_rle_pool.worker, entry);
+             eina_lock_take(&_rle_pool.lock);
+
+             _rle_pool.left--;
+          }
+        else
+          eina_condition_wait(&_rle_pool.cond);
+     }
+
+   _rle_pool.batch = NULL;
+   _rle_pool.size = 0;
+   _rle_pool.next = 0;
+   eina_lock_release(&_rle_pool.lock);
+
+   eina_lock_release(&_rle_pool.run_lock);
+}
+
+// called with _rle_lock held
+static void
+_rle_entry_unref(Shape_Rle_Entry *entry)
+{
+   if (--entry->ref) return;
+
+   if (entry->state == SHAPE_RLE_PENDING)
+     {
+        _rle_pending = eina_inlist_remove(_rle_pending, EINA_INLIST_GET(entry));
+        eina_hash_del(_rle_hash, entry->key, entry);
+        return;
+     }
+
+   _rle_unused = eina_inlist_append(_rle_unused, EINA_INLIST_GET(entry));
+   if (++_rle_unused_count > RLE_UNUSED_MAX)
+     {
+        Shape_Rle_Entry *old = EINA_INLIST_CONTAINER_GET(_rle_unused, Shape_Rle_Entry);
+
+        _rle_unused = eina_inlist_remove(_rle_unused, _rle_unused);
+        _rle_unused_count--;
+        eina_hash_del(_rle_hash, old->key, old);
+     }
+}
+
+// called with _rle_lock held, which is released while rasterizing
+static void
+_rle_flush(void)
+{
+   Shape_Rle_Entry **batch;
+   Shape_Rle_Entry *entry;
+   unsigned int count, i;
+
+   count = eina_inlist_count(_rle_pending);
+   if (!count) return;
+
+   batch = malloc(count * sizeof (Shape_Rle_Entry *));
+   if (!batch) return;
+
+   i = 0;
+   EINA_INLIST_FOREACH(_rle_pending, entry)
+     {
+        // the queue keeps its entries alive until they are done
+        entry->ref++;
+        entry->state = SHAPE_RLE_RUNNING;
+        batch[i++] = entry;
+     }
+   _rle_pending = NULL;
+
+   eina_lock_release(&_rle_lock);
+   _rle_batch_run(batch, count);
+   eina_lock_take(&_rle_lock);
+
+   for (i = 0; i < count; i++)
+     {
+        batch[i]->state = SHAPE_RLE_DONE;
+        _rle_entry_unref(batch[i]);
+     }
+   eina_condition_broadcast(&_rle_cond);
+
+   free(batch);
+}
+
+Shape_Rle_Entry *
+ector_software_rle_get(SW_FT_Outline *outline, Eina_Bool close_path,
+                       double stroke_width, Efl_Gfx_Cap cap, Efl_Gfx_Join join)
+{
+   Shape_Rle_Entry *entry;
+   Shape_Rle_Key *key;
+
+   key = _rle_key_new(outline, close_path, stroke_width, cap, join);
+   if (!key) return NULL;
+
+   eina_lock_take(&_rle_lock);
+
+   entry = eina_hash_find(_rle_hash, key);
+   if (entry)
+     {
+        free(key);
+        if (!entry->ref++)
+          {
+             _rle_unused = eina_inlist_remove(_rle_unused, EINA_INLIST_GET(entry));
+             _rle_unused_count--;
+          }
+        goto end;
+     }
+
+   entry = calloc(1, sizeof (Shape_Rle_Entry));
+   if (!entry)
+     {
+        free(key);
+        goto end;
+     }
+   entry->key = key;
+   entry->ref = 1;
+   entry->state = SHAPE_RLE_PENDING;
+
+   eina_hash_direct_add(_rle_hash, key, entry);
+   _rle_pending = eina_inlist_append(_rle_pending, EINA_INLIST_GET(entry));
+
+ end:
+   eina_lock_release(&_rle_lock);
+   return entry;
+}
+
+void
+ector_software_rle_wait(Shape_Rle_Entry *entry)
+{
+   eina_lock_take(&_rle_lock);
+
+   if (entry->state == SHAPE_RLE_PENDING)
+     _rle_flush();
+
+   // queued in a flush running in another thread
+   while (entry->state == SHAPE_RLE_RUNNING)
+     eina_condition_wait(&_rle_cond);
+
+   eina_lock_release(&_rle_lock);
+}
+
+void
+ector_software_rle_release(Shape_Rle_Entry *entry)
+{
+   if (!entry) return;
+
+   eina_lock_take(&_rle_lock);
+   _rle_entry_unref(entry);
+   eina_lock_release(&_rle_lock);
+}
+
+void
+ector_software_rle_init(void)
+{
+   eina_lock_new(&_rle_lock);
+   eina_condition_new(&_rle_cond, &_rle_lock);
+   _rle_hash = eina_hash_new(_rle_key_length, _rle_key_cmp, _rle_key_hash,
+                             _rle_entry_free, 8);
+
+   memset(&_rle_pool, 0, sizeof (_rle_pool));
+   eina_lock_new(&_rle_pool.lock);
+   eina_condition_new(&_rle_pool.cond, &_rle_pool.lock);
+   eina_lock_new(&_rle_pool.run_lock);
+}
+
+void
+ector_software_rle_shutdown(void)
+{
+   int i;
+
+   eina_lock_take(&_rle_pool.lock);
+   _rle_pool.exit = EINA_TRUE;
+   eina_condition_broadcast(&_rle_pool.cond);
+   eina_lock_release(&_rle_pool.lock);
+
+   for (i = 0; i < _rle_pool.count; i++)
+     eina_thread_join(_rle_pool.threads[i]);
+   _rle_worker_free(_rle_pool.worker);
+
+   eina_lock_free(&_rle_pool.run_lock);
+   eina_condition_free(&_rle_pool.cond);
+   eina_lock_free(&_rle_pool.lock);
+
+   eina_hash_free(_rle_hash);
+   _rle_hash = NULL;
+   _rle_pending = NULL;
+   _rle_unused = NULL;
+   _rle_unused_count = 0;
+
+   eina_condition_free(&_rle_cond);
+   eina_lock_free(&_rle_lock);
+}
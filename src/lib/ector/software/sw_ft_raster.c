@@ -68,6 +68,7 @@
 
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 #include <setjmp.h>
 #include <limits.h>
@@ -1776,26 +1777,26 @@ typedef struct  SW_FT_Outline_Funcs_
   }
 
 
-  /**** RASTER OBJECT CREATION: In stand-alone mode, we simply use *****/
-  /****                         a static object.                   *****/
+  /**** RASTER OBJECT CREATION: Each object is allocated, so that   *****/
+  /****                         several threads can render at once. *****/
 
   static int
   gray_raster_new(SW_FT_Raster*  araster )
   {
-    static gray_TRaster  the_raster;
+    gray_PRaster  raster;
 
-    *araster = (SW_FT_Raster)&the_raster;
-    SW_FT_MEM_ZERO( &the_raster, sizeof ( the_raster ) );
 
-    return 0;
+    raster = (gray_PRaster)calloc( 1, sizeof ( gray_TRaster ) );
+    *araster = (SW_FT_Raster)raster;
+
+    return raster ? 0 : ErrRaster_Memory_Overflow;
   }
 
 
   static void
   gray_raster_done( SW_FT_Raster  raster )
   {
-    /* nothing */
-    SW_FT_UNUSED( raster );
+    free( raster );
   }
 
   static void
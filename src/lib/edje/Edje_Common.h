@@ -298,6 +298,50 @@ EAPI int          edje_collection_cache_get       (void);
  */
 EAPI void         edje_collection_cache_flush     (void);
 
+/**
+ * @brief Enable or disable the layout cache.
+ *
+ * @param enable @c EINA_TRUE to share computed part geometry, @c EINA_FALSE
+ * to always compute it. Default is @c EINA_TRUE, unless the
+ * @c EDJE_LAYOUT_CACHE environment variable is set to @c 0.
+ *
+ * Objects created from the same collection, at the same size, scale and
+ * in the same states compute the very same part geometry. The layout
+ * cache keeps these results per collection so that identical objects,
+ * such as list or grid items, reuse them instead of computing them again.
+ *
+ * @see edje_layout_cache_get()
+ * @see edje_layout_cache_stats_get()
+ *
+ */
+EAPI void         edje_layout_cache_set           (Eina_Bool enable);
+
+/**
+ * @brief Return whether the layout cache is enabled.
+ *
+ * @return @c EINA_TRUE if the layout cache is enabled.
+ *
+ * @see edje_layout_cache_set()
+ *
+ */
+EAPI Eina_Bool    edje_layout_cache_get           (void);
+
+/**
+ * @brief Retrieve the layout cache hit and miss counters.
+ *
+ * @param hits Where to store the number of part calculations served from
+ * the cache, may be @c NULL.
+ * @param misses Where to store the number of cacheable part calculations
+ * that had to be computed, may be @c NULL.
+ *
+ * Parts that cannot be shared, like parts in a transition, dragable,
+ * mapped, box, table, textblock and external parts, count as neither.
+ *
+ * @see edje_layout_cache_set()
+ *
+ */
+EAPI void         edje_layout_cache_stats_get     (unsigned int *hits, unsigned int *misses);
+
 /**
  * @}
  */
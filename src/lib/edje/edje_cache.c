@@ -7,6 +7,11 @@ static Eina_List   *_edje_file_cache = NULL;
 
 static int          _edje_collection_cache_size = 16;
 
+Eina_Bool           _edje_layout_cache_enabled = EINA_TRUE;
+unsigned int        _edje_layout_cache_generation = 0;
+unsigned int        _edje_layout_cache_hits = 0;
+unsigned int        _edje_layout_cache_misses = 0;
+
 EAPI void
 edje_cache_emp_alloc(Edje_Part_Collection_Directory_Entry *ce)
 {  /* Init Eina Mempools this is also used in edje_pick.c */
@@ -125,6 +130,125 @@ _edje_programs_patterns_init(Edje_Part_Collection *edc)
    ssp->sources_patterns = edje_match_programs_source_init(all, j);
 }
 
+/* Record that part 'id' depends on part 'to'. seen[] drops the duplicate
+   edges coming from the different descriptions of the same part. When
+   fill is NULL only the number of dependents of each part is counted,
+   otherwise count[] is the write cursor of each part in fill. */
+static void
+_edje_part_deps_edge(unsigned int parts_count, unsigned int *seen,
+                     unsigned int *count, unsigned int *fill,
+                     unsigned int id, int to)
+{
+   if ((to < 0) || ((unsigned int) to >= parts_count) ||
+       ((unsigned int) to == id))
+     return;
+   if (seen[to] == id + 1) return;
+   seen[to] = id + 1;
+
+   if (fill) fill[count[to]] = id;
+   count[to]++;
+}
+
+static void
+_edje_part_deps_walk(Edje_Part_Collection *edc, unsigned int *seen,
+                     unsigned int *count, unsigned int *fill)
+{
+   unsigned int i, j;
+
+#define EDJE_DEPS_EDGE(Id, To)                                          \
+   _edje_part_deps_edge(edc->parts_count, seen, count, fill, Id, To)
+
+   for (i = 0; i < edc->parts_count; i++)
+     {
+        Edje_Part *ep = edc->parts[i];
+
+        if (!ep) continue;
+
+        EDJE_DEPS_EDGE(i, ep->clip_to_id);
+        EDJE_DEPS_EDGE(i, ep->dragable.confine_id);
+        EDJE_DEPS_EDGE(i, ep->dragable.threshold_id);
+
+        for (j = 0; j <= ep->other.desc_count; j++)
+          {
+             Edje_Part_Description_Common *desc;
+
+             desc = j ? ep->other.desc[j - 1] : ep->default_desc;
+             if (!desc) continue;
+
+             EDJE_DEPS_EDGE(i, desc->rel1.id_x);
+             EDJE_DEPS_EDGE(i, desc->rel1.id_y);
+             EDJE_DEPS_EDGE(i, desc->rel2.id_x);
+             EDJE_DEPS_EDGE(i, desc->rel2.id_y);
+             EDJE_DEPS_EDGE(i, desc->map.id_persp);
+             EDJE_DEPS_EDGE(i, desc->map.id_light);
+             EDJE_DEPS_EDGE(i, desc->map.rot.id_center);
+
+             switch (ep->type)
+               {
+                case EDJE_PART_TYPE_TEXT:
+                case EDJE_PART_TYPE_TEXTBLOCK:
+                  {
+                     Edje_Part_Description_Text *text;
+
+                     text = (Edje_Part_Description_Text *) desc;
+                     EDJE_DEPS_EDGE(i, text->text.id_source);
+                     EDJE_DEPS_EDGE(i, text->text.id_text_source);
+                     break;
+                  }
+                case EDJE_PART_TYPE_PROXY:
+                   EDJE_DEPS_EDGE(i, ((Edje_Part_Description_Proxy *) desc)->proxy.id);
+                   break;
+                default:
+                   break;
+               }
+          }
+     }
+
+#undef EDJE_DEPS_EDGE
+}
+
+void
+_edje_part_deps_init(Edje_Part_Collection *edc)
+{
+   unsigned int *seen, *count;
+   unsigned int i, total;
+
+   if (edc->deps.offsets) return;
+   if (!edc->parts_count) return;
+
+   seen = calloc(edc->parts_count, sizeof (unsigned int));
+   count = calloc(edc->parts_count, sizeof (unsigned int));
+   if (!seen || !count) goto on_error;
+
+   _edje_part_deps_walk(edc, seen, count, NULL);
+
+   edc->deps.offsets = malloc(sizeof (unsigned int) * (edc->parts_count + 1));
+   if (!edc->deps.offsets) goto on_error;
+
+   for (i = 0, total = 0; i < edc->parts_count; i++)
+     {
+        edc->deps.offsets[i] = total;
+        total += count[i];
+        count[i] = edc->deps.offsets[i];
+     }
+   edc->deps.offsets[i] = total;
+
+   edc->deps.parts = malloc(sizeof (unsigned int) * (total ? total : 1));
+   if (!edc->deps.parts)
+     {
+        free(edc->deps.offsets);
+        edc->deps.offsets = NULL;
+        goto on_error;
+     }
+
+   memset(seen, 0, sizeof (unsigned int) * edc->parts_count);
+   _edje_part_deps_walk(edc, seen, count, edc->deps.parts);
+
+ on_error:
+   free(seen);
+   free(count);
+}
+
 static Edje_Part_Collection *
 _edje_file_coll_open(Edje_File *edf, const char *coll)
 {
@@ -221,6 +345,7 @@ _edje_file_coll_open(Edje_File *edf, const char *coll)
    ce->ref = edc;
 
    _edje_programs_patterns_init(edc);
+   _edje_part_deps_init(edc);
 
    n = edc->programs.fnmatch_count +
      edc->programs.strcmp_count +
@@ -682,3 +807,26 @@ edje_collection_cache_flush(void)
    /* FIXME: freach in file hash too! */
    _edje_collection_cache_size = ps;
 }
+
+EAPI void
+edje_layout_cache_set(Eina_Bool enable)
+{
+   enable = !!enable;
+   if (_edje_layout_cache_enabled == enable) return;
+   _edje_layout_cache_enabled = enable;
+   /* let collections drop what they hold on their next recalc */
+   _edje_layout_cache_generation++;
+}
+
+EAPI Eina_Bool
+edje_layout_cache_get(void)
+{
+   return _edje_layout_cache_enabled;
+}
+
+EAPI void
+edje_layout_cache_stats_get(unsigned int *hits, unsigned int *misses)
+{
+   if (hits) *hits = _edje_layout_cache_hits;
+   if (misses) *misses = _edje_layout_cache_misses;
+}
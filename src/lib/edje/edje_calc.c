@@ -139,10 +139,24 @@ _edje_part_pos_set(Edje *ed, Edje_Real_Part *ep, int mode, FLOAT_T pos, FLOAT_T
 
    ep->description_pos = npos;
 
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
+   _edje_part_invalidate(ed, ep);
+}
+
+/**
+ * Mark a single part, and through the collection dependency graph the
+ * parts relative to it, as needing a recalc. Anything that also changes
+ * the object as a whole must still set ed->dirty.
+ */
+void
+_edje_part_invalidate(Edje *ed, Edje_Real_Part *ep)
+{
 #ifdef EDJE_CALC_CACHE
    ep->invalidate = EINA_TRUE;
+   ed->dirty_parts = EINA_TRUE;
+#else
+   (void) ep;
+   ed->dirty = EINA_TRUE;
 #endif
 }
 
@@ -670,11 +684,8 @@ _edje_part_description_apply(Edje *ed, Edje_Real_Part *ep, const char *d1, doubl
      }
 
    ed->recalc_hints = EINA_TRUE;
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   ep->invalidate = EINA_TRUE;
-#endif
+   _edje_part_invalidate(ed, ep);
 }
 
 void
@@ -705,6 +716,71 @@ _edje_recalc(Edje *ed)
 //   ed->postponed = EINA_TRUE;
 }
 
+#ifdef EDJE_CALC_CACHE
+/* Recalc only the invalidated parts and, following the collection
+ * dependency graph, every part that depends on them. Everything else
+ * keeps the geometry and state of the previous recalc. Returns
+ * EINA_FALSE when a full recalc is needed instead. */
+static Eina_Bool
+_edje_recalc_parts_do(Edje *ed)
+{
+   const Edje_Part_Collection *edc = ed->collection;
+   unsigned int *stack;
+   unsigned int i, top, count;
+
+   if (!edc || !edc->deps.offsets) return EINA_FALSE;
+   if (edc->parts_count != ed->table_parts_size) return EINA_FALSE;
+   if (ed->all_part_change || ed->text_part_change || ed->need_map_update)
+     return EINA_FALSE;
+
+   /* After the previous recalc every part is FLAG_XY, so clearing
+    * calculated doubles as the visited mark of the walk below. */
+   for (i = 0; i < ed->table_parts_size; i++)
+     if (ed->table_parts[i]->calculated != FLAG_XY) return EINA_FALSE;
+
+   stack = alloca(sizeof (unsigned int) * ed->table_parts_size);
+   count = 0;
+   for (i = 0; i < ed->table_parts_size; i++)
+     {
+        Edje_Real_Part *ep = ed->table_parts[i];
+
+        /* custom states may be relative to parts outside of the graph */
+        if (ep->invalidate || ep->custom)
+          {
+             ep->calculated = FLAG_NONE;
+             ep->calculating = FLAG_NONE;
+             stack[count++] = i;
+          }
+     }
+
+   for (top = 0; top < count; top++)
+     {
+        unsigned int id = stack[top];
+
+        for (i = edc->deps.offsets[id]; i < edc->deps.offsets[id + 1]; i++)
+          {
+             Edje_Real_Part *dep = ed->table_parts[edc->deps.parts[i]];
+
+             if (dep->calculated == FLAG_NONE) continue;
+             dep->calculated = FLAG_NONE;
+             dep->calculating = FLAG_NONE;
+             stack[count++] = edc->deps.parts[i];
+          }
+     }
+
+   ed->state++;
+   for (top = 0; top < count; top++)
+     {
+        Edje_Real_Part *ep = ed->table_parts[stack[top]];
+
+        if (ep->calculated != FLAG_XY)
+          _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+     }
+
+   return EINA_TRUE;
+}
+#endif
+
 void
 _edje_recalc_do(Edje *ed)
 {
@@ -715,29 +791,37 @@ _edje_recalc_do(Edje *ed)
 //   ed->postponed = EINA_FALSE;
    need_calc = evas_object_smart_need_recalculate_get(ed->obj);
    evas_object_smart_need_recalculate_set(ed->obj, 0);
+#ifdef EDJE_CALC_CACHE
+   if (!ed->dirty && !ed->dirty_parts) return;
+   if (ed->dirty || !_edje_recalc_parts_do(ed))
+#else
    if (!ed->dirty) return;
-   ed->dirty = EINA_FALSE;
-   ed->state++;
-   for (i = 0; i < ed->table_parts_size; i++)
+#endif
      {
-        Edje_Real_Part *ep;
+        ed->dirty = EINA_FALSE;
+        ed->state++;
+        for (i = 0; i < ed->table_parts_size; i++)
+          {
+             Edje_Real_Part *ep;
 
-        ep = ed->table_parts[i];
-        ep->calculated = FLAG_NONE;
-        ep->calculating = FLAG_NONE;
-     }
-   for (i = 0; i < ed->table_parts_size; i++)
-     {
-        Edje_Real_Part *ep;
+             ep = ed->table_parts[i];
+             ep->calculated = FLAG_NONE;
+             ep->calculating = FLAG_NONE;
+          }
+        for (i = 0; i < ed->table_parts_size; i++)
+          {
+             Edje_Real_Part *ep;
 
-        ep = ed->table_parts[i];
-        if (ep->calculated != FLAG_XY)
-          _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+             ep = ed->table_parts[i];
+             if (ep->calculated != FLAG_XY)
+               _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+          }
      }
    if (!ed->calc_only) ed->recalc = EINA_FALSE;
 #ifdef EDJE_CALC_CACHE
    ed->all_part_change = EINA_FALSE;
    ed->text_part_change = EINA_FALSE;
+   ed->dirty_parts = EINA_FALSE;
 #endif
    if (!ed->calc_only)
      {
@@ -897,8 +981,8 @@ _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y)
         ep->drag->x = x;
         ep->drag->tmp.x = 0;
         ep->drag->need_reset = 0;
-        ed->dirty = EINA_TRUE;
         ed->recalc_call = EINA_TRUE;
+        _edje_part_invalidate(ed, ep);
      }
 
    if (ep->drag->y != y || ep->drag->tmp.y)
@@ -906,8 +990,8 @@ _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y)
         ep->drag->y = y;
         ep->drag->tmp.y = 0;
         ep->drag->need_reset = 0;
-        ed->dirty = EINA_TRUE;
         ed->recalc_call = EINA_TRUE;
+        _edje_part_invalidate(ed, ep);
      }
 
 #ifdef EDJE_CALC_CACHE
@@ -3149,6 +3233,241 @@ _edje_map_prop_set(Evas_Map *map, const  Edje_Calc_Params *pf,
 #define Rel2X 2
 #define Rel2Y 3
 
+/* Layout cache.
+ *
+ * List and grid items instantiate the same group many times, at the same
+ * size and in the same states, and each of them computes the very same
+ * part geometry. The result of _edje_part_recalc_single() only depends on
+ * the description, the object size and scale, the geometry of the parts it
+ * is relative to and a few per part inputs, so it is kept in the collection
+ * and shared by all its objects. Anything relying on per-object state that
+ * is not part of the key is simply not cached. Global changes (scale,
+ * color and text classes, fontset) bump _edje_layout_cache_generation and
+ * collections drop their entries when they notice it.
+ */
+#define EDJE_LAYOUT_CACHE_MAX 1024
+
+typedef struct _Edje_Layout_Cache_Key Edje_Layout_Cache_Key;
+typedef struct _Edje_Layout_Cache_Entry Edje_Layout_Cache_Entry;
+
+struct _Edje_Layout_Cache_Key
+{
+   const Edje_Part_Description_Common *desc;
+   const Edje_Part_Description_Common *chosen_desc;
+   const char *text, *font, *filter;
+   FLOAT_T     scale, pos;
+   Evas_Coord  w, h;
+   Evas_Coord  mmw, mmh;
+   Evas_Coord  rel[4][4];
+   Edje_Size   swallow_min, swallow_max;
+   Edje_Aspect swallow_aspect;
+   int         size;
+};
+
+struct _Edje_Layout_Cache_Entry
+{
+   Edje_Layout_Cache_Key key;
+   Edje_Calc_Params      params;
+};
+
+static unsigned int
+_edje_layout_cache_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof (Edje_Layout_Cache_Key);
+}
+
+static int
+_edje_layout_cache_key_cmp(const void *key1, int key1_length EINA_UNUSED,
+                           const void *key2, int key2_length EINA_UNUSED)
+{
+   return memcmp(key1, key2, sizeof (Edje_Layout_Cache_Key));
+}
+
+static int
+_edje_layout_cache_key_hash(const void *key, int key_length)
+{
+   return eina_hash_superfast(key, key_length);
+}
+
+/* Strings are compared by address, the entry keeps them alive so the
+ * address is not given to another string while it is in the cache. */
+static void
+_edje_layout_cache_entry_free(void *data)
+{
+   Edje_Layout_Cache_Entry *entry = data;
+
+   eina_stringshare_del(entry->key.text);
+   eina_stringshare_del(entry->key.font);
+   eina_stringshare_del(entry->key.filter);
+   free(entry);
+}
+
+void
+_edje_layout_cache_clean(Edje_Part_Collection *edc)
+{
+   if (!edc->layout.entries) return;
+   eina_hash_free(edc->layout.entries);
+   edc->layout.entries = NULL;
+}
+
+static Eina_Bool
+_edje_layout_cache_key_set(Edje *ed, Edje_Real_Part *ep,
+                           Edje_Part_Description_Common *desc,
+                           Edje_Part_Description_Common *chosen_desc,
+                           Edje_Real_Part **rel,
+                           Evas_Coord mmw, Evas_Coord mmh,
+                           FLOAT_T pos,
+                           Edje_Layout_Cache_Key *key)
+{
+   unsigned int i;
+
+   if ((!_edje_layout_cache_enabled) || (ed->collection->layout.disabled))
+     return EINA_FALSE;
+   /* rounding is done differently, transitions and drags are per object,
+    * custom and rtl descriptions are allocated per object */
+   if ((ed->calc_only) || (ed->is_rtl) ||
+       (ep->param2) || (ep->drag) || (ep->custom))
+     return EINA_FALSE;
+   if ((desc->map.on) || (chosen_desc->map.on)) return EINA_FALSE;
+#ifdef HAVE_EPHYSICS
+   if ((ep->part->physics_body) || (ep->body)) return EINA_FALSE;
+#endif
+   if (eina_hash_population(ed->color_classes) > 0) return EINA_FALSE;
+
+   memset(key, 0, sizeof (*key));
+   switch (ep->part->type)
+     {
+      case EDJE_PART_TYPE_IMAGE:
+         /* the image picked from a set depends on the object size */
+         if (((Edje_Part_Description_Image *)desc)->image.set)
+           return EINA_FALSE;
+         break;
+      case EDJE_PART_TYPE_TEXT:
+           {
+              Edje_Part_Description_Text *text_desc = (Edje_Part_Description_Text *)desc;
+              Edje_Part_Description_Text *text_chosen = (Edje_Part_Description_Text *)chosen_desc;
+
+              if ((ed->text_classes) || (!ep->typedata.text)) return EINA_FALSE;
+              if ((text_desc->text.id_source >= 0) ||
+                  (text_desc->text.id_text_source >= 0) ||
+                  (text_chosen->text.id_source >= 0) ||
+                  (text_chosen->text.id_text_source >= 0))
+                return EINA_FALSE;
+              key->text = ep->typedata.text->text;
+              key->font = ep->typedata.text->font;
+              key->filter = ep->typedata.text->filter;
+              key->size = ep->typedata.text->size;
+              break;
+           }
+      case EDJE_PART_TYPE_RECTANGLE:
+      case EDJE_PART_TYPE_SWALLOW:
+      case EDJE_PART_TYPE_GROUP:
+      case EDJE_PART_TYPE_SPACER:
+      case EDJE_PART_TYPE_PROXY:
+         break;
+      default:
+         /* box and table measure their children, textblock its content,
+          * externals are opaque */
+         return EINA_FALSE;
+     }
+
+   key->desc = desc;
+   key->chosen_desc = chosen_desc;
+   key->scale = ed->scale;
+   key->pos = pos;
+   key->w = ed->w;
+   key->h = ed->h;
+   key->mmw = mmw;
+   key->mmh = mmh;
+   for (i = 0; i < 4; i++)
+     {
+        if (!rel[i]) continue;
+        key->rel[i][0] = rel[i]->x;
+        key->rel[i][1] = rel[i]->y;
+        key->rel[i][2] = rel[i]->w;
+        key->rel[i][3] = rel[i]->h;
+     }
+   if ((ep->type == EDJE_RP_TYPE_SWALLOW) && (ep->typedata.swallow))
+     {
+        key->swallow_min = ep->typedata.swallow->swallow_params.min;
+        key->swallow_max = ep->typedata.swallow->swallow_params.max;
+        key->swallow_aspect = ep->typedata.swallow->swallow_params.aspect;
+     }
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edje_layout_cache_get(Edje_Part_Collection *edc,
+                       const Edje_Layout_Cache_Key *key,
+                       Edje_Calc_Params *params)
+{
+   const Edje_Layout_Cache_Entry *entry;
+   const Edje_Calc_Params_Map *map;
+#ifdef HAVE_EPHYSICS
+   const Edje_Calc_Params_Physics *physics;
+#endif
+
+   if (!edc->layout.entries) return EINA_FALSE;
+   if (edc->layout.generation != _edje_layout_cache_generation)
+     {
+        _edje_layout_cache_clean(edc);
+        return EINA_FALSE;
+     }
+
+   entry = eina_hash_find(edc->layout.entries, key);
+   if (!entry) return EINA_FALSE;
+
+   /* map and physics belong to the object, mapped and physics parts are
+    * never cached so they are left as they are */
+   map = params->map;
+#ifdef HAVE_EPHYSICS
+   physics = params->physics;
+#endif
+   memcpy(params, &entry->params, sizeof (Edje_Calc_Params));
+   params->map = map;
+#ifdef HAVE_EPHYSICS
+   params->physics = physics;
+#endif
+   return EINA_TRUE;
+}
+
+static void
+_edje_layout_cache_add(Edje_Part_Collection *edc,
+                       const Edje_Layout_Cache_Key *key,
+                       const Edje_Calc_Params *params)
+{
+   Edje_Layout_Cache_Entry *entry;
+
+   if ((edc->layout.entries) &&
+       ((edc->layout.generation != _edje_layout_cache_generation) ||
+        (eina_hash_population(edc->layout.entries) >= EDJE_LAYOUT_CACHE_MAX)))
+     _edje_layout_cache_clean(edc);
+   if (!edc->layout.entries)
+     {
+        edc->layout.entries = eina_hash_new(_edje_layout_cache_key_length,
+                                            _edje_layout_cache_key_cmp,
+                                            _edje_layout_cache_key_hash,
+                                            _edje_layout_cache_entry_free, 6);
+        if (!edc->layout.entries) return;
+        edc->layout.generation = _edje_layout_cache_generation;
+     }
+
+   entry = malloc(sizeof (Edje_Layout_Cache_Entry));
+   if (!entry) return;
+   entry->key = *key;
+   entry->params = *params;
+   entry->params.map = NULL;
+#ifdef HAVE_EPHYSICS
+   entry->params.physics = NULL;
+#endif
+   eina_stringshare_ref(entry->key.text);
+   eina_stringshare_ref(entry->key.font);
+   eina_stringshare_ref(entry->key.filter);
+   if (!eina_hash_direct_add(edc->layout.entries, &entry->key, entry))
+     _edje_layout_cache_entry_free(entry);
+}
+
 void
 _edje_part_recalc(Edje *ed, Edje_Real_Part *ep, int flags, Edje_Calc_Params *state)
 {
@@ -3473,12 +3792,29 @@ _edje_part_recalc(Edje *ed, Edje_Real_Part *ep, int flags, Edje_Calc_Params *sta
              ed->text_part_change))
 #endif
           {
-             _edje_part_recalc_single(ed, ep, ep->param1.description,
-                                      chosen_desc, center[0], light[0],
-                                      persp[0], rp1[Rel1X], rp1[Rel1Y],
-                                      rp1[Rel2X], rp1[Rel2Y], confine_to,
-                                      threshold, p1, mmw, mmh,
-                                      pos);
+             Edje_Layout_Cache_Key key;
+             Eina_Bool cacheable;
+
+             cacheable = _edje_layout_cache_key_set(ed, ep, ep->param1.description,
+                                                    chosen_desc, rp1, mmw, mmh,
+                                                    pos, &key);
+             if ((cacheable) &&
+                 (_edje_layout_cache_get(ed->collection, &key, p1)))
+               _edje_layout_cache_hits++;
+             else
+               {
+                  _edje_part_recalc_single(ed, ep, ep->param1.description,
+                                           chosen_desc, center[0], light[0],
+                                           persp[0], rp1[Rel1X], rp1[Rel1Y],
+                                           rp1[Rel2X], rp1[Rel2Y], confine_to,
+                                           threshold, p1, mmw, mmh,
+                                           pos);
+                  if (cacheable)
+                    {
+                       _edje_layout_cache_misses++;
+                       _edje_layout_cache_add(ed->collection, &key, p1);
+                    }
+               }
 #ifdef EDJE_CALC_CACHE
              if (flags == FLAG_XY) ep->param1.state = ed->state;
 #endif
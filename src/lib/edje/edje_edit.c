@@ -200,6 +200,14 @@ _edje_edit_efl_file_file_set(Eo *obj, Edje_Edit *eed, const char *file, const ch
 
    eed->program_scripts = eina_hash_int32_new((Eina_Free_Cb)_edje_edit_program_script_free);
 
+   /* Parts and their relations are about to be edited, the dependency
+    * graph would go stale, so objects of this group always fully recalc.
+    * Descriptions are changed in place too, which the layout cache can't
+    * notice, so it is turned off for the group as well. */
+   _edje_part_deps_clean(eed->base->collection);
+   _edje_layout_cache_clean(eed->base->collection);
+   eed->base->collection->layout.disabled = EINA_TRUE;
+
    ef = eet_open(file, EET_FILE_MODE_READ);
 
    snprintf(buf, sizeof(buf), "edje/scripts/embryo/source/%i",
@@ -366,6 +366,15 @@ _edje_programs_patterns_clean(Edje_Part_Collection *edc)
    edc->patterns.programs.u.programs.globing = NULL;
 }
 
+void
+_edje_part_deps_clean(Edje_Part_Collection *edc)
+{
+   free(edc->deps.offsets);
+   edc->deps.offsets = NULL;
+   free(edc->deps.parts);
+   edc->deps.parts = NULL;
+}
+
 #ifdef HAVE_EPHYSICS
 static void
 _edje_physics_world_update_cb(void *data, EPhysics_World *world EINA_UNUSED, void *event_info EINA_UNUSED)
@@ -1715,6 +1724,8 @@ _edje_collection_free(Edje_File *edf, Edje_Part_Collection *ec, Edje_Part_Collec
    if (ec->patterns.table_programs) free(ec->patterns.table_programs);
    ec->patterns.table_programs = NULL;
    ec->patterns.table_programs_size = 0;
+   _edje_part_deps_clean(ec);
+   _edje_layout_cache_clean(ec);
 
    if (ec->script) embryo_program_free(ec->script);
    _edje_lua2_script_unload(ec);
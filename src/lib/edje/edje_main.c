@@ -68,13 +68,19 @@ edje_init(void)
      }
 
    _edje_scale = FROM_DOUBLE(1.0);
+   if (getenv("EDJE_LAYOUT_CACHE"))
+     _edje_layout_cache_enabled = !!atoi(getenv("EDJE_LAYOUT_CACHE"));
 
    _edje_edd_init();
    _edje_text_init();
    _edje_box_init();
    _edje_external_init();
    _edje_module_init();
-   _edje_message_init();
+   if (!_edje_message_init())
+     {
+	ERR("Mempool for Edje_Message cannot be allocated.");
+	goto shutdown_all;
+     }
    _edje_multisense_init();
    edje_signal_init();
 
@@ -141,6 +147,9 @@ _edje_shutdown_core(void)
 		   EINA_LOG_STATE_START,
 		   EINA_LOG_STATE_SHUTDOWN);
 
+   INF("Layout cache: %u hits, %u misses.",
+       _edje_layout_cache_hits, _edje_layout_cache_misses);
+
    _edje_file_cache_shutdown();
    _edje_color_class_members_free();
    _edje_color_class_hash_free();
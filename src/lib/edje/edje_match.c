@@ -97,24 +97,26 @@ _edje_match_states_insert(Edje_States *list,
 
    i = (idx * (patterns_max_length + 1)) + pos;
 
-   if (i < list->size)
-     {
-	if (list->has[i]) return;
-     }
+   if (list->has[i]) return;
    list->has[i] = 1;
 
    i = list->size;
    list->states[i].idx = idx;
    list->states[i].pos = pos;
-   list->has[i] = 0;
    list->size++;
 }
 
 static void
 _edje_match_states_clear(Edje_States *list,
                          EINA_UNUSED unsigned int patterns_size,
-                         EINA_UNUSED unsigned int patterns_max_length)
+                         unsigned int patterns_max_length)
 {
+   unsigned int i;
+
+   /* has[] only flags what is in the list, reset just that */
+   for (i = 0; i < list->size; ++i)
+     list->has[(list->states[i].idx * (patterns_max_length + 1))
+               + list->states[i].pos] = 0;
    list->size = 0;
 }
 
@@ -235,6 +237,7 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
 {
    unsigned int i;
 
+   _edje_match_states_clear(states, patterns_size, patterns_max_length);
    states->size = patterns_size;
 
    for (i = 0; i < patterns_size; ++i)
@@ -245,6 +248,181 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
      }
 }
 
+/* Lazily built DFA.
+ *
+ * The simulation below walks every live pattern state for each character
+ * of each emitted signal. The set of states reached only depends on the
+ * characters read so far though, so each distinct set becomes a DFA state
+ * the first time it is reached, and its transitions are filled in as
+ * characters show up. Once warm, matching is a table lookup per character.
+ *
+ * A state costs a little over 0.5KB, its 256 transitions plus its list of
+ * pattern states. There is one DFA per pattern set, that is two per
+ * collection with glob programs (signals and sources) and two per object
+ * with glob callbacks. A set holds at most EDJE_MATCH_DFA_MAX states, about
+ * 270KB, and all sets together at most EDJE_MATCH_DFA_BUDGET bytes. Strings
+ * that would need a state past either limit fall back to the simulation.
+ */
+
+#define EDJE_MATCH_DFA_MAX    512
+#define EDJE_MATCH_DFA_BUDGET (4 * 1024 * 1024)
+#define EDJE_MATCH_DFA_ERROR  0xffff
+
+typedef struct _Edje_Match_Dfa_Kernel Edje_Match_Dfa_Kernel;
+typedef struct _Edje_Match_Dfa_State  Edje_Match_Dfa_State;
+
+struct _Edje_Match_Dfa_Kernel
+{
+   unsigned int   size;
+   Edje_State     states[];
+};
+
+struct _Edje_Match_Dfa_State
+{
+   /* 0: not computed yet, EDJE_MATCH_DFA_ERROR: syntax error, otherwise
+    * the index of the next state + 1 */
+   unsigned short next[256];
+
+   unsigned int   index;
+   unsigned int   finals_size;
+   Edje_State    *finals; /* states ending a pattern, after the kernel */
+
+   Edje_Match_Dfa_Kernel kernel; /* states as _edje_match_fn() lists them */
+};
+
+struct _Edje_Match_Dfa
+{
+   Eina_Hash             *lookup;
+   Edje_Match_Dfa_State **states;
+   unsigned int           count;
+};
+
+/* bytes held by the states of every DFA */
+static size_t _edje_match_dfa_usage = 0;
+
+static size_t
+_edje_match_dfa_state_size(unsigned int states)
+{
+   return sizeof (Edje_Match_Dfa_State) + states * sizeof (Edje_State);
+}
+
+static void
+_edje_match_dfa_state_free(void *data)
+{
+   Edje_Match_Dfa_State *st = data;
+
+   _edje_match_dfa_usage -= _edje_match_dfa_state_size(st->kernel.size +
+                                                       st->finals_size);
+   free(st);
+}
+
+static unsigned int
+_edje_match_dfa_key_length(const void *key)
+{
+   const Edje_Match_Dfa_Kernel *k = key;
+
+   return sizeof (Edje_Match_Dfa_Kernel) + k->size * sizeof (Edje_State);
+}
+
+static int
+_edje_match_dfa_key_cmp(const void *key1, int key1_length,
+                        const void *key2, int key2_length)
+{
+   if (key1_length != key2_length) return key1_length - key2_length;
+   return memcmp(key1, key2, key1_length);
+}
+
+static int
+_edje_match_dfa_key_hash(const void *key, int key_length)
+{
+   return eina_hash_superfast(key, key_length);
+}
+
+static Edje_Match_Dfa *
+_edje_match_dfa_new(void)
+{
+   Edje_Match_Dfa *dfa;
+
+   dfa = calloc(1, sizeof (Edje_Match_Dfa));
+   if (!dfa) return NULL;
+
+   dfa->states = malloc(sizeof (Edje_Match_Dfa_State *) * EDJE_MATCH_DFA_MAX);
+   dfa->lookup = eina_hash_new(_edje_match_dfa_key_length,
+                               _edje_match_dfa_key_cmp,
+                               _edje_match_dfa_key_hash,
+                               _edje_match_dfa_state_free, 5);
+   if ((!dfa->states) || (!dfa->lookup))
+     {
+        if (dfa->lookup) eina_hash_free(dfa->lookup);
+        free(dfa->states);
+        free(dfa);
+        return NULL;
+     }
+
+   return dfa;
+}
+
+static void
+_edje_match_dfa_free(Edje_Match_Dfa *dfa)
+{
+   if (!dfa) return;
+
+   eina_hash_free(dfa->lookup);
+   free(dfa->states);
+   free(dfa);
+}
+
+/* Returns the state for the list, creating it if needed, or NULL once the
+   DFA is full. */
+static Edje_Match_Dfa_State *
+_edje_match_dfa_state_get(const Edje_Patterns *ppat,
+                          const Edje_States *list)
+{
+   Edje_Match_Dfa *dfa = ppat->dfa;
+   Edje_Match_Dfa_Kernel *key;
+   Edje_Match_Dfa_State *st;
+   unsigned int i, finals;
+   size_t size, alloc;
+
+   size = list->size * sizeof (Edje_State);
+   key = alloca(sizeof (Edje_Match_Dfa_Kernel) + size);
+   key->size = list->size;
+   memcpy(key->states, list->states, size);
+
+   st = eina_hash_find(dfa->lookup, key);
+   if (st) return st;
+   if (dfa->count >= EDJE_MATCH_DFA_MAX) return NULL;
+
+   for (i = 0, finals = 0; i < list->size; ++i)
+     if (list->states[i].pos >= ppat->finals[list->states[i].idx])
+       finals++;
+
+   alloc = _edje_match_dfa_state_size(list->size + finals);
+   if (_edje_match_dfa_usage + alloc > EDJE_MATCH_DFA_BUDGET) return NULL;
+   st = malloc(alloc);
+   if (!st) return NULL;
+
+   memset(st->next, 0, sizeof (st->next));
+   st->index = dfa->count;
+   st->kernel.size = list->size;
+   memcpy(st->kernel.states, list->states, size);
+   st->finals = st->kernel.states + list->size;
+   st->finals_size = 0;
+   for (i = 0; i < list->size; ++i)
+     if (list->states[i].pos >= ppat->finals[list->states[i].idx])
+       st->finals[st->finals_size++] = list->states[i];
+
+   if (!eina_hash_direct_add(dfa->lookup, &st->kernel, st))
+     {
+        free(st);
+        return NULL;
+     }
+   dfa->states[dfa->count++] = st;
+   _edje_match_dfa_usage += alloc;
+
+   return st;
+}
+
 /* Exported function. */
 
 #define EDJE_MATCH_INIT_LIST(Func, Type, Source, Show)		\
@@ -310,6 +488,7 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
           free(r);                                              \
           return NULL;                                          \
        }                                                        \
+     r->dfa = _edje_match_dfa_new();                            \
                                                                 \
      return r;                                                  \
   }
@@ -373,6 +552,7 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
           free(r);                                              \
           return NULL;                                          \
        }                                                        \
+     r->dfa = _edje_match_dfa_new();                            \
                                                                 \
      return r;                                                  \
   }
@@ -433,6 +613,7 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
           free(r);                                                      \
           return NULL;                                                  \
        }                                                                \
+     r->dfa = _edje_match_dfa_new();                                    \
                                                                         \
      return r;                                                          \
   }
@@ -572,6 +753,45 @@ edje_match_callback_exec_check_finals(const Edje_Signals_Sources_Patterns *ssp,
 }
 
 
+static Eina_Bool
+_edje_match_step(const Edje_Patterns      *ppat,
+                 Edje_States              *states,
+                 Edje_States              *new_states,
+                 char                      c)
+{
+   unsigned int  i;
+
+   _edje_match_states_clear(new_states, ppat->patterns_size, ppat->max_length);
+
+   for (i = 0; i < states->size; ++i)
+     {
+        const unsigned int idx = states->states[i].idx;
+        const unsigned int pos = states->states[i].pos;
+
+        if (!ppat->patterns[idx][pos])
+           continue;
+        else if (ppat->patterns[idx][pos] == '*')
+          {
+             _edje_match_states_insert(states, ppat->max_length, idx, pos + 1);
+             _edje_match_states_insert(new_states, ppat->max_length, idx, pos);
+          }
+        else
+          {
+             unsigned int m;
+
+             if (_edje_match_patterns_exec_token(ppat->patterns[idx] + pos,
+                                                 c,
+                                                 &m) != EDJE_MATCH_OK)
+                return EINA_FALSE;
+
+             if (m)
+                _edje_match_states_insert(new_states, ppat->max_length, idx, pos + m);
+          }
+     }
+
+   return EINA_TRUE;
+}
+
 static Edje_States*
 _edje_match_fn(const Edje_Patterns      *ppat,
                const char               *string,
@@ -582,62 +802,109 @@ _edje_match_fn(const Edje_Patterns      *ppat,
 
    for (c = string; *c && states->size; ++c)
      {
-        unsigned int  i;
+        Edje_States  *tmp;
 
-        _edje_match_states_clear(new_states, ppat->patterns_size, ppat->max_length);
+        if (!_edje_match_step(ppat, states, new_states, *c))
+          return NULL;
 
-        for (i = 0; i < states->size; ++i)
-          {
-             const unsigned int idx = states->states[i].idx;
-             const unsigned int pos = states->states[i].pos;
+        tmp = states;
+        states = new_states;
+        new_states = tmp;
+     }
 
-             if (!ppat->patterns[idx][pos])
-                continue;
-             else if (ppat->patterns[idx][pos] == '*')
-               {
-                  _edje_match_states_insert(states, ppat->max_length, idx, pos + 1);
-                  _edje_match_states_insert(new_states, ppat->max_length, idx, pos);
-               }
-             else
-               {
-                  unsigned int m;
+   return states;
+}
 
-                  if (_edje_match_patterns_exec_token(ppat->patterns[idx] + pos,
-                                                      *c,
-                                                      &m) != EDJE_MATCH_OK)
-                     return NULL;
+static unsigned short
+_edje_match_dfa_transition(const Edje_Patterns  *ppat,
+                           Edje_Match_Dfa_State *st,
+                           unsigned char         c)
+{
+   Edje_States *states = ppat->states;
+   Edje_States *new_states = ppat->states + 1;
+   Edje_Match_Dfa_State *next;
+   unsigned int i;
 
-                  if (m)
-                     _edje_match_states_insert(new_states, ppat->max_length, idx, pos + m);
-               }
-          }
-          {
-             Edje_States  *tmp = states;
+   _edje_match_states_clear(states, ppat->patterns_size, ppat->max_length);
+   for (i = 0; i < st->kernel.size; ++i)
+     _edje_match_states_insert(states, ppat->max_length,
+                               st->kernel.states[i].idx,
+                               st->kernel.states[i].pos);
+
+   if (!_edje_match_step(ppat, states, new_states, c))
+     return st->next[c] = EDJE_MATCH_DFA_ERROR;
+
+   next = _edje_match_dfa_state_get(ppat, new_states);
+   if (!next) return 0;
+
+   return st->next[c] = next->index + 1;
+}
 
-             states = new_states;
-             new_states = tmp;
+/* Match string against all patterns. On success, result lists the states
+   to check against finals. EINA_FALSE means a pattern has a syntax error
+   and nothing matches. */
+static Eina_Bool
+_edje_match_exec(const Edje_Patterns *ppat,
+                 const char          *string,
+                 Edje_States         *result)
+{
+   Edje_Match_Dfa *dfa = ppat->dfa;
+   Edje_Match_Dfa_State *st = NULL;
+   Edje_States *states;
+   const unsigned char *c;
+
+   if (dfa)
+     {
+        if (!dfa->count)
+          {
+             _edje_match_patterns_exec_init_states(ppat->states,
+                                                   ppat->patterns_size,
+                                                   ppat->max_length);
+             _edje_match_dfa_state_get(ppat, ppat->states);
           }
+        if (dfa->count) st = dfa->states[0];
      }
 
-   return states;
+   for (c = (const unsigned char *) string; st && *c && st->kernel.size; ++c)
+     {
+        unsigned short next = st->next[*c];
+
+        if (!next) next = _edje_match_dfa_transition(ppat, st, *c);
+        if (next == EDJE_MATCH_DFA_ERROR) return EINA_FALSE;
+        st = next ? dfa->states[next - 1] : NULL;
+     }
+
+   if (st)
+     {
+        result->size = st->finals_size;
+        result->states = st->finals;
+        result->has = NULL;
+        return EINA_TRUE;
+     }
+
+   /* no DFA or it is full, simulate */
+   _edje_match_patterns_exec_init_states(ppat->states,
+                                         ppat->patterns_size,
+                                         ppat->max_length);
+   states = _edje_match_fn(ppat, string, ppat->states);
+   if (!states) return EINA_FALSE;
+
+   *result = *states;
+   return EINA_TRUE;
 }
 
 Eina_Bool
 edje_match_collection_dir_exec(const Edje_Patterns      *ppat,
                                const char               *string)
 {
-   Edje_States  *result;
+   Edje_States   result;
    Eina_Bool     r = EINA_FALSE;
 
    /* under high memory presure, it could be NULL */
    if (!ppat) return EINA_FALSE;
 
-   _edje_match_patterns_exec_init_states(ppat->states, ppat->patterns_size, ppat->max_length);
-
-   result = _edje_match_fn(ppat, string, ppat->states);
-
-   if (result)
-      r = _edje_match_collection_dir_exec_finals(ppat->finals, result);
+   if (_edje_match_exec(ppat, string, &result))
+      r = _edje_match_collection_dir_exec_finals(ppat->finals, &result);
 
    return r;
 }
@@ -652,28 +919,19 @@ edje_match_programs_exec(const Edje_Patterns    *ppat_signal,
                          void                   *data,
                          Eina_Bool               prop)
 {
-   Edje_States  *signal_result;
-   Edje_States  *source_result;
+   Edje_States   signal_result;
+   Edje_States   source_result;
    Eina_Bool     r = EINA_FALSE;
 
    /* under high memory presure, they could be NULL */
    if (!ppat_source || !ppat_signal) return EINA_FALSE;
 
-   _edje_match_patterns_exec_init_states(ppat_signal->states,
-                                         ppat_signal->patterns_size,
-                                         ppat_signal->max_length);
-   _edje_match_patterns_exec_init_states(ppat_source->states,
-                                         ppat_source->patterns_size,
-                                         ppat_source->max_length);
-
-   signal_result = _edje_match_fn(ppat_signal, sig, ppat_signal->states);
-   source_result = _edje_match_fn(ppat_source, source, ppat_source->states);
-
-   if (signal_result && source_result)
+   if (_edje_match_exec(ppat_signal, sig, &signal_result) &&
+       _edje_match_exec(ppat_source, source, &source_result))
       r = edje_match_programs_exec_check_finals(ppat_signal->finals,
                                                 ppat_source->finals,
-                                                signal_result,
-                                                source_result,
+                                                &signal_result,
+                                                &source_result,
                                                 programs,
                                                 func,
                                                 data,
@@ -689,8 +947,8 @@ edje_match_callback_exec(const Edje_Signals_Sources_Patterns *ssp,
                          Edje *ed,
                          Eina_Bool prop)
 {
-   Edje_States  *signal_result;
-   Edje_States  *source_result;
+   Edje_States   signal_result;
+   Edje_States   source_result;
    int           r = 0;
 
    /* under high memory presure, they could be NULL */
@@ -698,21 +956,13 @@ edje_match_callback_exec(const Edje_Signals_Sources_Patterns *ssp,
 
    ssp->signals_patterns->ref++;
    ssp->sources_patterns->ref++;
-   _edje_match_patterns_exec_init_states(ssp->signals_patterns->states,
-                                         ssp->signals_patterns->patterns_size,
-                                         ssp->signals_patterns->max_length);
-   _edje_match_patterns_exec_init_states(ssp->sources_patterns->states,
-                                         ssp->sources_patterns->patterns_size,
-                                         ssp->sources_patterns->max_length);
-
-   signal_result = _edje_match_fn(ssp->signals_patterns, sig, ssp->signals_patterns->states);
-   source_result = _edje_match_fn(ssp->sources_patterns, source, ssp->sources_patterns->states);
 
-   if (signal_result && source_result)
+   if (_edje_match_exec(ssp->signals_patterns, sig, &signal_result) &&
+       _edje_match_exec(ssp->sources_patterns, source, &source_result))
      r = edje_match_callback_exec_check_finals(ssp,
 					       matches,
-                                               signal_result,
-                                               source_result,
+                                               &signal_result,
+                                               &source_result,
                                                sig,
                                                source,
                                                ed,
@@ -732,6 +982,7 @@ edje_match_patterns_free(Edje_Patterns *ppat)
    ppat->delete_me = EINA_TRUE;
    ppat->ref--;
    if (ppat->ref > 0) return;
+   _edje_match_dfa_free(ppat->dfa);
    _edje_match_states_free(ppat->states, 2);
    free(ppat);
 }
@@ -6,10 +6,66 @@ static int _injob = 0;
 static Ecore_Job *_job = NULL;
 static Ecore_Timer *_job_loss_timer = NULL;
 
-static Eina_List *msgq = NULL;
-static Eina_List *tmp_msgq = NULL;
-static int tmp_msgq_processing = 0;
-static int tmp_msgq_restart = 0;
+static Eina_Mempool *_edje_message_mp = NULL;
+
+/* every queued message is linked both in msgq, in the order it was sent,
+ * and in the queue of its edje, so that processing or dropping the
+ * messages of one object never has to walk the messages of all others.
+ * serials order the messages of different objects and tell the ones queued
+ * before a processing run started from the ones it fed in. */
+static Eina_Inlist *msgq = NULL;
+static unsigned int msgq_serial = 0;
+
+#define EDJE_MESSAGE_OWNER_GET(l) \
+  ((Edje_Message *)(void *)((char *)(l) - offsetof(Edje_Message, owner)))
+
+static inline Eina_Bool
+_edje_message_before(const Edje_Message *em, unsigned int serial)
+{
+   return (int)(em->serial - serial) < 0;
+}
+
+static void
+_edje_message_queue_append(Edje_Message *em)
+{
+   Edje *ed = em->edje;
+
+   em->serial = msgq_serial++;
+   msgq = eina_inlist_append(msgq, EINA_INLIST_GET(em));
+   ed->message.queue = eina_inlist_append(ed->message.queue, &em->owner);
+   ed->message.num++;
+}
+
+static void
+_edje_message_queue_remove(Edje_Message *em)
+{
+   Edje *ed = em->edje;
+
+   msgq = eina_inlist_remove(msgq, EINA_INLIST_GET(em));
+   ed->message.queue = eina_inlist_remove(ed->message.queue, &em->owner);
+   ed->message.num--;
+}
+
+static void
+_edje_message_dispatch(Edje_Message *em)
+{
+   Edje *ed = em->edje;
+
+   _edje_message_queue_remove(em);
+   if (!ed->delete_me)
+     {
+        ed->processing_messages++;
+        _edje_message_process(em);
+        _edje_message_free(em);
+        ed->processing_messages--;
+     }
+   else
+     _edje_message_free(em);
+   if (ed->processing_messages == 0)
+     {
+        if (ed->delete_me) _edje_del(ed);
+     }
+}
 
 /*============================================================================*
  *                                   API                                      *
@@ -46,87 +102,38 @@ _edje_object_message_handler_set(Eo *obj EINA_UNUSED, Edje *ed, Edje_Message_Han
 EOLIAN void
 _edje_object_message_signal_process(Eo *obj EINA_UNUSED, Edje *ed)
 {
-   Eina_List *l, *ln, *tmpq = NULL;
    Edje *lookup_ed;
    Eina_List *lg;
    Edje_Message *em;
-   Eina_List *groups = NULL;
-   int gotos = 0;
+   unsigned int serial;
 
    if (!ed) return;
 
-   groups = ed->groups;
-
-   EINA_LIST_FOREACH_SAFE(msgq, l, ln, em)
+   /* only deliver what was queued before we got here, anything sent from
+    * the handlers waits for the next run so a self-feeding object can not
+    * lock us in this loop. */
+   serial = msgq_serial;
+   ed->processing_messages++;
+   for (;;)
      {
-        EINA_LIST_FOREACH(groups, lg, lookup_ed)
-          if (em->edje == lookup_ed)
-            {
-               tmpq = eina_list_append(tmpq, em);
-               msgq = eina_list_remove_list(msgq, l);
-               break;
-            }
-     }
-   /* a temporary message queue */
-   if (tmp_msgq)
-     {
-        EINA_LIST_FREE(tmpq, em)
-          tmp_msgq = eina_list_append(tmp_msgq, em);
-     }
-   else
-     {
-	tmp_msgq = tmpq;
-	tmpq = NULL;
-     }
-
-   tmp_msgq_processing++;
-again:
-   EINA_LIST_FOREACH_SAFE(tmp_msgq, l, ln, em)
-     {
-        EINA_LIST_FOREACH(groups, lg, lookup_ed)
-          if (em->edje == lookup_ed)
-            break;
-        if (em->edje != lookup_ed) continue;
-	tmp_msgq = eina_list_remove_list(tmp_msgq, l);
-        if (!lookup_ed->delete_me)
-          {
-             lookup_ed->processing_messages++;
-             _edje_message_process(em);
-             _edje_message_free(em);
-             lookup_ed->processing_messages--;
-          }
-        else
-           _edje_message_free(em);
-        if (lookup_ed->processing_messages == 0)
-          {
-             if (lookup_ed->delete_me) _edje_del(lookup_ed);
-          }
-        // if some child callback in _edje_message_process called
-        // edje_object_message_signal_process() or
-        // edje_message_signal_process() then those will mark the restart
-        // flag when they finish - it mabsicammyt means tmp_msgq and
-        // any item in it has potentially become invalid - so that means l
-        // and ln could be rogue pointers, so start again from the beginning
-        // and skip anything that is not this object and process only what is.
-        // to avoid self-feeding loops allow a max of 1024 loops.
-        if (tmp_msgq_restart)
+        /* oldest pending message among the groups of this object */
+        em = NULL;
+        EINA_LIST_FOREACH(ed->groups, lg, lookup_ed)
           {
-             tmp_msgq_restart = 0;
-             gotos++;
-             if (gotos < 1024) goto again;
-             else
-               {
-                  WRN("Edje is in a self-feeding message loop (> 1024 gotos needed in a row)");
-                  goto end;
-               }
+             Edje_Message *first;
+
+             if (!lookup_ed->message.queue) continue;
+             first = EDJE_MESSAGE_OWNER_GET(lookup_ed->message.queue);
+             if (!_edje_message_before(first, serial)) continue;
+             if ((!em) || (_edje_message_before(first, em->serial)))
+               em = first;
           }
+        if (!em) break;
+        _edje_message_dispatch(em);
      }
-end:
-   tmp_msgq_processing--;
-   if (tmp_msgq_processing == 0)
-      tmp_msgq_restart = 0;
-   else
-      tmp_msgq_restart = 1;
+   ed->processing_messages--;
+   if ((ed->processing_messages == 0) && (ed->delete_me))
+     _edje_del(ed);
 }
 
 EAPI void
@@ -167,9 +174,13 @@ _edje_job_loss_timer(void *data EINA_UNUSED)
    return ECORE_CALLBACK_CANCEL;
 }
 
-void
+Eina_Bool
 _edje_message_init(void)
 {
+   _edje_message_mp = eina_mempool_add("chained_mempool",
+                                       "Edje_Message", NULL,
+                                       sizeof (Edje_Message), 64);
+   return !!_edje_message_mp;
 }
 
 void
@@ -186,6 +197,11 @@ _edje_message_shutdown(void)
         ecore_job_del(_job);
         _job = NULL;
      }
+   if (_edje_message_mp)
+     {
+        eina_mempool_del(_edje_message_mp);
+        _edje_message_mp = NULL;
+     }
 }
 
 void
@@ -209,13 +225,12 @@ _edje_message_new(Edje *ed, Edje_Queue queue, Edje_Message_Type type, int id)
 {
    Edje_Message *em;
 
-   em = calloc(1, sizeof(Edje_Message));
+   em = eina_mempool_calloc(_edje_message_mp, sizeof (Edje_Message));
    if (!em) return NULL;
    em->edje = ed;
    em->queue = queue;
    em->type = type;
    em->id = id;
-   em->edje->message.num++;
    return em;
 }
 
@@ -338,7 +353,7 @@ _edje_message_free(Edje_Message *em)
 	     break;
 	  }
      }
-   free(em);
+   eina_mempool_free(_edje_message_mp, em);
 }
 
 void
@@ -514,7 +529,7 @@ _edje_message_propornot_send(Edje *ed, Edje_Queue queue, Edje_Message_Type type,
      }
 
    em->msg = msg;
-   msgq = eina_list_append(msgq, em);
+   _edje_message_queue_append(em);
 }
 
 void
@@ -723,50 +738,19 @@ _edje_message_queue_process(void)
    /* us to go back to normal processing and let a 0 timeout deal with it */
    for (i = 0; (i < 8) && (msgq); i++)
      {
-	/* a temporary message queue */
-	if (tmp_msgq)
-	  {
-	     while (msgq)
-	       {
-		  tmp_msgq = eina_list_append(tmp_msgq, msgq->data);
-		  msgq = eina_list_remove_list(msgq, msgq);
-	       }
-	  }
-	else
-	  {
-	     tmp_msgq = msgq;
-	     msgq = NULL;
-	  }
+        unsigned int serial = msgq_serial;
 
-        tmp_msgq_processing++;
-	while (tmp_msgq)
-	  {
-	     Edje_Message *em;
-	     Edje *ed;
-
-	     em = tmp_msgq->data;
-	     ed = em->edje;
-	     tmp_msgq = eina_list_remove_list(tmp_msgq, tmp_msgq);
-	     em->edje->message.num--;
-	     if (!ed->delete_me)
-	       {
-		  ed->processing_messages++;
-		  _edje_message_process(em);
-		  _edje_message_free(em);
-		  ed->processing_messages--;
-	       }
-	     else
-	       _edje_message_free(em);
-	     if (ed->processing_messages == 0)
-	       {
-		  if (ed->delete_me) _edje_del(ed);
-	       }
-	  }
-        tmp_msgq_processing--;
-        if (tmp_msgq_processing == 0)
-           tmp_msgq_restart = 0;
-        else
-           tmp_msgq_restart = 1;
+        /* messages queued while processing wait for the next loop. msgq is
+         * looked up again each time as handlers may process or drop any
+         * message of the queue. */
+        while (msgq)
+          {
+             Edje_Message *em;
+
+             em = EINA_INLIST_CONTAINER_GET(msgq, Edje_Message);
+             if (!_edje_message_before(em, serial)) break;
+             _edje_message_dispatch(em);
+          }
      }
 
    /* if the message queue filled again set a timer to expire in 0.0 sec */
@@ -796,18 +780,8 @@ _edje_message_queue_clear(void)
      {
 	Edje_Message *em;
 
-	em = msgq->data;
-	msgq = eina_list_remove_list(msgq, msgq);
-	em->edje->message.num--;
-	_edje_message_free(em);
-     }
-   while (tmp_msgq)
-     {
-	Edje_Message *em;
-
-	em = tmp_msgq->data;
-	tmp_msgq = eina_list_remove_list(tmp_msgq, tmp_msgq);
-	em->edje->message.num--;
+	em = EINA_INLIST_CONTAINER_GET(msgq, Edje_Message);
+	_edje_message_queue_remove(em);
 	_edje_message_free(em);
      }
 }
@@ -815,41 +789,13 @@ _edje_message_queue_clear(void)
 void
 _edje_message_del(Edje *ed)
 {
-   Eina_List *l;
-
-   if (ed->message.num <= 0) return;
-   /* delete any messages on the main queue for this edje object */
-   for (l = msgq; l; )
+   /* delete any messages still queued for this edje object */
+   while (ed->message.queue)
      {
 	Edje_Message *em;
-	Eina_List *lp;
 
-	em = eina_list_data_get(l);
-	lp = l;
-	l = eina_list_next(l);
-	if (em->edje == ed)
-	  {
-	     msgq = eina_list_remove_list(msgq, lp);
-	     em->edje->message.num--;
-	     _edje_message_free(em);
-	  }
-	if (ed->message.num <= 0) return;
-     }
-   /* delete any on the processing queue */
-   for (l = tmp_msgq; l; )
-     {
-	Edje_Message *em;
-	Eina_List *lp;
-
-	em = eina_list_data_get(l);
-	lp = l;
-	l = eina_list_next(l);
-	if (em->edje == ed)
-	  {
-	     tmp_msgq = eina_list_remove_list(tmp_msgq, lp);
-	     em->edje->message.num--;
-	     _edje_message_free(em);
-	  }
-	if (ed->message.num <= 0) return;
+	em = EDJE_MESSAGE_OWNER_GET(ed->message.queue);
+	_edje_message_queue_remove(em);
+	_edje_message_free(em);
      }
 }
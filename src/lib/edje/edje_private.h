@@ -1012,6 +1012,17 @@ struct _Edje_Part_Collection
       Edje_Program **table_programs;
       int            table_programs_size;
    } patterns;
+
+   struct { /* parts depending on each part, indexed by part id */
+      unsigned int  *offsets; /* parts_count + 1 entries */
+      unsigned int  *parts;
+   } deps;
+
+   struct { /* memoised part geometry shared by objects of this group */
+      Eina_Hash     *entries;
+      unsigned int   generation; /* _edje_layout_cache_generation at fill */
+      Eina_Bool      disabled : 1;
+   } layout;
    /* *** *** */
 
    unsigned char    lua_script_only;
@@ -1512,6 +1523,7 @@ struct _Edje
    struct {
       Edje_Message_Handler_Cb  func;
       void                    *data;
+      Eina_Inlist             *queue;
       int                      num;
    } message;
 
@@ -1567,6 +1579,7 @@ struct _Edje
 #ifdef EDJE_CALC_CACHE
    Eina_Bool          text_part_change : 1;
    Eina_Bool          all_part_change : 1;
+   Eina_Bool          dirty_parts : 1; /* only invalidated parts need a recalc */
 #endif
    Eina_Bool          have_mapped_part : 1;
    Eina_Bool          recalc_call : 1;
@@ -1961,7 +1974,10 @@ struct _Edje_Message_Signal
 
 struct _Edje_Message
 {
+   EINA_INLIST; /* global queue, in send order */
+   Eina_Inlist        owner; /* queue of the edje it is sent to */
    Edje              *edje;
+   unsigned int       serial;
    Edje_Queue         queue;
    Edje_Message_Type  type;
    int                id;
@@ -1985,11 +2001,13 @@ typedef enum _Edje_Match_Error
 } Edje_Match_Error;
 
 typedef struct _Edje_States     Edje_States;
+typedef struct _Edje_Match_Dfa  Edje_Match_Dfa;
 struct _Edje_Patterns
 {
    const char    **patterns;
 
    Edje_States    *states;
+   Edje_Match_Dfa *dfa; /* built lazily while matching, see edje_match.c */
 
    int             ref;
    Eina_Bool       delete_me : 1;
@@ -2120,6 +2138,11 @@ extern int              _edje_util_freeze_val;
 extern int              _edje_util_freeze_calc_count;
 extern Eina_List       *_edje_util_freeze_calc_list;
 
+extern Eina_Bool        _edje_layout_cache_enabled;
+extern unsigned int     _edje_layout_cache_generation;
+extern unsigned int     _edje_layout_cache_hits;
+extern unsigned int     _edje_layout_cache_misses;
+
 extern Eina_Bool        _edje_password_show_last;
 extern FLOAT_T          _edje_password_show_last_timeout;
 
@@ -2161,6 +2184,7 @@ Edje_Part_Description_Common *_edje_part_description_find(Edje *ed,
 void  _edje_part_description_apply(Edje *ed, Edje_Real_Part *ep, const char  *d1, double v1, const char *d2, double v2);
 void  _edje_recalc(Edje *ed);
 void  _edje_recalc_do(Edje *ed);
+void  _edje_part_invalidate(Edje *ed, Edje_Real_Part *ep);
 int   _edje_part_dragable_calc(Edje *ed, Edje_Real_Part *ep, FLOAT_T *x, FLOAT_T *y);
 void  _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y);
 
@@ -2212,6 +2236,9 @@ void  _edje_program_end(Edje *ed, Edje_Running_Program *runp);
 void  _edje_program_run(Edje *ed, Edje_Program *pr, Eina_Bool force, const char *ssig, const char *ssrc);
 void _edje_programs_patterns_clean(Edje_Part_Collection *ed);
 void _edje_programs_patterns_init(Edje_Part_Collection *ed);
+void _edje_part_deps_clean(Edje_Part_Collection *edc);
+void _edje_part_deps_init(Edje_Part_Collection *edc);
+void _edje_layout_cache_clean(Edje_Part_Collection *edc);
 void  _edje_emit(Edje *ed, const char *sig, const char *src);
 void _edje_emit_full(Edje *ed, const char *sig, const char *src, void *data, void (*free_func)(void *));
 void _edje_emit_handle(Edje *ed, const char *sig, const char *src, Edje_Message_Signal_Data *data, Eina_Bool prop);
@@ -2351,7 +2378,7 @@ void          _edje_var_timer_reset         (Edje *ed, int id);
 int           _edje_var_anim_add            (Edje *ed, double len, const char *fname, int val);
 void          _edje_var_anim_del            (Edje *ed, int id);
 
-void          _edje_message_init            (void);
+Eina_Bool     _edje_message_init            (void);
 void          _edje_message_shutdown        (void);
 void          _edje_message_cb_set          (Edje *ed, void (*func) (void *data, Evas_Object *obj, Edje_Message_Type type, int id, void *msg), void *data);
 Edje_Message *_edje_message_new             (Edje *ed, Edje_Queue queue, Edje_Message_Type type, int id);
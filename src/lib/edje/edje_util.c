@@ -331,6 +331,7 @@ edje_fontset_append_set(const char *fonts)
    if (_edje_fontset_append)
      free(_edje_fontset_append);
    _edje_fontset_append = fonts ? strdup(fonts) : NULL;
+   _edje_layout_cache_generation++;
 }
 
 EAPI const char *
@@ -347,6 +348,7 @@ edje_scale_set(double scale)
 
    if (_edje_scale == FROM_DOUBLE(scale)) return;
    _edje_scale = FROM_DOUBLE(scale);
+   _edje_layout_cache_generation++;
    EINA_LIST_FOREACH(_edje_edjes, l, data)
      edje_object_calc_force(data);
 }
@@ -528,6 +530,7 @@ edje_color_class_set(const char *color_class, int r, int g, int b, int a, int r2
         if (!_edje_color_class_hash)
           _edje_color_class_hash = eina_hash_string_superfast_new(NULL);
         eina_hash_add(_edje_color_class_hash, color_class, cc);
+        _edje_layout_cache_generation++;
      }
 
    if (r < 0)        r = 0;
@@ -557,6 +560,7 @@ edje_color_class_set(const char *color_class, int r, int g, int b, int a, int r2
    cc->g3 = g3;
    cc->b3 = b3;
    cc->a3 = a3;
+   _edje_layout_cache_generation++;
 
    members = eina_hash_find(_edje_color_class_member_hash, color_class);
    if (!members) return EINA_TRUE;
@@ -625,6 +629,7 @@ edje_color_class_del(const char *color_class)
    eina_hash_del(_edje_color_class_hash, color_class, cc);
    eina_stringshare_del(cc->name);
    free(cc);
+   _edje_layout_cache_generation++;
 
    members = eina_hash_find(_edje_color_class_member_hash, color_class);
    it = eina_hash_iterator_data_new(members);
@@ -1013,6 +1018,7 @@ edje_text_class_set(const char *text_class, const char *font, Evas_Font_Size siz
         eina_stringshare_replace(&tc->font, font);
         tc->size = size;
      }
+   _edje_layout_cache_generation++;
 
    /* Tell all members of the text class to recalc */
    members = eina_hash_find(_edje_text_class_member_hash, text_class);
@@ -1073,6 +1079,7 @@ edje_text_class_del(const char *text_class)
    eina_stringshare_del(tc->name);
    eina_stringshare_del(tc->font);
    free(tc);
+   _edje_layout_cache_generation++;
 
    members = eina_hash_find(_edje_text_class_member_hash, text_class);
    it = eina_hash_iterator_data_new(members);
@@ -1312,12 +1319,9 @@ _edje_object_part_text_raw_set(Edje *ed, Evas_Object *obj, Edje_Real_Part *rp, c
      _edje_entry_text_markup_set(rp, text);
    else
      if (text) rp->typedata.text->text = eina_stringshare_add(text);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
    ed->recalc_hints = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_invalidate(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -1350,11 +1354,8 @@ _edje_object_part_text_raw_append(Edje *ed, Evas_Object *obj, Edje_Real_Part *rp
              eina_stringshare_replace(&rp->typedata.text->text, text);
           }
      }
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = 1;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_invalidate(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -1791,12 +1792,9 @@ _edje_object_part_text_insert(Eo *obj, Edje *ed, const char *part, const char *t
    if ((rp->part->type != EDJE_PART_TYPE_TEXTBLOCK)) return;
    if (rp->part->entry_mode <= EDJE_ENTRY_EDIT_MODE_NONE) return;
    _edje_entry_text_markup_insert(rp, text);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
    ed->recalc_hints = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_invalidate(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -1812,12 +1810,9 @@ _edje_object_part_text_append(Eo *obj, Edje *ed, const char *part, const char *t
    if (!rp) return;
    if ((rp->part->type != EDJE_PART_TYPE_TEXTBLOCK)) return;
    _edje_object_part_text_raw_append(ed, obj, rp, part, text);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
    ed->recalc_hints = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_invalidate(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -127,6 +127,8 @@ struct _Emile_Image
 
    Emile_Colorspace      cspace;
 
+   Emile_Image_Parallel_Run_Cb parallel_run;
+
    Eina_Bool             bin_source : 1;
 
    /* TGV option */
@@ -381,6 +383,226 @@ _tgv_length_get(const unsigned char *m,
    return r;
 }
 
+typedef struct _Emile_Tgv_Block Emile_Tgv_Block;
+struct _Emile_Tgv_Block
+{
+   const unsigned char *data;
+   unsigned int length;
+   unsigned int x, y;
+};
+
+typedef struct _Emile_Tgv_Decode Emile_Tgv_Decode;
+struct _Emile_Tgv_Decode
+{
+   Emile_Image *image;
+   Emile_Image_Property *prop;
+   const Emile_Tgv_Block *blocks;
+   Eina_Rectangle master;
+   unsigned int *p;
+   unsigned char *p_etc;
+   unsigned int etc_width;
+   unsigned int etc_block_size;
+   int alpha_offset;
+   int plane;
+   Eina_Bool failed;
+};
+
+// Minimum number of pixels decoded by a thread at once
+#define TGV_PARALLEL_PIXELS (64 * 1024)
+
+/* Decodes one macroblock into the pixels. The expanded data goes to buffer
+ * when the file is compressed. */
+static Eina_Bool
+_emile_tgv_block_decode(Emile_Tgv_Decode *d,
+                        const Emile_Tgv_Block *b,
+                        Eina_Binbuf *buffer)
+{
+   Emile_Image *image = d->image;
+   Eina_Rectangle current;
+   Eina_Binbuf *data_start;
+   const unsigned char *it;
+   unsigned int block_count;
+   unsigned int i, j;
+
+   EINA_RECTANGLE_SET(&current,
+                      b->x, b->y,
+                      image->block.width, image->block.height);
+   if (!eina_rectangle_intersection(&current, &d->master))
+     return EINA_TRUE;
+
+   block_count = image->block.width * image->block.height / (4 * 4);
+   data_start = eina_binbuf_manage_new(b->data, b->length, EINA_TRUE);
+
+   if (image->compress)
+     {
+        if (!emile_expand(data_start, buffer, EMILE_LZ4HC))
+          {
+             eina_binbuf_free(data_start);
+             return EINA_FALSE;
+          }
+     }
+   else
+     {
+        buffer = data_start;
+        if (block_count * d->etc_block_size != b->length)
+          {
+             eina_binbuf_free(data_start);
+             return EINA_FALSE;
+          }
+     }
+   it = eina_binbuf_string_get(buffer);
+
+   for (i = 0; i < image->block.height; i += 4)
+     for (j = 0; j < image->block.width; j += 4, it += d->etc_block_size)
+       {
+          Eina_Rectangle current_etc;
+          unsigned int temporary[4 * 4];
+          unsigned int offset_x, offset_y;
+          int k, l;
+
+          EINA_RECTANGLE_SET(&current_etc, b->x + j, b->y + i, 4, 4);
+
+          if (!eina_rectangle_intersection(&current_etc, &current))
+            continue;
+
+          switch (d->prop->cspace)
+            {
+             case EMILE_COLORSPACE_ARGB8888:
+               switch (image->cspace)
+                 {
+                  case EMILE_COLORSPACE_ETC1:
+                  case EMILE_COLORSPACE_ETC1_ALPHA:
+                    if (!rg_etc1_unpack_block(it, temporary, 0))
+                      {
+                         // TODO: Should we decode as RGB8_ETC2?
+                         fprintf(stderr, "ETC1: Block starting at {%i, %i} is corrupted!\n", b->x + j, b->y + i);
+                         continue;
+                      }
+                    break;
+
+                  case EMILE_COLORSPACE_RGB8_ETC2:
+                    rg_etc2_rgb8_decode_block((uint8_t *)it, temporary);
+                    break;
+
+                  case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
+                    rg_etc2_rgba8_decode_block((uint8_t *)it, temporary);
+                    break;
+
+                  default:
+                    abort();
+                 }
+
+               offset_x = current_etc.x - b->x - j;
+               offset_y = current_etc.y - b->y - i;
+
+               if (!d->plane)
+                 {
+#ifdef BUILD_NEON
+                    if (eina_cpu_features_get() & EINA_CPU_NEON)
+                      {
+                         uint32_t *dst = &d->p[current_etc.x - d->master.x + (current_etc.y - d->master.y) * d->master.w];
+                         uint32_t *src = &temporary[offset_x + offset_y * 4];
+                         for (k = 0; k < current_etc.h; k++)
+                           {
+                              if (current_etc.w == 4)
+                                vst1q_u32(dst, vld1q_u32(src));
+                              else if (current_etc.w == 3)
+                                {
+                                   vst1_u32(dst, vld1_u32(src));
+                                   *(dst + 2) = *(src + 2);
+                                }
+                              else if (current_etc.w == 2)
+                                vst1_u32(dst, vld1_u32(src));
+                              else
+                                *dst = *src;
+                              dst += d->master.w;
+                              src += 4;
+                           }
+                      }
+                    else
+#endif
+                    for (k = 0; k < current_etc.h; k++)
+                      {
+                         memcpy(&d->p[current_etc.x - d->master.x + (current_etc.y - d->master.y + k) * d->master.w],
+                                &temporary[offset_x + (offset_y + k) * 4],
+                                current_etc.w * sizeof(unsigned int));
+                      }
+                 }
+               else
+                 {
+                    for (k = 0; k < current_etc.h; k++)
+                      for (l = 0; l < current_etc.w; l++)
+                        {
+                           unsigned int *rgbdata = &d->p[current_etc.x - d->master.x + (current_etc.y - d->master.y + k) * d->master.w + l];
+                           unsigned int *adata = &temporary[offset_x + (offset_y + k) * 4 + l];
+                           A_VAL(rgbdata) = G_VAL(adata);
+                        }
+                 }
+               break;
+
+             case EMILE_COLORSPACE_ETC1:
+             case EMILE_COLORSPACE_RGB8_ETC2:
+             case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
+               memcpy(&d->p_etc[(current_etc.x / 4) * d->etc_block_size + (current_etc.y / 4) * d->etc_width],
+                      it,
+                      d->etc_block_size);
+               break;
+
+             case EMILE_COLORSPACE_ETC1_ALPHA:
+               memcpy(&d->p_etc[(current_etc.x / 4) * d->etc_block_size + (current_etc.y / 4) * d->etc_width + d->plane * d->alpha_offset],
+                      it,
+                      d->etc_block_size);
+               break;
+
+             default:
+               abort();
+            }
+       } /* bx,by inside blocks */
+
+   eina_binbuf_free(data_start);
+   return EINA_TRUE;
+}
+
+static void
+_emile_tgv_blocks_decode(void *data, int start, int end)
+{
+   Emile_Tgv_Decode *d = data;
+   Eina_Binbuf *buffer = NULL;
+   unsigned int size;
+   int i;
+
+   /* Each thread expands the blocks in its own buffer. It is on the heap,
+    * worker threads have small stacks. */
+   if (d->image->compress)
+     {
+        unsigned char *expand;
+
+        size = d->etc_block_size *
+          d->image->block.width * d->image->block.height / (4 * 4);
+        expand = calloc(1, size);
+        if (!expand)
+          {
+             d->failed = EINA_TRUE;
+             return;
+          }
+        buffer = eina_binbuf_manage_new(expand, size, EINA_FALSE);
+        if (!buffer)
+          {
+             free(expand);
+             d->failed = EINA_TRUE;
+             return;
+          }
+     }
+
+   for (i = start; (i < end) && (!d->failed); i++)
+     {
+        if (!_emile_tgv_block_decode(d, &d->blocks[i], buffer))
+          d->failed = EINA_TRUE;
+     }
+
+   if (buffer) eina_binbuf_free(buffer);
+}
+
 static Eina_Bool
 _emile_tgv_data(Emile_Image *image,
                 Emile_Image_Property *prop,
@@ -389,17 +611,14 @@ _emile_tgv_data(Emile_Image *image,
                 Emile_Image_Load_Error *error)
 {
    const unsigned char *m;
-   unsigned int *p = pixels;
-   unsigned char *p_etc = pixels;
-   Eina_Binbuf *buffer = NULL;
-   Eina_Rectangle master;
+   Emile_Tgv_Decode d;
+   Emile_Tgv_Block *blocks;
    unsigned int block_length;
    unsigned int length, offset;
    unsigned int x, y;
-   unsigned int block_count;
-   unsigned int etc_width = 0;
-   unsigned int etc_block_size;
-   int num_planes = 1, plane, alpha_offset = 0;
+   unsigned int count, min_chunk;
+   unsigned int plane_start[3];
+   int num_planes = 1, plane;
    Eina_Bool r = EINA_FALSE;
 
    m = _emile_image_file_source_map(image, &length);
@@ -416,8 +635,14 @@ _emile_tgv_data(Emile_Image *image,
 
    *error = EMILE_IMAGE_LOAD_ERROR_CORRUPT_FILE;
 
+   memset(&d, 0, sizeof (d));
+   d.image = image;
+   d.prop = prop;
+   d.p = pixels;
+   d.p_etc = pixels;
+
    /* By definition, prop{.w, .h} == region{.w, .h} */
-   EINA_RECTANGLE_SET(&master,
+   EINA_RECTANGLE_SET(&d.master,
                       image->region.x, image->region.y,
                       prop->w, prop->h);
 
@@ -425,23 +650,23 @@ _emile_tgv_data(Emile_Image *image,
      {
       case EMILE_COLORSPACE_ETC1:
       case EMILE_COLORSPACE_RGB8_ETC2:
-        etc_block_size = 8;
+        d.etc_block_size = 8;
         break;
 
       case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
-        etc_block_size = 16;
+        d.etc_block_size = 16;
         break;
 
       case EMILE_COLORSPACE_ETC1_ALPHA:
-        etc_block_size = 8;
+        d.etc_block_size = 8;
         num_planes = 2;
-        alpha_offset = ((prop->w + 2 + 3) / 4) * ((prop->h + 2 + 3) / 4) * 8 / sizeof(*p_etc);
+        d.alpha_offset = ((prop->w + 2 + 3) / 4) * ((prop->h + 2 + 3) / 4) * 8 / sizeof(*d.p_etc);
         break;
 
       default:
         abort();
      }
-   etc_width = ((prop->w + 2 + 3) / 4) * etc_block_size;
+   d.etc_width = ((prop->w + 2 + 3) / 4) * d.etc_block_size;
 
    switch (prop->cspace)
      {
@@ -449,15 +674,15 @@ _emile_tgv_data(Emile_Image *image,
       case EMILE_COLORSPACE_RGB8_ETC2:
       case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
       case EMILE_COLORSPACE_ETC1_ALPHA:
-        if (master.x % 4 || master.y % 4)
+        if (d.master.x % 4 || d.master.y % 4)
           // FIXME: Should we really abort here ? Seems like a late check for me
           abort();
         break;
 
       case EMILE_COLORSPACE_ARGB8888:
         /* Offset to take duplicated pixels into account */
-        master.x += 1;
-        master.y += 1;
+        d.master.x += 1;
+        d.master.y += 1;
         break;
 
       default:
@@ -476,173 +701,64 @@ _emile_tgv_data(Emile_Image *image,
         /* else: ETC2 is compatible with ETC1 and is preferred */
      }
 
-   /* Allocate space for each ETC block (8 or 16 bytes per 4 * 4 pixels group) */
-   block_count = image->block.width * image->block.height / (4 * 4);
-   if (image->compress)
-     buffer = eina_binbuf_manage_new(alloca(etc_block_size * block_count),
-                                     etc_block_size * block_count,
-                                     EINA_TRUE);
+   /* The macroblocks are stored one after the other, each prefixed by its
+    * length: find the ones inside the region first, then decode them. */
+   count = num_planes *
+     ((image->size.width + 2 + image->block.width - 1) / image->block.width) *
+     ((image->size.height + 2 + image->block.height - 1) / image->block.height);
+   blocks = malloc(count * sizeof (Emile_Tgv_Block));
+   if (!blocks)
+     {
+        *error = EMILE_IMAGE_LOAD_ERROR_RESOURCE_ALLOCATION_FAILED;
+        return EINA_FALSE;
+     }
 
+   count = 0;
    for (plane = 0; plane < num_planes; plane++)
-     for (y = 0; y < image->size.height + 2; y += image->block.height)
-       for (x = 0; x < image->size.width + 2; x += image->block.width)
-         {
-            Eina_Rectangle current;
-            Eina_Binbuf *data_start;
-            const unsigned char *it;
-            unsigned int i, j;
-
-            block_length = _tgv_length_get(m + offset, length, &offset);
-
-            if (block_length == 0)
-              {
-                 *error = EMILE_IMAGE_LOAD_ERROR_CORRUPT_FILE;
-                 goto on_error;
-              }
-
-            data_start = eina_binbuf_manage_new(m + offset,
-                                                block_length,
-                                                EINA_TRUE);
-            offset += block_length;
-
-            EINA_RECTANGLE_SET(&current,
-                               x, y,
-                               image->block.width, image->block.height);
-
-            if (!eina_rectangle_intersection(&current, &master))
-              {
-                 eina_binbuf_free(data_start);
-                 continue;
-              }
-
-            if (image->compress)
-              {
-                 if (!emile_expand(data_start, buffer, EMILE_LZ4HC))
-                   {
-                      eina_binbuf_free(data_start);
-                      goto on_error;
-                   }
-              }
-            else
-              {
-                 buffer = data_start;
-                 if (block_count * etc_block_size != block_length)
-                   {
-                      eina_binbuf_free(data_start);
-                      goto on_error;
-                   }
-              }
-            it = eina_binbuf_string_get(buffer);
-
-            for (i = 0; i < image->block.height; i += 4)
-              for (j = 0; j < image->block.width; j += 4, it += etc_block_size)
-                {
-                   Eina_Rectangle current_etc;
-                   unsigned int temporary[4 * 4];
-                   unsigned int offset_x, offset_y;
-                   int k, l;
-
-                   EINA_RECTANGLE_SET(&current_etc, x + j, y + i, 4, 4);
-
-                   if (!eina_rectangle_intersection(&current_etc, &current))
-                     continue;
-
-                   switch (prop->cspace)
-                     {
-                      case EMILE_COLORSPACE_ARGB8888:
-                        switch (image->cspace)
-                          {
-                           case EMILE_COLORSPACE_ETC1:
-                           case EMILE_COLORSPACE_ETC1_ALPHA:
-                             if (!rg_etc1_unpack_block(it, temporary, 0))
-                               {
-                                  // TODO: Should we decode as RGB8_ETC2?
-                                  fprintf(stderr, "ETC1: Block starting at {%i, %i} is corrupted!\n", x + j, y + i);
-                                  continue;
-                               }
-                             break;
-
-                           case EMILE_COLORSPACE_RGB8_ETC2:
-                             rg_etc2_rgb8_decode_block((uint8_t *)it, temporary);
-                             break;
-
-                           case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
-                             rg_etc2_rgba8_decode_block((uint8_t *)it, temporary);
-                             break;
-
-                           default:
-                             abort();
-                          }
-
-                        offset_x = current_etc.x - x - j;
-                        offset_y = current_etc.y - y - i;
-
-                        if (!plane)
-                          {
-#ifdef BUILD_NEON
-                             if (eina_cpu_features_get() & EINA_CPU_NEON)
-                               {
-                                  uint32_t *dst = &p[current_etc.x - 1 + (current_etc.y - 1) * master.w];
-                                  uint32_t *src = &temporary[offset_x + offset_y * 4];
-                                  for (k = 0; k < current_etc.h; k++)
-                                    {
-                                       if (current_etc.w == 4)
-                                         vst1q_u32(dst, vld1q_u32(src));
-                                       else if (current_etc.w == 3)
-                                         {
-                                            vst1_u32(dst, vld1_u32(src));
-                                            *(dst + 2) = *(src + 2);
-                                         }
-                                       else if (current_etc.w == 2)
-                                         vst1_u32(dst, vld1_u32(src));
-                                       else
-                                         *dst = *src;
-                                       dst += master.w;
-                                       src += 4;
-                                    }
-                               }
-                             else
-#endif
-                             for (k = 0; k < current_etc.h; k++)
-                               {
-                                  memcpy(&p[current_etc.x - 1 + (current_etc.y - 1 + k) * master.w],
-                                         &temporary[offset_x + (offset_y + k) * 4],
-                                         current_etc.w * sizeof(unsigned int));
-                               }
-                          }
-                        else
-                          {
-                             for (k = 0; k < current_etc.h; k++)
-                               for (l = 0; l < current_etc.w; l++)
-                                 {
-                                    unsigned int *rgbdata = &p[current_etc.x - 1 + (current_etc.y - 1 + k) * master.w + l];
-                                    unsigned int *adata = &temporary[offset_x + (offset_y + k) * 4 + l];
-                                    A_VAL(rgbdata) = G_VAL(adata);
-                                 }
-                          }
-                        break;
-
-                      case EMILE_COLORSPACE_ETC1:
-                      case EMILE_COLORSPACE_RGB8_ETC2:
-                      case EMILE_COLORSPACE_RGBA8_ETC2_EAC:
-                        memcpy(&p_etc[(current_etc.x / 4) * etc_block_size + (current_etc.y / 4) * etc_width],
-                               it,
-                               etc_block_size);
-                        break;
-
-                      case EMILE_COLORSPACE_ETC1_ALPHA:
-                        memcpy(&p_etc[(current_etc.x / 4) * etc_block_size + (current_etc.y / 4) * etc_width + plane * alpha_offset],
-                               it,
-                               etc_block_size);
-                        break;
-
-                      default:
-                        abort();
-                     }
-                } /* bx,by inside blocks */
-
-            eina_binbuf_free(data_start);
-         } /* x,y macroblocks */
+     {
+        plane_start[plane] = count;
+        for (y = 0; y < image->size.height + 2; y += image->block.height)
+          for (x = 0; x < image->size.width + 2; x += image->block.width)
+            {
+               Eina_Rectangle current;
+
+               block_length = _tgv_length_get(m + offset, length, &offset);
+
+               if ((block_length == 0) || (block_length > length - offset))
+                 {
+                    *error = EMILE_IMAGE_LOAD_ERROR_CORRUPT_FILE;
+                    goto on_error;
+                 }
+
+               EINA_RECTANGLE_SET(&current,
+                                  x, y,
+                                  image->block.width, image->block.height);
+               if (eina_rectangle_intersection(&current, &d.master))
+                 {
+                    blocks[count].data = m + offset;
+                    blocks[count].length = block_length;
+                    blocks[count].x = x;
+                    blocks[count].y = y;
+                    count++;
+                 }
+               offset += block_length;
+            }
+     }
+   plane_start[num_planes] = count;
+
+   /* The alpha plane is only merged once the color plane is done */
+   min_chunk = 1 + TGV_PARALLEL_PIXELS / (image->block.width * image->block.height);
+   for (plane = 0; (plane < num_planes) && (!d.failed); plane++)
+     {
+        d.plane = plane;
+        d.blocks = blocks + plane_start[plane];
+        count = plane_start[plane + 1] - plane_start[plane];
+        if (image->parallel_run)
+          image->parallel_run(count, min_chunk, _emile_tgv_blocks_decode, &d);
+        else
+          _emile_tgv_blocks_decode(&d, 0, count);
+     }
+   if (d.failed) goto on_error;
 
    // TODO: Add support for more unpremultiplied modes (ETC2)
    if (prop->cspace == EMILE_COLORSPACE_ARGB8888)
@@ -652,7 +768,7 @@ _emile_tgv_data(Emile_Image *image,
    r = EINA_TRUE;
 
 on_error:
-   if (image->compress) eina_binbuf_free(buffer);
+   free(blocks);
    return r;
 }
 
@@ -2384,6 +2500,15 @@ emile_image_jpeg_file_open(Eina_File *source,
    return _emile_image_bind(ei, opts, animated, error);
 }
 
+EAPI void
+emile_image_parallel_set(Emile_Image *image, Emile_Image_Parallel_Run_Cb run)
+{
+   if (!image)
+     return;
+
+   image->parallel_run = run;
+}
+
 EAPI void
 emile_image_close(Emile_Image *image)
 {
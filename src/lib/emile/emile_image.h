@@ -151,6 +151,26 @@ typedef struct _Emile_Image_Animated Emile_Image_Animated;
  */
 typedef struct _Emile_Image_Property Emile_Image_Property;
 
+/**
+ * @typedef Emile_Image_Parallel_Cb
+ *
+ * Function processing the [start, end) part of a job split over threads.
+ *
+ * @since 1.15
+ */
+typedef void (*Emile_Image_Parallel_Cb)(void *data, int start, int end);
+
+/**
+ * @typedef Emile_Image_Parallel_Run_Cb
+ *
+ * Function calling cb over the whole [0, count) range, in parts of at
+ * least min_chunk items that can run on different threads, and returning
+ * once all of them are done.
+ *
+ * @since 1.15
+ */
+typedef void (*Emile_Image_Parallel_Run_Cb)(int count, int min_chunk, Emile_Image_Parallel_Cb cb, void *data);
+
 struct _Emile_Image_Property
 {
   struct
@@ -295,6 +315,20 @@ EAPI Eina_Bool emile_image_head(Emile_Image * image, Emile_Image_Property * prop
  */
 EAPI Eina_Bool emile_image_data(Emile_Image * image, Emile_Image_Property * prop, unsigned int property_size, void *pixels, Emile_Image_Load_Error * error);
 
+/**
+ * Let the decoding of an image be split over several threads.
+ *
+ * Formats made of independently compressed parts (only TGV for now) are
+ * then decoded in parallel by emile_image_data(). Other formats ignore it.
+ *
+ * @param image The handler to decode in parallel.
+ * @param run The function running parts of the decoding on other threads,
+ * or @c NULL to decode on the calling thread only (the default).
+ *
+ * @since 1.15
+ */
+EAPI void emile_image_parallel_set(Emile_Image * image, Emile_Image_Parallel_Run_Cb run);
+
 /**
  * Close an opened image handler.
  *
@@ -639,6 +639,18 @@ typedef enum _Evas_Image_Content_Hint
    EVAS_IMAGE_CONTENT_HINT_STATIC = 2 /**< The contents won't change over time */
 } Evas_Image_Content_Hint; /**< How an image's data is to be treated by Evas, for optimization */
 
+/**
+ * Priorities of image preloads, see evas_object_image_preload_priority_set().
+ * Queued preloads of a more urgent priority always run first.
+ * @since 1.15
+ */
+typedef enum _Evas_Image_Preload_Priority
+{
+   EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE = 0, /**< The image is on screen (default) */
+   EVAS_IMAGE_PRELOAD_PRIORITY_NEAR_VISIBLE = 1, /**< The image is about to be scrolled into view */
+   EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE = 2 /**< The image may be needed later on */
+} Evas_Image_Preload_Priority; /**< How urgently an image preload is needed */
+
 /**
  * Possible orientation options for evas_object_image_orient_set().
  * @brief Types of orientation available
@@ -197,6 +197,29 @@ struct _Evas_Image_Load_Func
 EAPI Eina_Bool    evas_module_register   (const Evas_Module_Api *module, Evas_Module_Type type);
 EAPI Eina_Bool    evas_module_unregister (const Evas_Module_Api *module, Evas_Module_Type type);
 
+/**
+ * Runs @p cb over [0, @p count) in slices of at least @p min_chunk items,
+ * spread over the evas worker threads. Returns once every slice is done.
+ * Meant for loaders decoding independent parts of one image, the slices
+ * must not depend on each other.
+ *
+ * The pool is sized on first use from the EVAS_WORKER_THREADS environment
+ * variable, counting the calling thread, and defaults to the number of
+ * cores. With EVAS_WORKER_THREADS=1 @p cb is called once over the whole
+ * range from the calling thread.
+ * @since 1.15
+ */
+EAPI void         evas_loader_parallel_run (int count, int min_chunk, void (*cb) (void *data, int start, int end), void *data);
+
+/**
+ * Gives the part of a @p w x @p h image that @p opts asks to load.
+ * @p scale is set to the scale down factor and @p region to the load
+ * region, in the coordinates of the scaled down image and clipped to it.
+ * Returns EINA_FALSE when there is nothing left to load.
+ * @since 1.15
+ */
+EAPI Eina_Bool    evas_loader_region_get (const Evas_Image_Load_Opts *opts, int w, int h, int *scale, Eina_Rectangle *region);
+
 #define EVAS_MODULE_DEFINE(Type, Tn, Name)		\
   Eina_Bool evas_##Tn##_##Name##_init(void)		\
   {							\
@@ -3,6 +3,8 @@
 
 typedef struct _Evas_Cache_Image                Evas_Cache_Image;
 typedef struct _Evas_Cache_Image_Func           Evas_Cache_Image_Func;
+typedef struct _Evas_Cache_Image_Tag            Evas_Cache_Image_Tag;
+typedef struct _Evas_Cache_Image_Stats          Evas_Cache_Image_Stats;
 typedef struct _Evas_Cache_Engine_Image         Evas_Cache_Engine_Image;
 typedef struct _Evas_Cache_Engine_Image_Func    Evas_Cache_Engine_Image_Func;
 
@@ -40,6 +42,28 @@ struct _Evas_Cache_Image_Func
    void         (*debug)(const char *context, Image_Entry *im);
 };
 
+/* Inactive images sharing a tag, and the bytes they may use. Images are
+ * prepended on use, so the oldest is the last of the lru. */
+struct _Evas_Cache_Image_Tag
+{
+   EINA_INLIST;
+
+   Eina_Inlist                  *lru;
+
+   unsigned int                  tag;
+   int                           usage;
+   unsigned int                  limit;
+};
+
+struct _Evas_Cache_Image_Stats
+{
+   unsigned int                  hits;
+   unsigned int                  misses;
+   unsigned int                  evictions;
+   unsigned int                  demotions;
+   unsigned long long            evicted; /* bytes */
+};
+
 struct _Evas_Cache_Image
 {
    Evas_Cache_Image_Func         func;
@@ -49,7 +73,8 @@ struct _Evas_Cache_Image
 
    Eina_Inlist                  *dirty;
 
-   Eina_Inlist                  *lru;
+   Eina_Inlist                  *tags; /* the first one is tag 0 */
+   Eina_Inlist                  *lru_headers;
    Eina_Inlist                  *lru_nodata;
    Eina_Hash                    *inactiv;
    Eina_Hash                    *activ;
@@ -61,7 +86,12 @@ struct _Evas_Cache_Image
 
    int                           usage;
    unsigned int                  limit;
+   int                           headers_usage;
+   unsigned int                  headers_limit;
+   unsigned int                  lru_clock;
    int                           references;
+
+   Evas_Cache_Image_Stats        stats;
 };
 
 struct _Evas_Cache_Engine_Image_Func
@@ -128,6 +158,14 @@ EAPI void*                    evas_cache_private_from_image_entry_get(Image_Entr
 EAPI int                      evas_cache_image_usage_get(Evas_Cache_Image *cache);
 EAPI int                      evas_cache_image_get(Evas_Cache_Image *cache);
 EAPI void                     evas_cache_image_set(Evas_Cache_Image *cache, unsigned int size);
+EAPI int                      evas_cache_image_headers_get(Evas_Cache_Image *cache);
+EAPI void                     evas_cache_image_headers_set(Evas_Cache_Image *cache, unsigned int size);
+EAPI int                      evas_cache_image_tag_limit_get(Evas_Cache_Image *cache, unsigned int tag);
+EAPI void                     evas_cache_image_tag_limit_set(Evas_Cache_Image *cache, unsigned int tag, unsigned int size);
+EAPI void                     evas_cache_image_tag_set(Image_Entry *im, unsigned int tag);
+EAPI void                     evas_cache_image_pin(Image_Entry *im);
+EAPI void                     evas_cache_image_unpin(Image_Entry *im);
+EAPI void                     evas_cache_image_stats_get(Evas_Cache_Image *cache, Evas_Cache_Image_Stats *stats);
 
 EAPI Image_Entry*             evas_cache_image_alone(Image_Entry *im);
 EAPI Image_Entry*             evas_cache_image_dirty(Image_Entry *im, unsigned int x, unsigned int y, unsigned int w, unsigned int h);
@@ -166,6 +204,7 @@ EAPI void                     evas_cache_engine_image_load_data(Engine_Image_Ent
 EAPI void                     evas_cache_image_preload_data(Image_Entry *im, const Eo *target,
 							    Evas_Engine_Thread_Task_Cb func, const void *engine_data, const void *custom_data);
 EAPI void                     evas_cache_image_preload_cancel(Image_Entry *im, const Eo *target);
+EAPI void                     evas_cache_image_preload_priority_set(Image_Entry *im, const Eo *target, Evas_Image_Preload_Priority priority);
 
 EAPI void                     evas_cache_image_wakeup(void);
 
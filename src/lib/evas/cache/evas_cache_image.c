@@ -109,42 +109,68 @@ _evas_cache_image_activ_del(Image_Entry *im)
 static void
 _evas_cache_image_lru_add(Image_Entry *im)
 {
+   Evas_Cache_Image *cache = im->cache;
+   Evas_Cache_Image_Tag *tag;
+
    if (im->flags.lru) return;
    _evas_cache_image_dirty_del(im);
    _evas_cache_image_activ_del(im);
-   _evas_cache_image_lru_nodata_del(im); 
+   _evas_cache_image_lru_nodata_del(im);
    if (!im->cache_key) return;
    im->flags.lru = 1;
    im->flags.cached = 1;
    if (im->flags.given_mmap)
      {
-        eina_hash_direct_add(im->cache->mmap_inactiv, im->cache_key, im);
+        eina_hash_direct_add(cache->mmap_inactiv, im->cache_key, im);
      }
    else
      {
-        eina_hash_direct_add(im->cache->inactiv, im->cache_key, im);
+        eina_hash_direct_add(cache->inactiv, im->cache_key, im);
      }
-   im->cache->lru = eina_inlist_prepend(im->cache->lru, EINA_INLIST_GET(im));
-   im->cache->usage += im->cache->func.mem_size_get(im);
+
+   /* Remember what was charged, the size changes as data come and go */
+   tag = im->cache_tag ? im->cache_tag : (Evas_Cache_Image_Tag *)cache->tags;
+   im->cache_tag = tag;
+   im->cache_usage = cache->func.mem_size_get(im);
+   im->lru_stamp = cache->lru_clock++;
+   tag->usage += im->cache_usage;
+   cache->usage += im->cache_usage;
+   tag->lru = eina_inlist_prepend(tag->lru, EINA_INLIST_GET(im));
 }
 
 static void
 _evas_cache_image_lru_del(Image_Entry *im)
 {
+   Evas_Cache_Image *cache = im->cache;
+
    if (!im->flags.lru) return;
    if (!im->cache_key) return;
    im->flags.lru = 0;
    im->flags.cached = 0;
    if (im->flags.given_mmap)
      {
-        eina_hash_del(im->cache->mmap_inactiv, im->cache_key, im);
+        eina_hash_del(cache->mmap_inactiv, im->cache_key, im);
      }
    else
      {
-        eina_hash_del(im->cache->inactiv, im->cache_key, im);
+        eina_hash_del(cache->inactiv, im->cache_key, im);
      }
-   im->cache->lru = eina_inlist_remove(im->cache->lru, EINA_INLIST_GET(im));
-   im->cache->usage -= im->cache->func.mem_size_get(im);
+
+   if (im->flags.lru_headers)
+     {
+        im->flags.lru_headers = 0;
+        cache->lru_headers = eina_inlist_remove(cache->lru_headers,
+                                                EINA_INLIST_GET(im));
+        cache->headers_usage -= im->cache_usage;
+     }
+   else
+     {
+        im->cache_tag->lru = eina_inlist_remove(im->cache_tag->lru,
+                                                EINA_INLIST_GET(im));
+        im->cache_tag->usage -= im->cache_usage;
+     }
+   cache->usage -= im->cache_usage;
+   im->cache_usage = 0;
 }
 
 static void
@@ -152,10 +178,9 @@ _evas_cache_image_lru_nodata_add(Image_Entry *im)
 {
    if (im->flags.lru_nodata) return;
    _evas_cache_image_dirty_del(im);
-   _evas_cache_image_activ_del(im);
    _evas_cache_image_lru_del(im);
-   im->flags.lru = 1;
-   im->flags.cached = 1;
+   /* Still active, only its pixels can go away under memory pressure */
+   im->flags.lru_nodata = 1;
    im->cache->lru_nodata = eina_inlist_prepend(im->cache->lru_nodata, EINA_INLIST_GET(im));
 }
 
@@ -163,8 +188,7 @@ static void
 _evas_cache_image_lru_nodata_del(Image_Entry *im)
 {
    if (!im->flags.lru_nodata) return;
-   im->flags.lru = 0;
-   im->flags.cached = 0;
+   im->flags.lru_nodata = 0;
    im->cache->lru_nodata = eina_inlist_remove(im->cache->lru_nodata, EINA_INLIST_GET(im));
 }
 
@@ -424,6 +448,20 @@ _evas_cache_image_async_cancel(void *data)
    if (cache) evas_cache_image_flush(cache);
 }
 
+// the most urgent priority asked by the targets of an image entry
+static Evas_Image_Preload_Priority
+_evas_cache_image_entry_preload_priority(const Image_Entry *ie)
+{
+   Evas_Image_Preload_Priority priority = EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE;
+   Evas_Cache_Target *tg;
+
+   EINA_INLIST_FOREACH(ie->targets, tg)
+     {
+        if (tg->priority < priority) priority = tg->priority;
+     }
+   return priority;
+}
+
 // note - preload_add assumes a target is ONLY added ONCE to the image
 // entry. make sure you only add once, or remove first, then add
 static int
@@ -438,6 +476,10 @@ _evas_cache_image_entry_preload_add(Image_Entry *ie, const Eo *target,
    tg = malloc(sizeof (Evas_Cache_Target));
    if (!tg) return 0;
    tg->target = target;
+   if (target)
+     tg->priority = _evas_object_image_preload_priority_get(target);
+   else
+     tg->priority = EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE;
 
    if (func == NULL && engine_data == NULL && custom_data == NULL)
      {
@@ -466,11 +508,15 @@ _evas_cache_image_entry_preload_add(Image_Entry *ie, const Eo *target,
      {
         ie->cache->preload = eina_list_append(ie->cache->preload, ie);
         ie->flags.pending = 0;
-        ie->preload = evas_preload_thread_run(_evas_cache_image_async_heavy,
-                                              _evas_cache_image_async_end,
-                                              _evas_cache_image_async_cancel,
-                                              ie);
+        ie->preload = evas_preload_thread_priority_run(_evas_cache_image_entry_preload_priority(ie),
+                                                       _evas_cache_image_async_heavy,
+                                                       _evas_cache_image_async_end,
+                                                       _evas_cache_image_async_cancel,
+                                                       ie);
      }
+   else if (!ie->flags.pending)
+     evas_preload_thread_priority_set(ie->preload,
+                                      _evas_cache_image_entry_preload_priority(ie));
    return 1;
 }
 
@@ -531,6 +577,9 @@ _evas_cache_image_entry_preload_remove(Image_Entry *ie, const Eo *target)
         ie->flags.pending = 1;
         evas_preload_thread_cancel(ie->preload);
      }
+   else if ((ie->targets) && (ie->preload) && (!ie->flags.pending))
+     evas_preload_thread_priority_set(ie->preload,
+                                      _evas_cache_image_entry_preload_priority(ie));
 }
 
 EAPI int
@@ -556,6 +605,109 @@ evas_cache_image_set(Evas_Cache_Image *cache, unsigned int limit)
    evas_cache_image_flush(cache);
 }
 
+static Evas_Cache_Image_Tag *
+_evas_cache_image_tag_get(Evas_Cache_Image *cache, unsigned int id)
+{
+   Evas_Cache_Image_Tag *tag;
+
+   // There are only a handful of tags, so a list does
+   EINA_INLIST_FOREACH(cache->tags, tag)
+     if (tag->tag == id) return tag;
+
+   tag = calloc(1, sizeof (Evas_Cache_Image_Tag));
+   if (!tag) return NULL;
+   tag->tag = id;
+   tag->limit = (unsigned int)-1;
+   cache->tags = eina_inlist_append(cache->tags, EINA_INLIST_GET(tag));
+   return tag;
+}
+
+EAPI int
+evas_cache_image_headers_get(Evas_Cache_Image *cache)
+{
+   return cache->headers_limit;
+}
+
+EAPI void
+evas_cache_image_headers_set(Evas_Cache_Image *cache, unsigned int limit)
+{
+   if (cache->headers_limit == limit) return;
+   cache->headers_limit = limit;
+   evas_cache_image_flush(cache);
+}
+
+EAPI int
+evas_cache_image_tag_limit_get(Evas_Cache_Image *cache, unsigned int id)
+{
+   Evas_Cache_Image_Tag *tag;
+
+   EINA_INLIST_FOREACH(cache->tags, tag)
+     if (tag->tag == id) return tag->limit;
+   return -1;
+}
+
+EAPI void
+evas_cache_image_tag_limit_set(Evas_Cache_Image *cache, unsigned int id, unsigned int limit)
+{
+   Evas_Cache_Image_Tag *tag;
+
+   tag = _evas_cache_image_tag_get(cache, id);
+   if ((!tag) || (tag->limit == limit)) return;
+   tag->limit = limit;
+   evas_cache_image_flush(cache);
+}
+
+EAPI void
+evas_cache_image_tag_set(Image_Entry *im, unsigned int id)
+{
+   Evas_Cache_Image_Tag *tag;
+   Eina_Bool lru;
+
+   if (!im->cache) return;
+   if ((im->cache_tag) && (im->cache_tag->tag == id)) return;
+   tag = _evas_cache_image_tag_get(im->cache, id);
+   if (!tag) return;
+
+   /* Only pixels are charged to a tag, a header stays in its own lru */
+   if (im->flags.lru_headers)
+     {
+        im->cache_tag = tag;
+        return;
+     }
+
+   lru = im->flags.lru;
+   _evas_cache_image_lru_del(im);
+   im->cache_tag = tag;
+   if (lru)
+     {
+        _evas_cache_image_lru_add(im);
+        evas_cache_image_flush(im->cache);
+     }
+}
+
+/* A pin is held along with a reference, so a pinned image is always
+ * active and only has its pixels to lose. */
+EAPI void
+evas_cache_image_pin(Image_Entry *im)
+{
+   if (!im->cache) return;
+   if (im->pins++) return;
+   _evas_cache_image_lru_nodata_del(im);
+}
+
+EAPI void
+evas_cache_image_unpin(Image_Entry *im)
+{
+   if (!im->cache) return;
+   if (im->pins > 0) im->pins--;
+}
+
+EAPI void
+evas_cache_image_stats_get(Evas_Cache_Image *cache, Evas_Cache_Image_Stats *stats)
+{
+   *stats = cache->stats;
+}
+
 EAPI Evas_Cache_Image *
 evas_cache_image_init(const Evas_Cache_Image_Func *cb)
 {
@@ -570,6 +722,11 @@ evas_cache_image_init(const Evas_Cache_Image_Func *cb)
 
    cache = calloc(1, sizeof(Evas_Cache_Image));
    if (!cache) return NULL;
+   if (!_evas_cache_image_tag_get(cache, 0))
+     {
+        free(cache);
+        return NULL;
+     }
    cache->func = *cb;
    cache->inactiv = eina_hash_string_superfast_new(NULL);
    cache->activ = eina_hash_string_superfast_new(NULL);
@@ -607,9 +764,11 @@ evas_cache_image_shutdown(Evas_Cache_Image *cache)
      }
    evas_async_events_process();
 
-   EINA_INLIST_FREE(cache->lru, im)
-     _evas_cache_image_entry_delete(cache, im);
-   EINA_INLIST_FREE(cache->lru_nodata, im)
+   /* Pinned images are in no lru, go through the hashes */
+   delete_list = NULL;
+   eina_hash_foreach(cache->inactiv, _evas_cache_image_free_cb, &delete_list);
+   eina_hash_foreach(cache->mmap_inactiv, _evas_cache_image_free_cb, &delete_list);
+   EINA_LIST_FREE(delete_list, im)
      _evas_cache_image_entry_delete(cache, im);
 
    /* This is mad, I am about to destroy image still alive, but we need to prevent leak. */
@@ -642,6 +801,13 @@ evas_cache_image_shutdown(Evas_Cache_Image *cache)
    eina_hash_free(cache->inactiv);
    eina_hash_free(cache->mmap_activ);
    eina_hash_free(cache->mmap_inactiv);
+   while (cache->tags)
+     {
+        Evas_Cache_Image_Tag *tag = (Evas_Cache_Image_Tag *)cache->tags;
+
+        cache->tags = eina_inlist_remove(cache->tags, cache->tags);
+        free(tag);
+     }
    free(cache);
 
    if (--_evas_cache_mutex_init == 0)
@@ -770,7 +936,12 @@ evas_cache_image_mmap_request(Evas_Cache_Image *cache,
 
    /* find image by key in active mmap hash */
    im = eina_hash_find(cache->mmap_activ, hkey);
-   if (im) goto on_ok;
+   if (im)
+     {
+        _evas_cache_image_lru_nodata_del(im);
+        cache->stats.hits++;
+        goto on_ok;
+     }
 
    /* find image by key in inactive/lru hash */
    im = eina_hash_find(cache->mmap_inactiv, hkey);
@@ -778,11 +949,13 @@ evas_cache_image_mmap_request(Evas_Cache_Image *cache,
      {
         _evas_cache_image_lru_del(im);
         _evas_cache_image_activ_add(im);
+        cache->stats.hits++;
         goto on_ok;
      }
 
    im = _evas_cache_image_entry_new(cache, hkey, NULL, f, NULL, key, lo, error);
    if (!im) return NULL;
+   cache->stats.misses++;
 
  on_ok:
    *error = EVAS_LOAD_ERROR_NONE;
@@ -838,7 +1011,12 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
              ok = 0;
           }
         else if (!_timestamp_compare(&(im->tstamp), &st)) ok = 0;
-        if (ok) goto on_ok;
+        if (ok)
+          {
+             _evas_cache_image_lru_nodata_del(im);
+             cache->stats.hits++;
+             goto on_ok;
+          }
         /* image we found doesn't match what's on disk (stat info wise)
          * so dirty the active cache entry so we never find it again. this
          * also implicitly guarantees that we only have 1 active copy
@@ -871,6 +1049,7 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
              /* remove from lru and make it active again */
              _evas_cache_image_lru_del(im);
              _evas_cache_image_activ_add(im);
+             cache->stats.hits++;
              goto on_ok;
           }
         /* as active cache find - if we match in lru and its invalid, dirty */
@@ -889,6 +1068,7 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
    im = _evas_cache_image_entry_new(cache, hkey, &tstamp, NULL, file, key, 
                                     lo, error);
    if (!im) goto on_stat_error;
+   cache->stats.misses++;
    if (cache->func.debug) cache->func.debug("request", im);
 
 on_ok:
@@ -938,6 +1118,8 @@ evas_cache_image_drop(Image_Entry *im)
 
    if (references == 0)
      {
+        /* Whoever pinned it let it go without saying so */
+        im->pins = 0;
         if (im->preload)
           {
              _evas_cache_image_entry_preload_remove(im, NULL);
@@ -961,6 +1143,7 @@ evas_cache_image_data_not_needed(Image_Entry *im)
    references = im->references;
    if (references > 1) return;
    if ((im->flags.dirty) || (!im->flags.need_data)) return;
+   if (im->pins) return;
    _evas_cache_image_lru_nodata_add(im);
 }
 
@@ -1224,7 +1407,6 @@ evas_cache_image_unload_all(Evas_Cache_Image *cache)
 {
    Image_Entry *im;
 
-   EINA_INLIST_FOREACH(cache->lru, im) evas_cache_image_unload_data(im);
    EINA_INLIST_FOREACH(cache->lru_nodata, im) evas_cache_image_unload_data(im);
    eina_hash_foreach(cache->activ, _evas_cache_image_unload_cb, NULL);
    eina_hash_foreach(cache->inactiv, _evas_cache_image_unload_cb, NULL);
@@ -1280,6 +1462,26 @@ evas_cache_image_preload_cancel(Image_Entry *im, const Eo *target)
    _evas_cache_image_entry_preload_remove(im, target);
 }
 
+EAPI void
+evas_cache_image_preload_priority_set(Image_Entry *im, const Eo *target,
+                                      Evas_Image_Preload_Priority priority)
+{
+   Evas_Cache_Target *tg;
+
+   if (!target) return;
+   EINA_INLIST_FOREACH(im->targets, tg)
+     {
+        if (tg->target == target)
+          {
+             tg->priority = priority;
+             break;
+          }
+     }
+   if ((im->preload) && (!im->flags.pending))
+     evas_preload_thread_priority_set(im->preload,
+                                      _evas_cache_image_entry_preload_priority(im));
+}
+
 #ifdef CACHEDUMP
 static int total = 0;
 
@@ -1306,6 +1508,7 @@ _dump_cache_active(EINA_UNUSED const Eina_Hash *hash, EINA_UNUSED const void *ke
 static void
 _dump_cache(Evas_Cache_Image *cache)
 {
+   Evas_Cache_Image_Tag *tag;
    Image_Entry *im;
 
    printf("--CACHE DUMP----------------------------------------------------\n");
@@ -1316,8 +1519,11 @@ _dump_cache(Evas_Cache_Image *cache)
    total = 0;
    EINA_INLIST_FOREACH(cache->lru_nodata, im)
       _dump_img(im, "NODATA");
-   EINA_INLIST_FOREACH(cache->lru, im)
-      _dump_img(im, "DATA  ");
+   EINA_INLIST_FOREACH(cache->lru_headers, im)
+      _dump_img(im, "HEADER");
+   EINA_INLIST_FOREACH(cache->tags, tag)
+     EINA_INLIST_FOREACH(tag->lru, im)
+       _dump_img(im, "DATA  ");
    printf("tot: %i\n"
           "usg: %i\n",
           total,
@@ -1326,26 +1532,117 @@ _dump_cache(Evas_Cache_Image *cache)
 }
 #endif
 
+/* Oldest image with pixels, whatever its tag. */
+static Image_Entry *
+_evas_cache_image_lru_oldest(Evas_Cache_Image *cache)
+{
+   Evas_Cache_Image_Tag *tag;
+   Image_Entry *oldest = NULL, *im;
+
+   EINA_INLIST_FOREACH(cache->tags, tag)
+     {
+        if (!tag->lru) continue;
+        im = (Image_Entry *)tag->lru->last;
+        // The clock wraps around
+        if ((!oldest) || ((int)(im->lru_stamp - oldest->lru_stamp) < 0))
+          oldest = im;
+     }
+   return oldest;
+}
+
+static void
+_evas_cache_image_lru_evict(Evas_Cache_Image *cache, Image_Entry *im)
+{
+   int usage = im->cache_usage;
+
+   /* Keep the header of the image around while there is room for it, so
+    * a new request does not have to open and parse the file again. */
+   if ((cache->headers_limit > 0) && (!im->preload))
+     {
+        im->cache_tag->lru = eina_inlist_remove(im->cache_tag->lru,
+                                                EINA_INLIST_GET(im));
+        im->cache_tag->usage -= usage;
+        cache->usage -= usage;
+
+        if (im->flags.loaded)
+          {
+             cache->func.surface_delete(im);
+             im->flags.loaded = 0;
+          }
+
+        im->flags.lru_headers = 1;
+        im->cache_usage = cache->func.mem_size_get(im);
+        cache->lru_headers = eina_inlist_prepend(cache->lru_headers,
+                                                 EINA_INLIST_GET(im));
+        cache->headers_usage += im->cache_usage;
+        cache->usage += im->cache_usage;
+
+        cache->stats.demotions++;
+        cache->stats.evicted += usage - im->cache_usage;
+        return;
+     }
+
+   cache->stats.evictions++;
+   cache->stats.evicted += usage;
+   _evas_cache_image_entry_delete(cache, im);
+}
+
+static void
+_evas_cache_image_headers_trim(Evas_Cache_Image *cache)
+{
+   Image_Entry *im;
+
+   while ((cache->lru_headers) &&
+          (cache->headers_limit < (unsigned int)cache->headers_usage))
+     {
+        im = (Image_Entry *)cache->lru_headers->last;
+        cache->stats.evictions++;
+        cache->stats.evicted += im->cache_usage;
+        _evas_cache_image_entry_delete(cache, im);
+     }
+}
+
 EAPI int
 evas_cache_image_flush(Evas_Cache_Image *cache)
 {
+   Evas_Cache_Image_Tag *tag;
+   Image_Entry *im;
+
 #ifdef CACHEDUMP
    _dump_cache(cache);
 #endif  
+   /* Each tag first gives back what goes over its own budget */
+   EINA_INLIST_FOREACH(cache->tags, tag)
+     {
+        while ((tag->lru) && (tag->limit < (unsigned int)tag->usage))
+          _evas_cache_image_lru_evict(cache, (Image_Entry *)tag->lru->last);
+     }
+
+   _evas_cache_image_headers_trim(cache);
+
    if (cache->limit == (unsigned int)-1) return -1;
 
-   while ((cache->lru) && (cache->limit < (unsigned int)cache->usage))
+   while (cache->limit < (unsigned int)cache->usage)
      {
-        Image_Entry *im;
+        im = _evas_cache_image_lru_oldest(cache);
+        if (!im) break;
+        _evas_cache_image_lru_evict(cache, im);
+     }
+
+   /* The images demoted just above may not fit in the headers budget */
+   _evas_cache_image_headers_trim(cache);
 
-        im = (Image_Entry *)cache->lru->last;
+   /* Headers go last, they are cheap to keep and save a file parse */
+   while ((cache->lru_headers) && (cache->limit < (unsigned int)cache->usage))
+     {
+        im = (Image_Entry *)cache->lru_headers->last;
+        cache->stats.evictions++;
+        cache->stats.evicted += im->cache_usage;
         _evas_cache_image_entry_delete(cache, im);
      }
 
    while ((cache->lru_nodata) && (cache->limit < (unsigned int)cache->usage))
      {
-        Image_Entry *im;
-
         im = (Image_Entry *) cache->lru_nodata->last;
         _evas_cache_image_lru_nodata_del(im);
         cache->func.surface_delete(im);
@@ -26,7 +26,9 @@ struct _Evas_Preload_Pthread_Worker
    _evas_preload_pthread_func func_end;
    _evas_preload_pthread_func func_cancel;
    void *data;
+   Evas_Image_Preload_Priority priority;
    Eina_Bool cancel : 1;
+   Eina_Bool queued : 1;
 };
 
 struct _Evas_Preload_Pthread_Data
@@ -34,11 +36,47 @@ struct _Evas_Preload_Pthread_Data
    Eina_Thread thread;
 };
 
+#define PRELOAD_PRIORITY_COUNT (EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE + 1)
+
 static int _threads_count = 0;
-static Evas_Preload_Pthread_Worker *_workers = NULL;
+/* One FIFO per priority, the most urgent first */
+static Evas_Preload_Pthread_Worker *_workers[PRELOAD_PRIORITY_COUNT] = { NULL };
 
 static LK(_mutex);
 
+/* Must be called with _mutex held */
+static void
+_evas_preload_work_queue(Evas_Preload_Pthread_Worker *work)
+{
+   _workers[work->priority] = (Evas_Preload_Pthread_Worker *)eina_inlist_append(EINA_INLIST_GET(_workers[work->priority]), EINA_INLIST_GET(work));
+   work->queued = EINA_TRUE;
+}
+
+/* Must be called with _mutex held */
+static void
+_evas_preload_work_unqueue(Evas_Preload_Pthread_Worker *work)
+{
+   _workers[work->priority] = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers[work->priority]), EINA_INLIST_GET(work)), Evas_Preload_Pthread_Worker);
+   work->queued = EINA_FALSE;
+}
+
+/* Must be called with _mutex held */
+static Evas_Preload_Pthread_Worker *
+_evas_preload_work_next(void)
+{
+   Evas_Preload_Pthread_Worker *work;
+   int i;
+
+   for (i = 0; i < PRELOAD_PRIORITY_COUNT; i++)
+     {
+        if (!_workers[i]) continue;
+        work = _workers[i];
+        _evas_preload_work_unqueue(work);
+        return work;
+     }
+   return NULL;
+}
+
 static void
 _evas_preload_thread_end(void *data)
 {
@@ -69,30 +107,28 @@ _evas_preload_thread_worker(void *data, Eina_Thread thread EINA_UNUSED)
 {
    Evas_Preload_Pthread_Data *pth = data;
    Evas_Preload_Pthread_Worker *work;
+   int i;
 
 on_error:
    for (;;)
      {
         LKL(_mutex);
-        if (!_workers)
-          {
-             LKU(_mutex);
-             break;
-          }
-
-        work = _workers;
-        _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers), EINA_INLIST_GET(_workers)), Evas_Preload_Pthread_Worker);
+        work = _evas_preload_work_next();
         LKU(_mutex);
+        if (!work) break;
 
         if (work->func_heavy) work->func_heavy(work->data);
         evas_async_events_put(pth, 0, work, _evas_preload_thread_done);
      }
 
    LKL(_mutex);
-   if (_workers)
+   for (i = 0; i < PRELOAD_PRIORITY_COUNT; i++)
      {
-        LKU(_mutex);
-        goto on_error;
+        if (_workers[i])
+          {
+             LKU(_mutex);
+             goto on_error;
+          }
      }
    _threads_count--;
    LKU(_mutex);
@@ -106,6 +142,7 @@ on_error:
    work->func_end = (_evas_preload_pthread_func) _evas_preload_thread_end;
    work->func_cancel = NULL;
    work->cancel = EINA_FALSE;
+   work->queued = EINA_FALSE;
 
    evas_async_events_put(pth, 0, work, _evas_preload_thread_done);
    return pth;
@@ -129,10 +166,8 @@ _evas_preload_thread_shutdown(void)
    /* Force processing of async events. */
    evas_async_events_process();
    LKL(_mutex);
-   while (_workers)
+   while ((work = _evas_preload_work_next()))
      {
-        work = _workers;
-        _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers), EINA_INLIST_GET(_workers)), Evas_Preload_Pthread_Worker);
         if (work->func_cancel) work->func_cancel(work->data);
         free(work);
      }
@@ -146,6 +181,18 @@ evas_preload_thread_run(void (*func_heavy) (void *data),
                         void (*func_end) (void *data),
                         void (*func_cancel) (void *data),
                         const void *data)
+{
+   return evas_preload_thread_priority_run(EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE,
+                                           func_heavy, func_end, func_cancel,
+                                           data);
+}
+
+Evas_Preload_Pthread *
+evas_preload_thread_priority_run(Evas_Image_Preload_Priority priority,
+                                 void (*func_heavy) (void *data),
+                                 void (*func_end) (void *data),
+                                 void (*func_cancel) (void *data),
+                                 const void *data)
 {
    Evas_Preload_Pthread_Worker *work;
    Evas_Preload_Pthread_Data *pth;
@@ -162,9 +209,12 @@ evas_preload_thread_run(void (*func_heavy) (void *data),
    work->func_cancel = func_cancel;
    work->cancel = EINA_FALSE;
    work->data = (void *)data;
+   if ((unsigned int)priority >= PRELOAD_PRIORITY_COUNT)
+     priority = EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE;
+   work->priority = priority;
 
    LKL(_mutex);
-   _workers = (Evas_Preload_Pthread_Worker *)eina_inlist_append(EINA_INLIST_GET(_workers), EINA_INLIST_GET(work));
+   _evas_preload_work_queue(work);
    if (_threads_count == _threads_max)
      {
         LKU(_mutex);
@@ -190,9 +240,9 @@ evas_preload_thread_run(void (*func_heavy) (void *data),
 
 on_error:
    LKL(_mutex);
-   if (_threads_count == 0)
+   if ((_threads_count == 0) && (work->queued))
      {
-        _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers), EINA_INLIST_GET(work)), Evas_Preload_Pthread_Worker);
+        _evas_preload_work_unqueue(work);
         LKU(_mutex);
         if (work->func_cancel) work->func_cancel(work->data);
         free(work);
@@ -208,22 +258,42 @@ evas_preload_thread_cancel(Evas_Preload_Pthread *thread)
    Evas_Preload_Pthread_Worker *work;
 
    if (!thread) return EINA_TRUE;
+   work = (Evas_Preload_Pthread_Worker *)thread;
    LKL(_mutex);
-   EINA_INLIST_FOREACH(_workers, work)
+   if (work->queued)
      {
-        if (work == (Evas_Preload_Pthread_Worker *)thread)
-          {
-             _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers), EINA_INLIST_GET(work)), Evas_Preload_Pthread_Worker);
-             LKU(_mutex);
-             if (work->func_cancel) work->func_cancel(work->data);
-             free(work);
-             return EINA_TRUE;
-          }
+        _evas_preload_work_unqueue(work);
+        LKU(_mutex);
+        if (work->func_cancel) work->func_cancel(work->data);
+        free(work);
+        return EINA_TRUE;
      }
-   LKU(_mutex);
-
    /* Delay the destruction */
-   work = (Evas_Preload_Pthread_Worker *)thread;
    work->cancel = EINA_TRUE;
+   LKU(_mutex);
    return EINA_FALSE;
 }
+
+Eina_Bool
+evas_preload_thread_priority_set(Evas_Preload_Pthread *thread,
+                                 Evas_Image_Preload_Priority priority)
+{
+   Evas_Preload_Pthread_Worker *work;
+   Eina_Bool queued;
+
+   if (!thread) return EINA_FALSE;
+   if ((unsigned int)priority >= PRELOAD_PRIORITY_COUNT)
+     priority = EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE;
+
+   work = (Evas_Preload_Pthread_Worker *)thread;
+   LKL(_mutex);
+   queued = work->queued;
+   if ((queued) && (work->priority != priority))
+     {
+        _evas_preload_work_unqueue(work);
+        work->priority = priority;
+        _evas_preload_work_queue(work);
+     }
+   LKU(_mutex);
+   return queued;
+}
@@ -3,6 +3,8 @@
 
 #define MY_CLASS EVAS_3D_MESH_CLASS
 
+static void _mesh_bvh_free(Evas_3D_Mesh_Bvh *bvh);
+
 static Evas_3D_Mesh_Frame *
 evas_3d_mesh_frame_new(Evas_3D_Mesh *mesh)
 {
@@ -127,6 +129,8 @@ _mesh_init(Evas_3D_Mesh_Data *pd)
 
    pd->color_pick_key = -1.0;
    pd->color_pick_enabled = EINA_FALSE;
+
+   pd->bvh = NULL;
 }
 
 static inline void
@@ -150,6 +154,8 @@ _mesh_fini(Evas_3D_Mesh_Data *pd)
 
    if (pd->nodes)
      eina_hash_free(pd->nodes);
+
+   _mesh_bvh_free(pd->bvh);
 }
 
 static Eina_Bool
@@ -173,6 +179,17 @@ _mesh_node_material_change_notify(const Eina_Hash *hash EINA_UNUSED, const void
 static void
 _evas_3d_mesh_evas_3d_object_change_notify(Eo *obj, Evas_3D_Mesh_Data *pd, Evas_3D_State state, Evas_3D_Object *ref EINA_UNUSED)
 {
+   if (pd->bvh)
+     {
+        if (state == EVAS_3D_STATE_MESH_VERTEX_COUNT ||
+            state == EVAS_3D_STATE_MESH_INDEX_DATA ||
+            state == EVAS_3D_STATE_MESH_VERTEX_ASSEMBLY)
+          pd->bvh->rebuild = EINA_TRUE;
+        else if (state == EVAS_3D_STATE_MESH_VERTEX_DATA ||
+                 state == EVAS_3D_STATE_MESH_FRAME)
+          pd->bvh->refit = EINA_TRUE;
+     }
+
    if (state == EVAS_3D_STATE_MESH_MATERIAL)
      {
         if (pd->nodes)
@@ -607,7 +624,7 @@ _evas_3d_mesh_frame_vertex_data_map(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd,
 }
 
 EOLIAN static void
-_evas_3d_mesh_frame_vertex_data_unmap(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd, int frame, Evas_3D_Vertex_Attrib attrib)
+_evas_3d_mesh_frame_vertex_data_unmap(Eo *obj, Evas_3D_Mesh_Data *pd, int frame, Evas_3D_Vertex_Attrib attrib)
 {
    Evas_3D_Mesh_Frame *f = evas_3d_mesh_frame_find(pd, frame);
 
@@ -624,6 +641,7 @@ _evas_3d_mesh_frame_vertex_data_unmap(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd
      }
 
    f->vertices[attrib].mapped = EINA_FALSE;
+   eo_do(obj, evas_3d_object_change(EVAS_3D_STATE_MESH_VERTEX_DATA, NULL));
 }
 
 EOLIAN static int
@@ -656,7 +674,7 @@ _evas_3d_mesh_index_data_set(Eo *obj, Evas_3D_Mesh_Data *pd, Evas_3D_Index_Forma
 }
 
 EOLIAN static void
-_evas_3d_mesh_index_data_copy_set(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd, Evas_3D_Index_Format format, int count, const void *indices)
+_evas_3d_mesh_index_data_copy_set(Eo *obj, Evas_3D_Mesh_Data *pd, Evas_3D_Index_Format format, int count, const void *indices)
 {
    int size;
 
@@ -696,6 +714,8 @@ _evas_3d_mesh_index_data_copy_set(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd, Ev
 
    if (indices)
      memcpy(pd->indices, indices, size);
+
+   eo_do(obj, evas_3d_object_change(EVAS_3D_STATE_MESH_INDEX_DATA, NULL));
 }
 
 EOLIAN static Evas_3D_Index_Format
@@ -724,7 +744,7 @@ _evas_3d_mesh_index_data_map(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd)
 }
 
 EOLIAN static void
-_evas_3d_mesh_index_data_unmap(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd)
+_evas_3d_mesh_index_data_unmap(Eo *obj, Evas_3D_Mesh_Data *pd)
 {
    if (!pd->index_mapped)
      {
@@ -733,6 +753,7 @@ _evas_3d_mesh_index_data_unmap(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd)
      }
 
    pd->index_mapped = EINA_FALSE;
+   eo_do(obj, evas_3d_object_change(EVAS_3D_STATE_MESH_INDEX_DATA, NULL));
 }
 
 EOLIAN static void
@@ -1007,6 +1028,389 @@ evas_3d_mesh_interpolate_vertex_buffer_get(Evas_3D_Mesh *mesh, int frame,
      }
 }
 
+/* Triangles per BVH leaf. */
+#define MESH_BVH_LEAF_SIZE 4
+
+static inline void
+_position_get(Evas_Vec3 *out, const Evas_3D_Vertex_Buffer *pos0, const Evas_3D_Vertex_Buffer *pos1,
+              Evas_Real weight, int index)
+{
+   if (pos1->data == NULL)
+     {
+        float *ptr;
+
+        if (pos0->stride != 0.0)
+          ptr = (float *)((char *)pos0->data + pos0->stride * index);
+        else
+          ptr = (float *)((char *)pos0->data + (3 * sizeof(float)) * index);
+
+        out->x = ptr[0];
+        out->y = ptr[1];
+        out->z = ptr[2];
+     }
+   else
+     {
+        float *ptr0, *ptr1;
+
+        if (pos0->stride != 0.0)
+          ptr0 = (float *)((char *)pos0->data + pos0->stride * index);
+        else
+          ptr0 = (float *)((char *)pos0->data + (3 * sizeof(float)) * index);
+
+        if (pos1->stride != 0.0)
+          ptr1 = (float *)((char *)pos1->data + pos1->stride * index);
+        else
+          ptr1 = (float *)((char *)pos1->data + (3 * sizeof(float)) * index);
+
+        out->x = ptr0[0] * weight + ptr1[0] * (1.0 - weight);
+        out->y = ptr0[1] * weight + ptr1[1] * (1.0 - weight);
+        out->z = ptr0[2] * weight + ptr1[2] * (1.0 - weight);
+     }
+}
+
+static inline unsigned int
+_mesh_index_get(const Evas_3D_Mesh_Data *pd, int i)
+{
+   if (!pd->indices)
+     return i;
+   if (pd->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
+     return ((unsigned short *)pd->indices)[i];
+   return ((unsigned char *)pd->indices)[i];
+}
+
+/* Triangle list of the mesh, walked the same way picking always did. Points
+ * and lines can't be picked and give no triangles. */
+static int
+_mesh_triangles_get(const Evas_3D_Mesh_Data *pd, unsigned int **triangles)
+{
+   unsigned int *tri;
+   int count, n, i;
+
+   *triangles = NULL;
+
+   if (pd->indices || pd->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_BYTE)
+     count = pd->index_count;
+   else if (pd->index_count == 0)
+     count = pd->vertex_count;
+   else
+     return 0;
+
+   if (pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES)
+     n = count / 3;
+   else if (pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_STRIP ||
+            pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_FAN)
+     n = count - 2;
+   else
+     n = 0;
+
+   if (n <= 0)
+     return 0;
+
+   tri = malloc(n * 3 * sizeof(unsigned int));
+   if (!tri)
+     {
+        ERR("Failed to allocate memory.");
+        return 0;
+     }
+
+   for (i = 0; i < n; i++)
+     {
+        unsigned int *t = tri + (i * 3);
+
+        if (pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES)
+          {
+             t[0] = _mesh_index_get(pd, i * 3);
+             t[1] = _mesh_index_get(pd, i * 3 + 1);
+             t[2] = _mesh_index_get(pd, i * 3 + 2);
+          }
+        else if (pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_STRIP)
+          {
+             t[0] = _mesh_index_get(pd, i);
+             t[1] = _mesh_index_get(pd, i + 1);
+             t[2] = _mesh_index_get(pd, i + 2);
+          }
+        else
+          {
+             t[0] = _mesh_index_get(pd, 0);
+             t[1] = _mesh_index_get(pd, i + 1);
+             t[2] = _mesh_index_get(pd, i + 2);
+          }
+     }
+
+   *triangles = tri;
+   return n;
+}
+
+/* Interpolated vertex positions at the given frame, for every vertex the
+ * triangles refer to. */
+static Eina_Bool
+_mesh_bvh_positions_update(Evas_3D_Mesh *mesh, Evas_3D_Mesh_Bvh *bvh, int frame)
+{
+   Evas_3D_Vertex_Buffer pos0, pos1;
+   Evas_Real weight;
+   int i;
+
+   memset(&pos0, 0x00, sizeof(Evas_3D_Vertex_Buffer));
+   memset(&pos1, 0x00, sizeof(Evas_3D_Vertex_Buffer));
+
+   evas_3d_mesh_interpolate_vertex_buffer_get(mesh, frame, EVAS_3D_VERTEX_POSITION,
+                                              &pos0, &pos1, &weight);
+   if (!pos0.data)
+     return EINA_FALSE;
+
+   for (i = 0; i < bvh->position_count; i++)
+     _position_get(&bvh->positions[i], &pos0, &pos1, weight, i);
+
+   bvh->frame = frame;
+   return EINA_TRUE;
+}
+
+static inline void
+_mesh_bvh_triangle_box(const Evas_3D_Mesh_Bvh *bvh, int i, Evas_Box3 *box)
+{
+   const unsigned int *t = bvh->triangles + (i * 3);
+   const Evas_Vec3 *p0 = &bvh->positions[t[0]];
+   const Evas_Vec3 *p1 = &bvh->positions[t[1]];
+   const Evas_Vec3 *p2 = &bvh->positions[t[2]];
+
+   evas_vec3_set(&box->p0, MIN(MIN(p0->x, p1->x), p2->x),
+                 MIN(MIN(p0->y, p1->y), p2->y), MIN(MIN(p0->z, p1->z), p2->z));
+   evas_vec3_set(&box->p1, MAX(MAX(p0->x, p1->x), p2->x),
+                 MAX(MAX(p0->y, p1->y), p2->y), MAX(MAX(p0->z, p1->z), p2->z));
+}
+
+/* Leaf boxes are grown a little, so rays grazing an edge still reach the
+ * triangle test, which has the final say. */
+static inline void
+_mesh_bvh_box_pad(Evas_Box3 *box)
+{
+   Evas_Real pad;
+
+   pad = MAX(MAX(box->p1.x - box->p0.x, box->p1.y - box->p0.y), box->p1.z - box->p0.z);
+   pad = pad * 0.0001 + 0.000001;
+
+   box->p0.x -= pad;
+   box->p0.y -= pad;
+   box->p0.z -= pad;
+   box->p1.x += pad;
+   box->p1.y += pad;
+   box->p1.z += pad;
+}
+
+static inline Evas_Real
+_mesh_bvh_axis_get(const Evas_Vec3 *v, int axis)
+{
+   if (axis == 0) return v->x;
+   if (axis == 1) return v->y;
+   return v->z;
+}
+
+static inline void
+_mesh_bvh_triangle_swap(unsigned int *triangles, Evas_Vec3 *centers, int a, int b)
+{
+   unsigned int t[3];
+   Evas_Vec3 c;
+
+   memcpy(t, triangles + (a * 3), sizeof(t));
+   memcpy(triangles + (a * 3), triangles + (b * 3), sizeof(t));
+   memcpy(triangles + (b * 3), t, sizeof(t));
+
+   c = centers[a];
+   centers[a] = centers[b];
+   centers[b] = c;
+}
+
+/* Orders triangles [first, last] so that the k-th one along the axis is in
+ * place, with smaller ones before it and greater ones after. */
+static void
+_mesh_bvh_select(unsigned int *triangles, Evas_Vec3 *centers, int axis,
+                 int first, int last, int k)
+{
+   while (first < last)
+     {
+        Evas_Real pivot = _mesh_bvh_axis_get(&centers[(first + last) / 2], axis);
+        int i = first, j = last;
+
+        while (i <= j)
+          {
+             while (_mesh_bvh_axis_get(&centers[i], axis) < pivot) i++;
+             while (_mesh_bvh_axis_get(&centers[j], axis) > pivot) j--;
+             if (i <= j)
+               _mesh_bvh_triangle_swap(triangles, centers, i++, j--);
+          }
+
+        if (k <= j) last = j;
+        else if (k >= i) first = i;
+        else break;
+     }
+}
+
+static void
+_mesh_bvh_node_build(Evas_3D_Mesh_Bvh *bvh, Evas_Vec3 *centers, int node,
+                     int first, int count)
+{
+   Evas_3D_Mesh_Bvh_Node *n = &bvh->nodes[node];
+   Evas_Box3 box, bounds;
+   int i, axis, half, right;
+
+   _mesh_bvh_triangle_box(bvh, first, &n->box);
+   bounds.p0 = bounds.p1 = centers[first];
+   for (i = first + 1; i < first + count; i++)
+     {
+        _mesh_bvh_triangle_box(bvh, i, &box);
+        evas_box3_union(&n->box, &n->box, &box);
+
+        box.p0 = box.p1 = centers[i];
+        evas_box3_union(&bounds, &bounds, &box);
+     }
+
+   if (count <= MESH_BVH_LEAF_SIZE)
+     {
+        _mesh_bvh_box_pad(&n->box);
+        n->first = first;
+        n->count = count;
+        return;
+     }
+
+   /* Median split along the longest axis of the centers keeps the tree
+    * balanced, whatever the triangle distribution. */
+   evas_vec3_subtract(&bounds.p1, &bounds.p1, &bounds.p0);
+   if (bounds.p1.x >= bounds.p1.y && bounds.p1.x >= bounds.p1.z) axis = 0;
+   else if (bounds.p1.y >= bounds.p1.z) axis = 1;
+   else axis = 2;
+
+   half = count / 2;
+   _mesh_bvh_select(bvh->triangles, centers, axis, first, first + count - 1,
+                    first + half);
+
+   _mesh_bvh_node_build(bvh, centers, bvh->node_count++, first, half);
+   right = bvh->node_count++;
+   _mesh_bvh_node_build(bvh, centers, right, first + half, count - half);
+
+   n->first = right;
+   n->count = 0;
+}
+
+/* Children always come after their parent, so walking the nodes backwards
+ * updates every box from the bottom up. */
+static void
+_mesh_bvh_refit(Evas_3D_Mesh_Bvh *bvh)
+{
+   Evas_Box3 box;
+   int i, j;
+
+   for (i = bvh->node_count - 1; i >= 0; i--)
+     {
+        Evas_3D_Mesh_Bvh_Node *n = &bvh->nodes[i];
+
+        if (n->count)
+          {
+             _mesh_bvh_triangle_box(bvh, n->first, &n->box);
+             for (j = n->first + 1; j < n->first + n->count; j++)
+               {
+                  _mesh_bvh_triangle_box(bvh, j, &box);
+                  evas_box3_union(&n->box, &n->box, &box);
+               }
+             _mesh_bvh_box_pad(&n->box);
+          }
+        else
+          evas_box3_union(&n->box, &bvh->nodes[i + 1].box, &bvh->nodes[n->first].box);
+     }
+}
+
+static void
+_mesh_bvh_free(Evas_3D_Mesh_Bvh *bvh)
+{
+   if (!bvh) return;
+
+   free(bvh->nodes);
+   free(bvh->triangles);
+   free(bvh->positions);
+   free(bvh);
+}
+
+static Evas_3D_Mesh_Bvh *
+_mesh_bvh_new(Evas_3D_Mesh *mesh, Evas_3D_Mesh_Data *pd, int frame)
+{
+   Evas_3D_Mesh_Bvh *bvh;
+   Evas_Vec3 *centers;
+   unsigned int max = 0;
+   int i;
+
+   bvh = calloc(1, sizeof(Evas_3D_Mesh_Bvh));
+   if (!bvh)
+     {
+        ERR("Failed to allocate memory.");
+        return NULL;
+     }
+
+   bvh->triangle_count = _mesh_triangles_get(pd, &bvh->triangles);
+   if (!bvh->triangle_count)
+     return bvh;
+
+   for (i = 0; i < bvh->triangle_count * 3; i++)
+     if (bvh->triangles[i] > max) max = bvh->triangles[i];
+
+   bvh->position_count = max + 1;
+   bvh->positions = malloc(bvh->position_count * sizeof(Evas_Vec3));
+   bvh->nodes = malloc((2 * bvh->triangle_count - 1) * sizeof(Evas_3D_Mesh_Bvh_Node));
+   centers = malloc(bvh->triangle_count * sizeof(Evas_Vec3));
+   if (!bvh->positions || !bvh->nodes || !centers)
+     {
+        ERR("Failed to allocate memory.");
+        free(centers);
+        _mesh_bvh_free(bvh);
+        return NULL;
+     }
+
+   if (!_mesh_bvh_positions_update(mesh, bvh, frame))
+     {
+        free(centers);
+        _mesh_bvh_free(bvh);
+        return NULL;
+     }
+
+   for (i = 0; i < bvh->triangle_count; i++)
+     {
+        const unsigned int *t = bvh->triangles + (i * 3);
+
+        evas_vec3_add(&centers[i], &bvh->positions[t[0]], &bvh->positions[t[1]]);
+        evas_vec3_add(&centers[i], &centers[i], &bvh->positions[t[2]]);
+     }
+
+   bvh->node_count = 1;
+   _mesh_bvh_node_build(bvh, centers, 0, 0, bvh->triangle_count);
+   free(centers);
+
+   return bvh;
+}
+
+const Evas_3D_Mesh_Bvh *
+evas_3d_mesh_bvh_get(Evas_3D_Mesh *mesh, int frame)
+{
+   Evas_3D_Mesh_Data *pd = eo_data_scope_get(mesh, MY_CLASS);
+   Evas_3D_Mesh_Bvh *bvh = pd->bvh;
+
+   if (bvh && !bvh->rebuild)
+     {
+        if (!bvh->refit && bvh->frame == frame)
+          return bvh;
+
+        if (!bvh->triangle_count || _mesh_bvh_positions_update(mesh, bvh, frame))
+          {
+             if (bvh->triangle_count)
+               _mesh_bvh_refit(bvh);
+             bvh->frame = frame;
+             bvh->refit = EINA_FALSE;
+             return bvh;
+          }
+     }
+
+   _mesh_bvh_free(pd->bvh);
+   pd->bvh = _mesh_bvh_new(mesh, pd, frame);
+   return pd->bvh;
+}
+
 EOLIAN static Eina_Bool
 _evas_3d_mesh_color_pick_enable_get(Eo *obj EINA_UNUSED, Evas_3D_Mesh_Data *pd)
 {
@@ -466,22 +466,26 @@ _pack_meshes_vertex_data(Evas_3D_Node *node, Evas_Vec3 **vertices, int *count)
 {
    const Eina_List *m, *l;
    Evas_3D_Mesh *mesh;
-   Evas_3D_Mesh_Frame *f;
+   Evas_3D_Vertex_Buffer pos0, pos1;
+   Evas_Real weight;
    int j;
    int frame;
    Evas_3D_Mesh_Data *mpd;
    Evas_Vec3 *it;
 
+   /* Positions are interpolated like for drawing, so that nodes showing a
+    * frame between two key frames get a right bounding box too. */
    *count = 0;
    eo_do(node, m = (Eina_List *)evas_3d_node_mesh_list_get());
    EINA_LIST_FOREACH(m, l, mesh)
      {
         eo_do(node, frame = evas_3d_node_mesh_frame_get(mesh));
         mpd = eo_data_scope_get(mesh, EVAS_3D_MESH_CLASS);
-        f = evas_3d_mesh_frame_find(mpd, frame);
-        if (f)
-          if (f->vertices[EVAS_3D_VERTEX_POSITION].data)
-            *count += mpd->vertex_count;
+        pos0.data = NULL;
+        evas_3d_mesh_interpolate_vertex_buffer_get(mesh, frame, EVAS_3D_VERTEX_POSITION,
+                                                   &pos0, &pos1, &weight);
+        if (pos0.data)
+          *count += mpd->vertex_count;
      }
 
    *vertices = (Evas_Vec3*)malloc(*count * sizeof(Evas_Vec3));
@@ -494,23 +498,37 @@ _pack_meshes_vertex_data(Evas_3D_Node *node, Evas_Vec3 **vertices, int *count)
 
    EINA_LIST_FOREACH(m, l, mesh)
      {
+        float *src0, *src1;
+        int stride0, stride1;
+
         eo_do(node, frame = evas_3d_node_mesh_frame_get(mesh));
         mpd = eo_data_scope_get(mesh, EVAS_3D_MESH_CLASS);
-        f = evas_3d_mesh_frame_find(mpd, frame);
-        if (f)
+        pos0.data = NULL;
+        evas_3d_mesh_interpolate_vertex_buffer_get(mesh, frame, EVAS_3D_VERTEX_POSITION,
+                                                   &pos0, &pos1, &weight);
+        if (!pos0.data) continue;
+
+        src0 = (float *)pos0.data;
+        stride0 = pos0.stride ? pos0.stride : (int)sizeof(float) * 3;
+        src1 = (float *)pos1.data;
+        stride1 = pos1.stride ? pos1.stride : (int)sizeof(float) * 3;
+        for (j = 0; j < mpd->vertex_count; j++)
           {
-             float *src = (float *)f->vertices[EVAS_3D_VERTEX_POSITION].data;
-             if (!src) continue;
-             int stride = f->vertices[EVAS_3D_VERTEX_POSITION].stride;
-             if (!stride) stride = sizeof(float) * 3;
-             for (j = 0; j < mpd->vertex_count; j++)
+             if (src1)
+               {
+                  it->x = src0[0] * weight + src1[0] * (1.0 - weight);
+                  it->y = src0[1] * weight + src1[1] * (1.0 - weight);
+                  it->z = src0[2] * weight + src1[2] * (1.0 - weight);
+                  src1 = (float *)((char *)src1 + stride1);
+               }
+             else
                {
-                  it->x = src[0];
-                  it->y = src[1];
-                  it->z = src[2];
-                  it++;
-                  src = (float *)((char *)src + stride);
+                  it->x = src0[0];
+                  it->y = src0[1];
+                  it->z = src0[2];
                }
+             it++;
+             src0 = (float *)((char *)src0 + stride0);
           }
      }
 }
@@ -971,11 +989,36 @@ evas_3d_node_tree_traverse(Evas_3D_Node *root, Evas_3D_Tree_Traverse_Type type,
      eina_list_free(nodes);
 }
 
-Eina_Bool
-_node_is_visible(Evas_3D_Node *node EINA_UNUSED, Evas_3D_Node *camera_node EINA_UNUSED)
+/* Subtrees whose bounding box lies outside the view frustum are culled.
+ * Nothing is culled when shadows are on: nodes out of view may still cast
+ * shadows into it. */
+static Eina_Bool
+_node_is_visible(Evas_3D_Node *node, Evas_3D_Scene_Public_Data *scene_data)
 {
-   /* TODO: */
-   return EINA_TRUE;
+   Evas_3D_Node_Data *pd = eo_data_scope_get(node, MY_CLASS);
+
+   if (scene_data->shadows_enabled || !scene_data->camera_node)
+     return EINA_TRUE;
+
+   if (!scene_data->frustum_set)
+     {
+        Evas_3D_Node_Data *pd_camera_node;
+        Evas_3D_Camera_Data *pd_camera;
+        Evas_Mat4 matrix_vp;
+
+        pd_camera_node = eo_data_scope_get(scene_data->camera_node, MY_CLASS);
+        if (!pd_camera_node->data.camera.camera)
+          return EINA_TRUE;
+
+        pd_camera = eo_data_scope_get(pd_camera_node->data.camera.camera,
+                                      EVAS_3D_CAMERA_CLASS);
+        evas_mat4_multiply(&matrix_vp, &pd_camera->projection,
+                           &pd_camera_node->data.camera.matrix_world_to_eye);
+        evas_frustum_calculate(scene_data->frustum, &matrix_vp);
+        scene_data->frustum_set = EINA_TRUE;
+     }
+
+   return evas_is_box_in_frustum(&pd->aabb, scene_data->frustum);
 }
 
 Eina_Bool
@@ -983,7 +1026,7 @@ evas_3d_node_mesh_collect(Evas_3D_Node *node, void *data)
 {
    Evas_3D_Scene_Public_Data *scene_data = (Evas_3D_Scene_Public_Data *)data;
    Evas_3D_Node_Data *pd = eo_data_scope_get(node, MY_CLASS);
-   if (!_node_is_visible(node, scene_data->camera_node))
+   if (!_node_is_visible(node, scene_data))
      {
         /* Skip entire sub-tree of this node. */
         return EINA_FALSE;
@@ -11,6 +11,7 @@ evas_3d_scene_data_init(Evas_3D_Scene_Public_Data *data)
    data->mesh_nodes = NULL;
    data->node_mesh_colors = NULL;
    data->colors_node_mesh = NULL;
+   data->frustum_set = EINA_FALSE;
 }
 
 void
@@ -222,43 +223,6 @@ _pick_data_triangle_add(Evas_3D_Pick_Data *data, const Evas_Ray3 *ray,
    return EINA_FALSE;
 }
 
-static inline void
-_position_get(Evas_Vec3 *out, const Evas_3D_Vertex_Buffer *pos0, const Evas_3D_Vertex_Buffer *pos1,
-              Evas_Real weight, int index)
-{
-   if (pos1->data == NULL)
-     {
-        float *ptr;
-
-        if (pos0->stride != 0.0)
-          ptr = (float *)((char *)pos0->data + pos0->stride * index);
-        else
-          ptr = (float *)((char *)pos0->data + (3 * sizeof(float)) * index);
-
-        out->x = ptr[0];
-        out->y = ptr[1];
-        out->z = ptr[2];
-     }
-   else
-     {
-        float *ptr0, *ptr1;
-
-        if (pos0->stride != 0.0)
-          ptr0 = (float *)((char *)pos0->data + pos0->stride * index);
-        else
-          ptr0 = (float *)((char *)pos0->data + (3 * sizeof(float)) * index);
-
-        if (pos1->stride != 0.0)
-          ptr1 = (float *)((char *)pos1->data + pos1->stride * index);
-        else
-          ptr1 = (float *)((char *)pos1->data + (3 * sizeof(float)) * index);
-
-        out->x = ptr0[0] * weight + ptr1[0] * (1.0 - weight);
-        out->y = ptr0[1] * weight + ptr1[1] * (1.0 - weight);
-        out->z = ptr0[2] * weight + ptr1[2] * (1.0 - weight);
-     }
-}
-
 static inline void
 _pick_data_texcoord_update(Evas_3D_Pick_Data *data,
                            const Evas_3D_Vertex_Buffer *tex0, const Evas_3D_Vertex_Buffer *tex1,
@@ -266,22 +230,27 @@ _pick_data_texcoord_update(Evas_3D_Pick_Data *data,
 {
    Evas_Real s0, s1, s2;
    Evas_Real t0, t1, t2;
+   int stride0, stride1;
+
+   /* Buffers copied into the mesh are tightly packed, with a 0 stride. */
+   stride0 = tex0->stride ? tex0->stride : (int)(2 * sizeof(float));
+   stride1 = tex1->stride ? tex1->stride : (int)(2 * sizeof(float));
 
    if (tex1->data == NULL)
      {
         float *ptr;
 
-        ptr = (float *)((char *)tex0->data + tex0->stride * i0);
+        ptr = (float *)((char *)tex0->data + stride0 * i0);
 
         s0 = ptr[0];
         t0 = ptr[1];
 
-        ptr = (float *)((char *)tex0->data + tex0->stride * i1);
+        ptr = (float *)((char *)tex0->data + stride0 * i1);
 
         s1 = ptr[0];
         t1 = ptr[1];
 
-        ptr = (float *)((char *)tex0->data + tex0->stride * i2);
+        ptr = (float *)((char *)tex0->data + stride0 * i2);
 
         s2 = ptr[0];
         t2 = ptr[1];
@@ -290,20 +259,20 @@ _pick_data_texcoord_update(Evas_3D_Pick_Data *data,
      {
         float *ptr0, *ptr1;
 
-        ptr0 = (float *)((char *)tex0->data + tex0->stride * i0);
-        ptr1 = (float *)((char *)tex1->data + tex1->stride * i0);
+        ptr0 = (float *)((char *)tex0->data + stride0 * i0);
+        ptr1 = (float *)((char *)tex1->data + stride1 * i0);
 
         s0 = ptr0[0] * weight + ptr1[0] * (1.0 - weight);
         t0 = ptr0[1] * weight + ptr1[1] * (1.0 - weight);
 
-        ptr0 = (float *)((char *)tex0->data + tex0->stride * i1);
-        ptr1 = (float *)((char *)tex1->data + tex1->stride * i1);
+        ptr0 = (float *)((char *)tex0->data + stride0 * i1);
+        ptr1 = (float *)((char *)tex1->data + stride1 * i1);
 
         s1 = ptr0[0] * weight + ptr1[0] * (1.0 - weight);
         t1 = ptr0[1] * weight + ptr1[1] * (1.0 - weight);
 
-        ptr0 = (float *)((char *)tex0->data + tex0->stride * i2);
-        ptr1 = (float *)((char *)tex1->data + tex1->stride * i2);
+        ptr0 = (float *)((char *)tex0->data + stride0 * i2);
+        ptr1 = (float *)((char *)tex1->data + stride1 * i2);
 
         s2 = ptr0[0] * weight + ptr1[0] * (1.0 - weight);
         t2 = ptr0[1] * weight + ptr1[1] * (1.0 - weight);
@@ -314,269 +283,102 @@ _pick_data_texcoord_update(Evas_3D_Pick_Data *data,
 }
 
 
+/* Slab test of the ray segment against a box, up to the parameter tmax. */
+static inline Eina_Bool
+_pick_box_hit(const Evas_Box3 *box, const Evas_Ray3 *ray, const Evas_Vec3 *inv,
+              Evas_Real tmax)
+{
+   Evas_Real tmin = 0.0, t0, t1;
+
+#define PICK_SLAB(c)                                                   \
+   if (ray->dir.c == 0.0)                                              \
+     {                                                                 \
+        if (ray->org.c < box->p0.c || ray->org.c > box->p1.c)          \
+          return EINA_FALSE;                                           \
+     }                                                                 \
+   else                                                                \
+     {                                                                 \
+        t0 = (box->p0.c - ray->org.c) * inv->c;                        \
+        t1 = (box->p1.c - ray->org.c) * inv->c;                        \
+        if (t0 > t1) { Evas_Real tt = t0; t0 = t1; t1 = tt; }          \
+        if (t0 > tmin) tmin = t0;                                      \
+        if (t1 < tmax) tmax = t1;                                      \
+        if (tmin > tmax) return EINA_FALSE;                            \
+     }
+
+   PICK_SLAB(x);
+   PICK_SLAB(y);
+   PICK_SLAB(z);
+
+#undef PICK_SLAB
+
+   return EINA_TRUE;
+}
+
 static inline void
 _pick_data_mesh_add(Evas_3D_Pick_Data *data, const Evas_Ray3 *ray,
                     Evas_3D_Mesh *mesh, int frame, Evas_3D_Node *node)
 {
-   Evas_3D_Vertex_Buffer   pos0, pos1, tex0, tex1;
-   Evas_Real               pos_weight, tex_weight;
+   const Evas_3D_Mesh_Bvh *bvh;
+   Evas_3D_Vertex_Buffer   tex0, tex1;
+   Evas_Real               tex_weight;
    Evas_Triangle3          tri;
-   int                     i;
+   Evas_Vec3               inv;
+   int                     stack[64];
+   int                     sp = 0, i;
+
+   bvh = evas_3d_mesh_bvh_get(mesh, frame);
+   if (!bvh || !bvh->triangle_count)
+     return;
 
-   memset(&pos0, 0x00, sizeof(Evas_3D_Vertex_Buffer));
-   memset(&pos1, 0x00, sizeof(Evas_3D_Vertex_Buffer));
    memset(&tex0, 0x00, sizeof(Evas_3D_Vertex_Buffer));
    memset(&tex1, 0x00, sizeof(Evas_3D_Vertex_Buffer));
 
-   evas_3d_mesh_interpolate_vertex_buffer_get(mesh, frame, EVAS_3D_VERTEX_POSITION,
-                                              &pos0, &pos1, &pos_weight);
-
    evas_3d_mesh_interpolate_vertex_buffer_get(mesh, frame, EVAS_3D_VERTEX_TEXCOORD,
                                               &tex0, &tex1, &tex_weight);
-   Evas_3D_Mesh_Data *pdmesh = eo_data_scope_get(mesh, EVAS_3D_MESH_CLASS);
-   if (pdmesh->indices)
-     {
-        unsigned int i0, i1, i2;
 
-        if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES)
-          {
-             for (i = 0; i < pdmesh->index_count; i += 3)
-               {
-                  if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-                    {
-                       i0 = ((unsigned short *)pdmesh->indices)[i];
-                       i1 = ((unsigned short *)pdmesh->indices)[i + 1];
-                       i2 = ((unsigned short *)pdmesh->indices)[i + 2];
-                    }
-                  else
-                    {
-                       i0 = ((unsigned char *)pdmesh->indices)[i];
-                       i1 = ((unsigned char *)pdmesh->indices)[i + 1];
-                       i2 = ((unsigned char *)pdmesh->indices)[i + 2];
-                    }
-
-                  _position_get(&tri.p0, &pos0, &pos1, pos_weight, i0);
-                  _position_get(&tri.p1, &pos0, &pos1, pos_weight, i1);
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i2);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i0, i1, i2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-        else if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_STRIP)
-          {
-             if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-               {
-                  i1 = ((unsigned short *)pdmesh->indices)[0];
-                  i2 = ((unsigned short *)pdmesh->indices)[1];
-               }
-             else
-               {
-                  i1 = ((unsigned char *)pdmesh->indices)[0];
-                  i2 = ((unsigned char *)pdmesh->indices)[1];
-               }
-
-             _position_get(&tri.p1, &pos0, &pos1, pos_weight, i1);
-             _position_get(&tri.p2, &pos0, &pos1, pos_weight, i2);
-
-             for (i = 0; i < pdmesh->index_count - 2; i++)
-               {
-                  tri.p0 = tri.p1;
-                  tri.p1 = tri.p2;
-
-                  if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-                    i2 = ((unsigned short *)pdmesh->indices)[i + 2];
-                  else
-                    i2 = ((unsigned char *)pdmesh->indices)[i + 2];
+   evas_vec3_set(&inv,
+                 ray->dir.x != 0.0 ? 1.0 / ray->dir.x : 0.0,
+                 ray->dir.y != 0.0 ? 1.0 / ray->dir.y : 0.0,
+                 ray->dir.z != 0.0 ? 1.0 / ray->dir.z : 0.0);
 
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i2);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-                         {
-                            i0 = ((unsigned short *)pdmesh->indices)[i];
-                            i1 = ((unsigned short *)pdmesh->indices)[i + 1];
-                         }
-                       else
-                         {
-                            i0 = ((unsigned char *)pdmesh->indices)[i];
-                            i1 = ((unsigned char *)pdmesh->indices)[i + 1];
-                         }
-
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i0, i1, i2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-        else if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_FAN)
-          {
-             if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-               {
-                  i0 = ((unsigned short *)pdmesh->indices)[0];
-                  i2 = ((unsigned short *)pdmesh->indices)[1];
-               }
-             else
-               {
-                  i0 = ((unsigned char *)pdmesh->indices)[0];
-                  i2 = ((unsigned char *)pdmesh->indices)[1];
-               }
-
-             _position_get(&tri.p0, &pos0, &pos1, pos_weight, i0);
-             _position_get(&tri.p2, &pos0, &pos1, pos_weight, i2);
-
-             for (i = 1; i < pdmesh->index_count - 1; i++)
-               {
-                  tri.p1 = tri.p2;
-
-                  if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-                    i2 = ((unsigned short *)pdmesh->indices)[i + 1];
-                  else
-                    i2 = ((unsigned char *)pdmesh->indices)[i + 1];
-
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i2);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT)
-                         i1 = ((unsigned short *)pdmesh->indices)[i];
-                       else
-                         i1 = ((unsigned char *)pdmesh->indices)[i];
-
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i0, i1, i2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-     }
-   else if (pdmesh->index_format == EVAS_3D_INDEX_FORMAT_UNSIGNED_BYTE)
+   /* Only the nodes the ray goes through, closer than the current hit, are
+    * visited. The tree is balanced, its depth never gets near the stack size. */
+   stack[sp++] = 0;
+   while (sp > 0)
      {
-        if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES)
-          {
-             for (i = 0; i < pdmesh->index_count; i += 3)
-               {
-                  _position_get(&tri.p0, &pos0, &pos1, pos_weight, i);
-                  _position_get(&tri.p1, &pos0, &pos1, pos_weight, i + 1);
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i + 2);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i, i + 1, i + 2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-        else if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_STRIP)
-          {
-             _position_get(&tri.p1, &pos0, &pos1, pos_weight, 0);
-             _position_get(&tri.p2, &pos0, &pos1, pos_weight, 1);
-
-             for (i = 0; i < pdmesh->index_count - 2; i++)
-               {
-                  tri.p0 = tri.p1;
-                  tri.p1 = tri.p2;
+        int index = stack[--sp];
+        const Evas_3D_Mesh_Bvh_Node *n = &bvh->nodes[index];
 
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i + 2);
+        if (!_pick_box_hit(&n->box, ray, &inv, data->picked ? data->z : 1.0))
+          continue;
 
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i, i + 1, i + 2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-        else if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_FAN)
+        if (n->count == 0)
           {
-             _position_get(&tri.p0, &pos0, &pos1, pos_weight, 0);
-             _position_get(&tri.p2, &pos0, &pos1, pos_weight, 1);
-
-             for (i = 1; i < pdmesh->index_count - 1; i++)
+             if (sp + 2 > (int)(sizeof(stack) / sizeof(stack[0])))
                {
-                  tri.p1 = tri.p2;
-
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i + 1);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                      if (tex0.data)
-                        _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, 0, i, i + 1);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
+                  ERR("Mesh BVH too deep.");
+                  return;
                }
+             stack[sp++] = n->first;
+             stack[sp++] = index + 1;
+             continue;
           }
-     }
-   else if (pdmesh->index_count == 0.0 && pdmesh->vertex_count != 0)
-     {
-        if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES)
-          {
-             for (i = 0; i < pdmesh->vertex_count; i += 3)
-               {
-                  _position_get(&tri.p0, &pos0, &pos1, pos_weight, i);
-                  _position_get(&tri.p1, &pos0, &pos1, pos_weight, i + 1);
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i + 2);
 
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i, i + 1, i + 2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-        else if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_STRIP)
+        for (i = n->first; i < n->first + n->count; i++)
           {
-             _position_get(&tri.p1, &pos0, &pos1, pos_weight, 0);
-             _position_get(&tri.p2, &pos0, &pos1, pos_weight, 1);
-
-             for (i = 0; i < pdmesh->vertex_count - 2; i++)
-               {
-                  tri.p0 = tri.p1;
-                  tri.p1 = tri.p2;
+             const unsigned int *t = bvh->triangles + (i * 3);
 
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i + 2);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                      if (tex0.data)
-                        _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, i, i + 1, i + 2);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
-               }
-          }
-        else if (pdmesh->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_FAN)
-          {
-             _position_get(&tri.p0, &pos0, &pos1, pos_weight, 0);
-             _position_get(&tri.p2, &pos0, &pos1, pos_weight, 1);
+             tri.p0 = bvh->positions[t[0]];
+             tri.p1 = bvh->positions[t[1]];
+             tri.p2 = bvh->positions[t[2]];
 
-             for (i = 1; i < pdmesh->vertex_count - 1; i++)
+             if (_pick_data_triangle_add(data, ray, &tri))
                {
-                  tri.p1 = tri.p2;
-
-                  _position_get(&tri.p2, &pos0, &pos1, pos_weight, i + 1);
-
-                  if (_pick_data_triangle_add(data, ray, &tri))
-                    {
-                       if (tex0.data)
-                         _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, 0, i, i + 1);
-                       data->mesh = mesh;
-                       data->node = node;
-                    }
+                  if (tex0.data)
+                    _pick_data_texcoord_update(data, &tex0, &tex1, tex_weight, t[0], t[1], t[2]);
+                  data->mesh = mesh;
+                  data->node = node;
                }
           }
      }
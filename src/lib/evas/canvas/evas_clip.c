@@ -7,6 +7,7 @@ evas_object_clip_dirty(Evas_Object *eo_obj EINA_UNUSED, Evas_Object_Protected_Da
    Evas_Object_Protected_Data *clipee;
    Eina_List *l;
 
+   evas_object_smart_render_cache_invalidate(obj);
    if (obj->cur->cache.clip.dirty) return;
 
    EINA_COW_STATE_WRITE_BEGIN(obj, state_write, cur)
@@ -285,6 +286,7 @@ _evas_object_clip_set(Eo *eo_obj, Evas_Object_Protected_Data *obj, Evas_Object *
 	/* unclip */
         obj->cur->clipper->clip.cache_clipees_answer = eina_list_free(obj->cur->clipper->clip.cache_clipees_answer);
         obj->cur->clipper->clip.clipees = eina_list_remove(obj->cur->clipper->clip.clipees, obj);
+        evas_object_smart_render_cache_invalidate(obj->cur->clipper);
         if (!obj->cur->clipper->clip.clipees)
           {
              EINA_COW_STATE_WRITE_BEGIN(obj->cur->clipper, state_write, cur)
@@ -357,6 +359,7 @@ _evas_object_clip_set(Eo *eo_obj, Evas_Object_Protected_Data *obj, Evas_Object *
 
    clip->clip.cache_clipees_answer = eina_list_free(clip->clip.cache_clipees_answer);
    clip->clip.clipees = eina_list_append(clip->clip.clipees, obj);
+   evas_object_smart_render_cache_invalidate(clip);
    if (clip->clip.clipees)
      {
         EINA_COW_STATE_WRITE_BEGIN(clip, state_write, cur)
@@ -413,6 +416,7 @@ _evas_object_clip_unset(Eo *eo_obj, Evas_Object_Protected_Data *obj)
    if (obj->cur->clipper)
      {
         obj->cur->clipper->clip.clipees = eina_list_remove(obj->cur->clipper->clip.clipees, obj);
+        evas_object_smart_render_cache_invalidate(obj->cur->clipper);
         if (!obj->cur->clipper->clip.clipees)
           {
              EINA_COW_STATE_WRITE_BEGIN(obj->cur->clipper, state_write, cur)
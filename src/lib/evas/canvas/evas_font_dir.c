@@ -22,6 +22,10 @@ static Eina_List *fonts_cache = NULL;
 static Eina_List *fonts_zero = NULL;
 static Eina_List *global_font_path = NULL;
 
+/* fonts_cache and fonts_zero are also used by textblocks laid out off the
+ * main loop */
+static LK(fonts_lock);
+
 typedef struct _Fndat Fndat;
 
 struct _Fndat
@@ -32,6 +36,7 @@ struct _Fndat
    Evas_Font_Set   *font;
    int              ref;
    Font_Rend_Flags  wanted_rend;
+   Evas_Font_Hinting_Flags hinting;
 
 #ifdef HAVE_FONTCONFIG
    FcFontSet *set;
@@ -138,12 +143,25 @@ evas_font_set_get(const char *name)
    return fonts;
 }
 
+void
+evas_font_dir_init(void)
+{
+   LKI(fonts_lock);
+}
+
+void
+evas_font_dir_shutdown(void)
+{
+   LKD(fonts_lock);
+}
+
 void
 evas_fonts_zero_free(Evas *eo_evas)
 {
    Fndat *fd;
    Evas_Public_Data *evas = eo_data_scope_get(eo_evas, EVAS_CANVAS_CLASS);
 
+   LKL(fonts_lock);
    EINA_LIST_FREE(fonts_zero, fd)
      {
         if (fd->fdesc) evas_font_desc_unref(fd->fdesc);
@@ -155,6 +173,7 @@ evas_fonts_zero_free(Evas *eo_evas)
 #endif
 	free(fd);
      }
+   LKU(fonts_lock);
 }
 
 void
@@ -163,6 +182,7 @@ evas_fonts_zero_pressure(Evas *eo_evas)
    Fndat *fd;
    Evas_Public_Data *evas = eo_data_scope_get(eo_evas, EVAS_CANVAS_CLASS);
 
+   LKL(fonts_lock);
    while (fonts_zero
 	  && eina_list_count(fonts_zero) > 4) /* 4 is arbitrary */
      {
@@ -182,6 +202,7 @@ evas_fonts_zero_pressure(Evas *eo_evas)
 
 	if (eina_list_count(fonts_zero) < 5) break;
      }
+   LKU(fonts_lock);
 }
 
 void
@@ -191,6 +212,7 @@ evas_font_free(Evas *eo_evas, void *font)
    Fndat *fd;
    Evas_Public_Data *evas = eo_data_scope_get(eo_evas, EVAS_CANVAS_CLASS);
 
+   LKL(fonts_lock);
    EINA_LIST_FOREACH(fonts_cache, l, fd)
      {
 	if (fd->font == font)
@@ -223,6 +245,7 @@ evas_font_free(Evas *eo_evas, void *font)
 
 	if (eina_list_count(fonts_zero) < 43) break;
      }
+   LKU(fonts_lock);
 }
 
 #ifdef HAVE_FONTCONFIG
@@ -518,8 +541,8 @@ evas_font_name_parse(Evas_Font_Description *fdesc, const char *name)
      }
 }
 
-void *
-evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source, Evas_Font_Size size)
+static void *
+_evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source, Evas_Font_Size size)
 {
    Evas_Public_Data *evas = eo_data_scope_get(eo_evas, EVAS_CANVAS_CLASS);
 #ifdef HAVE_FONTCONFIG
@@ -555,7 +578,8 @@ evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source,
 		 ((source) && (fd->source) && (!strcmp(source, fd->source))))
 	       {
 		  if ((size == fd->size) &&
-                        (wanted_rend == fd->wanted_rend))
+                        (wanted_rend == fd->wanted_rend) &&
+                        (evas->hinting == fd->hinting))
 		    {
 		       fonts_cache = eina_list_promote_list(fonts_cache, l);
 		       fd->ref++;
@@ -587,7 +611,8 @@ evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source,
 		 ((source) && (fd->source) && (!strcmp(source, fd->source))))
 	       {
 		  if ((size == fd->size) &&
-                        (wanted_rend == fd->wanted_rend))
+                        (wanted_rend == fd->wanted_rend) &&
+                        (evas->hinting == fd->hinting))
 		    {
 		       fonts_zero = eina_list_remove_list(fonts_zero, l);
 		       fonts_cache = eina_list_prepend(fonts_cache, fd);
@@ -864,6 +889,7 @@ evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source,
         if (source) fd->source = eina_stringshare_add(source);
         fd->font = font;
         fd->wanted_rend = wanted_rend;
+        fd->hinting = evas->hinting;
         fd->size = size;
         fd->ref = 1;
         fonts_cache = eina_list_prepend(fonts_cache, fd);
@@ -880,12 +906,30 @@ evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source,
    return font;
 }
 
+void *
+evas_font_load(Evas *eo_evas, Evas_Font_Description *fdesc, const char *source, Evas_Font_Size size)
+{
+   void *font;
+
+   LKL(fonts_lock);
+   font = _evas_font_load(eo_evas, fdesc, source, size);
+   LKU(fonts_lock);
+   return font;
+}
+
 void
 evas_font_load_hinting_set(Evas *eo_evas, void *font, int hinting)
 {
    Evas_Public_Data *evas = eo_data_scope_get(eo_evas, EVAS_CANVAS_CLASS);
+   Eina_List *l;
+   Fndat *fd;
+
+   LKL(fonts_lock);
    evas->engine.func->font_hinting_set(evas->engine.data.output, font,
 				       hinting);
+   EINA_LIST_FOREACH(fonts_cache, l, fd)
+     if (fd->font == font) fd->hinting = hinting;
+   LKU(fonts_lock);
 }
 
 Eina_List *
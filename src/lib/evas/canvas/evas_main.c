@@ -46,6 +46,7 @@ evas_init(void)
      }
 
    eo_init();
+   ector_init();
 
 #ifdef BUILD_LOADER_EET
    eet_init();
@@ -62,6 +63,7 @@ evas_init(void)
    }
 #endif
    _evas_preload_thread_init();
+   evas_font_dir_init();
 
    evas_thread_init();
 
@@ -123,11 +125,13 @@ evas_shutdown(void)
    _evas_preload_thread_shutdown();
    evas_async_events_shutdown();
    evas_common_shutdown();
+   evas_font_dir_shutdown();
    evas_module_shutdown();
 
 #ifdef BUILD_LOADER_EET
    eet_shutdown();
 #endif
+   ector_shutdown();
    eo_shutdown();
 
    eina_log_domain_unregister(_evas_log_dom_global);
@@ -112,12 +112,15 @@ struct _Evas_Object_Image
    const Evas_Object_Image_Pixels *pixels;
 
    void             *engine_data;
+   void             *cache_pinned_image; // engine_data this object holds a pin on
 
    int               pixels_checked_out;
    int               load_error;
 
    Evas_Image_Scale_Hint   scale_hint;
    Evas_Image_Content_Hint content_hint;
+   Evas_Image_Preload_Priority preload_priority;
+   unsigned int      cache_tag;
 
    Eina_Bool         changed : 1;
    Eina_Bool         dirty_pixels : 1;
@@ -127,6 +130,7 @@ struct _Evas_Object_Image
    Eina_Bool         video_surface : 1;
    Eina_Bool         video_visible : 1;
    Eina_Bool         created : 1;
+   Eina_Bool         cache_pinned : 1;
    Eina_Bool         proxyerror : 1;
    Eina_Bool         proxy_src_clip : 1;
    Eina_Bool         written : 1;
@@ -192,6 +196,7 @@ static void _proxy_error(Evas_Object *proxy, void *context, void *output, void *
 
 static void _3d_set(Evas_Object *eo_obj, Evas_3D_Scene *scene);
 static void _3d_unset(Evas_Object *eo_obj, Evas_Object_Protected_Data *image, Evas_Image_Data *o);
+static void _image_cache_unpin(Evas_Object_Protected_Data *obj, Evas_Image_Data *o);
 
 static const Evas_Object_Func object_func =
 {
@@ -304,6 +309,7 @@ _evas_object_image_cleanup(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj,
         o->preloading = EINA_FALSE;
         ENFN->image_data_preload_cancel(ENDT, o->engine_data, eo_obj);
      }
+   _image_cache_unpin(obj, o);
    if (o->cur->source) _proxy_unset(eo_obj, obj, o);
    if (o->cur->scene) _3d_unset(eo_obj, obj, o);
 }
@@ -416,6 +422,36 @@ evas_object_image_memfile_set(Evas_Object *eo_obj, void *data, int size, char *f
    eina_file_close(f);
 }
 
+/* Tags and pins live on the cache entry, which may be shared, so only
+ * touch them when this object asked for something. */
+static void
+_image_cache_hint_apply(Evas_Object_Protected_Data *obj, Evas_Image_Data *o)
+{
+   int pin = 0;
+
+   if ((!o->engine_data) || (!ENFN->image_cache_hint_set)) return;
+   if ((!o->cache_tag) && (!o->cache_pinned)) return;
+   if ((o->cache_pinned) && (o->cache_pinned_image != o->engine_data))
+     {
+        o->cache_pinned_image = o->engine_data;
+        pin = 1;
+     }
+   ENFN->image_cache_hint_set(ENDT, o->engine_data, o->cache_tag, pin);
+}
+
+/* Give the pin back before the image goes. If the engine swapped the
+ * image under us, the old one may be gone already, and the cache drops
+ * its pins along with its last reference. */
+static void
+_image_cache_unpin(Evas_Object_Protected_Data *obj, Evas_Image_Data *o)
+{
+   if (!o->cache_pinned_image) return;
+   if ((o->cache_pinned_image == o->engine_data) &&
+       (ENFN->image_cache_hint_set))
+     ENFN->image_cache_hint_set(ENDT, o->engine_data, o->cache_tag, -1);
+   o->cache_pinned_image = NULL;
+}
+
 static void
 _image_init_set(const Eina_File *f, const char *file, const char *key,
                 Eo *eo_obj, Evas_Object_Protected_Data *obj, Evas_Image_Data *o,
@@ -459,6 +495,7 @@ _image_init_set(const Eina_File *f, const char *file, const char *key,
         EINA_COW_WRITE_END(evas_object_image_state_cow, o->prev, state_write);
      }
 
+   _image_cache_unpin(obj, o);
    if (o->engine_data)
      {
         if (o->preloading)
@@ -494,6 +531,8 @@ _image_done_set(Eo *eo_obj, Evas_Object_Protected_Data *obj, Evas_Image_Data *o)
 {
    Eina_Bool resize_call = EINA_FALSE;
 
+   _image_cache_hint_apply(obj, o);
+
    if (o->engine_data)
      {
         int w, h;
@@ -1334,6 +1373,7 @@ _evas_image_data_get(Eo *eo_obj, Evas_Image_Data *_pd EINA_UNUSED, Eina_Bool for
 
    if (for_writing) evas_object_async_block(obj);
    if (for_writing) evas_render_rendering_wait(obj->layer->evas);
+   if (for_writing) _image_cache_unpin(obj, o);
 
    data = NULL;
    if (ENFN->image_scale_hint_set)
@@ -1431,6 +1471,84 @@ _evas_image_preload_cancel(Eo *eo_obj, Evas_Image_Data *_pd EINA_UNUSED)
    _image_preload_internal(eo_obj, _pd, EINA_TRUE);
 }
 
+EOLIAN static void
+_evas_image_preload_priority_set(Eo *eo_obj, Evas_Image_Data *o,
+                                 Evas_Image_Preload_Priority priority)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+
+   if ((priority < EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE) ||
+       (priority > EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE))
+     return;
+   if (o->preload_priority == priority) return;
+   o->preload_priority = priority;
+   if ((o->preloading) && (o->engine_data) &&
+       (ENFN->image_data_preload_priority_set))
+     ENFN->image_data_preload_priority_set(ENDT, o->engine_data, eo_obj,
+                                           priority);
+}
+
+EOLIAN static Evas_Image_Preload_Priority
+_evas_image_preload_priority_get(Eo *eo_obj EINA_UNUSED, Evas_Image_Data *o)
+{
+   return o->preload_priority;
+}
+
+EOLIAN static void
+_evas_image_cache_tag_set(Eo *eo_obj, Evas_Image_Data *o, unsigned int tag)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+
+   if (o->cache_tag == tag) return;
+   evas_object_async_block(obj);
+   o->cache_tag = tag;
+   if ((o->engine_data) && (ENFN->image_cache_hint_set))
+     ENFN->image_cache_hint_set(ENDT, o->engine_data, tag, 0);
+}
+
+EOLIAN static unsigned int
+_evas_image_cache_tag_get(Eo *eo_obj EINA_UNUSED, Evas_Image_Data *o)
+{
+   return o->cache_tag;
+}
+
+EOLIAN static void
+_evas_image_cache_pinned_set(Eo *eo_obj, Evas_Image_Data *o, Eina_Bool pinned)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+
+   pinned = !!pinned;
+   if (o->cache_pinned == pinned) return;
+   evas_object_async_block(obj);
+   o->cache_pinned = pinned;
+   if (pinned)
+     _image_cache_hint_apply(obj, o);
+   else
+     _image_cache_unpin(obj, o);
+}
+
+EOLIAN static Eina_Bool
+_evas_image_cache_pinned_get(Eo *eo_obj EINA_UNUSED, Evas_Image_Data *o)
+{
+   return o->cache_pinned;
+}
+
+EOLIAN static Eina_Bool
+_evas_image_prescale(Eo *eo_obj, Evas_Image_Data *o, int w, int h)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+
+   if ((w <= 0) || (h <= 0) || (!o->engine_data)) return EINA_FALSE;
+   if (!ENFN->image_prescale) return EINA_FALSE;
+   // bordered images are drawn in pieces, each with its own scale
+   if ((o->cur->border.l) || (o->cur->border.r) ||
+       (o->cur->border.t) || (o->cur->border.b) ||
+       (!o->cur->border.fill))
+     return EINA_FALSE;
+   return ENFN->image_prescale(ENDT, o->engine_data, o->cur->smooth_scale,
+                               0, 0, o->cur->image.w, o->cur->image.h, w, h);
+}
+
 EOLIAN static void
 _evas_image_data_copy_set(Eo *eo_obj, Evas_Image_Data *o, void *data)
 {
@@ -2341,6 +2459,80 @@ _evas_canvas_image_cache_get(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e)
    return e->engine.func->image_cache_get(e->engine.data.output);
 }
 
+/* All engines keep the source images in the common cache, the budgets are
+ * set on it directly rather than through each engine. */
+EOLIAN void
+_evas_canvas_image_cache_headers_set(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e EINA_UNUSED, int size)
+{
+   Evas_Cache_Image *cache = evas_common_image_cache_get();
+
+   if (!cache) return;
+   if (size < 0) size = 0;
+   evas_cache_image_headers_set(cache, size);
+}
+
+EOLIAN int
+_evas_canvas_image_cache_headers_get(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e EINA_UNUSED)
+{
+   Evas_Cache_Image *cache = evas_common_image_cache_get();
+
+   if (!cache) return 0;
+   return evas_cache_image_headers_get(cache);
+}
+
+EOLIAN void
+_evas_canvas_image_cache_tag_limit_set(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e EINA_UNUSED, unsigned int tag, int size)
+{
+   Evas_Cache_Image *cache = evas_common_image_cache_get();
+
+   if (!cache) return;
+   if (size < 0) size = -1;
+   evas_cache_image_tag_limit_set(cache, tag, size);
+}
+
+EOLIAN int
+_evas_canvas_image_cache_tag_limit_get(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e EINA_UNUSED, unsigned int tag)
+{
+   Evas_Cache_Image *cache = evas_common_image_cache_get();
+
+   if (!cache) return -1;
+   return evas_cache_image_tag_limit_get(cache, tag);
+}
+
+EOLIAN void
+_evas_canvas_image_cache_stats_get(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e EINA_UNUSED,
+                                   unsigned int *hits, unsigned int *misses,
+                                   unsigned int *evictions, unsigned int *demotions,
+                                   unsigned long long *evicted)
+{
+   Evas_Cache_Image *cache = evas_common_image_cache_get();
+   Evas_Cache_Image_Stats stats = { 0, 0, 0, 0, 0 };
+
+   if (cache) evas_cache_image_stats_get(cache, &stats);
+   if (hits) *hits = stats.hits;
+   if (misses) *misses = stats.misses;
+   if (evictions) *evictions = stats.evictions;
+   if (demotions) *demotions = stats.demotions;
+   if (evicted) *evicted = stats.evicted;
+}
+
+EOLIAN void
+_evas_canvas_image_scale_cache_stats_get(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e EINA_UNUSED,
+                                         unsigned int *hits, unsigned int *misses,
+                                         unsigned int *populated, unsigned int *prescaled,
+                                         unsigned int *evicted, unsigned int *size)
+{
+   Evas_Common_Scalecache_Stats stats;
+
+   evas_common_rgba_image_scalecache_stats_get(&stats);
+   if (hits) *hits = stats.hits;
+   if (misses) *misses = stats.misses;
+   if (populated) *populated = stats.populated;
+   if (prescaled) *prescaled = stats.prescaled;
+   if (evicted) *evicted = stats.evicted;
+   if (size) *size = stats.size;
+}
+
 EOLIAN Eina_Bool
 _evas_canvas_image_max_size_get(Eo *eo_e EINA_UNUSED, Evas_Public_Data *e, int *maxw, int *maxh)
 {
@@ -2650,6 +2842,7 @@ evas_object_image_unload(Evas_Object *eo_obj, Eina_Bool dirty)
 
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _image_cache_unpin(obj, o);
    if (dirty)
      {
         if (o->engine_data)
@@ -2728,6 +2921,8 @@ evas_object_image_load(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj, Eva
         int stride = 0;
         Eina_Bool resize_call = EINA_FALSE;
 
+        _image_cache_hint_apply(obj, o);
+
         ENFN->image_size_get(ENDT, o->engine_data, &w, &h);
         if (ENFN->image_stride_get)
           ENFN->image_stride_get(ENDT, o->engine_data, &stride);
@@ -2853,6 +3048,7 @@ evas_object_image_free(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj)
    if (o->cur->scene) _3d_unset(eo_obj, obj, o);
    if (obj->layer && obj->layer->evas)
      {
+       _image_cache_unpin(obj, o);
        if (o->engine_data)
 	 {
 	   if (o->preloading)
@@ -4717,6 +4913,16 @@ _evas_object_image_preloading_set(Evas_Object *eo_obj, Eina_Bool preloading)
    o->preloading = preloading;
 }
 
+Evas_Image_Preload_Priority
+_evas_object_image_preload_priority_get(const Evas_Object *eo_obj)
+{
+   Evas_Image_Data *o;
+
+   if (!eo_isa(eo_obj, MY_CLASS)) return EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE;
+   o = eo_data_scope_get(eo_obj, MY_CLASS);
+   return o->preload_priority;
+}
+
 void
 _evas_object_image_preloading_check(Evas_Object *eo_obj)
 {
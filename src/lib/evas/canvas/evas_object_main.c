@@ -252,6 +252,7 @@ evas_object_change(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj)
 
    if (!obj->layer) return;
    if (!obj->layer->evas) return;
+   evas_object_smart_render_cache_invalidate(obj);
    if (obj->layer->evas->nochange) return;
    obj->layer->evas->changed = EINA_TRUE;
 
@@ -30,6 +30,15 @@ struct _Evas_Smart_Data
 
    Evas_Smart_Cb_Description_Array callbacks_descriptions;
 
+   /* phase 1 render output of this subtree, reused while nothing in it
+    * changes (see obj->render_cache_valid) */
+   struct {
+      Eina_Array     active_objects;
+      Eina_Array     render_objects;
+      Eina_Inarray   rect_del; /* rect_del of each of render_objects */
+      int            validity;
+   } render_cache;
+
    int               walking_list;
    int               member_count; /** number of smart member objects */
 
@@ -290,6 +299,7 @@ _evas_object_smart_member_del(Eo *smart_obj, Evas_Smart_Data *_pd EINA_UNUSED, E
      smart->smart.smart->smart_class->member_del(smart_obj, eo_obj);
 
    Evas_Smart_Data *o = eo_data_scope_get(smart_obj, MY_CLASS);
+   evas_object_smart_render_cache_invalidate(smart);
    o->contained = eina_inlist_remove(o->contained, EINA_INLIST_GET(obj));
    eo_data_unref(eo_obj, obj);
    o->member_count--;
@@ -554,6 +564,12 @@ _evas_object_smart_eo_base_constructor(Eo *eo_obj, Evas_Smart_Data *class_data E
 
    smart = class_data;
    smart->object = eo_obj;
+   eina_array_step_set(&smart->render_cache.active_objects,
+                       sizeof (Eina_Array), 16);
+   eina_array_step_set(&smart->render_cache.render_objects,
+                       sizeof (Eina_Array), 16);
+   eina_inarray_step_set(&smart->render_cache.rect_del,
+                         sizeof (Eina_Inarray), sizeof (Eina_Bool), 16);
 
    eo_do_super(eo_obj, MY_CLASS, eo_constructor());
    evas_object_smart_init(eo_obj);
@@ -1006,6 +1022,90 @@ evas_object_smart_changed_get(Evas_Object *eo_obj)
    return EINA_FALSE;
 }
 
+/* Marks the cached phase 1 output of every smart ancestor of obj (and of
+ * obj itself) as stale. A smart object only holds a valid cache when all of
+ * its smart members do, so the walk stops at the first invalid ancestor. */
+void
+evas_object_smart_render_cache_invalidate(Evas_Object_Protected_Data *obj)
+{
+   Evas_Object *eo_parent;
+
+   if (obj->is_smart)
+     {
+        if (!obj->render_cache_valid) return;
+        obj->render_cache_valid = EINA_FALSE;
+     }
+
+   for (eo_parent = obj->smart.parent; eo_parent;
+        eo_parent = obj->smart.parent)
+     {
+        obj = eo_data_scope_get(eo_parent, EVAS_OBJECT_CLASS);
+        if ((!obj) || (!obj->render_cache_valid)) return;
+        obj->render_cache_valid = EINA_FALSE;
+     }
+}
+
+Eina_Bool
+evas_object_smart_render_cache_get(const Evas_Object *eo_obj, int validity,
+                                   const Eina_Array **active_objects,
+                                   const Eina_Array **render_objects,
+                                   const Eina_Inarray **rect_del)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+   Evas_Smart_Data *o;
+
+   if ((!obj) || (!obj->is_smart) || (!obj->render_cache_valid))
+     return EINA_FALSE;
+
+   o = eo_data_scope_get(eo_obj, MY_CLASS);
+   if (o->render_cache.validity != validity)
+     {
+        evas_object_smart_render_cache_invalidate(obj);
+        return EINA_FALSE;
+     }
+
+   *active_objects = &o->render_cache.active_objects;
+   *render_objects = &o->render_cache.render_objects;
+   *rect_del = &o->render_cache.rect_del;
+   return EINA_TRUE;
+}
+
+void
+evas_object_smart_render_cache_set(Evas_Object *eo_obj, int validity,
+                                   const Eina_Array *active_objects,
+                                   unsigned int active_first,
+                                   const Eina_Array *render_objects,
+                                   unsigned int render_first)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+   Evas_Smart_Data *o;
+   unsigned int i;
+
+   if ((!obj) || (!obj->is_smart) || (obj->delete_me)) return;
+
+   o = eo_data_scope_get(eo_obj, MY_CLASS);
+   eina_array_clean(&o->render_cache.active_objects);
+   eina_array_clean(&o->render_cache.render_objects);
+   eina_inarray_flush(&o->render_cache.rect_del);
+
+   for (i = active_first; i < eina_array_count(active_objects); i++)
+     if (!eina_array_push(&o->render_cache.active_objects,
+                          eina_array_data_get(active_objects, i)))
+       return;
+   for (i = render_first; i < eina_array_count(render_objects); i++)
+     {
+        Evas_Object_Protected_Data *obj2 = eina_array_data_get(render_objects, i);
+        Eina_Bool rect_del = obj2->rect_del;
+
+        if (!eina_array_push(&o->render_cache.render_objects, obj2)) return;
+        if (eina_inarray_push(&o->render_cache.rect_del, &rect_del) < 0)
+          return;
+     }
+
+   o->render_cache.validity = validity;
+   obj->render_cache_valid = EINA_TRUE;
+}
+
 void
 evas_object_smart_del(Evas_Object *eo_obj)
 {
@@ -1221,6 +1321,11 @@ evas_object_smart_cleanup(Evas_Object *eo_obj)
 
         evas_smart_cb_descriptions_resize(&o->callbacks_descriptions, 0);
         eo_do(eo_obj, evas_obj_smart_data_set(NULL));
+
+        obj->render_cache_valid = EINA_FALSE;
+        eina_array_flush(&o->render_cache.active_objects);
+        eina_array_flush(&o->render_cache.render_objects);
+        eina_inarray_flush(&o->render_cache.rect_del);
      }
 
    obj->smart.parent = NULL;
@@ -205,6 +205,12 @@ typedef struct _Evas_Object_Textblock_Format      Evas_Object_Textblock_Format;
  * A textblock selection iterator.
  */
 typedef struct _Evas_Textblock_Selection_Iterator Evas_Textblock_Selection_Iterator;
+/**
+ * @internal
+ * @typedef Evas_Textblock_Layout_Job
+ * A layout running off the main loop.
+ */
+typedef struct _Evas_Textblock_Layout_Job         Evas_Textblock_Layout_Job;
 /**
  * @internal
  * @def IS_AT_END(ti, ind)
@@ -359,10 +365,12 @@ struct _Evas_Object_Textblock_Paragraph
    Evas_BiDi_Paragraph_Props         *bidi_props; /**< Only valid during layout. */
    Evas_BiDi_Direction                direction;  /**< Bidi direction enum value. The display direction like right to left.*/
    Evas_Coord                         y, w, h;  /**< Text block co-ordinates. y co-ord, width and height. */
+   Evas_Coord                         last_fw;  /**< Formatted width this paragraph adds to the textblock. */
    int                                line_no;  /**< Line no of the text block. */
    Eina_Bool                          is_bidi : 1;  /**< EINA_TRUE if this is BiDi Paragraph, else EINA_FALSE. */
    Eina_Bool                          visible : 1;  /**< EINA_TRUE if paragraph visible, else EINA_FALSE. */
    Eina_Bool                          rendered : 1;  /**< EINA_TRUE if paragraph rendered, else EINA_FALSE. */
+   Eina_Bool                          base_format : 1;  /**< EINA_TRUE if no format was pushed when the paragraph started, else EINA_FALSE. */
 };
 
 struct _Evas_Object_Textblock_Line
@@ -491,6 +499,13 @@ struct _Evas_Object_Textblock
    int                                 num_paragraphs;
    Evas_Object_Textblock_Paragraph    *paragraphs;
    Evas_Object_Textblock_Paragraph    *par_index[TEXTBLOCK_PAR_INDEX_SIZE];
+   int                                 par_index_num; /* num_paragraphs when par_index was built */
+   struct {
+      Evas_Object_Textblock_Paragraph *first; /* where the next layout starts, NULL for the first paragraph */
+      int                              last_line; /* line_no of the last touched paragraph */
+      Eina_Bool                        set : 1;
+      Eina_Bool                        all : 1; /* can't tell, lay everything out */
+   } dirty;
 
    Evas_Object_Textblock_Text_Item    *ellip_ti;
    Eina_List                          *ellip_prev_it; /* item that is placed before ellipsis item (0.0 <= ellipsis < 1.0), if required */
@@ -509,6 +524,11 @@ struct _Evas_Object_Textblock
       int                              w, h, oneline_h;
       Eina_Bool                        valid : 1;
    } formatted, native;
+   struct {
+      Evas_Textblock_Layout_Job       *job; /* layout running in a thread, NULL if none */
+      Eina_Bool                        enabled : 1;
+      Eina_Bool                        copy : 1; /* this is the copy a job lays out */
+   } async;
    Eina_Bool                           redraw : 1;
    Eina_Bool                           changed : 1;
    Eina_Bool                           content_changed : 1;
@@ -517,6 +537,20 @@ struct _Evas_Object_Textblock
    Eina_Bool                           legacy_newline : 1;
 };
 
+struct _Evas_Textblock_Layout_Job
+{
+   Evas_Object                        *obj;
+   Evas_Textblock_Data                 o; /* layout is built here, content is shared */
+   Eina_Lock                           lock;
+   Eina_Condition                      cond;
+   int                                 w, h; /* object size it's laid out for */
+   int                                 formatted_w, formatted_h;
+   Eina_Bool                           cancel; /* checked while laying out */
+   Eina_Bool                           started : 1;
+   Eina_Bool                           done : 1;
+   Eina_Bool                           detached : 1; /* object is done with it */
+};
+
 struct _Evas_Textblock_Selection_Iterator
 {
    Eina_Iterator                       iterator; /**< Eina Iterator. */
@@ -604,7 +638,9 @@ static void _evas_textblock_node_format_remove(Evas_Textblock_Data *o, Evas_Obje
 static void _evas_textblock_node_format_free(Evas_Textblock_Data *o, Evas_Object_Textblock_Node_Format *n);
 static void _evas_textblock_node_text_free(Evas_Object_Textblock_Node_Text *n);
 static void _evas_textblock_changed(Evas_Textblock_Data *o, Evas_Object *eo_obj);
+static void _evas_textblock_dirty_add(Evas_Textblock_Data *o, Evas_Object_Textblock_Node_Text *n);
 static void _evas_textblock_invalidate_all(Evas_Textblock_Data *o);
+static void _layout_job_finish(Evas_Object *eo_obj, Evas_Textblock_Data *o, Eina_Bool apply);
 static void _evas_textblock_cursors_update_offset(const Evas_Textblock_Cursor *cur, const Evas_Object_Textblock_Node_Text *n, size_t start, int offset);
 static void _evas_textblock_cursors_set_node(Evas_Textblock_Data *o, const Evas_Object_Textblock_Node_Text *n, Evas_Object_Textblock_Node_Text *new_node);
 
@@ -779,6 +815,9 @@ static void
 _nodes_clear(const Evas_Object *eo_obj)
 {
    Evas_Textblock_Data *o = eo_data_scope_get(eo_obj, MY_CLASS);
+   /* Everything goes away, the pending layout too. */
+   _layout_job_finish((Evas_Object *) eo_obj, o, EINA_FALSE);
+   o->dirty.all = EINA_TRUE;
    while (o->text_nodes)
      {
 	Evas_Object_Textblock_Node_Text *n;
@@ -1313,13 +1352,13 @@ _format_clean_param(Eina_Tmpstr *s)
  * @internal
  * Parses the cmd and parameter and adds the parsed format to fmt.
  *
- * @param obj the evas object - should not be NULL.
+ * @param o the textblock data being laid out - should not be NULL.
  * @param fmt The format to populate - should not be NULL.
  * @param[in] cmd the command to process, should be stringshared.
  * @param[in] param the parameter of the command.
  */
 static void
-_format_command(Evas_Object *eo_obj, Evas_Object_Textblock_Format *fmt, const char *cmd, Eina_Tmpstr *param)
+_format_command(Evas_Textblock_Data *o, Evas_Object_Textblock_Format *fmt, const char *cmd, Eina_Tmpstr *param)
 {
    int len;
 
@@ -2262,7 +2301,6 @@ _format_command(Evas_Object *eo_obj, Evas_Object_Textblock_Format *fmt, const ch
           fmt->ellipsis = -1.0;
         else
           {
-             Evas_Textblock_Data *o = eo_data_scope_get(eo_obj, MY_CLASS);
              o->have_ellipsis = 1;
           }
      }
@@ -2446,12 +2484,12 @@ _format_parse(const char **s)
  * @internal
  * Parse the format str and populate fmt with the formats found.
  *
- * @param obj The evas object - Not NULL.
+ * @param o the textblock data being laid out - Not NULL.
  * @param[out] fmt The format to populate - Not NULL.
  * @param[in] str the string to parse.- Not NULL.
  */
 static void
-_format_fill(Evas_Object *eo_obj, Evas_Object_Textblock_Format *fmt, const char *str)
+_format_fill(Evas_Textblock_Data *o, Evas_Object_Textblock_Format *fmt, const char *str)
 {
    const char *s;
    const char *item;
@@ -2469,7 +2507,7 @@ _format_fill(Evas_Object *eo_obj, Evas_Object_Textblock_Format *fmt, const char
              Eina_Tmpstr *val = NULL;
 
              _format_param_parse(item, &key, &val);
-             if ((key) && (val)) _format_command(eo_obj, fmt, key, val);
+             if ((key) && (val)) _format_command(o, fmt, key, val);
              eina_stringshare_del(key);
              eina_tmpstr_del(val);
           }
@@ -2551,8 +2589,12 @@ struct _Ctxt
    int have_underline, have_underline2;
    double align, valign;
    Textblock_Position position;
+   Evas_Object_Textblock_Paragraph *clean_head; /* last untouched paragraph before the relaid out ones */
+   Evas_Object_Textblock_Paragraph *clean_tail; /* first untouched paragraph after them */
    Eina_Bool align_auto : 1;
    Eina_Bool width_changed : 1;
+   Eina_Bool incremental : 1;
+   Eina_Bool wmax_lost : 1;
 };
 
 static void _layout_text_add_logical_item(Ctxt *c, Evas_Object_Textblock_Text_Item *ti, Eina_List *rel);
@@ -2896,11 +2938,11 @@ _paragraph_clear(const Evas_Object *obj EINA_UNUSED,
 /**
  * @internal
  * Free the layout paragraph and all of it's lines and logical items.
+ * Keeping num_paragraphs in sync is up to the caller.
  */
 static void
 _paragraph_free(const Evas_Object *eo_obj, Evas_Object_Textblock_Paragraph *par)
 {
-   Evas_Textblock_Data *o = eo_data_scope_get(eo_obj, MY_CLASS);
    _paragraph_clear(eo_obj, par);
 
      {
@@ -2918,8 +2960,6 @@ _paragraph_free(const Evas_Object *eo_obj, Evas_Object_Textblock_Paragraph *par)
    if (par->text_node && (par->text_node->par == par))
       par->text_node->par = NULL;
 
-   o->num_paragraphs--;
-
    free(par);
 }
 
@@ -2955,8 +2995,6 @@ _paragraphs_free(const Evas_Object *eo_obj, Evas_Object_Textblock_Paragraph *par
 {
    Evas_Textblock_Data *o = eo_data_scope_get(eo_obj, MY_CLASS);
 
-   o->num_paragraphs = 0;
-
    while (pars)
      {
         Evas_Object_Textblock_Paragraph *par;
@@ -2965,6 +3003,11 @@ _paragraphs_free(const Evas_Object *eo_obj, Evas_Object_Textblock_Paragraph *par
         pars = (Evas_Object_Textblock_Paragraph *)eina_inlist_remove(EINA_INLIST_GET(pars), EINA_INLIST_GET(par));
         _paragraph_free(eo_obj, par);
      }
+
+   o->num_paragraphs = 0;
+   memset(o->par_index, 0, sizeof(o->par_index));
+   o->dirty.first = NULL;
+   o->dirty.all = EINA_TRUE;
 }
 
 /**
@@ -3104,7 +3147,7 @@ _layout_format_value_handle(Ctxt *c, Evas_Object_Textblock_Format *fmt, const ch
    Eina_Tmpstr *val = NULL;
 
    _format_param_parse(item, &key, &val);
-   if ((key) && (val)) _format_command(c->obj, fmt, key, val);
+   if ((key) && (val)) _format_command(c->o, fmt, key, val);
    if (key) eina_stringshare_del(key);
    if (val) eina_tmpstr_del(val);
    c->align = fmt->halign;
@@ -3504,6 +3547,8 @@ loop_advance:
            c->marginl + c->marginr - (c->o->style_pad.l + c->o->style_pad.r);
         if (new_wmax > c->wmax)
            c->wmax = new_wmax;
+        if (new_wmax > c->par->last_fw)
+           c->par->last_fw = new_wmax;
      }
 
    if (c->position == TEXTBLOCK_POSITION_START)
@@ -4754,6 +4799,10 @@ _layout_par(Ctxt *c)
              if (ln)
                 c->line_no = c->par->line_no + ln->line_no + 1;
 
+             /* Its lines still count towards the formatted width. */
+             if (c->par->last_fw > c->wmax)
+                c->wmax = c->par->last_fw;
+
              /* After this par we are no longer at the beginning, as there
               * must be some text in the par. */
              if (c->position == TEXTBLOCK_POSITION_START)
@@ -4791,6 +4840,7 @@ _layout_par(Ctxt *c)
      }
 
    c->y = c->par->y;
+   c->par->last_fw = 0;
 
 
 #ifdef BIDI_SUPPORT
@@ -5098,12 +5148,11 @@ end:
  * This goes through all the new format changes and marks the text nodes
  * that should be invalidated because of format changes.
  *
- * @param c the working context.
+ * @param fnode the format node to start at, there are no new ones before it.
  */
 static inline void
-_format_changes_invalidate_text_nodes(Ctxt *c)
+_format_changes_invalidate_text_nodes(Evas_Object_Textblock_Node_Format *fnode)
 {
-   Evas_Object_Textblock_Node_Format *fnode = c->o->format_nodes;
    Evas_Object_Textblock_Node_Text *start_n = NULL;
    Eina_List *fstack = NULL;
    int balance = 0;
@@ -5253,6 +5302,115 @@ _layout_split_text_because_format(const Evas_Object_Textblock_Format *fmt,
    return EINA_FALSE;
 }
 
+/**
+ * @internal
+ * Called right before the layout frees a paragraph: point the index entries
+ * at it to repl instead, and remember if it was the widest one.
+ *
+ * @param c the working context.
+ * @param par the paragraph that is going away.
+ * @param repl the paragraph that takes its place, can be NULL.
+ */
+static void
+_layout_paragraph_forget(Ctxt *c, Evas_Object_Textblock_Paragraph *par,
+      Evas_Object_Textblock_Paragraph *repl)
+{
+   int i;
+
+   for (i = 0 ; i < TEXTBLOCK_PAR_INDEX_SIZE ; i++)
+     {
+        if (c->o->par_index[i] == par)
+           c->o->par_index[i] = repl;
+     }
+   if (par->last_fw >= c->o->formatted.w)
+      c->wmax_lost = EINA_TRUE;
+}
+
+/**
+ * @internal
+ * Rebuild the paragraph index from scratch.
+ *
+ * @param o the textblock object.
+ */
+static void
+_layout_par_index_update(Evas_Textblock_Data *o)
+{
+   Evas_Object_Textblock_Paragraph *par;
+   int par_index_step = o->num_paragraphs / TEXTBLOCK_PAR_INDEX_SIZE;
+   int par_count = 1; /* Force it to take the first one */
+   int par_index_pos = 0;
+
+   if (par_index_step == 0) par_index_step = 1;
+
+   memset(o->par_index, 0, sizeof(o->par_index));
+   EINA_INLIST_FOREACH(o->paragraphs, par)
+     {
+        if (par_index_pos >= TEXTBLOCK_PAR_INDEX_SIZE)
+           break;
+        if (--par_count == 0)
+          {
+             par_count = par_index_step;
+             o->par_index[par_index_pos++] = par;
+          }
+     }
+   o->par_index_num = o->num_paragraphs;
+}
+
+/**
+ * @internal
+ * Move the paragraphs from c->par on so they follow the ones that were just
+ * laid out. Their own layout is still valid, only their position and line
+ * numbers change.
+ *
+ * @param c the working context.
+ */
+static void
+_layout_paragraphs_shift(Ctxt *c)
+{
+   Evas_Object_Textblock_Paragraph *par, *prev;
+   Evas_Coord dy;
+   int dl;
+
+   prev = (Evas_Object_Textblock_Paragraph *) EINA_INLIST_GET(c->par)->prev;
+   dy = (prev) ? (prev->y + prev->h - c->par->y) : -c->par->y;
+   dl = c->line_no - c->par->line_no;
+   if (!dy && !dl) return;
+
+   for (par = c->par ; par ;
+        par = (Evas_Object_Textblock_Paragraph *) EINA_INLIST_GET(par)->next)
+     {
+        par->y += dy;
+        par->line_no += dl;
+     }
+}
+
+/**
+ * @internal
+ * Check if the layout job the context is running in was called off. The
+ * layout is thrown away then, so it can stop anywhere.
+ *
+ * @param c the working context.
+ */
+static inline Eina_Bool
+_layout_cancelled(const Ctxt *c)
+{
+   return c->o->async.copy && c->o->async.job->cancel;
+}
+
+/**
+ * @internal
+ * Check if the next layout can start from the range of paragraphs touched
+ * since the last one, see _layout_pre().
+ */
+static inline Eina_Bool
+_layout_can_continue(const Evas_Textblock_Data *o)
+{
+   return o->content_changed && o->dirty.set && !o->dirty.all &&
+      o->paragraphs && !o->have_ellipsis &&
+      !o->style_pad.l && !o->style_pad.r &&
+      !o->style_pad.t && !o->style_pad.b;
+}
+
 /** FIXME: Document */
 static void
 _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
@@ -5260,26 +5418,58 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
 {
    Evas_Object *eo_obj = c->obj;
    Evas_Textblock_Data *o = c->o;
+   Evas_Object_Textblock_Node_Text *n = o->text_nodes;
+   Evas_Object_Textblock_Node_Format *fnode = o->format_nodes;
+   /* With no paragraphs to reuse (e.g in a layout job, which starts from
+    * scratch), every node is laid out as a new one. */
+   Eina_Bool rebuild = !o->paragraphs;
+
+   c->par = c->paragraphs = o->paragraphs;
+
+   /* If only a range of paragraphs was touched since the last layout, start
+    * right before it. That's only possible if nothing that came before
+    * pushed a format or added padding, as we don't keep those around. */
+   if (_layout_can_continue(o))
+     {
+        Evas_Object_Textblock_Paragraph *first = o->dirty.first;
+
+        if (!first)
+          {
+             c->incremental = EINA_TRUE;
+          }
+        else if (first->base_format && first->text_node &&
+                 (first->text_node->par == first) &&
+                 !first->text_node->is_new)
+          {
+             c->incremental = EINA_TRUE;
+             c->clean_head = (Evas_Object_Textblock_Paragraph *)
+                EINA_INLIST_GET(first)->prev;
+             c->par = first;
+             n = first->text_node;
+             if (n->format_node)
+                fnode = n->format_node;
+          }
+     }
 
    /* Mark text nodes as dirty if format have changed. */
    if (o->format_changed)
-     _format_changes_invalidate_text_nodes(c);
+     _format_changes_invalidate_text_nodes(fnode);
 
    if (o->content_changed)
      {
-        Evas_Object_Textblock_Node_Text *n;
         c->o->have_ellipsis = 0;
-        c->par = c->paragraphs = o->paragraphs;
         /* Go through all the text nodes to create the logical layout */
-        EINA_INLIST_FOREACH(c->o->text_nodes, n)
+        for ( ; n ; n = _NODE_TEXT(EINA_INLIST_GET(n)->next))
           {
-             Evas_Object_Textblock_Node_Format *fnode;
              size_t start;
              int off;
 
+             if (_layout_cancelled(c))
+                break;
+
              /* If it's not a new paragraph, either update it or skip it.
               * Remove all the paragraphs that were deleted */
-             if (!n->is_new)
+             if (!n->is_new && !rebuild)
                {
                   /* Remove all the deleted paragraphs at this point */
                   while (c->par->text_node != n)
@@ -5288,14 +5478,25 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
                           (Evas_Object_Textblock_Paragraph *)
                           EINA_INLIST_GET(c->par)->next;
 
+                       _layout_paragraph_forget(c, c->par, tmp_par);
                        c->paragraphs = (Evas_Object_Textblock_Paragraph *)
                           eina_inlist_remove(EINA_INLIST_GET(c->paragraphs),
                                 EINA_INLIST_GET(c->par));
                        _paragraph_free(eo_obj, c->par);
+                       o->num_paragraphs--;
 
                        c->par = tmp_par;
                     }
 
+                  /* Past the touched range, the rest is up to date. */
+                  if (c->incremental && !n->dirty &&
+                      (c->par->line_no > o->dirty.last_line) &&
+                      !c->format_stack->next)
+                    {
+                       c->clean_tail = c->par;
+                       break;
+                    }
+
                   /* If it's dirty, remove and recreate, if it's clean,
                    * skip to the next. */
                   if (n->dirty)
@@ -5304,13 +5505,16 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
 
                        _layout_paragraph_new(c, n, EINA_TRUE);
 
+                       _layout_paragraph_forget(c, prev_par, c->par);
                        c->paragraphs = (Evas_Object_Textblock_Paragraph *)
                           eina_inlist_remove(EINA_INLIST_GET(c->paragraphs),
                                 EINA_INLIST_GET(prev_par));
                        _paragraph_free(eo_obj, prev_par);
+                       o->num_paragraphs--;
                     }
                   else
                     {
+                       c->par->base_format = !c->format_stack->next;
                        c->par = (Evas_Object_Textblock_Paragraph *)
                           EINA_INLIST_GET(c->par)->next;
 
@@ -5344,6 +5548,7 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
                   /* If it's a new paragraph, just add it. */
                   _layout_paragraph_new(c, n, EINA_FALSE);
                }
+             c->par->base_format = !c->format_stack->next;
 
 #ifdef BIDI_SUPPORT
              _layout_update_bidi_props(c->o, c->par);
@@ -5420,16 +5625,18 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
           }
 
         /* Delete the rest of the layout paragraphs */
-        while (c->par)
+        while (c->par && !c->clean_tail)
           {
              Evas_Object_Textblock_Paragraph *tmp_par =
                 (Evas_Object_Textblock_Paragraph *)
                 EINA_INLIST_GET(c->par)->next;
 
+             _layout_paragraph_forget(c, c->par, NULL);
              c->paragraphs = (Evas_Object_Textblock_Paragraph *)
                 eina_inlist_remove(EINA_INLIST_GET(c->paragraphs),
                       EINA_INLIST_GET(c->par));
              _paragraph_free(eo_obj, c->par);
+             o->num_paragraphs--;
 
              c->par = tmp_par;
           }
@@ -5450,21 +5657,20 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
  * Create the layout from the nodes.
  *
  * @param obj the evas object - NOT NULL.
- * @param calc_only true if should only calc sizes false if should also create the layout.. It assumes native size is being calculated, doesn't support formatted size atm.
+ * @param o the textblock data to lay out, the object's own or a job's copy.
  * @param w the object's w, -1 means no wrapping (i.e infinite size)
  * @param h the object's h, -1 means inifinte size.
  * @param w_ret the object's calculated w.
  * @param h_ret the object's calculated h.
  */
 static void
-_layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
+_layout(const Evas_Object *eo_obj, Evas_Textblock_Data *o, int w, int h,
+      int *w_ret, int *h_ret)
 {
-   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
-   Evas_Textblock_Data *o = eo_data_ref(eo_obj, MY_CLASS);
    Ctxt ctxt, *c;
    int style_pad_l = 0, style_pad_r = 0, style_pad_t = 0, style_pad_b = 0;
 
-   LYDBG("ZZ: layout %p %4ix%4i | w=%4i | last_w=%4i --- '%s'\n", eo_obj, w, h, obj->cur->geometry.w, o->last_w, o->markup_text);
+   LYDBG("ZZ: layout %p %4ix%4i | last_w=%4i --- '%s'\n", eo_obj, w, h, o->last_w, o->markup_text);
    /* setup context */
    c = &ctxt;
    c->obj = (Evas_Object *)eo_obj;
@@ -5486,7 +5692,10 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
    c->align = 0.0;
    c->align_auto = EINA_TRUE;
    c->ln = NULL;
-   c->width_changed = (obj->cur->geometry.w != o->last_w);
+   c->clean_head = c->clean_tail = NULL;
+   c->width_changed = (w != o->last_w);
+   c->incremental = EINA_FALSE;
+   c->wmax_lost = EINA_FALSE;
 
    /* Start of logical layout creation */
    /* setup default base style */
@@ -5495,7 +5704,7 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
         if ((c->o->style) && (c->o->style->default_tag))
           {
              c->fmt = _layout_format_push(c, NULL, NULL);
-             _format_fill(c->obj, c->fmt, c->o->style->default_tag);
+             _format_fill(c->o, c->fmt, c->o->style->default_tag);
              finalize = EINA_TRUE;
           }
 
@@ -5505,7 +5714,7 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
                {
                   c->fmt = _layout_format_push(c, NULL, NULL);
                }
-             _format_fill(c->obj, c->fmt, c->o->style_user->default_tag);
+             _format_fill(c->o, c->fmt, c->o->style_user->default_tag);
              finalize = EINA_TRUE;
           }
 
@@ -5550,14 +5759,50 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
       int par_index_pos = 0;
 
       c->position = TEXTBLOCK_POSITION_START;
+      c->par = c->paragraphs;
 
-      if (par_index_step == 0) par_index_step = 1;
+      /* Paragraphs around the relaid out ones don't move sideways, so the
+       * ones before can be left alone and the ones after just slide. */
+      c->incremental = c->incremental && !c->width_changed &&
+         !o->have_ellipsis && !(o->valign > 0.0);
+      if (c->incremental)
+        {
+           if (c->clean_head)
+             {
+                Evas_Object_Textblock_Line *ln;
+
+                ln = (Evas_Object_Textblock_Line *)
+                   EINA_INLIST_GET(c->clean_head->lines)->last;
+                if (ln)
+                   c->line_no = c->clean_head->line_no + ln->line_no + 1;
+                c->position = TEXTBLOCK_POSITION_ELSE;
+                c->par = (Evas_Object_Textblock_Paragraph *)
+                   EINA_INLIST_GET(c->clean_head)->next;
+             }
+        }
+      else
+        {
+           if (par_index_step == 0) par_index_step = 1;
 
-      /* Clear all of the index */
-      memset(o->par_index, 0, sizeof(o->par_index));
+           /* Clear all of the index */
+           memset(o->par_index, 0, sizeof(o->par_index));
+           o->par_index_num = o->num_paragraphs;
+        }
 
-      EINA_INLIST_FOREACH(c->paragraphs, c->par)
+      for ( ; c->par ;
+            c->par = (Evas_Object_Textblock_Paragraph *)
+            EINA_INLIST_GET(c->par)->next)
         {
+           if (_layout_cancelled(c))
+              break;
+
+           if (c->incremental && (c->par == c->clean_tail))
+             {
+                _layout_paragraphs_shift(c);
+                c->par = NULL;
+                break;
+             }
+
            _layout_update_par(c);
 
            /* Break if we should stop here. */
@@ -5567,7 +5812,8 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
                 break;
              }
 
-           if ((par_index_pos < TEXTBLOCK_PAR_INDEX_SIZE) && (--par_count == 0))
+           if (!c->incremental && (par_index_pos < TEXTBLOCK_PAR_INDEX_SIZE) &&
+               (--par_count == 0))
              {
                 par_count = par_index_step;
 
@@ -5575,6 +5821,41 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
              }
         }
 
+      if (c->incremental)
+        {
+           int drift = o->num_paragraphs - o->par_index_num;
+
+           if (abs(drift) > (o->par_index_num / TEXTBLOCK_PAR_INDEX_SIZE))
+              _layout_par_index_update(o);
+
+           /* c->wmax only covers what was laid out now. If the widest
+            * paragraph went away and nothing as wide replaced it, look for
+            * the new widest one. */
+           if (c->wmax < o->formatted.w)
+             {
+                if (c->wmax_lost)
+                  {
+                     Evas_Object_Textblock_Paragraph *par;
+
+                     EINA_INLIST_FOREACH(c->paragraphs, par)
+                       {
+                          if (par->last_fw > c->wmax)
+                             c->wmax = par->last_fw;
+                       }
+                  }
+                else
+                  {
+                     c->wmax = o->formatted.w;
+                  }
+             }
+        }
+
+      /* Only a layout that went through all of the paragraphs can be
+       * continued from. */
+      o->dirty.first = NULL;
+      o->dirty.set = EINA_FALSE;
+      o->dirty.all = (last_vis_par || o->have_ellipsis);
+
       /* Mark all the rest of the paragraphs as invisible */
       if (c->par)
         {
@@ -5590,8 +5871,22 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
 
       /* Get the last visible paragraph in the layout */
       if (!last_vis_par && c->paragraphs)
-         last_vis_par = (Evas_Object_Textblock_Paragraph *)
-            EINA_INLIST_GET(c->paragraphs)->last;
+        {
+           last_vis_par = (Evas_Object_Textblock_Paragraph *)
+              EINA_INLIST_GET(c->paragraphs)->last;
+
+           /* If it was skipped as unchanged, its last line is measured as
+            * the end of the textblock here, like a full layout does. */
+           if ((c->position != TEXTBLOCK_POSITION_END) &&
+               (c->position != TEXTBLOCK_POSITION_SINGLE))
+             {
+                c->position = ((last_vis_par == c->paragraphs) &&
+                      last_vis_par->lines &&
+                      !EINA_INLIST_GET(last_vis_par->lines)->next) ?
+                   TEXTBLOCK_POSITION_SINGLE : TEXTBLOCK_POSITION_END;
+                c->descent = c->maxdescent = 0;
+             }
+        }
 
       if (last_vis_par)
         {
@@ -5622,16 +5917,18 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
           }
      }
 
-   if ((o->style_pad.l != style_pad_l) || (o->style_pad.r != style_pad_r) ||
-       (o->style_pad.t != style_pad_t) || (o->style_pad.b != style_pad_b))
+   if (((o->style_pad.l != style_pad_l) || (o->style_pad.r != style_pad_r) ||
+        (o->style_pad.t != style_pad_t) || (o->style_pad.b != style_pad_b)) &&
+       !_layout_cancelled(c))
      {
         o->style_pad.l = style_pad_l;
         o->style_pad.r = style_pad_r;
         o->style_pad.t = style_pad_t;
         o->style_pad.b = style_pad_b;
         _paragraphs_clear(eo_obj, c->paragraphs);
+        o->dirty.all = EINA_TRUE;
         LYDBG("ZZ: ... layout #2\n");
-        _layout(eo_obj, w, h, w_ret, h_ret);
+        _layout(eo_obj, o, w, h, w_ret, h_ret);
      }
 }
 
@@ -5646,7 +5943,7 @@ _relayout(const Evas_Object *eo_obj)
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    Evas_Textblock_Data *o = eo_data_scope_get(eo_obj, MY_CLASS);
-   _layout(eo_obj, obj->cur->geometry.w, obj->cur->geometry.h,
+   _layout(eo_obj, o, obj->cur->geometry.w, obj->cur->geometry.h,
          &o->formatted.w, &o->formatted.h);
    o->formatted.valid = 1;
    o->formatted.oneline_h = 0;
@@ -5668,6 +5965,293 @@ _relayout(const Evas_Object *eo_obj)
    o->redraw = 1;
 }
 
+/*
+ * @internal
+ * Lay the job's copy of the textblock out.
+ */
+static void
+_layout_job_run(Evas_Textblock_Layout_Job *job)
+{
+   _layout(job->obj, &job->o, job->w, job->h,
+         &job->formatted_w, &job->formatted_h);
+
+   eina_lock_take(&job->lock);
+   job->done = EINA_TRUE;
+   eina_condition_broadcast(&job->cond);
+   eina_lock_release(&job->lock);
+}
+
+static void
+_layout_job_heavy(void *data)
+{
+   Evas_Textblock_Layout_Job *job = data;
+
+   /* The main loop may have taken it over already. */
+   eina_lock_take(&job->lock);
+   if (job->started)
+     {
+        eina_lock_release(&job->lock);
+        return;
+     }
+   job->started = EINA_TRUE;
+   eina_lock_release(&job->lock);
+
+   _layout_job_run(job);
+}
+
+static void
+_layout_job_free(Evas_Textblock_Layout_Job *job)
+{
+   eina_condition_free(&job->cond);
+   eina_lock_free(&job->lock);
+   free(job);
+}
+
+/*
+ * @internal
+ * Replace the layout of the object with the one the job built.
+ */
+static void
+_layout_job_apply(Evas_Object *eo_obj, Evas_Textblock_Data *o,
+      Evas_Textblock_Layout_Job *job)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+
+   /* The render thread may still be drawing the old one. */
+   evas_object_async_block(obj);
+   if (o->paragraphs) _paragraphs_free(eo_obj, o->paragraphs);
+   if (o->ellip_ti) _item_free(eo_obj, NULL, _ITEM(o->ellip_ti));
+
+   o->paragraphs = job->o.paragraphs;
+   o->num_paragraphs = job->o.num_paragraphs;
+   memcpy(o->par_index, job->o.par_index, sizeof(o->par_index));
+   o->par_index_num = job->o.par_index_num;
+   o->dirty = job->o.dirty;
+   o->style_pad = job->o.style_pad;
+   o->ellip_ti = job->o.ellip_ti;
+   o->ellip_prev_it = job->o.ellip_prev_it;
+   o->have_ellipsis = job->o.have_ellipsis;
+
+   o->formatted.w = job->formatted_w;
+   o->formatted.h = job->formatted_h;
+   o->formatted.oneline_h = 0;
+   o->last_w = job->w;
+   o->last_h = job->h;
+   if ((o->paragraphs) && (!EINA_INLIST_GET(o->paragraphs)->next) &&
+       (o->paragraphs->lines) && (!EINA_INLIST_GET(o->paragraphs->lines)->next))
+     {
+        if (job->h < o->formatted.h)
+           o->formatted.oneline_h = o->formatted.h;
+     }
+   /* Still valid, unless the object was resized in the meantime. */
+   o->formatted.valid = !o->changed;
+   o->redraw = 1;
+   evas_object_change(eo_obj, obj);
+}
+
+/*
+ * @internal
+ * Throw the layout the job built away, and make sure the next layout goes
+ * through everything again: the job already marked the nodes as laid out.
+ */
+static void
+_layout_job_drop(Evas_Textblock_Data *o, Evas_Textblock_Layout_Job *job)
+{
+   Evas_Object_Textblock_Paragraph *par;
+   Evas_Object_Textblock_Node_Text *n;
+
+   while (job->o.paragraphs)
+     {
+        par = job->o.paragraphs;
+        job->o.paragraphs = (Evas_Object_Textblock_Paragraph *)
+           eina_inlist_remove(EINA_INLIST_GET(job->o.paragraphs),
+                 EINA_INLIST_GET(par));
+        _paragraph_free(job->obj, par);
+     }
+   if (job->o.ellip_ti) _item_free(job->obj, NULL, _ITEM(job->o.ellip_ti));
+
+   EINA_INLIST_FOREACH(o->paragraphs, par)
+     {
+        if (par->text_node) par->text_node->par = par;
+     }
+   EINA_INLIST_FOREACH(o->text_nodes, n)
+     {
+        if (!n->par) n->is_new = EINA_TRUE;
+     }
+   _evas_textblock_invalidate_all(o);
+   o->content_changed = 1;
+   o->formatted.valid = 0;
+}
+
+/*
+ * @internal
+ * Take the pending layout job back from the thread, waiting for it if it
+ * already started, and either apply its layout or drop it.
+ *
+ * @param eo_obj the textblock object.
+ * @param o the textblock data.
+ * @param apply EINA_TRUE to use the layout, EINA_FALSE to throw it away.
+ */
+static void
+_layout_job_finish(Evas_Object *eo_obj, Evas_Textblock_Data *o, Eina_Bool apply)
+{
+   Evas_Textblock_Layout_Job *job = o->async.job;
+   Eina_Bool run = EINA_FALSE;
+
+   if (!job) return;
+   o->async.job = NULL;
+
+   eina_lock_take(&job->lock);
+   if (!job->started)
+     {
+        /* Still queued, don't wait for a thread to pick it up. */
+        job->started = EINA_TRUE;
+        if (apply) run = EINA_TRUE;
+        else job->done = EINA_TRUE;
+     }
+   else
+     {
+        if (!apply) job->cancel = EINA_TRUE;
+        while (!job->done)
+           eina_condition_wait(&job->cond);
+     }
+   /* The end callback still comes, it only frees the job now. */
+   job->detached = EINA_TRUE;
+   eina_lock_release(&job->lock);
+
+   if (run) _layout_job_run(job);
+   if (apply) _layout_job_apply(eo_obj, o, job);
+   else _layout_job_drop(o, job);
+}
+
+static void
+_layout_job_end(void *data)
+{
+   Evas_Textblock_Layout_Job *job = data;
+
+   if (!job->detached)
+     {
+        Evas_Textblock_Data *o = eo_data_scope_get(job->obj, MY_CLASS);
+
+        o->async.job = NULL;
+        _layout_job_apply(job->obj, o, job);
+     }
+   _layout_job_free(job);
+}
+
+static void
+_layout_job_cancel(void *data)
+{
+   Evas_Textblock_Layout_Job *job = data;
+
+   /* No thread could take it, it never started: the object lays itself
+    * out in place instead. */
+   if (!job->detached)
+     {
+        Evas_Textblock_Data *o = eo_data_scope_get(job->obj, MY_CLASS);
+
+        o->async.job = NULL;
+     }
+   _layout_job_free(job);
+}
+
+/*
+ * @internal
+ * Start laying the object out in a thread, for its current size. The object
+ * keeps showing its current layout until the job is done.
+ *
+ * @return EINA_TRUE if the job was started.
+ */
+static Eina_Bool
+_layout_job_start(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj,
+      Evas_Textblock_Data *o)
+{
+   Evas_Textblock_Layout_Job *job;
+
+   job = calloc(1, sizeof(Evas_Textblock_Layout_Job));
+   if (!job) return EINA_FALSE;
+   if (!eina_lock_new(&job->lock))
+     {
+        free(job);
+        return EINA_FALSE;
+     }
+   if (!eina_condition_new(&job->cond, &job->lock))
+     {
+        eina_lock_free(&job->lock);
+        free(job);
+        return EINA_FALSE;
+     }
+   job->obj = eo_obj;
+   job->w = obj->cur->geometry.w;
+   job->h = obj->cur->geometry.h;
+
+   /* The copy shares the content and starts with no layout at all. */
+   job->o = *o;
+   job->o.paragraphs = NULL;
+   job->o.num_paragraphs = 0;
+   memset(job->o.par_index, 0, sizeof(job->o.par_index));
+   job->o.par_index_num = 0;
+   job->o.dirty.first = NULL;
+   job->o.dirty.set = EINA_FALSE;
+   job->o.dirty.all = EINA_TRUE;
+   job->o.ellip_ti = NULL;
+   job->o.ellip_prev_it = NULL;
+   job->o.content_changed = 1;
+   job->o.async.job = job;
+   job->o.async.copy = EINA_TRUE;
+
+   o->async.job = job;
+   if (!evas_preload_thread_run(_layout_job_heavy, _layout_job_end,
+                                _layout_job_cancel, job))
+     {
+        /* No new thread, but the job may still be queued for one that is
+         * already running: take it back before laying out in place. */
+        if (o->async.job == job) _layout_job_finish(eo_obj, o, EINA_FALSE);
+        return EINA_FALSE;
+     }
+
+   o->last_w = job->w;
+   o->last_h = job->h;
+   o->changed = 0;
+   o->content_changed = 0;
+   o->format_changed = EINA_FALSE;
+   return EINA_TRUE;
+}
+
+/*
+ * @internal
+ * Make sure no layout job is working on the object anymore, using its
+ * layout if there was one. Anything that changes the content or the format
+ * of the object has to call this first.
+ */
+static inline void
+_evas_textblock_async_block(Evas_Textblock_Data *o)
+{
+   if (o->async.job) _layout_job_finish(o->async.job->obj, o, EINA_TRUE);
+}
+
+/*
+ * @internal
+ * Relayout the object in a thread if it asked for it and it's worth it.
+ *
+ * @return EINA_TRUE if a layout job is taking care of it.
+ */
+static Eina_Bool
+_relayout_async(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj,
+      Evas_Textblock_Data *o)
+{
+   if (!o->async.enabled) return EINA_FALSE;
+   if (o->async.job) return EINA_TRUE;
+
+   /* Relayouts that don't go through every paragraph again are cheap,
+    * they are done in place. */
+   if ((obj->cur->geometry.w == o->last_w) && !(o->valign > 0.0) &&
+       (!o->content_changed || _layout_can_continue(o)))
+     return EINA_FALSE;
+
+   return _layout_job_start(eo_obj, obj, o);
+}
+
 /*
  * @internal
  * Check if the object needs a relayout, and if so, execute it.
@@ -5677,6 +6261,8 @@ _relayout_if_needed(Evas_Object *eo_obj, const Evas_Textblock_Data *o)
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
 
+   if (o->async.job)
+     _layout_job_finish(eo_obj, eo_data_scope_get(eo_obj, MY_CLASS), EINA_TRUE);
    evas_object_textblock_coords_recalc(eo_obj, obj, obj->private_data);
    if (!o->formatted.valid)
      {
@@ -6006,6 +6592,7 @@ _textblock_style_generic_set(Evas_Object *eo_obj, Evas_Textblock_Style *ts,
       Evas_Textblock_Style **obj_ts)
 {
    TB_HEAD();
+   _evas_textblock_async_block(o);
    if (ts == *obj_ts) return;
    if ((ts) && (ts->delete_me)) return;
    if (*obj_ts)
@@ -6100,6 +6687,7 @@ _evas_textblock_replace_char_set(Eo *eo_obj, Evas_Textblock_Data *o, const char
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _evas_textblock_async_block(o);
    if (o->repch) eina_stringshare_del(o->repch);
    if (ch) o->repch = eina_stringshare_add(ch);
    else o->repch = NULL;
@@ -6112,6 +6700,7 @@ _evas_textblock_legacy_newline_set(Eo *eo_obj EINA_UNUSED, Evas_Textblock_Data *
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _evas_textblock_async_block(o);
    if (o->legacy_newline == mode)
       return;
 
@@ -6131,10 +6720,12 @@ _evas_textblock_valign_set(Eo *eo_obj, Evas_Textblock_Data *o, double align)
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _evas_textblock_async_block(o);
    if (align < 0.0) align = 0.0;
    else if (align > 1.0) align = 1.0;
    if (o->valign == align) return;
    o->valign = align;
+   o->dirty.all = EINA_TRUE;
    _evas_textblock_changed(o, eo_obj);
 }
 
@@ -6149,6 +6740,7 @@ _evas_textblock_bidi_delimiters_set(Eo *eo_obj EINA_UNUSED, Evas_Textblock_Data
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _evas_textblock_async_block(o);
    eina_stringshare_replace(&o->bidi_delimiters, delim);
 }
 
@@ -6412,6 +7004,7 @@ evas_object_textblock_text_markup_prepend(Evas_Textblock_Cursor *cur, const char
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
    TB_HEAD();
+   _evas_textblock_async_block(o);
    if (text)
      {
         char *s, *p;
@@ -6879,6 +7472,7 @@ _evas_textblock_nodes_merge(Evas_Textblock_Data *o, Evas_Object_Textblock_Node_T
    int to_len, len;
 
    if (!to) return;
+   _evas_textblock_dirty_add(o, to);
    from = _NODE_TEXT(EINA_INLIST_GET(to)->next);
 
    to_len = eina_ustrbuf_length_get(to->unicode);
@@ -7223,6 +7817,7 @@ _evas_textblock_node_format_remove_pair(Eo *eo_obj, Evas_Textblock_Data *o, Evas
 
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _evas_textblock_async_block(o);
    do
      {
         const char *fstr = fmt->orig_format;
@@ -7308,6 +7903,7 @@ found:
         while (tnode1)
           {
              tnode1->dirty = EINA_TRUE;
+             _evas_textblock_dirty_add(o, tnode1);
              if (tnode1 == tnode2)
                 break;
              tnode1 =
@@ -8169,6 +8765,7 @@ _evas_textblock_node_text_get_first_format_between(
 static void
 _evas_textblock_node_text_remove(Evas_Textblock_Data *o, Evas_Object_Textblock_Node_Text *n)
 {
+   _evas_textblock_dirty_add(o, n);
    _evas_textblock_node_text_adjust_offsets_to_start(o, n, 0, -1);
 
    o->text_nodes = _NODE_TEXT(eina_inlist_remove(
@@ -8411,6 +9008,7 @@ _evas_textblock_cursor_break_paragraph(Evas_Textblock_Cursor *cur,
                    EINA_INLIST_GET(o->text_nodes),
                    EINA_INLIST_GET(n),
                    EINA_INLIST_GET(cur->node)));
+   _evas_textblock_dirty_add(o, n);
    /* Handle text and format changes. */
    if (cur->node)
      {
@@ -8579,10 +9177,65 @@ _evas_textblock_invalidate_all(Evas_Textblock_Data *o)
 {
    Evas_Object_Textblock_Node_Text *n;
 
+   _evas_textblock_async_block(o);
    EINA_INLIST_FOREACH(o->text_nodes, n)
      {
         n->dirty = EINA_TRUE;
      }
+   o->dirty.all = EINA_TRUE;
+}
+
+/**
+ * @internal
+ * Grow the range of paragraphs the next layout has to go through so it
+ * covers the text node n, which was just added or is about to be changed or
+ * removed. Paragraphs outside of that range keep their layout.
+ *
+ * @param o the textblock object.
+ * @param n the text node.
+ */
+static void
+_evas_textblock_dirty_add(Evas_Textblock_Data *o,
+      Evas_Object_Textblock_Node_Text *n)
+{
+   Evas_Object_Textblock_Paragraph *first = NULL;
+   int line = -1;
+
+   if (o->dirty.all) return;
+
+   /* A node that was never laid out goes with the node before it. If that
+    * one is new as well, it was already added. */
+   if (n && n->is_new)
+     {
+        n = _NODE_TEXT(EINA_INLIST_GET(n)->prev);
+        if (n && n->is_new) return;
+     }
+
+   if (n)
+     {
+        if (!n->par || (n->par->text_node != n))
+          {
+             o->dirty.all = EINA_TRUE;
+             return;
+          }
+        /* Start one paragraph earlier, n's own paragraph may go away. */
+        first = (Evas_Object_Textblock_Paragraph *)
+           EINA_INLIST_GET(n->par)->prev;
+        line = n->par->line_no;
+     }
+
+   if (!o->dirty.set)
+     {
+        o->dirty.first = first;
+        o->dirty.last_line = line;
+        o->dirty.set = EINA_TRUE;
+        return;
+     }
+   if (o->dirty.first &&
+       (!first || (first->line_no < o->dirty.first->line_no)))
+      o->dirty.first = first;
+   if (line > o->dirty.last_line)
+      o->dirty.last_line = line;
 }
 
 EAPI int
@@ -8598,6 +9251,7 @@ evas_textblock_cursor_text_append(Evas_Textblock_Cursor *cur, const char *_text)
    evas_object_async_block(obj);
    text = eina_unicode_utf8_to_unicode(_text, &len);
    Evas_Textblock_Data *o = eo_data_scope_get(cur->obj, MY_CLASS);
+   _evas_textblock_async_block(o);
 
    n = cur->node;
    if (n)
@@ -8652,6 +9306,7 @@ evas_textblock_cursor_text_append(Evas_Textblock_Cursor *cur, const char *_text)
 
    _evas_textblock_changed(o, cur->obj);
    n->dirty = EINA_TRUE;
+   _evas_textblock_dirty_add(o, n);
    free(text);
 
    if (!o->cursor->node)
@@ -8850,6 +9505,7 @@ evas_textblock_cursor_format_append(Evas_Textblock_Cursor *cur, const char *form
    evas_object_async_block(obj);
    if ((!format) || (format[0] == 0)) return EINA_FALSE;
    Evas_Textblock_Data *o = eo_data_scope_get(cur->obj, MY_CLASS);
+   _evas_textblock_async_block(o);
    /* We should always have at least one text node */
    if (!o->text_nodes)
      {
@@ -8967,6 +9623,7 @@ evas_textblock_cursor_format_append(Evas_Textblock_Cursor *cur, const char *form
         o->format_changed = EINA_TRUE;
      }
 
+   _evas_textblock_dirty_add(o, cur->node);
    _evas_textblock_changed(o, cur->obj);
 
    if (!o->cursor->node)
@@ -9004,6 +9661,7 @@ evas_textblock_cursor_char_delete(Evas_Textblock_Cursor *cur)
    Evas_Object_Protected_Data *obj = eo_data_scope_get(cur->obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
    Evas_Textblock_Data *o = eo_data_scope_get(cur->obj, MY_CLASS);
+   _evas_textblock_async_block(o);
    n = cur->node;
 
    text = eina_ustrbuf_string_get(n->unicode);
@@ -9014,6 +9672,7 @@ evas_textblock_cursor_char_delete(Evas_Textblock_Cursor *cur)
       chr = 0;
 
    if (chr == 0) return;
+   _evas_textblock_dirty_add(o, n);
    ppos = cur->pos;
    eina_ustrbuf_remove(n->unicode, cur->pos, ind);
    /* Remove a format node if needed, and remove the char only if the
@@ -9068,6 +9727,7 @@ evas_textblock_cursor_char_delete(Evas_Textblock_Cursor *cur)
    _evas_textblock_cursors_update_offset(cur, n, ppos, -(ind - ppos));
    _evas_textblock_changed(o, cur->obj);
    cur->node->dirty = EINA_TRUE;
+   _evas_textblock_dirty_add(o, cur->node);
 }
 
 EAPI void
@@ -9083,6 +9743,7 @@ evas_textblock_cursor_range_delete(Evas_Textblock_Cursor *cur1, Evas_Textblock_C
    Evas_Object_Protected_Data *obj = eo_data_scope_get(cur1->obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
    Evas_Textblock_Data *o = eo_data_scope_get(cur1->obj, MY_CLASS);
+   _evas_textblock_async_block(o);
    if (evas_textblock_cursor_compare(cur1, cur2) > 0)
      {
 	Evas_Textblock_Cursor *tc;
@@ -9159,6 +9820,8 @@ evas_textblock_cursor_range_delete(Evas_Textblock_Cursor *cur1, Evas_Textblock_C
    n1 = cur1->node;
    n2 = cur2->node;
    n1->dirty = n2->dirty = EINA_TRUE;
+   _evas_textblock_dirty_add(o, n1);
+   _evas_textblock_dirty_add(o, n2);
 
    if (should_merge)
      {
@@ -10806,6 +11469,7 @@ _evas_textblock_clear(Eo *eo_obj, Evas_Textblock_Data *o)
 
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
+   _layout_job_finish(eo_obj, o, EINA_FALSE);
    if (o->paragraphs)
      {
 	_paragraphs_free(eo_obj, o->paragraphs);
@@ -10842,7 +11506,11 @@ _evas_textblock_size_formatted_get(Eo *eo_obj, Evas_Textblock_Data *o, Evas_Coor
 {
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    evas_object_async_block(obj);
-   _relayout_if_needed(eo_obj, o);
+   /* With an asynchronous layout, don't wait for it: this is the size of the
+    * last one that was done then. */
+   evas_object_textblock_coords_recalc(eo_obj, obj, obj->private_data);
+   if (!o->async.job && !(o->changed && _relayout_async(eo_obj, obj, o)))
+     _relayout_if_needed(eo_obj, o);
 
    if (w) *w = o->formatted.w;
    if (h) *h = o->formatted.h;
@@ -11123,6 +11791,36 @@ _evas_textblock_style_insets_get(Eo *eo_obj, Evas_Textblock_Data *o, Evas_Coord
    if (b) *b = o->style_pad.b;
 }
 
+EOLIAN static void
+_evas_textblock_async_layout_set(Eo *eo_obj, Evas_Textblock_Data *o, Eina_Bool enabled)
+{
+   enabled = !!enabled;
+   if (o->async.enabled == enabled) return;
+   if (!enabled && o->async.job)
+     _layout_job_finish(eo_obj, o, EINA_TRUE);
+   o->async.enabled = enabled;
+}
+
+EOLIAN static Eina_Bool
+_evas_textblock_async_layout_get(Eo *eo_obj EINA_UNUSED, Evas_Textblock_Data *o)
+{
+   return o->async.enabled;
+}
+
+EOLIAN static Eina_Bool
+_evas_textblock_layout_pending_get(Eo *eo_obj EINA_UNUSED, Evas_Textblock_Data *o)
+{
+   return !!o->async.job;
+}
+
+EOLIAN static void
+_evas_textblock_layout_wait(Eo *eo_obj, Evas_Textblock_Data *o)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+   evas_object_async_block(obj);
+   _relayout_if_needed(eo_obj, o);
+}
+
 EOLIAN static void
 _evas_textblock_eo_base_dbg_info_get(Eo *eo_obj, Evas_Textblock_Data *o EINA_UNUSED, Eo_Dbg_Info *root)
 {
@@ -11197,6 +11895,7 @@ evas_object_textblock_free(Evas_Object *eo_obj)
 {
    Evas_Textblock_Data *o = eo_data_scope_get(eo_obj, MY_CLASS);
 
+   _layout_job_finish(eo_obj, o, EINA_FALSE);
    _evas_object_textblock_clear_all(eo_obj);
    evas_object_textblock_style_set(eo_obj, NULL);
    while (evas_object_textblock_style_user_peek(eo_obj))
@@ -11764,7 +12463,7 @@ evas_object_textblock_render_pre(Evas_Object *eo_obj,
    /* if so what and where and add the appropriate redraw textblocks */
 
    evas_object_textblock_coords_recalc(eo_obj, obj, obj->private_data);
-   if (o->changed)
+   if (o->changed && !_relayout_async(eo_obj, obj, o))
      {
         LYDBG("ZZ: relayout 16\n");
         _relayout(eo_obj);
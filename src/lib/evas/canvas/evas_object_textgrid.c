@@ -70,10 +70,13 @@ struct _Evas_Textgrid_Data
 
    Eina_Array                     glyphs_cleanup;
 
+   Evas_Font_Array                batch; // one row of glyph runs, drawn at once
+
    unsigned int                   changed : 1;
    unsigned int                   core_change : 1;
    unsigned int                   row_change : 1;
    unsigned int                   pal_change : 1;
+   unsigned int                   scroll_change : 1;
 };
 
 struct _Evas_Object_Textgrid_Color
@@ -84,6 +87,7 @@ struct _Evas_Object_Textgrid_Color
 struct _Evas_Object_Textgrid_Row
 {
    int ch1, ch2; // change region, -1 == none
+   Eina_Bool moved; // scrolled, needs a redraw but not to be built again
    int rects_num, texts_num, lines_num;
    int rects_alloc, texts_alloc, lines_alloc;
    Evas_Object_Textgrid_Rect *rects; // rects + colors
@@ -463,6 +467,8 @@ evas_object_textgrid_free(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj)
      }
    eina_array_flush(&o->glyphs_cleanup);
 
+   if (o->batch.array) eina_inarray_free(o->batch.array);
+
    free(o->master);
    free(o->glyphs);
    free(o->master_used);
@@ -702,54 +708,75 @@ evas_object_textgrid_render(Evas_Object *eo_obj,
                                   do_async);
           }
 
-        if (row->texts_num)
+        if ((row->texts_num) && (ENFN->multi_font_draw))
           {
-             if ((do_async) && (ENFN->multi_font_draw))
-               {
-                  Eina_Bool async_unref;
-		  Evas_Font_Array_Data *fad;
+             Eina_Bool async_unref;
+             Evas_Font_Array_Data *fad;
 
+             // all the cells of a row share a baseline, so hand them to the
+             // engine as one batch instead of one draw per cell
+             if (do_async)
+               {
                   texts = malloc(sizeof(*texts));
-                  texts->array = eina_inarray_new(sizeof(Evas_Font_Array_Data), 1); /* FIXME: Wasting 1 int here */
+                  if (!texts) return;
+                  texts->array = eina_inarray_new(sizeof(Evas_Font_Array_Data), row->texts_num);
                   texts->refcount = 1;
-
-		  fad = eina_inarray_grow(texts->array, row->texts_num);
-		  if (!fad)
-		    {
-                       ERR("Failed to allocate Evas_Font_Array_Data.");
+                  fad = eina_inarray_grow(texts->array, row->texts_num);
+               }
+             else
+               {
+                  // drawn right away, so the same array serves every row
+                  if (!o->batch.array)
+                    o->batch.array = eina_inarray_new(sizeof(Evas_Font_Array_Data), 64);
+                  texts = &o->batch;
+                  fad = NULL;
+                  if (eina_inarray_resize(texts->array, row->texts_num))
+                    fad = eina_inarray_nth(texts->array, 0);
+               }
+             if (!fad)
+               {
+                  ERR("Failed to allocate Evas_Font_Array_Data.");
+                  if (do_async)
+                    {
                        eina_inarray_free(texts->array);
                        free(texts);
-                       return;
-		    }
+                    }
+                  return;
+               }
 
-                  for (xx = 0; xx < row->texts_num; xx++)
-                    {
-                       Evas_Text_Props     *props;
+             for (xx = 0; xx < row->texts_num; xx++)
+               {
+                  Evas_Text_Props     *props;
 
-                       props =
-                         evas_object_textgrid_textprop_int_to
-                         (o, row->texts[xx].text_props);
+                  props =
+                    evas_object_textgrid_textprop_int_to
+                    (o, row->texts[xx].text_props);
 
-                       evas_common_font_draw_prepare(props);
+                  evas_common_font_draw_prepare(props);
 
+                  if (do_async)
+                    {
                        evas_common_font_glyphs_ref(props->glyphs);
                        evas_unref_queue_glyph_put(obj->layer->evas,
                                                   props->glyphs);
+                    }
 
-                       fad->color.r = row->texts[xx].r;
-                       fad->color.g = row->texts[xx].g;
-                       fad->color.b = row->texts[xx].b;
-                       fad->color.a = row->texts[xx].a;
-                       fad->x = row->texts[xx].x;
-                       fad->glyphs = props->glyphs;
+                  fad->color.r = row->texts[xx].r;
+                  fad->color.g = row->texts[xx].g;
+                  fad->color.b = row->texts[xx].b;
+                  fad->color.a = row->texts[xx].a;
+                  fad->x = row->texts[xx].x;
+                  fad->glyphs = props->glyphs;
 
-		       fad++;
-                    }
+                  fad++;
+               }
 
-                  async_unref =
-                    ENFN->multi_font_draw(output, context, surface,
-                                          o->font, xp, yp + o->ascent,
-                                          ww, hh, ww, hh, texts, do_async);
+             async_unref =
+               ENFN->multi_font_draw(output, context, surface,
+                                     o->font, xp, yp + o->ascent,
+                                     ww, hh, ww, hh, texts, do_async);
+             if (do_async)
+               {
                   if (async_unref)
                     evas_unref_queue_texts_put(obj->layer->evas, texts);
                   else
@@ -760,30 +787,30 @@ evas_object_textgrid_render(Evas_Object *eo_obj,
                        free(texts);
                     }
                }
-             else
+          }
+        else if (row->texts_num)
+          {
+             for (xx = 0; xx < row->texts_num; xx++)
                {
-                  for (xx = 0; xx < row->texts_num; xx++)
-                    {
-                       Evas_Text_Props *props;
-                       unsigned int     r, g, b, a;
-                       int              tx = xp + row->texts[xx].x;
-                       int              ty = yp + o->ascent;
-
-                       props =
-                         evas_object_textgrid_textprop_int_to
-                         (o, row->texts[xx].text_props);
-
-                       r = row->texts[xx].r;
-                       g = row->texts[xx].g;
-                       b = row->texts[xx].b;
-                       a = row->texts[xx].a;
-
-                       ENFN->context_color_set(output, context,
-                                               r, g, b, a);
-                       evas_font_draw_async_check(obj, output, context, surface,
-                                                  o->font, tx, ty, ww, hh,
-                                                  ww, hh, props, do_async);
-                    }
+                  Evas_Text_Props *props;
+                  unsigned int     r, g, b, a;
+                  int              tx = xp + row->texts[xx].x;
+                  int              ty = yp + o->ascent;
+
+                  props =
+                    evas_object_textgrid_textprop_int_to
+                    (o, row->texts[xx].text_props);
+
+                  r = row->texts[xx].r;
+                  g = row->texts[xx].g;
+                  b = row->texts[xx].b;
+                  a = row->texts[xx].a;
+
+                  ENFN->context_color_set(output, context,
+                                          r, g, b, a);
+                  evas_font_draw_async_check(obj, output, context, surface,
+                                             o->font, tx, ty, ww, hh,
+                                             ww, hh, props, do_async);
                }
           }
 
@@ -912,13 +939,21 @@ evas_object_textgrid_render_pre(Evas_Object *eo_obj,
              for (i = 0; i < o->cur.h; i++)
                {
                   Evas_Object_Textgrid_Row *r = &(o->cur.rows[i]);
-                  if (r->ch1 >= 0)
+                  if ((r->ch1 >= 0) || (r->moved))
                     {
                        Evas_Coord chx, chy, chw, chh;
                        
-                       chx = r->ch1 * o->cur.char_width;
+                       if (r->moved)
+                         {
+                            chx = 0;
+                            chw = o->cur.w * o->cur.char_width;
+                         }
+                       else
+                         {
+                            chx = r->ch1 * o->cur.char_width;
+                            chw = (r->ch2 - r->ch1 + 1) * o->cur.char_width;
+                         }
                        chy = i * o->cur.char_height;
-                       chw = (r->ch2 - r->ch1 + 1) * o->cur.char_width;
                        chh = o->cur.char_height;
                        
                        chx -= o->cur.char_width;
@@ -941,9 +976,17 @@ evas_object_textgrid_render_pre(Evas_Object *eo_obj,
      }
    
    done:
+   if (o->scroll_change)
+     {
+        int i;
+
+        for (i = 0; i < o->cur.h; i++)
+          o->cur.rows[i].moved = EINA_FALSE;
+     }
    o->core_change = 0;
    o->row_change = 0;
    o->pal_change = 0;
+   o->scroll_change = 0;
    evas_object_render_pre_effect_updates(&obj->layer->evas->clip_changes, eo_obj, is_v, was_v);
 }
 
@@ -1490,6 +1533,78 @@ _evas_textgrid_update_add(Eo *eo_obj, Evas_Textgrid_Data *o, int x, int y, int w
    evas_object_change(eo_obj, obj);
 }
 
+EOLIAN static void
+_evas_textgrid_rows_scroll(Eo *eo_obj, Evas_Textgrid_Data *o, int y, int h, int dy)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+   Evas_Object_Textgrid_Row *rows_tmp;
+   Evas_Textgrid_Cell *cells_tmp;
+   Evas_Textgrid_Cell *cells;
+   Evas_Object_Textgrid_Row *rows;
+   int n, w, i, ny;
+
+   if (y < 0)
+     {
+        h += y;
+        y = 0;
+     }
+   if ((y + h) > o->cur.h) h = o->cur.h - y;
+   if ((h <= 0) || (!dy) || (!o->cur.rows)) return;
+
+   n = abs(dy);
+   if (n >= h)
+     {
+        _evas_textgrid_update_add(eo_obj, o, 0, y, o->cur.w, h);
+        return;
+     }
+
+   w = o->cur.w;
+   rows_tmp = malloc(n * sizeof(Evas_Object_Textgrid_Row));
+   cells_tmp = malloc(n * w * sizeof(Evas_Textgrid_Cell));
+   if ((!rows_tmp) || (!cells_tmp))
+     {
+        free(rows_tmp);
+        free(cells_tmp);
+        _evas_textgrid_update_add(eo_obj, o, 0, y, o->cur.w, h);
+        return;
+     }
+
+   evas_object_async_block(obj);
+   rows = o->cur.rows + y;
+   cells = o->cur.cells + (y * w);
+   // rotate the band so what falls off one end comes back at the other
+   if (dy < 0)
+     {
+        memcpy(rows_tmp, rows, n * sizeof(Evas_Object_Textgrid_Row));
+        memmove(rows, rows + n, (h - n) * sizeof(Evas_Object_Textgrid_Row));
+        memcpy(rows + h - n, rows_tmp, n * sizeof(Evas_Object_Textgrid_Row));
+        memcpy(cells_tmp, cells, n * w * sizeof(Evas_Textgrid_Cell));
+        memmove(cells, cells + (n * w), (h - n) * w * sizeof(Evas_Textgrid_Cell));
+        memcpy(cells + ((h - n) * w), cells_tmp, n * w * sizeof(Evas_Textgrid_Cell));
+        ny = y + h - n;
+     }
+   else
+     {
+        memcpy(rows_tmp, rows + h - n, n * sizeof(Evas_Object_Textgrid_Row));
+        memmove(rows + n, rows, (h - n) * sizeof(Evas_Object_Textgrid_Row));
+        memcpy(rows, rows_tmp, n * sizeof(Evas_Object_Textgrid_Row));
+        memcpy(cells_tmp, cells + ((h - n) * w), n * w * sizeof(Evas_Textgrid_Cell));
+        memmove(cells + (n * w), cells, (h - n) * w * sizeof(Evas_Textgrid_Cell));
+        memcpy(cells, cells_tmp, n * w * sizeof(Evas_Textgrid_Cell));
+        ny = y;
+     }
+   free(rows_tmp);
+   free(cells_tmp);
+
+   // rows that only moved keep their rects and glyphs, they just need to
+   // be drawn where they are now
+   for (i = y; i < y + h; i++)
+     o->cur.rows[i].moved = EINA_TRUE;
+   o->scroll_change = 1;
+
+   _evas_textgrid_update_add(eo_obj, o, 0, ny, o->cur.w, n);
+}
+
 EOLIAN static void
 _evas_textgrid_eo_base_dbg_info_get(Eo *eo_obj, Evas_Textgrid_Data *o EINA_UNUSED, Eo_Dbg_Info *root)
 {
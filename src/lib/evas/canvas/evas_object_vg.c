@@ -1,5 +1,8 @@
 #include "evas_common_private.h"
 #include "evas_private.h"
+#ifdef EVAS_CSERVE2
+#include "../cserve2/evas_cs2_private.h"
+#endif
 
 #include "evas_vg_private.h"
 #include "efl_vg_root_node.eo.h"
@@ -11,18 +14,11 @@ static const char o_type[] = "vectors";
 
 const char *o_vg_type = o_type;
 
-/* private struct for rectangle object internal data */
-typedef struct _Evas_VG_Data      Evas_VG_Data;
+/* Total size of the raster caches of all vg objects. Objects that do not
+ * fit anymore are drawn directly, hidden objects give their share back. */
+#define EVAS_VG_CACHE_BUDGET (16 * 1024 * 1024)
 
-struct _Evas_VG_Data
-{
-   void   *engine_data;
-   Efl_VG *root;
-
-   Eina_Rectangle fill;
-
-   unsigned int width, height;
-};
+static unsigned int _evas_vg_cache_usage = 0;
 
 static void evas_object_vg_render(Evas_Object *eo_obj,
                                   Evas_Object_Protected_Data *obj,
@@ -91,9 +87,25 @@ _evas_vg_root_node_get(Eo *obj EINA_UNUSED, Evas_VG_Data *pd)
    return pd->root;
 }
 
+static void
+_evas_vg_cache_free(Evas_Object_Protected_Data *obj, Evas_VG_Data *vd)
+{
+   if (!vd->cache.surface) return;
+
+   if (obj->layer)
+     obj->layer->evas->engine.func->image_map_surface_free
+       (obj->layer->evas->engine.data.output, vd->cache.surface);
+   _evas_vg_cache_usage -= vd->cache.w * vd->cache.h * 4;
+   vd->cache.surface = NULL;
+   vd->cache.w = vd->cache.h = 0;
+}
+
 void
 _evas_vg_eo_base_destructor(Eo *eo_obj, Evas_VG_Data *pd)
 {
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
+
+   _evas_vg_cache_free(obj, pd);
    eo_unref(pd->root);
    eo_do_super(eo_obj, MY_CLASS, eo_destructor());
 }
@@ -146,6 +158,97 @@ _evas_vg_render(Evas_Object_Protected_Data *obj,
      }
 }
 
+/* Draw the object from its raster cache, filling the cache first if needed.
+ * The cache is keyed on the object size and color, as the color multiplies
+ * each node like when drawing directly. Returns EINA_FALSE when the tree
+ * has to be drawn directly: when it just changed (it may well change again
+ * next frame), with render ops other than blend, or when the cache budget
+ * is exhausted. */
+static Eina_Bool
+_evas_vg_cache_render(Evas_Object_Protected_Data *obj, Evas_VG_Data *vd,
+                      void *output, void *context, void *surface,
+                      int x, int y, Eina_Bool do_async)
+{
+   Evas_Public_Data *e = obj->layer->evas;
+   int w = obj->cur->geometry.w;
+   int h = obj->cur->geometry.h;
+   Eina_Bool async_unref;
+   void *ctx;
+
+   if (vd->cache.changed || (obj->cur->render_op != EVAS_RENDER_BLEND) ||
+       (w <= 0) || (h <= 0))
+     return EINA_FALSE;
+
+   if ((vd->cache.w != w) || (vd->cache.h != h) ||
+       (vd->cache.r != obj->cur->cache.clip.r) ||
+       (vd->cache.g != obj->cur->cache.clip.g) ||
+       (vd->cache.b != obj->cur->cache.clip.b) ||
+       (vd->cache.a != obj->cur->cache.clip.a))
+     _evas_vg_cache_free(obj, vd);
+
+   if (!vd->cache.surface)
+     {
+        if (_evas_vg_cache_usage + (w * h * 4) > EVAS_VG_CACHE_BUDGET)
+          return EINA_FALSE;
+
+        vd->cache.surface = e->engine.func->image_map_surface_new
+          (e->engine.data.output, w, h, EINA_TRUE);
+        if (!vd->cache.surface) return EINA_FALSE;
+        vd->cache.w = w;
+        vd->cache.h = h;
+        vd->cache.r = obj->cur->cache.clip.r;
+        vd->cache.g = obj->cur->cache.clip.g;
+        vd->cache.b = obj->cur->cache.clip.b;
+        vd->cache.a = obj->cur->cache.clip.a;
+        _evas_vg_cache_usage += w * h * 4;
+
+        ctx = e->engine.func->context_new(output);
+        e->engine.func->context_color_set(output, ctx, 0, 0, 0, 0);
+        e->engine.func->context_render_op_set(output, ctx, EVAS_RENDER_COPY);
+        e->engine.func->rectangle_draw(output, ctx, vd->cache.surface,
+                                       0, 0, w, h, do_async);
+
+        e->engine.func->context_color_set(output, ctx,
+                                          vd->cache.r, vd->cache.g,
+                                          vd->cache.b, vd->cache.a);
+        e->engine.func->context_anti_alias_set(output, ctx,
+                                               obj->cur->anti_alias);
+        e->engine.func->context_render_op_set(output, ctx, EVAS_RENDER_BLEND);
+        e->engine.func->ector_begin(output, ctx, vd->cache.surface,
+                                    0, 0, do_async);
+        _evas_vg_render(obj, output, ctx, vd->cache.surface, vd->root, NULL,
+                        do_async);
+        e->engine.func->ector_end(output, ctx, vd->cache.surface, do_async);
+        e->engine.func->context_free(output, ctx);
+
+        vd->cache.surface = e->engine.func->image_dirty_region
+          (output, vd->cache.surface, 0, 0, w, h);
+     }
+
+   e->engine.func->context_color_set(output, context, 255, 255, 255, 255);
+   e->engine.func->context_multiplier_unset(output, context);
+   e->engine.func->context_render_op_set(output, context, EVAS_RENDER_BLEND);
+
+   async_unref = e->engine.func->image_draw(output, context, surface,
+                                            vd->cache.surface, 0, 0, w, h,
+                                            obj->cur->geometry.x + x,
+                                            obj->cur->geometry.y + y, w, h,
+                                            EINA_FALSE, do_async);
+   if (do_async && async_unref)
+     {
+        /* the cache may be dropped before the render thread is done */
+#ifdef EVAS_CSERVE2
+        if (evas_cserve2_use_get())
+          evas_cache2_image_ref((Image_Entry *)vd->cache.surface);
+        else
+#endif
+          evas_cache_image_ref((Image_Entry *)vd->cache.surface);
+        evas_unref_queue_image_put(e, vd->cache.surface);
+     }
+
+   return EINA_TRUE;
+}
+
 static void
 evas_object_vg_render(Evas_Object *eo_obj EINA_UNUSED,
                       Evas_Object_Protected_Data *obj,
@@ -162,6 +265,10 @@ evas_object_vg_render(Evas_Object *eo_obj EINA_UNUSED,
    // to another Ector_Surface as long as that Ector_Surface is a
    // child of the main Ector_Surface (necessary for Evas_Map).
 
+   if (_evas_vg_cache_render(obj, vd, output, context, surface,
+                             x, y, do_async))
+     return;
+
    /* render object to surface with context, and offxet by x,y */
    obj->layer->evas->engine.func->context_color_set(output,
                                                     context,
@@ -229,6 +336,8 @@ evas_object_vg_render_pre(Evas_Object *eo_obj,
    if (rnd->changed)
      {
         rnd->changed = EINA_FALSE;
+        vd->cache.changed = EINA_TRUE;
+        _evas_vg_cache_free(obj, vd);
         evas_object_render_pre_prev_cur_add(&obj->layer->evas->clip_changes, eo_obj, obj);
         goto done;
      }
@@ -320,9 +429,17 @@ evas_object_vg_render_pre(Evas_Object *eo_obj,
 
 static void
 evas_object_vg_render_post(Evas_Object *eo_obj,
-                           Evas_Object_Protected_Data *obj EINA_UNUSED,
-                           void *type_private_data EINA_UNUSED)
+                           Evas_Object_Protected_Data *obj,
+                           void *type_private_data)
 {
+   Evas_VG_Data *vd = type_private_data;
+
+   /* unchanged from now on, the next draw fills the cache */
+   vd->cache.changed = EINA_FALSE;
+   /* leave the budget to the objects on screen */
+   if (!evas_object_is_visible(eo_obj, obj))
+     _evas_vg_cache_free(obj, vd);
+
    /* this moves the current data to the previous state parts of the object */
    /* in whatever way is safest for the object. also if we don't need object */
    /* data anymore we can free it if the object deems this is a good idea */
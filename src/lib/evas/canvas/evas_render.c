@@ -454,6 +454,55 @@ _evas_render_phase1_direct(Evas_Public_Data *e,
    RD(0, "  ---]\n");
 }
 
+static Eina_Bool
+_evas_render_phase1_cache_use(Evas_Public_Data *e,
+                              Evas_Object_Protected_Data *obj,
+                              Eina_Array *active_objects,
+                              Eina_Array *render_objects,
+                              int level EINA_UNUSED)
+{
+   const Eina_Array *cached_active, *cached_render;
+   const Eina_Inarray *cached_rect_del;
+   Evas_Object_Protected_Data *obj2;
+   Eina_Bool *rect_del;
+   unsigned int i;
+
+   if (!evas_object_smart_render_cache_get(obj->object, e->output_validity,
+                                           &cached_active, &cached_render,
+                                           &cached_rect_del))
+     return EINA_FALSE;
+
+   RD(level, "[--- CACHED [%p] %u active, %u render ---]\n", obj,
+      eina_array_count(cached_active), eina_array_count(cached_render));
+
+   /* set the per frame state of the subtree as walking it would have:
+    * the cache is dropped when anything it depends on changes, so only
+    * these flags need to be put back, not recomputed */
+   for (i = 0; i < eina_array_count(cached_active); i++)
+     {
+        obj2 = eina_array_data_get(cached_active, i);
+        obj2->is_active = EINA_TRUE;
+        obj2->rect_del = EINA_FALSE;
+        obj2->render_pre = EINA_FALSE;
+        OBJ_ARRAY_PUSH(active_objects, obj2);
+     }
+   for (i = 0; i < eina_array_count(cached_render); i++)
+     {
+        obj2 = eina_array_data_get(cached_render, i);
+        rect_del = eina_inarray_nth(cached_rect_del, i);
+        obj2->rect_del = *rect_del;
+        obj2->render_pre = !*rect_del;
+        OBJ_ARRAY_PUSH(render_objects, obj2);
+     }
+   return EINA_TRUE;
+}
+
+/* Walks the subtree of eo_obj and fills the phase 1 arrays. Smart objects
+ * whose subtree did not change since the last walk reuse the slice of the
+ * arrays they produced back then instead of being walked again. A subtree
+ * is only cached when none of its objects is changed, deleted, restacked,
+ * mapped or a proxy source, as those make the output depend on the frame.
+ * Any such object clears *cacheable for its ancestors. */
 static Eina_Bool
 _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
                                    Eina_Array *active_objects,
@@ -463,16 +512,35 @@ _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
                                    int restack,
                                    int *redraw_all,
                                    Eina_Bool mapped_parent,
-                                   Eina_Bool src_changed, int level)
+                                   Eina_Bool src_changed,
+                                   Eina_Bool *cacheable,
+                                   int level)
 {
    Eina_Bool clean_them = EINA_FALSE;
+   Eina_Bool subtree_cacheable;
+   unsigned int active_first, render_first;
    int is_active;
    Eina_Bool map, hmap;
 
    Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJECT_CLASS);
    //Need pre render for the children of mapped object.
    //But only when they have changed.
-   if (mapped_parent && (!obj->changed)) return EINA_FALSE;
+   if (mapped_parent && (!obj->changed))
+     {
+        *cacheable = EINA_FALSE;
+        return EINA_FALSE;
+     }
+
+   subtree_cacheable = ((!restack) && (!mapped_parent) && (!src_changed) &&
+                        (!obj->changed) && (obj->delete_me == 0) &&
+                        (!obj->proxy->proxies) && (!obj->proxy->proxy_textures));
+   if (obj->is_smart && subtree_cacheable &&
+       _evas_render_phase1_cache_use(e, obj, active_objects, render_objects,
+                                     level))
+     return EINA_FALSE;
+
+   active_first = eina_array_count(active_objects);
+   render_first = eina_array_count(render_objects);
 
    obj->rect_del = EINA_FALSE;
    obj->render_pre = EINA_FALSE;
@@ -514,6 +582,7 @@ _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
 
    map = _evas_render_has_map(eo_obj, obj);
    hmap = _evas_render_had_map(obj);
+   if (map || hmap) subtree_cacheable = EINA_FALSE;
 
    if ((restack) && (!map))
      {
@@ -564,11 +633,13 @@ _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
                                                                redraw_all,
                                                                EINA_TRUE,
                                                                src_changed,
+                                                               &subtree_cacheable,
                                                                level + 1);
                          }
                     }
                }
           }
+        *cacheable = EINA_FALSE;
         return clean_them;
      }
    else if (hmap)
@@ -621,6 +692,7 @@ _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
                                                      redraw_all,
                                                      mapped_parent,
                                                      src_changed,
+                                                     &subtree_cacheable,
                                                      level + 1);
                }
           }
@@ -699,6 +771,7 @@ _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
                                                              redraw_all,
                                                              mapped_parent,
                                                              src_changed,
+                                                             &subtree_cacheable,
                                                              level + 1);
                        }
                }
@@ -752,6 +825,11 @@ _evas_render_phase1_object_process(Evas_Public_Data *e, Evas_Object *eo_obj,
 */
      }
    if (!is_active) obj->restack = EINA_FALSE;
+   if (!subtree_cacheable) *cacheable = EINA_FALSE;
+   else if (obj->is_smart)
+     evas_object_smart_render_cache_set(eo_obj, e->output_validity,
+                                        active_objects, active_first,
+                                        render_objects, render_first);
    RD(level, "---]\n");
    return clean_them;
 }
@@ -766,6 +844,7 @@ _evas_render_phase1_process(Evas_Public_Data *e,
 {
    Evas_Layer *lay;
    Eina_Bool clean_them = EINA_FALSE;
+   Eina_Bool cacheable;
 
    RD(0, "  [--- PHASE 1\n");
    EINA_INLIST_FOREACH(e->layers, lay)
@@ -774,9 +853,11 @@ _evas_render_phase1_process(Evas_Public_Data *e,
 
         EINA_INLIST_FOREACH(lay->objects, obj)
           {
+             cacheable = EINA_TRUE;
              clean_them |= _evas_render_phase1_object_process
                 (e, obj->object, active_objects, restack_objects, delete_objects,
-                 render_objects, 0, redraw_all, EINA_FALSE, EINA_FALSE, 2);
+                 render_objects, 0, redraw_all, EINA_FALSE, EINA_FALSE,
+                 &cacheable, 2);
           }
      }
    RD(0, "  ---]\n");
@@ -2648,6 +2729,9 @@ evas_render_updates_internal(Evas *eo_e,
      {
         Evas_Event_Render_Post post;
 
+        /* glyphs nothing draws anymore can go now */
+        evas_common_font_glyph_cache_trim();
+
         post.updated_area = e->render.updates;
         _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_POST, e->render.updates ? &post : NULL);
      }
@@ -2730,6 +2814,7 @@ evas_render_wakeup(Evas *eo_e)
 
    eina_array_foreach(&e->texts_unref_queue, _drop_texts_ref, NULL);
    eina_array_clean(&e->texts_unref_queue);
+   evas_common_font_glyph_cache_trim();
 
    /* post rendering */
    _rendering_evases = eina_list_remove(_rendering_evases, e);
@@ -3,10 +3,29 @@
 
 #include <Ector.h>
 
+typedef struct _Evas_VG_Data Evas_VG_Data;
 typedef struct _Efl_VG_Base_Data Efl_VG_Base_Data;
 typedef struct _Efl_VG_Container_Data Efl_VG_Container_Data;
 typedef struct _Efl_VG_Gradient_Data Efl_VG_Gradient_Data;
 
+struct _Evas_VG_Data
+{
+   void   *engine_data;
+   Efl_VG *root;
+
+   Eina_Rectangle fill;
+
+   unsigned int width, height;
+
+   /* the tree drawn once at the object size, blitted while it is unchanged */
+   struct {
+      void *surface;
+      int w, h;
+      int r, g, b, a; /* the object color is applied to each node */
+      Eina_Bool changed : 1; /* the tree changed during this frame */
+   } cache;
+};
+
 struct _Efl_VG_Base_Data
 {
    Eina_Matrix3 *m;
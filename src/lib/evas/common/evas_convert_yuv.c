@@ -5,6 +5,11 @@
 # include "evas_mmx.h"
 #endif
 
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+# include <emmintrin.h>
+# define EVAS_YUV_SSE2 1
+#endif
+
 #ifdef HAVE_ALTIVEC_H
 # include <altivec.h>
 #ifdef CONFIG_DARWIN
@@ -15,6 +20,10 @@
 
 #endif
 
+typedef void (*Evas_Yuv_Convert_Func)(unsigned char **yuv, unsigned char *rgb, int w, int h);
+typedef void (*Evas_Yuv_420_Rows_Func)(unsigned char *yp1, unsigned char *yp2, unsigned char *up,
+                                       unsigned char *dp1, unsigned char *dp2, int w);
+
 static void _evas_yuv_init         (void);
 static void _evas_yv12torgb_sse    (unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_yv12torgb_mmx    (unsigned char **yuv, unsigned char *rgb, int w, int h);
@@ -25,7 +34,14 @@ static void _evas_yv12torgb_diz    (unsigned char **yuv, unsigned char *rgb, int
 static void _evas_yv12torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_yuy2torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_nv12torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
-static void _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h);
+static void _evas_nv12_rows_raster (unsigned char *yp1, unsigned char *yp2, unsigned char *up, unsigned char *dp1, unsigned char *dp2, int w);
+#ifdef EVAS_YUV_SSE2
+static void _evas_yuy2torgb_sse2   (unsigned char **yuv, unsigned char *rgb, int w, int h);
+static void _evas_nv12torgb_sse2   (unsigned char **yuv, unsigned char *rgb, int w, int h);
+static void _evas_nv12_rows_sse2   (unsigned char *yp1, unsigned char *yp2, unsigned char *up, unsigned char *dp1, unsigned char *dp2, int w);
+#endif
+static void _evas_nv12tiledtorgb   (unsigned char **yuv, unsigned char *rgb, int w, int h, Evas_Yuv_420_Rows_Func rows);
+static void _evas_yuv_convert      (Evas_Yuv_Convert_Func func, int chroma_planes, unsigned char **yuv, unsigned char *rgb, int w, int h);
 
 #define CRV    104595
 #define CBU    132251
@@ -124,19 +140,19 @@ void
 evas_common_convert_yuv_420p_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX2))
-     _evas_yv12torgb_sse(src, dst, w, h);
+     _evas_yuv_convert(_evas_yv12torgb_sse, 2, src, dst, w, h);
    else if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
-     _evas_yv12torgb_mmx(src, dst, w, h);
+     _evas_yuv_convert(_evas_yv12torgb_mmx, 2, src, dst, w, h);
 #ifdef BUILD_ALTIVEC
    if (evas_common_cpu_has_feature(CPU_FEATURE_ALTIVEC))
-     _evas_yv12torgb_altivec(src, dst, w, h);
+     _evas_yuv_convert(_evas_yv12torgb_altivec, 2, src, dst, w, h);
 #endif
    else
      {
 	if (!initted) _evas_yuv_init();
 	initted = 1;
 	/* FIXME: diz may be faster sometimes */
-	_evas_yv12torgb_raster(src, dst, w, h);
+	_evas_yuv_convert(_evas_yv12torgb_raster, 2, src, dst, w, h);
      }
 }
 
@@ -864,12 +880,77 @@ _evas_yv12torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
      }
 }
 
+/* Frames are converted in slices of row pairs on the worker pool. A slice
+ * gets its own table of row pointers, laid out like the one of a whole frame
+ * (luma rows, then each half height chroma plane), so the converters don't
+ * need to know about it. */
+
+// Minimum number of pixels in a slice given to a thread
+#define YUV_SLICE_PIXELS (1 << 16)
+
+typedef struct _Evas_Yuv_Slices Evas_Yuv_Slices;
+
+struct _Evas_Yuv_Slices
+{
+   Evas_Yuv_Convert_Func func;
+   unsigned char **yuv;
+   unsigned char *rgb;
+   int w, h;
+   int chroma_planes;
+};
+
+static void
+_evas_yuv_slice_run(void *data, int start, int end)
+{
+   Evas_Yuv_Slices *s = data;
+   unsigned char **rows;
+   int y0 = start * 2;
+   int h = (end - start) * 2;
+   int p;
+
+   rows = alloca((h + s->chroma_planes * (h / 2)) * sizeof (unsigned char *));
+   memcpy(rows, s->yuv + y0, h * sizeof (unsigned char *));
+   for (p = 0; p < s->chroma_planes; p++)
+     memcpy(rows + h + (p * (h / 2)),
+            s->yuv + s->h + (p * (s->h / 2)) + (y0 / 2),
+            (h / 2) * sizeof (unsigned char *));
+
+   s->func(rows, s->rgb + (y0 * s->w * 4), s->w, h);
+}
+
+static void
+_evas_yuv_convert(Evas_Yuv_Convert_Func func, int chroma_planes,
+                  unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   Evas_Yuv_Slices s;
+
+   if ((w <= 0) || (h & 0x1) || ((w * h) < (2 * YUV_SLICE_PIXELS)))
+     {
+        func(yuv, rgb, w, h);
+        return;
+     }
+
+   s.func = func;
+   s.yuv = yuv;
+   s.rgb = rgb;
+   s.w = w;
+   s.h = h;
+   s.chroma_planes = chroma_planes;
+   evas_thread_parallel_run(h / 2, 1 + (YUV_SLICE_PIXELS / (2 * w)),
+                            _evas_yuv_slice_run, &s);
+}
+
 void
 evas_common_convert_yuv_422_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
    if (!initted) _evas_yuv_init();
    initted = 1;
-   _evas_yuy2torgb_raster(src, dst, w, h);
+#ifdef EVAS_YUV_SSE2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     _evas_yuv_convert(_evas_yuy2torgb_sse2, 0, src, dst, w, h);
+   else
+#endif
+     _evas_yuv_convert(_evas_yuy2torgb_raster, 0, src, dst, w, h);
 }
 
 void
@@ -877,68 +958,76 @@ evas_common_convert_yuv_420_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
    if (!initted) _evas_yuv_init();
    initted = 1;
-   _evas_nv12torgb_raster(src, dst, w, h);
+#ifdef EVAS_YUV_SSE2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     _evas_yuv_convert(_evas_nv12torgb_sse2, 1, src, dst, w, h);
+   else
+#endif
+     _evas_yuv_convert(_evas_nv12torgb_raster, 1, src, dst, w, h);
 }
 
 void
 evas_common_convert_yuv_420T_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
-   if (initted) _evas_yuv_init();
+   if (!initted) _evas_yuv_init();
    initted = 1;
-   _evas_nv12tiledtorgb_raster(src, dst, w, h);
+#ifdef EVAS_YUV_SSE2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     _evas_nv12tiledtorgb(src, dst, w, h, _evas_nv12_rows_sse2);
+   else
+#endif
+     _evas_nv12tiledtorgb(src, dst, w, h, _evas_nv12_rows_raster);
 }
 
 static void
-_evas_yuy2torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+_evas_yuy2_row_raster(unsigned char *line, unsigned char *dp1, int w)
 {
-   int xx, yy;
+   int xx;
    int y, u, v;
    unsigned char *yp1, *yp2, *up, *vp;
-   unsigned char *dp1;
 
-   dp1 = rgb;
+   yp1 = line + 0;
+   up = line + 1;
+   yp2 = line + 2;
+   vp = line + 3;
 
-   /* destination pointers */
-   for (yy = 0; yy < h; yy++)
+   for (xx = 0; xx < w; xx += 2)
      {
-        /* plane pointers */
-        unsigned char *line;
+        int vmu;
 
-        line = yuv[yy];
-        yp1 = line + 0;
-        up = line + 1;
-        yp2 = line + 2;
-        vp = line + 3;
+        /* collect u & v for 2 pixels block */
+        u = *up;
+        v = *vp;
 
-        for (xx = 0; xx < w; xx += 2)
-          {
-             int vmu;
+        /* save lookups */
+        vmu = _v813[v] + _v391[u];
+        u = _v2018[u];
+        v = _v1596[v];
 
-             /* collect u & v for 2 pixels block */
-             u = *up;
-             v = *vp;
+        /* do the top 2 pixels of the 2x2 block which shared u & v */
+        /* yuv to rgb */
+        y = _v1164[*yp1];
+        *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
 
-             /* save lookups */
-             vmu = _v813[v] + _v391[u];
-             u = _v2018[u];
-             v = _v1596[v];
+        dp1 += 4;
 
-             /* do the top 2 pixels of the 2x2 block which shared u & v */
-	     /* yuv to rgb */
-	     y = _v1164[*yp1];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+        /* yuv to rgb */
+        y = _v1164[*yp2];
+        *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
 
-	     dp1 += 4;
+        dp1 += 4;
 
-	     /* yuv to rgb */
-	     y = _v1164[*yp2];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+        yp1 += 4; yp2 += 4; up += 4; vp += 4;
+     }
+}
 
-             dp1 += 4;
+static void
+_evas_yuy2torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   int yy;
 
-	     yp1 += 4; yp2 += 4; up += 4; vp += 4;
-	  }
-     }
+   for (yy = 0; yy < h; yy++)
+     _evas_yuy2_row_raster(yuv[yy], rgb + (yy * w * 4), w);
 }
 
 static inline void
@@ -1022,40 +1111,275 @@ _evas_yuv2rgb_420_raster(unsigned char *yp1, unsigned char *yp2, unsigned char *
 }
 
 static void
-_evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+_evas_nv12_rows_raster(unsigned char *yp1, unsigned char *yp2, unsigned char *up,
+                       unsigned char *dp1, unsigned char *dp2, int w)
+{
+   int xx;
+
+   for (xx = 0; xx < w; xx += 2)
+     {
+        _evas_yuv2rgb_420_raster(yp1, yp2, up, up + 1, dp1, dp2);
+
+        /* the previous call just rendered 2 pixels per lines */
+        dp1 += 8; dp2 += 8;
+
+        /* and took for that 2 lines with 2 Y, 1 U and 1 V. Don't forget U & V are in the same plane */
+        yp1 += 2; yp2 += 2; up += 2;
+     }
+}
+
+#ifdef EVAS_YUV_SSE2
+/* Same arithmetic as _evas_yuv2rgb_420_raster, on 32 bit lanes. SSE2 has no
+ * 32 bit multiply, so each product is split in two 16 bit ones for madd,
+ * like (y << 2) * 19070 + y * 3 for y * YMUL. */
+static void
+_evas_nv12_rows_sse2(unsigned char *yp1, unsigned char *yp2, unsigned char *up,
+                     unsigned char *dp1, unsigned char *dp2, int w)
 {
-#define HANDLE_MACROBLOCK(YP1, YP2, UP, VP, DP1, DP2)                   \
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i alpha = _mm_set1_epi8(-1);
+   const __m128i lo16 = _mm_set1_epi32(0x0000ffff);
+   const __m128i hi16 = _mm_set1_epi32(0xffff0000);
+   const __m128i c16 = _mm_set1_epi16(16);
+   const __m128i c128 = _mm_set1_epi16(128);
+   const __m128i ymul = _mm_set1_epi32((3 << 16) | 19070);
+   const __m128i crv = _mm_set1_epi32((3 << 16) | 26148);
+   const __m128i cbu = _mm_set1_epi32((3 << 16) | 16531);
+   const __m128i cguv = _mm_set1_epi32((26640 << 16) | (CGU));
+   const __m128i off = _mm_set1_epi32(OFF);
+   int xx, k;
+
+   for (xx = 0; xx + 8 <= w; xx += 8)
+     {
+        __m128i uv, rv, guv, bu, rv2[2], guv2[2], bu2[2];
+        unsigned char *yp[2] = { yp1 + xx, yp2 + xx };
+        unsigned char *dp[2] = { dp1 + (xx * 4), dp2 + (xx * 4) };
+
+        /* u0 v0 u1 v1 u2 v2 u3 v3, one 32 bit lane per 2 pixels */
+        uv = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(up + xx)), zero);
+        uv = _mm_sub_epi16(uv, c128);
+
+        /* (v << 2, v), (u << 3, u) and (u, v << 1) pairs */
+        rv = _mm_or_si128(_mm_srli_epi32(_mm_slli_epi16(uv, 2), 16),
+                          _mm_and_si128(uv, hi16));
+        bu = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(uv, 3), lo16),
+                          _mm_slli_epi32(uv, 16));
+        guv = _mm_add_epi16(uv, _mm_and_si128(uv, hi16));
+
+        rv = _mm_madd_epi16(rv, crv);
+        bu = _mm_add_epi32(_mm_madd_epi16(bu, cbu), off);
+        guv = _mm_sub_epi32(off, _mm_madd_epi16(guv, cguv));
+
+        rv2[0] = _mm_unpacklo_epi32(rv, rv);
+        rv2[1] = _mm_unpackhi_epi32(rv, rv);
+        guv2[0] = _mm_unpacklo_epi32(guv, guv);
+        guv2[1] = _mm_unpackhi_epi32(guv, guv);
+        bu2[0] = _mm_unpacklo_epi32(bu, bu);
+        bu2[1] = _mm_unpackhi_epi32(bu, bu);
+
+        for (k = 0; k < 2; k++)
+          {
+             __m128i y, ylo, yhi, r, g, b, bg, ra;
+
+             y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)yp[k]), zero);
+             y = _mm_sub_epi16(y, c16);
+             ylo = _mm_madd_epi16(_mm_unpacklo_epi16(_mm_slli_epi16(y, 2), y), ymul);
+             yhi = _mm_madd_epi16(_mm_unpackhi_epi16(_mm_slli_epi16(y, 2), y), ymul);
+
+             r = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(ylo, rv2[0]), 16),
+                                 _mm_srai_epi32(_mm_add_epi32(yhi, rv2[1]), 16));
+             g = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(ylo, guv2[0]), 16),
+                                 _mm_srai_epi32(_mm_add_epi32(yhi, guv2[1]), 16));
+             b = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(ylo, bu2[0]), 16),
+                                 _mm_srai_epi32(_mm_add_epi32(yhi, bu2[1]), 16));
+
+             /* saturation does the clipping */
+             r = _mm_packus_epi16(r, r);
+             g = _mm_packus_epi16(g, g);
+             b = _mm_packus_epi16(b, b);
+
+             bg = _mm_unpacklo_epi8(b, g);
+             ra = _mm_unpacklo_epi8(r, alpha);
+             _mm_storeu_si128((__m128i *)dp[k], _mm_unpacklo_epi16(bg, ra));
+             _mm_storeu_si128((__m128i *)(dp[k] + 16), _mm_unpackhi_epi16(bg, ra));
+          }
+     }
+
+   if (xx < w)
+     _evas_nv12_rows_raster(yp1 + xx, yp2 + xx, up + xx,
+                            dp1 + (xx * 4), dp2 + (xx * 4), w - xx);
+}
+
+/* The same lookup tables as the C code, as (|x| * c) >> shift with the sign
+ * of x put back, which gives the same truncation towards 0. */
+static inline __m128i
+_evas_yuv_lut_sse2(__m128i x, int base, int shift, int c)
+{
+   __m128i sign;
+
+   x = _mm_sub_epi16(x, _mm_set1_epi16(base));
+   sign = _mm_srai_epi16(x, 15);
+   x = _mm_sub_epi16(_mm_xor_si128(x, sign), sign);
+   x = _mm_mulhi_epu16(_mm_slli_epi16(x, 16 - shift), _mm_set1_epi16(c));
+   return _mm_sub_epi16(_mm_xor_si128(x, sign), sign);
+}
+
+#define EVEN_LANES _MM_SHUFFLE(2, 2, 0, 0)
+#define ODD_LANES _MM_SHUFFLE(3, 3, 1, 1)
+#define LANES_DUP(x, m) _mm_shufflehi_epi16(_mm_shufflelo_epi16((x), (m)), (m))
+
+static void
+_evas_yuy2_row_sse2(unsigned char *line, unsigned char *dp1, int w)
+{
+   const __m128i alpha = _mm_set1_epi8(-1);
+   const __m128i lo8 = _mm_set1_epi16(0xff);
+   int xx;
+
+   for (xx = 0; xx + 8 <= w; xx += 8)
+     {
+        __m128i px, y, uv, u, v, vmu, r, g, b, bg, ra;
+
+        /* y0 u0 y1 v0 y2 u1 y3 v1 ... */
+        px = _mm_loadu_si128((const __m128i *)(line + (xx * 2)));
+        y = _evas_yuv_lut_sse2(_mm_and_si128(px, lo8), 16, 13, 9535);
+        uv = _mm_srli_epi16(px, 8);
+
+        u = LANES_DUP(_evas_yuv_lut_sse2(uv, 128, 13, 16531), EVEN_LANES);
+        v = LANES_DUP(_evas_yuv_lut_sse2(uv, 128, 13, 13075), ODD_LANES);
+        vmu = _mm_add_epi16(LANES_DUP(_evas_yuv_lut_sse2(uv, 128, 8, 208), ODD_LANES),
+                            LANES_DUP(_evas_yuv_lut_sse2(uv, 128, 11, 801), EVEN_LANES));
+
+        /* saturation does the clipping */
+        r = _mm_add_epi16(y, v);
+        r = _mm_packus_epi16(r, r);
+        g = _mm_sub_epi16(y, vmu);
+        g = _mm_packus_epi16(g, g);
+        b = _mm_add_epi16(y, u);
+        b = _mm_packus_epi16(b, b);
+
+        bg = _mm_unpacklo_epi8(b, g);
+        ra = _mm_unpacklo_epi8(r, alpha);
+        _mm_storeu_si128((__m128i *)(dp1 + (xx * 4)), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128((__m128i *)(dp1 + (xx * 4) + 16), _mm_unpackhi_epi16(bg, ra));
+     }
+
+   if (xx < w)
+     _evas_yuy2_row_raster(line + (xx * 2), dp1 + (xx * 4), w - xx);
+}
+
+#undef EVEN_LANES
+#undef ODD_LANES
+#undef LANES_DUP
+
+static void
+_evas_yuy2torgb_sse2(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   int yy;
+
+   for (yy = 0; yy < h; yy++)
+     _evas_yuy2_row_sse2(yuv[yy], rgb + (yy * w * 4), w);
+}
+#endif
+
+#define HANDLE_MACROBLOCK(YP1, YP2, UP, DP1, DP2)                       \
    {                                                                    \
      int i;                                                             \
-     int j;                                                             \
                                                                         \
      for (i = 0; i < 32; i += 2)                                        \
        {                                                                \
-          for (j = 0; j < 64; j += 2)                                   \
-            {                                                           \
-               _evas_yuv2rgb_420_raster(YP1, YP2, UP, VP, DP1, DP2);    \
-                                                                        \
-               /* the previous call just rendered 2 pixels per lines */ \
-               DP1 += 8; DP2 += 8;                                      \
+          t->rows(YP1, YP2, UP, DP1, DP2, 64);                          \
                                                                         \
-               /* and took for that 2 lines with 2 Y, 1 U and 1 V. Don't forget U & V are in the same plane */ \
-               YP1 += 2; YP2 += 2; UP += 2; VP += 2;                    \
-            }                                                           \
-                                                                        \
-          DP1 += sizeof (int) * ((w << 1) - 64);			\
-          DP2 += sizeof (int) * ((w << 1) - 64);			\
-          YP1 += 64;                                                    \
-          YP2 += 64;                                                    \
+          /* 2 lines of 64 pixels, from 2 lines of Y and 1 line of UV */ \
+          DP1 += sizeof (int) * (t->w << 1);                            \
+          DP2 += sizeof (int) * (t->w << 1);                            \
+          YP1 += 128;                                                   \
+          YP2 += 128;                                                   \
+          UP += 64;                                                     \
        }                                                                \
    }
 
+typedef struct _Evas_Yuv_Tiled Evas_Yuv_Tiled;
+
+struct _Evas_Yuv_Tiled
+{
+   Evas_Yuv_420_Rows_Func rows;
+   unsigned char **yuv;
+   unsigned char *rgb;
+   int w, mb_w, base_h;
+};
+
+/* Converts the macroblock rows 2 * mb_y and 2 * mb_y + 1 */
+static void
+_evas_nv12tiled_mb_rows(Evas_Yuv_Tiled *t, int mb_y)
+{
    /* One macro block is 32 lines of Y and 16 lines of UV */
    const int offset_value[2] = { 0, 64 * 16 };
-   int mb_x, mb_y, mb_w, mb_h;
-   int base_h;
-   int uv_x, uv_step;
-   int stride;
+   const int stride = t->w * sizeof (int);
+   int step = 2;
+   int offset = 0;
+   int x = 0;
+   int rmb_x = 0;
+   int ry[2];
+   int mb_x, uv_x, uv_step;
+
+   ry[0] = mb_y * 2 * 32 * stride;
+   ry[1] = ry[0] + 32 * stride;
+
+   uv_step = (mb_y & 0x1) == 0 ? 4 : 0;
+   uv_x = (mb_y & 0x1) == 0 ? 0 : 2 * 64 * 32;
+
+   for (mb_x = 0; mb_x < t->mb_w * 2; mb_x++, rmb_x += 64 * 32)
+     {
+        unsigned char *yp1, *yp2, *up;
+        unsigned char *dp1, *dp2;
+
+        dp1 = t->rgb + x + ry[offset];
+        dp2 = dp1 + stride;
+
+        yp1 = t->yuv[mb_y] + rmb_x;
+        yp2 = yp1 + 64;
+
+        /* UV plane is two time less bigger in pixel count, but it old two bytes each times */
+        up = t->yuv[(mb_y >> 1) + t->base_h] + uv_x + offset_value[offset];
+
+        HANDLE_MACROBLOCK(yp1, yp2, up, dp1, dp2);
+
+        step++;
+        if ((step & 0x3) == 0)
+          {
+             offset = 1 - offset;
+             x -= 64 * sizeof (int);
+             uv_x -= 64 * 32;
+          }
+        else
+          {
+             x += 64 * sizeof (int);
+             uv_x += 64 * 32;
+          }
+
+        uv_step++;
+        if (uv_step == 8)
+          {
+             uv_step = 0;
+             uv_x += 4 * 64 * 32;
+          }
+     }
+}
+
+static void
+_evas_nv12tiled_slice_run(void *data, int start, int end)
+{
+   Evas_Yuv_Tiled *t = data;
+   int mb_y;
+
+   for (mb_y = start; mb_y < end; mb_y++)
+     _evas_nv12tiled_mb_rows(t, mb_y);
+}
 
+static void
+_evas_nv12tiledtorgb(unsigned char **yuv, unsigned char *rgb, int w, int h,
+                     Evas_Yuv_420_Rows_Func rows)
+{
    /* Idea iterate over each macroblock and convert each of them using _evas_nv12torgb_raster */
 
    /* The layout of the Y macroblock order in RGB non tiled space : */
@@ -1083,82 +1407,36 @@ _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int
    /* |    |    |    |    |    |    |    |    |    |    | */
    /* - 20 - 21 - 22 - 22 - 23 - 24 - 25 - 26 - 27 - 28 - */
 
+   Evas_Yuv_Tiled tiled;
+   Evas_Yuv_Tiled *t = &tiled;
+   int mb_x, mb_y, mb_h;
+
    /* the number of macroblock should be a multiple of 64x32 */
-   mb_w = w / 64;
+   t->rows = rows;
+   t->yuv = yuv;
+   t->rgb = rgb;
+   t->w = w;
+   t->mb_w = w / 64;
    mb_h = h / 32;
-
-   base_h = (mb_h >> 1) + (mb_h & 0x1);
-   stride = w * sizeof (int);
-
-   uv_x = 0;
+   t->base_h = (mb_h >> 1) + (mb_h & 0x1);
 
    /* In this format we linearize macroblock on two line to form a Z and it's invert */
-   for (mb_y = 0; mb_y < (mb_h >> 1); mb_y++)
-     {
-        int step = 2;
-        int offset = 0;
-        int x = 0;
-	int rmb_x = 0;
-	int ry[2];
-
-	ry[0] = mb_y * 2 * 32 * stride;
-	ry[1] = ry[0] + 32 * stride;
-
-	uv_step = (mb_y & 0x1) == 0 ? 4 : 0;
-	uv_x = (mb_y & 0x1) == 0 ? 0 : 2 * 64 * 32;
-
-	for (mb_x = 0; mb_x < mb_w * 2; mb_x++, rmb_x += 64 * 32)
-	  {
-	    unsigned char *yp1, *yp2, *up, *vp;
-	    unsigned char *dp1, *dp2;
-
-	    dp1 = rgb + x + ry[offset];
-	    dp2 = dp1 + stride;
-
-	    yp1 = yuv[mb_y] + rmb_x;
-	    yp2 = yp1 + 64;
-
-	    /* UV plane is two time less bigger in pixel count, but it old two bytes each times */
-	    up = yuv[(mb_y >> 1) + base_h] + uv_x + offset_value[offset];
-	    vp = up + 1;
-
-	    HANDLE_MACROBLOCK(yp1, yp2, up, vp, dp1, dp2);
-
-	    step++;
-	    if ((step & 0x3) == 0)
-	      {
-		offset = 1 - offset;
-		x -= 64 * sizeof (int);
-		uv_x -= 64 * 32;
-	      }
-	    else
-	      {
-		x += 64 * sizeof (int);
-		uv_x += 64 * 32;
-	      }
-
-	    uv_step++;
-	    if (uv_step == 8)
-	      {
-		uv_step = 0;
-		uv_x += 4 * 64 * 32;
-	      }
-	  }
-     }
+   mb_y = mb_h >> 1;
+   evas_thread_parallel_run(mb_y, 1, _evas_nv12tiled_slice_run, t);
 
    if (mb_h & 0x1)
      {
         int x = 0;
-	int ry;
+        int ry;
+        int uv_x;
 
-	ry = mb_y << 1;
+        ry = mb_y << 1;
 
-	uv_step = 0;
-	uv_x = 0;
+        uv_x = 0;
 
-        for (mb_x = 0; mb_x < mb_w; mb_x++, x++, uv_x++)
+        for (mb_x = 0; mb_x < t->mb_w; mb_x++, x++, uv_x++)
           {
-             unsigned char *yp1, *yp2, *up, *vp;
+             unsigned char *yp1, *yp2, *up;
              unsigned char *dp1, *dp2;
 
              dp1 = rgb + (x * 64 + (ry * 32 * w)) * sizeof (int);
@@ -1167,49 +1445,36 @@ _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int
              yp1 = yuv[mb_y] + mb_x * 64 * 32;
              yp2 = yp1 + 64;
 
-             up = yuv[mb_y / 2 + base_h] + uv_x * 64 * 32;
-             vp = up + 1;
+             up = yuv[mb_y / 2 + t->base_h] + uv_x * 64 * 32;
 
-             HANDLE_MACROBLOCK(yp1, yp2, up, vp, dp1, dp2);
+             HANDLE_MACROBLOCK(yp1, yp2, up, dp1, dp2);
           }
      }
 }
 
+#undef HANDLE_MACROBLOCK
+
 static void
-_evas_nv12torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+_evas_nv12torgb(unsigned char **yuv, unsigned char *rgb, int w, int h,
+                Evas_Yuv_420_Rows_Func rows)
 {
-   int xx, yy;
-   unsigned char *yp1, *yp2, *up, *vp;
-   unsigned char *dp1;
-   unsigned char *dp2;
+   int yy;
 
-   dp1 = rgb;
-   dp2 = dp1 + sizeof (int) * w;
-
-   for (yy = 0; yy < h; yy++)
-     {
-        yp1 = yuv[yy++];
-        yp2 = yuv[yy];
-
-        up = yuv[h + (yy >> 1)];
-        vp = up + 1;
-
-        for (xx = 0; xx < w; xx += 2)
-          {
-             _evas_yuv2rgb_420_raster(yp1, yp2, up, vp, dp1, dp2);
-
-             /* the previous call just rendered 2 pixels per lines */
-             dp1 += 8; dp2 += 8;
-
-             /* and took for that 2 lines with 2 Y, 1 U and 1 V. Don't forget U & V are in the same plane */
-             yp1 += 2; yp2 += 2; up += 2; vp += 2;
-          }
+   for (yy = 0; yy + 1 < h; yy += 2)
+     rows(yuv[yy], yuv[yy + 1], yuv[h + (yy >> 1)],
+          rgb + (yy * w * 4), rgb + ((yy + 1) * w * 4), w);
+}
 
-        /* jump one line */
-        dp1 += sizeof (int) * w;
-        dp2 += sizeof (int) * w;
-        yp1 += w;
-        yp2 += w;
-     }
+static void
+_evas_nv12torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   _evas_nv12torgb(yuv, rgb, w, h, _evas_nv12_rows_raster);
 }
 
+#ifdef EVAS_YUV_SSE2
+static void
+_evas_nv12torgb_sse2(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   _evas_nv12torgb(yuv, rgb, w, h, _evas_nv12_rows_sse2);
+}
+#endif
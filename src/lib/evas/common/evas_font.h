@@ -4,6 +4,18 @@
 
 /* The tangent of the slant angle we do on runtime. */
 #define _EVAS_FONT_SLANT_TAN 0.221694663
+
+typedef struct _Evas_Common_Glyph_Cache_Stats Evas_Common_Glyph_Cache_Stats;
+
+/* Counters of the glyph cache, see evas_common_font_int_cache_glyph_get() */
+struct _Evas_Common_Glyph_Cache_Stats
+{
+   unsigned int hits; /* glyphs found in their font instance */
+   unsigned int misses; /* glyphs loaded from the face */
+   unsigned int evicted; /* unused glyphs freed to stay in budget */
+   int          usage; /* bytes of rendered glyphs held now */
+   int          size; /* bytes they are trimmed to */
+};
 /* main */
 
 EAPI void              evas_common_font_init                 (void);
@@ -22,12 +34,17 @@ EAPI int               evas_common_font_instance_underline_position_get       (R
 EAPI int               evas_common_font_instance_underline_thickness_get      (RGBA_Font_Int *fi);
 EAPI int               evas_common_font_get_line_advance     (RGBA_Font *fn);
 void *evas_common_font_freetype_face_get(RGBA_Font *font); /* XXX: Not EAPI on purpose. Not ment to be used in modules. */
+EAPI int               evas_common_font_glyph_cache_get      (void);
+EAPI void              evas_common_font_glyph_cache_set      (int size);
+EAPI void              evas_common_font_glyph_cache_trim     (void);
+EAPI void              evas_common_font_glyph_cache_stats_get(Evas_Common_Glyph_Cache_Stats *st);
 
 /* draw */
 typedef Eina_Bool (*Evas_Common_Font_Draw_Cb)(RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas_Glyph_Array *glyphs, RGBA_Gfx_Func func, int ext_x, int ext_y, int ext_w, int ext_h, int im_w, int im_h);
 
 EAPI Eina_Bool         evas_common_font_draw_cb              (RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas_Glyph_Array *glyphs, Evas_Common_Font_Draw_Cb cb);
 EAPI void              evas_common_font_draw                 (RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas_Glyph_Array *glyphs);
+EAPI void              evas_common_font_draw_multi           (RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas_Font_Array *texts);
 EAPI Eina_Bool         evas_common_font_rgba_draw            (RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas_Glyph_Array *glyphs, RGBA_Gfx_Func func, int ext_x, int ext_y, int ext_w, int ext_h, int im_w, int im_h);
 EAPI int               evas_common_font_glyph_search         (RGBA_Font *fn, RGBA_Font_Int **fi_ret, Eina_Unicode gl);
 EAPI RGBA_Font_Glyph  *evas_common_font_int_cache_glyph_get  (RGBA_Font_Int *fi, FT_UInt index);
@@ -202,7 +202,8 @@ evas_common_font_glyphs_ref(Evas_Glyph_Array *array)
 
         iter = eina_inarray_iterator_new(array->array);
         EINA_ITERATOR_FOREACH(iter, glyph)
-          evas_cserve2_font_glyph_ref(glyph->fg->glyph_out, EINA_TRUE);
+          if (glyph->fg->fi->cs2_handler)
+            evas_cserve2_font_glyph_ref(glyph->fg->glyph_out, EINA_TRUE);
         eina_iterator_free(iter);
      }
 #endif
@@ -213,21 +214,18 @@ evas_common_font_glyphs_ref(Evas_Glyph_Array *array)
 void
 evas_common_font_glyphs_unref(Evas_Glyph_Array *array)
 {
+   Evas_Glyph *glyph;
+
    if (--array->refcount) return;
 
-#ifdef EVAS_CSERVE2
-   if (evas_cserve2_use_get())
+   EINA_INARRAY_FOREACH(array->array, glyph)
      {
-        Eina_Iterator *iter;
-        Evas_Glyph *glyph;
-
-        iter = eina_inarray_iterator_new(array->array);
-        EINA_ITERATOR_FOREACH(iter, glyph)
+#ifdef EVAS_CSERVE2
+        if (evas_cserve2_use_get() && glyph->fg->fi->cs2_handler)
           evas_cserve2_font_glyph_ref(glyph->fg->glyph_out, EINA_FALSE);
-        eina_iterator_free(iter);
-     }
 #endif
-
+        evas_common_font_glyph_unref(glyph->fg);
+     }
    eina_inarray_free(array->array);
    evas_common_font_int_unref(array->fi);
    free(array);
@@ -253,6 +251,7 @@ evas_common_font_draw_prepare(Evas_Text_Props *text_props)
 {
    RGBA_Font_Int *fi;
    RGBA_Font_Glyph *fg = NULL;
+   Evas_Glyph *glyph;
    Eina_Inarray *glyphs;
    size_t unit = 32;
    Eina_Bool reused_glyphs;
@@ -267,41 +266,32 @@ evas_common_font_draw_prepare(Evas_Text_Props *text_props)
    if (text_props->len < unit) unit = text_props->len;
    if (text_props->glyphs && text_props->glyphs->refcount == 1)
      {
-#ifdef EVAS_CSERVE2
-        if (evas_cserve2_use_get())
+        EINA_INARRAY_FOREACH(text_props->glyphs->array, glyph)
           {
-             Eina_Iterator *iter;
-             Evas_Glyph *glyph;
-
-             iter = eina_inarray_iterator_new(text_props->glyphs->array);
-             EINA_ITERATOR_FOREACH(iter, glyph)
+#ifdef EVAS_CSERVE2
+             if (evas_cserve2_use_get() && glyph->fg->fi->cs2_handler)
                evas_cserve2_font_glyph_ref(glyph->fg->glyph_out, EINA_FALSE);
-             eina_iterator_free(iter);
-          }
 #endif
+             evas_common_font_glyph_unref(glyph->fg);
+          }
         glyphs = text_props->glyphs->array;
         glyphs->len = 0;
         reused_glyphs = EINA_TRUE;
      }
    else
      {
+        if (text_props->glyphs) evas_common_font_glyphs_unref(text_props->glyphs);
+        text_props->glyphs = NULL;
         glyphs = eina_inarray_new(sizeof(Evas_Glyph), unit);
         reused_glyphs = EINA_FALSE;
      }
    evas_common_font_int_reload(fi);
 
-   if (fi->src->current_size != fi->size)
-     {
-        evas_common_font_source_reload(fi->src);
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
-
+   /* Text is also shaped off the main loop, which fills the glyph cache of
+    * fi under that lock too */
+   LKL(fi->ft_mutex);
    EVAS_FONT_WALK_TEXT_START()
      {
-        Evas_Glyph *glyph;
         FT_UInt idx;
 
         if (!EVAS_FONT_WALK_IS_VISIBLE) continue;
@@ -316,13 +306,14 @@ evas_common_font_draw_prepare(Evas_Text_Props *text_props)
           }
 
 #ifdef EVAS_CSERVE2
-        if (evas_cserve2_use_get())
+        if (evas_cserve2_use_get() && fg->fi->cs2_handler)
           evas_cserve2_font_glyph_ref(fg->glyph_out, EINA_TRUE);
 #endif
 	
 	glyph = eina_inarray_grow(glyphs, 1);
 	if (!glyph) goto error;
 
+        evas_common_font_glyph_ref(fg);
         glyph->fg = fg;
         glyph->idx = idx;
         glyph->x = EVAS_FONT_WALK_PEN_X + EVAS_FONT_WALK_X_OFF + EVAS_FONT_WALK_X_BEAR;
@@ -332,8 +323,6 @@ evas_common_font_draw_prepare(Evas_Text_Props *text_props)
 
    if (!reused_glyphs)
      {
-        if (text_props->glyphs) evas_common_font_glyphs_unref(text_props->glyphs);
-
         text_props->glyphs = malloc(sizeof(*text_props->glyphs));
         if (!text_props->glyphs) goto error;
         text_props->glyphs->refcount = 1;
@@ -341,6 +330,7 @@ evas_common_font_draw_prepare(Evas_Text_Props *text_props)
         text_props->glyphs->fi = fi;
         fi->references++;
      }
+   LKU(fi->ft_mutex);
 
    /* check if there's a request queue in fi, if so ask cserve2 to render
     * those glyphs
@@ -348,10 +338,12 @@ evas_common_font_draw_prepare(Evas_Text_Props *text_props)
 
    text_props->generation = fi->generation;
    text_props->changed = EINA_FALSE;
-
    return;
 
 error:
+   LKU(fi->ft_mutex);
+   EINA_INARRAY_FOREACH(glyphs, glyph)
+     evas_common_font_glyph_unref(glyph->fg);
    eina_inarray_free(glyphs);
 }
 
@@ -436,6 +428,60 @@ evas_common_font_draw(RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas
                             evas_common_font_rgba_draw);
 }
 
+/* Draws a batch of glyph runs sharing one baseline, like a textgrid row.
+ * The clip and cutouts are only resolved once for the whole batch. */
+EAPI void
+evas_common_font_draw_multi(RGBA_Image *dst, RGBA_Draw_Context *dc, int x, int y, Evas_Font_Array *texts)
+{
+   Cutout_Rects *rects = NULL;
+   Evas_Font_Array_Data *itr;
+   RGBA_Gfx_Func func;
+   Eina_Rectangle area;
+   Cutout_Rect *r;
+   DATA32 col;
+   int c, cx, cy, cw, ch;
+   int im_w, im_h, i;
+
+   if ((!texts) || (!texts->array)) return;
+
+   im_w = dst->cache_entry.w;
+   im_h = dst->cache_entry.h;
+
+   col = dc->col.col;
+   c = dc->clip.use; cx = dc->clip.x; cy = dc->clip.y; cw = dc->clip.w; ch = dc->clip.h;
+   if (!evas_common_font_draw_prepare_cutout(&rects, dst, dc, &func))
+     goto end;
+   EINA_RECTANGLE_SET(&area, dc->clip.x, dc->clip.y, dc->clip.w, dc->clip.h);
+
+   EINA_INARRAY_FOREACH(texts->array, itr)
+     {
+        if (!itr->glyphs) continue;
+        evas_common_draw_context_set_color(dc, itr->color.r, itr->color.g,
+                                           itr->color.b, itr->color.a);
+        if (!rects)
+          {
+             evas_common_font_rgba_draw(dst, dc, x + itr->x, y, itr->glyphs,
+                                        func, area.x, area.y, area.w, area.h,
+                                        im_w, im_h);
+             continue;
+          }
+        for (i = 0; i < rects->active; i++)
+          {
+             r = rects->rects + i;
+             evas_common_draw_context_set_clip(dc, r->x, r->y, r->w, r->h);
+             evas_common_font_rgba_draw(dst, dc, x + itr->x, y, itr->glyphs,
+                                        func, r->x, r->y, r->w, r->h,
+                                        im_w, im_h);
+          }
+     }
+   if (rects) evas_common_draw_context_apply_clear_cutouts(rects);
+
+ end:
+   dc->clip.use = c; dc->clip.x = cx; dc->clip.y = cy; dc->clip.w = cw; dc->clip.h = ch;
+   evas_common_draw_context_set_color(dc, R_VAL(&col), G_VAL(&col),
+                                      B_VAL(&col), A_VAL(&col));
+}
+
 EAPI void
 evas_common_font_draw_do(const Cutout_Rects *reuse, const Eina_Rectangle *clip, RGBA_Gfx_Func func,
                          RGBA_Image *dst, RGBA_Draw_Context *dc,
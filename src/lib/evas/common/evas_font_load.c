@@ -33,6 +33,11 @@ static Eina_Inlist *fonts_use_lru = NULL;
 static int          fonts_use_usage = 0;
 
 static void _evas_common_font_int_clear(RGBA_Font_Int *fi);
+static RGBA_Font_Int *_evas_common_font_int_hinted_get(RGBA_Font_Int *fi, Font_Hint_Flags hinting);
+
+/* The hinting a font instance is loaded with, the one of a new RGBA_Font.
+ * Instances with another hinting are only made by hinting changes. */
+#define FONT_INT_DEFAULT_HINT FONT_BYTECODE_HINT
 
 static int
 _evas_font_cache_int_cmp(const RGBA_Font_Int *k1, int k1_length EINA_UNUSED,
@@ -42,7 +47,11 @@ _evas_font_cache_int_cmp(const RGBA_Font_Int *k1, int k1_length EINA_UNUSED,
    if (k1->src->name == k2->src->name)
      {
         if (k1->size == k2->size)
-           return k1->wanted_rend - k2->wanted_rend;
+          {
+             if (k1->wanted_rend == k2->wanted_rend)
+               return k1->hinting - k2->hinting;
+             return k1->wanted_rend - k2->wanted_rend;
+          }
         else
            return k1->size - k2->size;
      }
@@ -54,9 +63,11 @@ _evas_font_cache_int_hash(const RGBA_Font_Int *key, int key_length EINA_UNUSED)
 {
    int hash;
    unsigned int wanted_rend = key->wanted_rend;
+   unsigned int hinting = key->hinting;
    hash = eina_hash_djb2(key->src->name, eina_stringshare_strlen(key->src->name) + 1);
    hash ^= eina_hash_int32(&key->size, sizeof (int));
    hash ^= eina_hash_int32(&wanted_rend, sizeof (int));
+   hash ^= eina_hash_int32(&hinting, sizeof (int));
    return hash;
 }
 
@@ -80,6 +91,7 @@ _evas_common_font_int_free(RGBA_Font_Int *fi)
 
    evas_common_font_int_modify_cache_by(fi, -1);
    _evas_common_font_int_clear(fi);
+   evas_common_text_props_cache_font_del(fi);
    eina_hash_free(fi->kerning);
 
    LKD(fi->ft_mutex);
@@ -350,6 +362,7 @@ evas_common_font_int_memory_load(const char *source, const char *name, int size,
 	return NULL;
      }
    fi->size = size;
+   fi->hinting = FONT_INT_DEFAULT_HINT;
    _evas_common_font_int_cache_init(fi);
    fi = evas_common_font_int_load_init(fi);
    evas_common_font_int_load_complete(fi);
@@ -393,6 +406,7 @@ evas_common_font_int_load(const char *name, int size,
      }
    fi->size = size;
    fi->wanted_rend = wanted_rend;
+   fi->hinting = FONT_INT_DEFAULT_HINT;
    _evas_common_font_int_cache_init(fi);
    fi = evas_common_font_int_load_init(fi);
 #ifdef EVAS_CSERVE2
@@ -558,8 +572,7 @@ evas_common_font_memory_load(const char *source, const char *name, int size, con
 	return NULL;
      }
    fn->fonts = eina_list_append(fn->fonts, fi);
-   fn->hinting = FONT_BYTECODE_HINT;
-   fi->hinting = fn->hinting;
+   fn->hinting = FONT_INT_DEFAULT_HINT;
    fn->references = 1;
    LKI(fn->lock);
    if (fi->inuse) evas_common_font_int_promote(fi);
@@ -605,8 +618,7 @@ evas_common_font_load(const char *name, int size, Font_Rend_Flags wanted_rend)
      }
 
    fn->fonts = eina_list_append(fn->fonts, fi);
-   fn->hinting = FONT_BYTECODE_HINT;
-   fi->hinting = fn->hinting;
+   fn->hinting = FONT_INT_DEFAULT_HINT;
    fn->references = 1;
    LKI(fn->lock);
    if (fi->inuse) evas_common_font_int_promote(fi);
@@ -627,8 +639,8 @@ evas_common_font_add(RGBA_Font *fn, const char *name, int size, Font_Rend_Flags
    fi = evas_common_font_int_load(name, size, wanted_rend);
    if (fi)
      {
+        fi = _evas_common_font_int_hinted_get(fi, fn->hinting);
 	fn->fonts = eina_list_append(fn->fonts, fi);
-	fi->hinting = fn->hinting;
         if (fi->inuse) evas_common_font_int_promote(fi);
         else
          {
@@ -650,8 +662,8 @@ evas_common_font_memory_add(RGBA_Font *fn, const char *source, const char *name,
    fi = evas_common_font_int_memory_load(source, name, size, data, data_size, wanted_rend);
    if (fi)
      {
+        fi = _evas_common_font_int_hinted_get(fi, fn->hinting);
 	fn->fonts = eina_list_append(fn->fonts, fi);
-	fi->hinting = fn->hinting;
         if (fi->inuse) evas_common_font_int_promote(fi);
         else
          {
@@ -663,11 +675,18 @@ evas_common_font_memory_add(RGBA_Font *fn, const char *source, const char *name,
    return NULL;
 }
 
+/* References are taken and given back under fi->ft_mutex, as text laid out
+ * off the main loop holds some too. Fonts hold theirs until they are freed
+ * on the main loop, so that's where the last one goes. */
 EAPI void
 evas_common_font_int_unref(RGBA_Font_Int *fi)
 {
-   fi->references--;
-   if (fi->references == 0)
+   int references;
+
+   LKL(fi->ft_mutex);
+   references = --fi->references;
+   LKU(fi->ft_mutex);
+   if (references == 0)
      {
         fonts_lru = eina_list_append(fonts_lru, fi);
         evas_common_font_int_modify_cache_by(fi, 1);
@@ -697,16 +716,31 @@ EAPI void
 evas_common_font_hinting_set(RGBA_Font *fn, Font_Hint_Flags hinting)
 {
    Eina_List *l;
-   RGBA_Font_Int *fi;
+   RGBA_Font_Int *fi, *hfi;
+   Eina_Bool changed = EINA_FALSE;
 
    if (!fn) return;
+   LKL(fn->lock);
    fn->hinting = hinting;
    EINA_LIST_FOREACH(fn->fonts, l, fi)
      {
-        if (fi->hinting != fn->hinting)
-          _evas_common_font_int_clear(fi);
-        fi->hinting = fn->hinting;
+        hfi = _evas_common_font_int_hinted_get(fi, hinting);
+        if (hfi == fi) continue;
+        if (!hfi->inuse)
+          {
+             hfi->inuse = 1;
+             fonts_use_lru = eina_inlist_prepend(fonts_use_lru, EINA_INLIST_GET(hfi));
+          }
+        eina_list_data_set(l, hfi);
+        changed = EINA_TRUE;
+     }
+   /* the glyph search cache points to the old instances */
+   if ((changed) && (fn->fash))
+     {
+        fn->fash->freeme(fn->fash);
+        fn->fash = NULL;
      }
+   LKU(fn->lock);
 }
 
 EAPI Eina_Bool
@@ -937,28 +971,89 @@ evas_common_font_flush_last(void)
    eina_hash_del(fonts, fi, fi);
 }
 
-EAPI RGBA_Font_Int *
-evas_common_font_int_find(const char *name, int size,
-                          Font_Rend_Flags wanted_rend)
+static RGBA_Font_Int *
+_evas_common_font_int_cache_find(const RGBA_Font_Int *key)
 {
-   RGBA_Font_Int tmp_fi;
-   RGBA_Font_Source tmp_fn;
    RGBA_Font_Int *fi;
 
-   tmp_fn.name = (char*) eina_stringshare_add(name);
-   tmp_fi.src = &tmp_fn;
-   tmp_fi.size = size;
-   tmp_fi.wanted_rend = wanted_rend;
-   fi = eina_hash_find(fonts, &tmp_fi);
+   fi = eina_hash_find(fonts, key);
    if (fi)
      {
+        LKL(fi->ft_mutex);
 	if (fi->references == 0)
 	  {
 	     evas_common_font_int_modify_cache_by(fi, -1);
 	     fonts_lru = eina_list_remove(fonts_lru, fi);
 	  }
 	fi->references++;
+        LKU(fi->ft_mutex);
      }
+   return fi;
+}
+
+EAPI RGBA_Font_Int *
+evas_common_font_int_find(const char *name, int size,
+                          Font_Rend_Flags wanted_rend)
+{
+   RGBA_Font_Int tmp_fi;
+   RGBA_Font_Source tmp_fn;
+   RGBA_Font_Int *fi;
+
+   tmp_fn.name = (char*) eina_stringshare_add(name);
+   tmp_fi.src = &tmp_fn;
+   tmp_fi.size = size;
+   tmp_fi.wanted_rend = wanted_rend;
+   tmp_fi.hinting = FONT_INT_DEFAULT_HINT;
+   fi = _evas_common_font_int_cache_find(&tmp_fi);
    eina_stringshare_del(tmp_fn.name);
    return fi;
 }
+
+/* Returns the instance of fi's font with the given hinting, loading it if
+ * needed, and takes over the reference to fi. Each hinting keeps its own
+ * glyphs, so canvases hinting the same font differently share them instead
+ * of clearing each other's. */
+static RGBA_Font_Int *
+_evas_common_font_int_hinted_get(RGBA_Font_Int *fi, Font_Hint_Flags hinting)
+{
+   RGBA_Font_Int tmp_fi, *hfi;
+
+   if (fi->hinting == hinting) return fi;
+   tmp_fi.src = fi->src;
+   tmp_fi.size = fi->size;
+   tmp_fi.wanted_rend = fi->wanted_rend;
+   tmp_fi.hinting = hinting;
+   hfi = _evas_common_font_int_cache_find(&tmp_fi);
+   if (!hfi)
+     {
+        hfi = calloc(1, sizeof(RGBA_Font_Int));
+        if (!hfi) return fi;
+        hfi->src = fi->src;
+        hfi->src->references++;
+        hfi->size = fi->size;
+        hfi->wanted_rend = fi->wanted_rend;
+        hfi->hinting = hinting;
+        _evas_common_font_int_cache_init(hfi);
+        hfi = evas_common_font_int_load_init(hfi);
+#ifdef EVAS_CSERVE2
+        if (fi->cs2_handler)
+          {
+             hfi->cs2_handler = evas_cserve2_font_load_again(fi->cs2_handler);
+             if ((hfi->cs2_handler) &&
+                 (evas_cserve2_font_load_wait((Font_Entry *)hfi->cs2_handler) != 0))
+               {
+                  evas_cserve2_font_free(hfi->cs2_handler);
+                  hfi->cs2_handler = NULL;
+               }
+          }
+#endif
+        /* fallback fonts complete their load on first use */
+        if (fi->ft.size)
+          {
+             evas_common_font_int_reload(fi);
+             evas_common_font_int_load_complete(hfi);
+          }
+     }
+   evas_common_font_int_unref(fi);
+   return hfi;
+}
@@ -23,6 +23,17 @@ static int      initialised = 0;
 LK(lock_font_draw); // for freetype2 API calls
 LK(lock_bidi); // for evas bidi internal usage.
 LK(lock_ot); // for evas bidi internal usage.
+LK(lock_glyph_cache); // for the glyph LRU and references
+
+/* Glyphs live in the font instances, which are shared by every canvas of the
+ * process. Glyphs no glyph array references sit in glyph_lru, oldest first,
+ * and are freed from there when their rendered size goes over the budget. */
+static Eina_Inlist *glyph_lru = NULL;
+static int          glyph_cache_usage = 0;
+static int          glyph_cache_size = 4 * 1024 * 1024;
+static unsigned int glyph_cache_hits = 0;
+static unsigned int glyph_cache_misses = 0;
+static unsigned int glyph_cache_evicted = 0;
 
 EAPI void
 evas_common_font_init(void)
@@ -34,6 +45,7 @@ evas_common_font_init(void)
    if (initialised != 1) return;
    error = FT_Init_FreeType(&evas_ft_lib);
    if (error) return;
+   evas_common_text_props_cache_init();
    evas_common_font_load_init();
    evas_common_font_draw_init();
    s = getenv("EVAS_FONT_DPI");
@@ -43,9 +55,12 @@ evas_common_font_init(void)
 
         if (dpi > 0) evas_common_font_dpi_set(dpi);
      }
+   s = getenv("EVAS_GLYPH_CACHE_SIZE");
+   if (s) glyph_cache_size = atoi(s) * 1024;
    LKI(lock_font_draw);
    LKI(lock_bidi);
    LKI(lock_ot);
+   LKI(lock_glyph_cache);
 }
 
 EAPI void
@@ -58,6 +73,7 @@ evas_common_font_shutdown(void)
    evas_common_font_load_shutdown();
    evas_common_font_cache_set(0);
    evas_common_font_flush();
+   evas_common_text_props_cache_shutdown();
 
    FT_Done_FreeType(evas_ft_lib);
    evas_ft_lib = 0;
@@ -65,6 +81,7 @@ evas_common_font_shutdown(void)
    LKD(lock_font_draw);
    LKD(lock_bidi);
    LKD(lock_ot);
+   LKD(lock_glyph_cache);
 }
 
 EAPI void
@@ -89,23 +106,33 @@ evas_common_font_freetype_face_get(RGBA_Font *font)
    return fi->src->ft.face;
 }
 
-EAPI int
-evas_common_font_instance_ascent_get(RGBA_Font_Int *fi)
+/* The face of a source is shared by the instances of all its sizes, and
+ * text is also laid out off the main loop: it is only used with FTLOCK
+ * held, after making the size of the instance it's used for the active
+ * one with this. */
+void
+evas_common_font_int_size_activate(RGBA_Font_Int *fi)
 {
-   int val;
-   evas_common_font_int_reload(fi);
    if (fi->src->current_size != fi->size)
      {
-        FTLOCK();
         FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
         fi->src->current_size = fi->size;
      }
+}
+
+EAPI int
+evas_common_font_instance_ascent_get(RGBA_Font_Int *fi)
+{
+   int val;
+   evas_common_font_int_reload(fi);
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
    if (!FT_IS_SCALABLE(fi->src->ft.face))
      {
         WRN("NOT SCALABLE!");
      }
    val = (int)fi->src->ft.face->size->metrics.ascender;
+   FTUNLOCK();
    return FONT_METRIC_ROUNDUP(val);
 //   printf("%i | %i\n", val, val >> 6);
 //   if (fi->src->ft.face->units_per_EM == 0)
@@ -120,14 +147,10 @@ evas_common_font_instance_descent_get(RGBA_Font_Int *fi)
 {
    int val;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
    val = -(int)fi->src->ft.face->size->metrics.descender;
+   FTUNLOCK();
    return FONT_METRIC_ROUNDUP(val);
 //   if (fi->src->ft.face->units_per_EM == 0)
 //     return val;
@@ -143,13 +166,8 @@ evas_common_font_instance_max_ascent_get(RGBA_Font_Int *fi)
    int ret;
 
    evas_common_font_int_reload(fi);
-  if (fi->src->current_size != fi->size)
-     {
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
    if ((fi->src->ft.face->bbox.yMax == 0) &&
        (fi->src->ft.face->bbox.yMin == 0) &&
        (fi->src->ft.face->units_per_EM == 0))
@@ -157,9 +175,13 @@ evas_common_font_instance_max_ascent_get(RGBA_Font_Int *fi)
    else
      val = (int)fi->src->ft.face->bbox.yMax;
    if (fi->src->ft.face->units_per_EM == 0)
-     return val;
+     {
+        FTUNLOCK();
+        return val;
+     }
    dv = (fi->src->ft.orig_upem * 2048) / fi->src->ft.face->units_per_EM;
    ret = FONT_METRIC_CONV(val, dv, fi->src->ft.face->size->metrics.y_scale);
+   FTUNLOCK();
    return ret;
 }
 
@@ -170,13 +192,8 @@ evas_common_font_instance_max_descent_get(RGBA_Font_Int *fi)
    int ret;
 
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
    if ((fi->src->ft.face->bbox.yMax == 0) &&
        (fi->src->ft.face->bbox.yMin == 0) &&
        (fi->src->ft.face->units_per_EM == 0))
@@ -184,9 +201,13 @@ evas_common_font_instance_max_descent_get(RGBA_Font_Int *fi)
    else
      val = -(int)fi->src->ft.face->bbox.yMin;
    if (fi->src->ft.face->units_per_EM == 0)
-     return val;
+     {
+        FTUNLOCK();
+        return val;
+     }
    dv = (fi->src->ft.orig_upem * 2048) / fi->src->ft.face->units_per_EM;
    ret = FONT_METRIC_CONV(val, dv, fi->src->ft.face->size->metrics.y_scale);
+   FTUNLOCK();
    return ret;
 }
 
@@ -227,21 +248,17 @@ evas_common_font_get_line_advance(RGBA_Font *fn)
 //   evas_common_font_size_use(fn);
    fi = fn->fonts->data;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
    val = (int)fi->src->ft.face->size->metrics.height;
    if ((fi->src->ft.face->bbox.yMax == 0) &&
        (fi->src->ft.face->bbox.yMin == 0) &&
        (fi->src->ft.face->units_per_EM == 0))
-     return FONT_METRIC_ROUNDUP(val);
-   else if (fi->src->ft.face->units_per_EM == 0)
-     return val;
-   return FONT_METRIC_ROUNDUP(val);
+     val = FONT_METRIC_ROUNDUP(val);
+   else if (fi->src->ft.face->units_per_EM != 0)
+     val = FONT_METRIC_ROUNDUP(val);
+   FTUNLOCK();
+   return val;
 //   dv = (fi->src->ft.orig_upem * 2048) / fi->src->ft.face->units_per_EM;
 //   ret = (val * fi->src->ft.face->size->metrics.y_scale) / (dv * dv);
 //   return ret;
@@ -255,16 +272,12 @@ evas_common_font_instance_underline_position_get(RGBA_Font_Int *fi)
    if (!fi) goto end;
 
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
 
    position = FT_MulFix(fi->src->ft.face->underline_position,
          fi->src->ft.face->size->metrics.x_scale);
+   FTUNLOCK();
    position = FONT_METRIC_ROUNDUP(abs(position));
 
 end:
@@ -283,16 +296,12 @@ evas_common_font_instance_underline_thickness_get(RGBA_Font_Int *fi)
    if (!fi) goto end;
 
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FTLOCK();
+   evas_common_font_int_size_activate(fi);
 
    thickness = FT_MulFix(fi->src->ft.face->underline_thickness,
          fi->src->ft.face->size->metrics.x_scale);
+   FTUNLOCK();
    thickness = FONT_METRIC_ROUNDUP(thickness);
 
 end:
@@ -364,11 +373,40 @@ _fash_int_add(Fash_Int *fash, int item, RGBA_Font_Int *fint, int idx)
    fash->bucket[grp]->bucket[maj]->item[min].index = idx;
 }
 
+static void
+_glyph_cache_add(RGBA_Font_Glyph *fg)
+{
+   LKL(lock_glyph_cache);
+   glyph_lru = eina_inlist_append(glyph_lru, EINA_INLIST_GET(fg));
+   glyph_cache_misses++;
+   LKU(lock_glyph_cache);
+}
+
+static inline RGBA_Font_Glyph *
+_glyph_cache_hit(RGBA_Font_Glyph *fg)
+{
+   LKL(lock_glyph_cache);
+   glyph_cache_hits++;
+   LKU(lock_glyph_cache);
+   return fg;
+}
+
+static void
+_glyph_cache_del(RGBA_Font_Glyph *fg)
+{
+   LKL(lock_glyph_cache);
+   if (!fg->references)
+     glyph_lru = eina_inlist_remove(glyph_lru, EINA_INLIST_GET(fg));
+   glyph_cache_usage -= fg->usage;
+   LKU(lock_glyph_cache);
+}
+
 static void
 _glyph_free(RGBA_Font_Glyph *fg)
 {
    if ((!fg) || (fg == (void *)(-1))) return;
 
+   _glyph_cache_del(fg);
    if (fg->glyph_out)
      {
         if ((!fg->glyph_out->rle) && (!fg->glyph_out->bitmap.rle_alloc))
@@ -466,6 +504,8 @@ _fash_gl_add(Fash_Glyph *fash, int item, RGBA_Font_Glyph *glyph)
    fash->bucket[grp]->bucket[maj]->item[min] = glyph;
 }
 
+/* Called with fi->ft_mutex held: it guards the glyph table of fi, and keeps
+ * the glyph returned from being freed for as long as it's held. */
 EAPI RGBA_Font_Glyph *
 evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt idx)
 {
@@ -488,16 +528,16 @@ evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt idx)
                {
                   if (evas_cserve2_font_glyph_used(fi->cs2_handler, idx,
                                                    fi->hinting))
-                    return fg;
+                    return _glyph_cache_hit(fg);
                   else
                     {
                        _glyph_free(fg);
                        _fash_gl_add(fi->fash, idx, NULL);
                     }
                }
-             else return fg;
+             else return _glyph_cache_hit(fg);
 #else
-             return fg;
+             return _glyph_cache_hit(fg);
 #endif
           }
      }
@@ -505,15 +545,18 @@ evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt idx)
 //   if (fg) return fg;
 
    evas_common_font_int_reload(fi);
+   /* The glyph slot is the face's, so it's kept locked until the glyph is
+    * copied out of it */
    FTLOCK();
+   evas_common_font_int_size_activate(fi);
    error = FT_Load_Glyph(fi->src->ft.face, idx,
                          (FT_HAS_COLOR(fi->src->ft.face) ?
                           (FT_LOAD_COLOR | hintflags[fi->hinting]) :
                           (FT_LOAD_DEFAULT | FT_LOAD_NO_BITMAP | hintflags[fi->hinting])));
 
-   FTUNLOCK();
    if (error)
      {
+        FTUNLOCK();
         if (!fi->fash) fi->fash = _fash_gl_new();
         if (fi->fash) _fash_gl_add(fi->fash, idx, (void *)(-1));
         return NULL;
@@ -527,9 +570,12 @@ evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt idx)
       FT_GlyphSlot_Embolden(fi->src->ft.face->glyph);
 
    fg = calloc(1, sizeof(RGBA_Font_Glyph));
-   if (!fg) return NULL;
+   if (!fg)
+     {
+        FTUNLOCK();
+        return NULL;
+     }
 
-   FTLOCK();
    error = FT_Get_Glyph(fi->src->ft.face->glyph, &(fg->glyph));
    FTUNLOCK();
    if (error)
@@ -556,6 +602,7 @@ evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt idx)
 
    if (!fi->fash) fi->fash = _fash_gl_new();
    if (fi->fash) _fash_gl_add(fi->fash, idx, fg);
+   _glyph_cache_add(fg);
 
 #ifdef EVAS_CSERVE2
    if (fi->cs2_handler)
@@ -584,6 +631,7 @@ evas_common_font_int_cache_glyph_render(RGBA_Font_Glyph *fg)
           {
              if (!fi->fash) fi->fash = _fash_gl_new();
              if (fi->fash) _fash_gl_add(fi->fash, fg->index, (void *)(-1));
+             _glyph_cache_del(fg);
              free(fg);
              return EINA_FALSE;
           }
@@ -603,6 +651,7 @@ evas_common_font_int_cache_glyph_render(RGBA_Font_Glyph *fg)
         FTUNLOCK();
         if (!fi->fash) fi->fash = _fash_gl_new();
         if (fi->fash) _fash_gl_add(fi->fash, fg->index, (void *)(-1));
+        _glyph_cache_del(fg);
         free(fg);
         return EINA_FALSE;
      }
@@ -624,6 +673,10 @@ evas_common_font_int_cache_glyph_render(RGBA_Font_Glyph *fg)
     (fg->glyph_out->bitmap.width * fg->glyph_out->bitmap.rows / 2) + 100;
    fi->usage += size;
    if (fi->inuse) evas_common_font_int_use_increase(size);
+   fg->usage = size;
+   LKL(lock_glyph_cache);
+   glyph_cache_usage += size;
+   LKU(lock_glyph_cache);
 
    if (!FT_HAS_COLOR(fi->src->ft.face))
      {
@@ -648,6 +701,93 @@ evas_common_font_int_cache_glyph_render(RGBA_Font_Glyph *fg)
    return EINA_TRUE;
 }
 
+void
+evas_common_font_glyph_ref(RGBA_Font_Glyph *fg)
+{
+   LKL(lock_glyph_cache);
+   if (!fg->references++)
+     glyph_lru = eina_inlist_remove(glyph_lru, EINA_INLIST_GET(fg));
+   LKU(lock_glyph_cache);
+}
+
+void
+evas_common_font_glyph_unref(RGBA_Font_Glyph *fg)
+{
+   LKL(lock_glyph_cache);
+   if (!--fg->references)
+     glyph_lru = eina_inlist_append(glyph_lru, EINA_INLIST_GET(fg));
+   LKU(lock_glyph_cache);
+}
+
+/* Only the main loop frees glyphs, once a frame is rendered: render threads
+ * draw through glyph arrays, whose glyphs are referenced and so never in the
+ * LRU, and code looking glyphs up holds the lock of their font instance for
+ * as long as it uses them, so a glyph is only freed with that lock held. */
+EAPI void
+evas_common_font_glyph_cache_trim(void)
+{
+   RGBA_Font_Glyph *fg;
+   RGBA_Font_Int *fi;
+
+   if (!eina_main_loop_is()) return;
+   for (;;)
+     {
+        LKL(lock_glyph_cache);
+        if ((glyph_cache_usage <= glyph_cache_size) || (!glyph_lru))
+          {
+             LKU(lock_glyph_cache);
+             break;
+          }
+        fi = EINA_INLIST_CONTAINER_GET(glyph_lru, RGBA_Font_Glyph)->fi;
+        LKU(lock_glyph_cache);
+
+        LKL(fi->ft_mutex);
+        LKL(lock_glyph_cache);
+        fg = glyph_lru ? EINA_INLIST_CONTAINER_GET(glyph_lru, RGBA_Font_Glyph) : NULL;
+        /* The oldest glyph changed meanwhile, look again */
+        if ((!fg) || (fg->fi != fi))
+          {
+             LKU(lock_glyph_cache);
+             LKU(fi->ft_mutex);
+             continue;
+          }
+        glyph_cache_evicted++;
+        LKU(lock_glyph_cache);
+
+        if (fi->fash) _fash_gl_add(fi->fash, fg->index, NULL);
+        fi->usage -= fg->usage;
+        if (fi->inuse) evas_common_font_int_use_increase(-fg->usage);
+        _glyph_free(fg);
+        LKU(fi->ft_mutex);
+     }
+}
+
+EAPI int
+evas_common_font_glyph_cache_get(void)
+{
+   return glyph_cache_size;
+}
+
+EAPI void
+evas_common_font_glyph_cache_set(int size)
+{
+   glyph_cache_size = size;
+   evas_common_font_glyph_cache_trim();
+}
+
+EAPI void
+evas_common_font_glyph_cache_stats_get(Evas_Common_Glyph_Cache_Stats *st)
+{
+   if (!st) return;
+   LKL(lock_glyph_cache);
+   st->hits = glyph_cache_hits;
+   st->misses = glyph_cache_misses;
+   st->evicted = glyph_cache_evicted;
+   st->usage = glyph_cache_usage;
+   st->size = glyph_cache_size;
+   LKU(lock_glyph_cache);
+}
+
 typedef struct _Font_Char_Index Font_Char_Index;
 struct _Font_Char_Index
 {
@@ -712,14 +852,11 @@ evas_common_get_char_index(RGBA_Font_Int* fi, Eina_Unicode gl)
 //     }
 
    evas_common_font_int_reload(fi);
-   /*
-    * There is no point in locking FreeType at this point as all caller
-    * are running in the main loop at a time where there is zero chance
-    * that something else try to use it.
-    */
-   /* FTLOCK(); */
+   /* Text is also laid out off the main loop, see
+    * evas_common_font_int_size_activate() */
+   FTLOCK();
    result.index = FT_Get_Char_Index(fi->src->ft.face, gl);
-   /* FTUNLOCK(); */
+   FTUNLOCK();
    result.gl = gl;
 
 //   eina_hash_direct_add(fi->indexes, &result->gl, result);
@@ -775,8 +912,8 @@ evas_common_get_char_index(RGBA_Font_Int* fi, Eina_Unicode gl)
    return result.index;
 }
 
-EAPI int
-evas_common_font_glyph_search(RGBA_Font *fn, RGBA_Font_Int **fi_ret, Eina_Unicode gl)
+static int
+_evas_common_font_glyph_search(RGBA_Font *fn, RGBA_Font_Int **fi_ret, Eina_Unicode gl)
 {
    Eina_List *l;
 
@@ -847,3 +984,16 @@ evas_common_font_glyph_search(RGBA_Font *fn, RGBA_Font_Int **fi_ret, Eina_Unicod
    *fi_ret = NULL;
    return 0;
 }
+
+EAPI int
+evas_common_font_glyph_search(RGBA_Font *fn, RGBA_Font_Int **fi_ret, Eina_Unicode gl)
+{
+   int idx;
+
+   /* The char map of fn and the fallbacks it loads are also used by text
+    * laid out off the main loop */
+   LKL(fn->lock);
+   idx = _evas_common_font_glyph_search(fn, fi_ret, gl);
+   LKU(fn->lock);
+   return idx;
+}
@@ -175,7 +175,7 @@ evas_common_font_ot_cluster_size_get(const Evas_Text_Props *props, size_t char_i
    return (items > 0) ? items : 1;
 }
 
-/* Harfbuzz font functions */
+/* Harfbuzz font functions, called while shaping, so with fi->ft_mutex held */
 
 static hb_position_t
 _evas_common_font_ot_hb_get_glyph_advance(hb_font_t *font,
@@ -247,9 +247,13 @@ _evas_common_font_ot_shape(hb_buffer_t *buffer, RGBA_Font_Int *fi, Evas_Text_Pro
      {
         hb_font_t *hb_ft_font;
 
+        /* It's scaled by the size active in the face */
+        FTLOCK();
+        evas_common_font_int_size_activate(fi);
         hb_ft_font = hb_ft_font_create(fi->src->ft.face, NULL);
         fi->ft.hb_font = hb_font_create_sub_font(hb_ft_font);
         hb_font_destroy(hb_ft_font);
+        FTUNLOCK();
 
         hb_font_set_funcs(fi->ft.hb_font,
               _evas_common_font_ot_font_funcs_get(), fi, NULL);
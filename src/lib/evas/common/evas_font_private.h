@@ -23,6 +23,10 @@ void evas_common_font_int_use_increase(int size);
 void evas_common_font_int_use_trim(void);
 void evas_common_font_int_unload(RGBA_Font_Int *fi);
 void evas_common_font_int_reload(RGBA_Font_Int *fi);
+void evas_common_font_int_size_activate(RGBA_Font_Int *fi);
+
+void evas_common_font_glyph_ref(RGBA_Font_Glyph *fg);
+void evas_common_font_glyph_unref(RGBA_Font_Glyph *fg);
 
 /* 6th bit is on is the same as frac part >= 0.5 */
 # define EVAS_FONT_ROUND_26_6_TO_INT(x) \
@@ -167,6 +167,8 @@ evas_common_font_query_run_font_end_get(RGBA_Font *fn, RGBA_Font_Int **script_fi
  * @param right the right glyph index
  * @param[out] kerning the kerning calculated.
  * @return FALSE on error, TRUE on success.
+ *
+ * Called with fi->ft_mutex held, which guards the kerning cache of fi.
  */
 EAPI int
 evas_common_font_query_kerning(RGBA_Font_Int *fi, FT_UInt left, FT_UInt right,
@@ -195,6 +197,7 @@ evas_common_font_query_kerning(RGBA_Font_Int *fi, FT_UInt left, FT_UInt right,
     * matter */
    evas_common_font_int_reload(fi);
    FTLOCK();
+   evas_common_font_int_size_activate(fi);
    if (FT_Get_Kerning(fi->src->ft.face,
 		      left, right,
 		      FT_KERNING_DEFAULT, &delta) == 0)
@@ -36,6 +36,18 @@ EAPI RGBA_Image       *evas_common_load_image_from_file            (const char *
 EAPI RGBA_Image       *evas_common_load_image_from_mmap            (Eina_File *f, const char *key, Evas_Image_Load_Opts *lo, int *error);
 EAPI int               evas_common_save_image_to_file              (RGBA_Image *im, const char *file, const char *key, int quality, int compress, const char *encoding);
 
+typedef struct _Evas_Common_Scalecache_Stats Evas_Common_Scalecache_Stats;
+
+struct _Evas_Common_Scalecache_Stats
+{
+   unsigned long long hits;      /* draws served from a cached scaled copy */
+   unsigned long long misses;    /* scaled draws done from the original */
+   unsigned long long populated; /* copies made while drawing */
+   unsigned long long prescaled; /* copies made ahead of time by a thread */
+   unsigned long long evicted;   /* copies dropped to stay in budget */
+   unsigned int size, max_size;  /* bytes used and allowed */
+};
+
 EAPI void evas_common_rgba_image_scalecache_init(Image_Entry *ie);
 EAPI void evas_common_rgba_image_scalecache_shutdown(Image_Entry *ie);
 EAPI void evas_common_rgba_image_scalecache_size_set(unsigned int size);
@@ -43,6 +55,12 @@ EAPI unsigned int evas_common_rgba_image_scalecache_size_get(void);
 EAPI void evas_common_rgba_image_scalecache_flush(void);
 EAPI void evas_common_rgba_image_scalecache_dump(void);
 EAPI void evas_common_rgba_image_scalecache_prune(void);
+EAPI void evas_common_rgba_image_scalecache_stats_get(Evas_Common_Scalecache_Stats *st);
+EAPI Eina_Bool
+  evas_common_rgba_image_scalecache_prescale(Image_Entry *ie, int smooth,
+                                             int src_region_x, int src_region_y,
+                                             int src_region_w, int src_region_h,
+                                             int dst_region_w, int dst_region_h);
 EAPI void
   evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst,
                                             RGBA_Draw_Context *dc, int smooth,
@@ -481,3 +481,34 @@ evas_common_extension_can_load_get(const char *file)
 
    return EINA_FALSE;
 }
+
+EAPI void
+evas_loader_parallel_run(int count, int min_chunk,
+                         void (*cb) (void *data, int start, int end),
+                         void *data)
+{
+   evas_thread_parallel_run(count, min_chunk, cb, data);
+}
+
+EAPI Eina_Bool
+evas_loader_region_get(const Evas_Image_Load_Opts *opts, int w, int h,
+                       int *scale, Eina_Rectangle *region)
+{
+   *scale = 1;
+   if (opts->scale_down_by > 1)
+     {
+        *scale = opts->scale_down_by;
+        w /= *scale;
+        h /= *scale;
+     }
+   EINA_RECTANGLE_SET(region, 0, 0, w, h);
+   if ((opts->region.w > 0) && (opts->region.h > 0))
+     {
+        EINA_RECTANGLE_SET(region,
+                           opts->region.x, opts->region.y,
+                           opts->region.w, opts->region.h);
+        RECTS_CLIP_TO_RECT(region->x, region->y, region->w, region->h,
+                           0, 0, w, h);
+     }
+   return ((region->w > 0) && (region->h > 0));
+}
@@ -296,6 +296,8 @@ _evas_common_rgba_image_delete(Image_Entry *ie)
 {
    RGBA_Image *im = (RGBA_Image *)ie;
 
+   // first, as a prescale thread may still be reading the file
+   evas_common_rgba_image_scalecache_shutdown(&im->cache_entry);
 #ifdef BUILD_PIPE_RENDER
    evas_common_pipe_free(im);
 #endif
@@ -308,7 +310,6 @@ _evas_common_rgba_image_delete(Image_Entry *ie)
 	  evas_image_load_func->file_close(ie->loader_data);
 	ie->loader_data = NULL;
      }
-   evas_common_rgba_image_scalecache_shutdown(&im->cache_entry);
    if (ie->info.module) evas_module_unref((Evas_Module *)ie->info.module);
 #ifdef EVAS_CSERVE2
    if (ie->data1)
@@ -527,6 +528,8 @@ _evas_common_rgba_image_surface_delete(Image_Entry *ie)
 {
    RGBA_Image   *im = (RGBA_Image *) ie;
 
+   // before the pixels go, a prescale thread may still be reading them
+   evas_common_rgba_image_scalecache_dirty(&im->cache_entry);
 #ifdef HAVE_PIXMAN
 # ifdef PIXMAN_IMAGE
    if (im->pixman.im)
@@ -571,7 +574,6 @@ _evas_common_rgba_image_surface_delete(Image_Entry *ie)
    ie->allocated.h = 0;
    ie->flags.preload_done = 0;
    ie->flags.loaded = 0;
-   evas_common_rgba_image_scalecache_dirty(&im->cache_entry);
 #ifdef SURFDBG
    surf_debug();
 #endif
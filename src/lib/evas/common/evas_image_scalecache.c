@@ -29,6 +29,7 @@
 
 typedef struct _ScaleitemKey ScaleitemKey;
 typedef struct _Scaleitem Scaleitem;
+typedef struct _Scaleitem_Prescale Scaleitem_Prescale;
 
 struct _ScaleitemKey
 {
@@ -52,6 +53,16 @@ struct _Scaleitem
 
    Eina_Bool forced_unload : 1;
    Eina_Bool populate_me : 1;
+   Eina_Bool prescaling : 1; // a worker thread is scaling it
+   Eina_Bool orphaned : 1; // dropped while prescaling, freed when done
+};
+
+struct _Scaleitem_Prescale
+{
+   Scaleitem *sci;
+   RGBA_Image *im, *scaled;
+   Eina_Bool running : 1; // in the heavy callback, owns im
+   Eina_Bool detached : 1; // im is being freed, don't touch it anymore
 };
 
 #ifdef SCALECACHE
@@ -67,6 +78,13 @@ static unsigned int max_dimension = MAX_SCALECACHE_DIM;
 static unsigned int max_flop_count = MAX_FLOP_COUNT;
 static unsigned int max_scale_items = MAX_SCALEITEMS;
 static unsigned int min_scale_uses = MIN_SCALE_USES;
+
+static Evas_Common_Scalecache_Stats stats;
+static RGBA_Draw_Context *copy_ct = NULL;
+
+static LK(prescale_lock);
+static Eina_Condition prescale_cond;
+static Eina_List *prescale_jobs = NULL;
 #endif
 
 static int
@@ -121,7 +139,10 @@ evas_common_scalecache_init(void)
    init++;
    if (init > 1) return;
    use_counter = 0;
+   memset(&stats, 0, sizeof(stats));
    SLKI(cache_lock);
+   LKI(prescale_lock);
+   eina_condition_new(&prescale_cond, &prescale_lock);
    s = getenv("EVAS_SCALECACHE_SIZE");
    if (s) max_cache_size = atoi(s) * 1024;
    s = getenv("EVAS_SCALECACHE_MAX_DIMENSION");
@@ -141,7 +162,11 @@ evas_common_scalecache_shutdown(void)
 #ifdef SCALECACHE
    init--;
    if (init ==0)
-      SLKD(cache_lock);
+     {
+        eina_condition_free(&prescale_cond);
+        LKD(prescale_lock);
+        SLKD(cache_lock);
+     }
 #endif
 }
 
@@ -155,6 +180,26 @@ evas_common_rgba_image_scalecache_init(Image_Entry *ie)
 #endif
 }
 
+#ifdef SCALECACHE
+// wait for the threads still scaling im, and tell the others to leave it be
+static void
+_sci_prescale_detach(RGBA_Image *im)
+{
+   Scaleitem_Prescale *job;
+   Eina_List *l;
+
+   LKL(prescale_lock);
+   EINA_LIST_FOREACH(prescale_jobs, l, job)
+     {
+        if (job->im != im) continue;
+        job->detached = 1;
+        while (job->running)
+          eina_condition_wait(&prescale_cond);
+     }
+   LKU(prescale_lock);
+}
+#endif
+
 void
 evas_common_rgba_image_scalecache_shutdown(Image_Entry *ie)
 {
@@ -172,6 +217,7 @@ evas_common_rgba_image_scalecache_dirty(Image_Entry *ie)
 #ifdef SCALECACHE
    RGBA_Image *im = (RGBA_Image *)ie;
 
+   _sci_prescale_detach(im);
    SLKL(im->cache.lock);
    while (im->cache.list)
      {
@@ -194,7 +240,9 @@ evas_common_rgba_image_scalecache_dirty(Image_Entry *ie)
              SLKU(cache_lock);
           }
 
-        if (!sci->im)
+        if (sci->prescaling)
+          sci->orphaned = 1;
+        else if (!sci->im)
           free(sci);
      }
    eina_hash_free(im->cache.hash);
@@ -334,11 +382,17 @@ _sci_find(RGBA_Image *im,
             (sci->usage_count == im->cache.newest_usage_count))
           _sci_fix_newest(im);
 
+        if (sci->prescaling)
+          {
+             sci->orphaned = 1;
+             goto try_alloc;
+          }
         if (sci->im)
           {
              if (sci->im->cache_entry.references > 0) goto try_alloc;
 
              evas_common_rgba_image_free(&sci->im->cache_entry);
+             stats.evicted++;
              if (!sci->forced_unload)
                cache_size -= sci->key.dst_w * sci->key.dst_h * 4;
              else
@@ -361,6 +415,8 @@ try_alloc:
    sci->usage = 0;
    sci->usage_count = 0;
    sci->populate_me = 0;
+   sci->prescaling = 0;
+   sci->orphaned = 0;
    sci->key.smooth = smooth;
    sci->forced_unload = 0;
    sci->flop = 0;
@@ -383,6 +439,20 @@ try_alloc:
    return sci;
 }
 
+// call with cache_lock held
+static RGBA_Draw_Context *
+_sci_copy_context_get(void)
+{
+   if (!copy_ct)
+     {
+        // FIXME: static ct - never can free on shutdown? not a leak
+        // or real harm - just annoying valgrind bitch
+        copy_ct = evas_common_draw_context_new();
+        evas_common_draw_context_set_render_op(copy_ct, _EVAS_RENDER_COPY);
+     }
+   return copy_ct;
+}
+
 static void
 _cache_prune(Scaleitem *notsci, Eina_Bool copies_only)
 {
@@ -415,6 +485,7 @@ _cache_prune(Scaleitem *notsci, Eina_Bool copies_only)
         if ((!scie) || (scie->references > 0)) continue;
 
         evas_common_rgba_image_free(scie);
+        stats.evicted++;
         sci->im = NULL;
         sci->usage = 0;
         sci->usage_count = 0;
@@ -497,6 +568,201 @@ evas_common_rgba_image_scalecache_flush(void)
 #endif   
 }
 
+EAPI void
+evas_common_rgba_image_scalecache_stats_get(Evas_Common_Scalecache_Stats *st)
+{
+   if (!st) return;
+#ifdef SCALECACHE
+   SLKL(cache_lock);
+   *st = stats;
+   st->size = cache_size;
+   st->max_size = max_cache_size;
+   SLKU(cache_lock);
+#else
+   memset(st, 0, sizeof(*st));
+#endif
+}
+
+#ifdef SCALECACHE
+static void
+_sci_prescale_heavy(void *data)
+{
+   Scaleitem_Prescale *job = data;
+   Scaleitem *sci = job->sci;
+   RGBA_Image *im = job->im;
+   RGBA_Draw_Context *ct;
+
+   LKL(prescale_lock);
+   if (job->detached)
+     {
+        LKU(prescale_lock);
+        return;
+     }
+   job->running = 1;
+   LKU(prescale_lock);
+
+   // the key of a prescaling item never changes, and the pixels of im stay
+   // until the job is detached, which waits for us. so scale into our own
+   // image without the cache locks and only publish it from the main loop.
+   if (!im->image.data) goto end;
+   job->scaled = evas_common_image_new(sci->key.dst_w, sci->key.dst_h,
+                                       im->cache_entry.flags.alpha);
+   if (!job->scaled) goto end;
+   SLKL(cache_lock);
+   ct = _sci_copy_context_get();
+   SLKU(cache_lock);
+   if (sci->key.smooth)
+     evas_common_scale_rgba_in_to_out_clip_smooth
+       (im, job->scaled, ct,
+        sci->key.src_x, sci->key.src_y, sci->key.src_w, sci->key.src_h,
+        0, 0, sci->key.dst_w, sci->key.dst_h);
+   else
+     evas_common_scale_rgba_in_to_out_clip_sample
+       (im, job->scaled, ct,
+        sci->key.src_x, sci->key.src_y, sci->key.src_w, sci->key.src_h,
+        0, 0, sci->key.dst_w, sci->key.dst_h);
+   evas_common_cpu_end_opt();
+end:
+   LKL(prescale_lock);
+   job->running = 0;
+   eina_condition_broadcast(&prescale_cond);
+   LKU(prescale_lock);
+}
+
+static void
+_sci_prescale_finish(Scaleitem_Prescale *job, Eina_Bool keep)
+{
+   Scaleitem *sci = job->sci;
+   RGBA_Image *im = job->im;
+   Eina_Bool detached;
+
+   LKL(prescale_lock);
+   prescale_jobs = eina_list_remove(prescale_jobs, job);
+   detached = job->detached;
+   LKU(prescale_lock);
+   if (detached)
+     {
+        // im is gone, and sci was orphaned when it was cleared
+        if (job->scaled)
+          evas_common_rgba_image_free(&job->scaled->cache_entry);
+        free(sci);
+        free(job);
+        return;
+     }
+
+   SLKL(im->cache.lock);
+   SLKL(cache_lock);
+   sci->prescaling = 0;
+   if ((keep) && (job->scaled) && (!sci->orphaned) && (!sci->im))
+     {
+        sci->im = job->scaled;
+        job->scaled = NULL;
+        cache_size += sci->key.dst_w * sci->key.dst_h * 4;
+        cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
+        stats.prescaled++;
+        _cache_prune(sci, 0);
+     }
+   if (job->scaled)
+     evas_common_rgba_image_free(&job->scaled->cache_entry);
+   if (sci->orphaned) free(sci);
+   SLKU(cache_lock);
+   SLKU(im->cache.lock);
+
+   evas_cache_image_drop(&im->cache_entry);
+   free(job);
+}
+
+static void
+_sci_prescale_end(void *data)
+{
+   _sci_prescale_finish(data, EINA_TRUE);
+}
+
+static void
+_sci_prescale_cancel(void *data)
+{
+   _sci_prescale_finish(data, EINA_FALSE);
+}
+#endif
+
+/* Scales a region of ie ahead of time on a preload thread, so the first draws
+ * of that region at dst_w x dst_h already hit the cache. Returns EINA_FALSE if
+ * this scale can't be cached, or if ie's data isn't loaded yet. */
+EAPI Eina_Bool
+evas_common_rgba_image_scalecache_prescale(Image_Entry *ie, int smooth,
+                                           int src_region_x, int src_region_y,
+                                           int src_region_w, int src_region_h,
+                                           int dst_region_w, int dst_region_h)
+{
+#ifdef SCALECACHE
+   RGBA_Image *im = (RGBA_Image *)ie;
+   Scaleitem_Prescale *job;
+   Scaleitem *sci;
+
+   if ((dst_region_w <= 0) || (dst_region_h <= 0) ||
+       (src_region_w <= 0) || (src_region_h <= 0)) return EINA_FALSE;
+   if ((src_region_w == dst_region_w) && (src_region_h == dst_region_h))
+     return EINA_FALSE;
+   if ((ie->scale_hint == EVAS_IMAGE_SCALE_HINT_DYNAMIC) ||
+       (ie->animated.animated) || (ie->preload) ||
+       (ie->space != EVAS_COLORSPACE_ARGB8888))
+     return EINA_FALSE;
+#ifdef EVAS_CSERVE2
+   // the server does its own scaling
+   if (evas_cserve2_use_get()) return EINA_FALSE;
+#endif
+   if (((unsigned int)dst_region_w >= max_dimension) ||
+       ((unsigned int)dst_region_h >= max_dimension))
+     return EINA_FALSE;
+   // decoding the original here would block the main loop, and a thread
+   // can't race its first draw for it: only scale what is loaded already
+   if ((!ie->flags.loaded) || (!im->image.data)) return EINA_FALSE;
+
+   SLKL(im->cache.lock);
+   SLKL(cache_lock);
+   if (((unsigned long long)dst_region_w * dst_region_h * 4) > max_cache_size)
+     sci = NULL;
+   else
+     sci = _sci_find(im, NULL, smooth,
+                     src_region_x, src_region_y, src_region_w, src_region_h,
+                     dst_region_w, dst_region_h);
+   if ((!sci) || (sci->im) || (sci->prescaling))
+     {
+        SLKU(cache_lock);
+        SLKU(im->cache.lock);
+        return !!sci;
+     }
+   job = calloc(1, sizeof(Scaleitem_Prescale));
+   if (!job)
+     {
+        SLKU(cache_lock);
+        SLKU(im->cache.lock);
+        return EINA_FALSE;
+     }
+   if (sci->populate_me)
+     {
+        sci->populate_me = 0;
+        im->cache.populate_count--;
+     }
+   sci->prescaling = 1;
+   job->sci = sci;
+   job->im = im;
+   SLKU(cache_lock);
+   SLKU(im->cache.lock);
+
+   LKL(prescale_lock);
+   prescale_jobs = eina_list_append(prescale_jobs, job);
+   LKU(prescale_lock);
+   evas_cache_image_ref(ie);
+   // on failure, the cancel callback has already released the job
+   evas_preload_thread_run(_sci_prescale_heavy, _sci_prescale_end,
+                           _sci_prescale_cancel, job);
+   return EINA_TRUE;
+#else
+   return EINA_FALSE;
+#endif
+}
+
 EAPI void
 evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst EINA_UNUSED,
                                           RGBA_Draw_Context *dc, int smooth,
@@ -594,7 +860,7 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst EINA_
 //       && (sci->usage_count > (use_counter - MIN_SCALE_AGE_GAP))
        )
      {
-        if (!sci->im)
+        if ((!sci->im) && (!sci->prescaling))
           {
              if ((sci->key.dst_w < max_dimension) && 
                  (sci->key.dst_h < max_dimension))
@@ -686,6 +952,7 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
    sci = _sci_find(im, dc, smooth,
                    src_region_x, src_region_y, src_region_w, src_region_h,
                    dst_region_w, dst_region_h);
+   if (!sci) stats.misses++;
    SLKU(cache_lock);
    if (!sci)
      {
@@ -786,20 +1053,14 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
           (dst_region_w, dst_region_h, im->cache_entry.flags.alpha);
         if (sci->im)
           {
-             static RGBA_Draw_Context *ct = NULL;
+             RGBA_Draw_Context *ct;
 
              SLKL(cache_lock);
              im->cache.orig_usage++;
              im->cache.usage_count = use_counter;
              im->cache.populate_count--;
-//             pops++;
-             if (!ct)
-               {
-                  // FIXME: static ct - never can free on shutdown? not a leak
-                  // or real harm - just annoying valgrind bitch
-                  ct = evas_common_draw_context_new();
-                  evas_common_draw_context_set_render_op(ct, _EVAS_RENDER_COPY);
-               }
+             stats.populated++;
+             ct = _sci_copy_context_get();
              SLKU(im->cache.lock);
              if (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888)
                {
@@ -876,6 +1137,7 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
 	     SLKL(cache_lock);
              cache_list = eina_inlist_remove(cache_list, (Eina_Inlist *)sci);
              cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
+             stats.hits++;
 	     SLKU(cache_lock);
           }
         else
@@ -930,6 +1192,9 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
    else
      {
         SLKU(im->cache.lock);
+        SLKL(cache_lock);
+        stats.misses++;
+        SLKU(cache_lock);
         if (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888)
           {
 #ifdef EVAS_CSERVE2
@@ -13,6 +13,10 @@
 # define SCALE_USING_MMX
 #endif
 
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+# define EVAS_MAP_SSE3 1
+#endif
+
 #define FPI 8
 #define FPI1 (1 << (FPI))
 #define FPIH (1 << (FPI - 1))
@@ -88,6 +92,9 @@ _interpolated_clip_span(Span *s, int c1, int c2, Eina_Bool interp_col)
 }
 
 #include "evas_map_image_aa.c"
+#ifdef EVAS_MAP_SSE3
+#include "evas_map_image_sse3.c"
+#endif
 
 // 12.63 % of time - this can improve
 static void
@@ -630,6 +637,17 @@ evas_common_map_rgba_prepare(RGBA_Image *src, RGBA_Image *dst,
 # include "evas_map_image_internal.c"
 #endif
 
+#ifdef EVAS_MAP_SSE3
+# undef FUNC_NAME
+# undef FUNC_NAME_DO
+# define FUNC_NAME _evas_common_map_rgba_internal_sse3
+# define FUNC_NAME_DO evas_common_map_rgba_internal_sse3_do
+# undef SCALE_USING_MMX
+# define SCALE_USING_SSE3
+# include "evas_map_image_internal.c"
+# undef SCALE_USING_SSE3
+#endif
+
 #undef FUNC_NAME
 #undef FUNC_NAME_DO
 #define FUNC_NAME _evas_common_map_rgba_internal
@@ -649,6 +667,135 @@ evas_common_map_rgba_prepare(RGBA_Image *src, RGBA_Image *dst,
 #  undef SCALE_USING_NEON
 #endif
 
+typedef void (*Evas_Common_Map_RGBA_Internal_Func)(RGBA_Image *src, RGBA_Image *dst,
+                                                   int clip_x, int clip_y, int clip_w, int clip_h,
+                                                   DATA32 mul_col, int render_op,
+                                                   RGBA_Map_Point *p,
+                                                   int smooth, int anti_alias, int level,
+                                                   RGBA_Image *mask_ie, int mask_x, int mask_y);
+
+// Minimum number of destination pixels in a band of rows given to a thread
+#define MAP_BAND_PIXELS (1 << 14)
+
+typedef struct _Map_Band Map_Band;
+
+struct _Map_Band
+{
+   Evas_Common_Map_RGBA_Internal_Func func;
+   RGBA_Image *src, *dst;
+   int clip_x, clip_y, clip_w;
+   DATA32 mul_col;
+   int render_op;
+   RGBA_Map_Point *p;
+   int smooth, level;
+   RGBA_Image *mask_ie;
+   int mask_x, mask_y;
+};
+
+static void
+_map_band_draw(void *data, int start, int end)
+{
+   Map_Band *b = data;
+   RGBA_Map_Point p[4];
+
+   // the points get clamped to the source size, don't share them
+   memcpy(p, b->p, sizeof(p));
+   b->func(b->src, b->dst,
+           b->clip_x, b->clip_y + start, b->clip_w, end - start,
+           b->mul_col, b->render_op,
+           p, b->smooth, EINA_FALSE, b->level,
+           b->mask_ie, b->mask_x, b->mask_y);
+}
+
+/* Large maps are cut in bands of rows that are drawn in parallel. The spans
+ * of a row don't depend on the other rows, except for the anti-aliased
+ * edges, so anti-aliased maps are always drawn in one go. */
+static void
+_evas_common_map_rgba_bands(Evas_Common_Map_RGBA_Internal_Func func,
+                            RGBA_Image *src, RGBA_Image *dst,
+                            int clip_x, int clip_y, int clip_w, int clip_h,
+                            DATA32 mul_col, int render_op,
+                            RGBA_Map_Point *p,
+                            int smooth, int anti_alias, int level,
+                            RGBA_Image *mask_ie, int mask_x, int mask_y)
+{
+   int xleft, xright, ytop, ybottom, i;
+   Map_Band b;
+
+   if (anti_alias) goto one_go;
+
+   xleft = xright = p[0].x;
+   ytop = ybottom = p[0].y;
+   for (i = 1; i < 4; i++)
+     {
+        if (p[i].x < xleft) xleft = p[i].x;
+        if (p[i].x > xright) xright = p[i].x;
+        if (p[i].y < ytop) ytop = p[i].y;
+        if (p[i].y > ybottom) ybottom = p[i].y;
+     }
+   xleft = MAX(xleft >> FP, clip_x);
+   xright = MIN(xright >> FP, clip_x + clip_w);
+   ytop = MAX(ytop >> FP, clip_y);
+   ybottom = MIN(ybottom >> FP, clip_y + clip_h - 1);
+   if ((xright <= xleft) || (ybottom < ytop) ||
+       ((xright - xleft) * (ybottom - ytop + 1) < 2 * MAP_BAND_PIXELS))
+     goto one_go;
+
+   b.func = func;
+   b.src = src;
+   b.dst = dst;
+   b.clip_x = clip_x;
+   b.clip_y = ytop;
+   b.clip_w = clip_w;
+   b.mul_col = mul_col;
+   b.render_op = render_op;
+   b.p = p;
+   b.smooth = smooth;
+   b.level = level;
+   b.mask_ie = mask_ie;
+   b.mask_x = mask_x;
+   b.mask_y = mask_y;
+   evas_thread_parallel_run(ybottom - ytop + 1,
+                            1 + MAP_BAND_PIXELS / (xright - xleft),
+                            _map_band_draw, &b);
+   return;
+
+one_go:
+   func(src, dst, clip_x, clip_y, clip_w, clip_h, mul_col, render_op,
+        p, smooth, anti_alias, level, mask_ie, mask_x, mask_y);
+}
+
+
+#ifdef EVAS_MAP_SSE3
+void evas_common_map_rgba_internal_sse3(RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Map_Point *p, int smooth, int level)
+{
+   int clip_x, clip_y, clip_w, clip_h;
+   DATA32 mul_col;
+
+   if (dc->clip.use)
+     {
+	clip_x = dc->clip.x;
+	clip_y = dc->clip.y;
+	clip_w = dc->clip.w;
+	clip_h = dc->clip.h;
+     }
+   else
+     {
+	clip_x = clip_y = 0;
+	clip_w = dst->cache_entry.w;
+	clip_h = dst->cache_entry.h;
+     }
+
+   mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
+
+   _evas_common_map_rgba_bands(_evas_common_map_rgba_internal_sse3,
+                               src, dst,
+                               clip_x, clip_y, clip_w, clip_h,
+                               mul_col, dc->render_op,
+                               p, smooth, dc->anti_alias, level,
+                               dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
+}
+#endif
 
 #ifdef BUILD_MMX
 void evas_common_map_rgba_internal_mmx(RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Map_Point *p, int smooth, int level)
@@ -672,11 +819,12 @@ void evas_common_map_rgba_internal_mmx(RGBA_Image *src, RGBA_Image *dst, RGBA_Dr
 
    mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
 
-   _evas_common_map_rgba_internal_mmx(src, dst,
-                                      clip_x, clip_y, clip_w, clip_h,
-                                      mul_col, dc->render_op,
-                                      p, smooth, dc->anti_alias, level,
-                                      dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
+   _evas_common_map_rgba_bands(_evas_common_map_rgba_internal_mmx,
+                               src, dst,
+                               clip_x, clip_y, clip_w, clip_h,
+                               mul_col, dc->render_op,
+                               p, smooth, dc->anti_alias, level,
+                               dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
 }
 #endif
 
@@ -701,11 +849,12 @@ void evas_common_map_rgba_internal(RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_C
 
    mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
 
-   _evas_common_map_rgba_internal(src, dst,
-                                  clip_x, clip_y, clip_w, clip_h,
-                                  mul_col, dc->render_op,
-                                  p, smooth, dc->anti_alias, level,
-                                  dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
+   _evas_common_map_rgba_bands(_evas_common_map_rgba_internal,
+                               src, dst,
+                               clip_x, clip_y, clip_w, clip_h,
+                               mul_col, dc->render_op,
+                               p, smooth, dc->anti_alias, level,
+                               dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
 }
 
 #ifdef BUILD_NEON
@@ -730,11 +879,12 @@ void evas_common_map_rgba_internal_neon(RGBA_Image *src, RGBA_Image *dst, RGBA_D
 
    mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
 
-   _evas_common_map_rgba_internal_neon(src, dst,
-                                  clip_x, clip_y, clip_w, clip_h,
-                                  mul_col, dc->render_op,
-                                  p, smooth, dc->anti_alias, level,
-                                  dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
+   _evas_common_map_rgba_bands(_evas_common_map_rgba_internal_neon,
+                               src, dst,
+                               clip_x, clip_y, clip_w, clip_h,
+                               mul_col, dc->render_op,
+                               p, smooth, dc->anti_alias, level,
+                               dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
 }
 #endif
 
@@ -851,6 +1001,13 @@ evas_common_map_rgba(RGBA_Image *src, RGBA_Image *dst,
    int mmx, sse, sse2;
 
    evas_common_cpu_can_do(&mmx, &sse, &sse2);
+#endif
+#ifdef EVAS_MAP_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     cb = evas_common_map_rgba_internal_sse3;
+   else
+#endif
+#ifdef BUILD_MMX
    if (mmx)
      cb = evas_common_map_rgba_internal_mmx;
    else
@@ -868,32 +1025,34 @@ evas_common_map_rgba(RGBA_Image *src, RGBA_Image *dst,
 EAPI void
 evas_common_map_rgba_draw(RGBA_Image *src, RGBA_Image *dst, int clip_x, int clip_y, int clip_w, int clip_h, DATA32 mul_col, int render_op, int npoints EINA_UNUSED, RGBA_Map_Point *p, int smooth, Eina_Bool anti_alias, int level, RGBA_Image *mask_ie, int mask_x, int mask_y)
 {
+   Evas_Common_Map_RGBA_Internal_Func func;
 #ifdef BUILD_MMX
    int mmx, sse, sse2;
 
    evas_common_cpu_can_do(&mmx, &sse, &sse2);
+#endif
+#ifdef EVAS_MAP_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     func = _evas_common_map_rgba_internal_sse3;
+   else
+#endif
+#ifdef BUILD_MMX
    if (mmx)
-     _evas_common_map_rgba_internal_mmx(src, dst,
-                                        clip_x, clip_y, clip_w, clip_h,
-                                        mul_col, render_op,
-                                        p, smooth, anti_alias, level,
-                                        mask_ie, mask_x, mask_y);
+     func = _evas_common_map_rgba_internal_mmx;
    else
 #endif
 #ifdef BUILD_NEON
    if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
-     _evas_common_map_rgba_internal_neon(src, dst,
-                                    clip_x, clip_y, clip_w, clip_h,
-                                    mul_col, render_op,
-                                    p, smooth, anti_alias, level,
-                                    mask_ie, mask_x, mask_y);
+     func = _evas_common_map_rgba_internal_neon;
    else
 #endif
-     _evas_common_map_rgba_internal(src, dst,
-                                    clip_x, clip_y, clip_w, clip_h,
-                                    mul_col, render_op,
-                                    p, smooth, anti_alias, level,
-                                    mask_ie, mask_x, mask_y);
+     func = _evas_common_map_rgba_internal;
+
+   _evas_common_map_rgba_bands(func, src, dst,
+                               clip_x, clip_y, clip_w, clip_h,
+                               mul_col, render_op,
+                               p, smooth, anti_alias, level,
+                               mask_ie, mask_x, mask_y);
 }
 
 EAPI void
@@ -905,6 +1064,9 @@ evas_common_map_rgba_do(const Eina_Rectangle *clip,
 {
 #ifdef BUILD_MMX
    int mmx, sse, sse2;
+#endif
+#ifdef EVAS_MAP_SSE3
+   Eina_Bool sse3 = evas_common_cpu_has_feature(CPU_FEATURE_SSE3);
 #endif
    const Cutout_Rects *rects;
    const RGBA_Map_Cutout *spans;
@@ -922,6 +1084,13 @@ evas_common_map_rgba_do(const Eina_Rectangle *clip,
        spans->count == 1)
      {
         evas_common_draw_context_set_clip(dc, clip->x, clip->y, clip->w, clip->h);
+#ifdef EVAS_MAP_SSE3
+        if (sse3)
+          evas_common_map_rgba_internal_sse3_do(src, dst, dc,
+                                                &spans->spans[0], smooth,
+                                                dc->anti_alias, level);
+        else
+#endif
 #ifdef BUILD_MMX
         if (mmx)
           evas_common_map_rgba_internal_mmx_do(src, dst, dc,
@@ -949,6 +1118,13 @@ evas_common_map_rgba_do(const Eina_Rectangle *clip,
         EINA_RECTANGLE_SET(&area, r->x, r->y, r->w, r->h);
         if (!eina_rectangle_intersection(&area, clip)) continue ;
         evas_common_draw_context_set_clip(dc, area.x, area.y, area.w, area.h);
+#ifdef EVAS_MAP_SSE3
+        if (sse3)
+          evas_common_map_rgba_internal_sse3_do(src, dst, dc,
+                                                &spans->spans[i], smooth,
+                                                dc->anti_alias, level);
+        else
+#endif
 #ifdef BUILD_MMX
         if (mmx)
           {
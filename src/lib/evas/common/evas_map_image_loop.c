@@ -68,6 +68,27 @@
 #  endif //COLBLACK
 # endif //SCALE_USING_NEON
 
+# ifdef SCALE_USING_SSE3
+#  ifndef COLBLACK
+#   ifdef COLMUL
+#    ifdef COLSAME
+   _map_span_smooth_sse3(d, ww, sp, sw, swp, shp, u, v, ud, vd, c1, c1, 0, 0);
+#    else //COLSAME
+   _map_span_smooth_sse3(d, ww, sp, sw, swp, shp, u, v, ud, vd, c1, c2, cv, cd);
+#    endif //COLSAME
+#   else //COLMUL
+   _map_span_smooth_sse3(d, ww, sp, sw, swp, shp, u, v, ud, vd,
+                         0xffffffff, 0xffffffff, 0, 0);
+#   endif //COLMUL
+   if (anti_alias)
+     {
+        for (; ww > 0; ww--, d++)
+          *d = _aa_coverage_apply(line, ww, w, *d);
+     }
+   ww = 0;
+#  endif //COLBLACK
+# endif //SCALE_USING_SSE3
+
    while (ww > 0)
      {
 # ifdef COLBLACK
@@ -296,6 +317,18 @@
 #  endif //COLBLACK
 # endif //SCALE_USING_NEON
 
+# ifdef SCALE_USING_SSE3
+#  if defined(COLMUL) && defined(COLSAME) && !defined(COLBLACK)
+   _map_span_nearest_sse3(d, ww, sp, sw, u, v, ud, vd, c1);
+   if (anti_alias)
+     {
+        for (; ww > 0; ww--, d++)
+          *d = _aa_coverage_apply(line, ww, w, *d);
+     }
+   ww = 0;
+#  endif
+# endif //SCALE_USING_SSE3
+
    while (ww > 0)
      {
 # ifndef SCALE_USING_NEON
@@ -0,0 +1,169 @@
+/* @file evas_map_image_sse3.c
+ * Should define the functions:
+ * - _map_span_smooth_sse3
+ * - _map_span_nearest_sse3
+ *
+ * Span loops of the map renderer, two pixels at a time. They give the same
+ * results as the MMX loops. Only SSE2 instructions are used, as this file is
+ * not built with -msse3.
+ */
+
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+
+#include <emmintrin.h>
+
+/* INTERP_256_R2R on 16 bit channels: y + (((x - y) * a) >> 8), low byte */
+static inline __m128i
+_map_interp_256_sse3(__m128i a, __m128i x, __m128i y, __m128i x255)
+{
+   x = _mm_sub_epi16(x, y);
+   x = _mm_mullo_epi16(x, a);
+   x = _mm_srli_epi16(x, 8);
+   return _mm_and_si128(_mm_add_epi16(x, y), x255);
+}
+
+/* MUL4_SYM_R2R on 16 bit channels: ((x * c) + 255) >> 8 */
+static inline __m128i
+_map_mul4_sym_sse3(__m128i c, __m128i x, __m128i x255)
+{
+   x = _mm_mullo_epi16(x, c);
+   return _mm_srli_epi16(_mm_add_epi16(x, x255), 8);
+}
+
+/* Two pixels, unpacked to 16 bit channels */
+static inline __m128i
+_map_pair_sse3(DATA32 p0, DATA32 p1)
+{
+   return _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(p0),
+                                               _mm_cvtsi32_si128(p1)),
+                            _mm_setzero_si128());
+}
+
+/* Two 8 bit factors, each one repeated over the four channels of a pixel */
+static inline __m128i
+_map_factor_pair_sse3(int a0, int a1)
+{
+   return _mm_unpacklo_epi64(_mm_set1_epi16(a0), _mm_set1_epi16(a1));
+}
+
+/* Bilinear sampling of one pixel, as done by the smooth loop */
+#define MAP_SMOOTH_FETCH(u, v, ru, val1, val2, val3, val4) \
+   do { \
+        FPc uu1, vv1, uu2, vv2; \
+        const DATA32 *row1, *row2; \
+        uu1 = u; \
+        if (uu1 < 0) uu1 = 0; \
+        else if (uu1 >= swp) uu1 = swp - 1; \
+        vv1 = v; \
+        if (vv1 < 0) vv1 = 0; \
+        else if (vv1 >= shp) vv1 = shp - 1; \
+        uu2 = uu1 + FPFPI1; \
+        if (uu2 >= swp) uu2 = swp - 1; \
+        vv2 = vv1 + FPFPI1; \
+        if (vv2 >= shp) vv2 = shp - 1; \
+        ru = (u >> (FP + FPI - 8)) & 0xff; \
+        row1 = sp + ((vv1 >> (FP + FPI)) * sw); \
+        row2 = sp + ((vv2 >> (FP + FPI)) * sw); \
+        val1 = row1[uu1 >> (FP + FPI)]; \
+        val2 = row1[uu2 >> (FP + FPI)]; \
+        val3 = row2[uu1 >> (FP + FPI)]; \
+        val4 = row2[uu2 >> (FP + FPI)]; \
+   } while (0)
+
+/* Smooth span: bilinear sampling, then multiplied by c1 if c1 == c2, or by
+ * the gradient from c1 to c2 otherwise. White is not multiplied at all. */
+static void
+_map_span_smooth_sse3(DATA32 *d, int ww, const DATA32 *sp, int sw,
+                      FPc swp, FPc shp, FPc u, FPc v, FPc ud, FPc vd,
+                      DATA32 c1, DATA32 c2, FPc cv, FPc cd)
+{
+   const __m128i x255 = _mm_set1_epi16(0xff);
+   const Eina_Bool colsame = (c1 == c2);
+   const Eina_Bool colmul = !colsame || (c1 != 0xffffffff);
+   const __m128i c1v = _map_pair_sse3(c1, c1);
+   const __m128i c2v = _map_pair_sse3(c2, c2);
+
+   for (; ww > 0; ww -= 2, d += 2)
+     {
+        DATA32 a1, a2, a3, a4, b1, b2, b3, b4;
+        FPc rua, rva, rub = 0, rvb = 0;
+        __m128i top, bottom, r;
+
+        MAP_SMOOTH_FETCH(u, v, rua, a1, a2, a3, a4);
+        rva = (v >> (FP + FPI - 8)) & 0xff;
+        u += ud;
+        v += vd;
+        if (ww > 1)
+          {
+             MAP_SMOOTH_FETCH(u, v, rub, b1, b2, b3, b4);
+             rvb = (v >> (FP + FPI - 8)) & 0xff;
+             u += ud;
+             v += vd;
+          }
+        else
+          b1 = b2 = b3 = b4 = 0;
+
+        r = _map_factor_pair_sse3(rua, rub);
+        top = _map_interp_256_sse3(r, _map_pair_sse3(a2, b2),
+                                   _map_pair_sse3(a1, b1), x255);
+        bottom = _map_interp_256_sse3(r, _map_pair_sse3(a4, b4),
+                                      _map_pair_sse3(a3, b3), x255);
+        r = _map_factor_pair_sse3(rva, rvb);
+        r = _map_interp_256_sse3(r, bottom, top, x255);
+
+        if (colmul)
+          {
+             __m128i c = c1v;
+
+             if (!colsame)
+               {
+                  __m128i cc = _map_factor_pair_sse3(cv >> 16, (cv + cd) >> 16);
+
+                  c = _map_interp_256_sse3(cc, c2v, c1v, x255);
+                  cv += 2 * cd;
+               }
+             r = _map_mul4_sym_sse3(c, r, x255);
+          }
+
+        r = _mm_packus_epi16(r, r);
+        if (ww > 1)
+          _mm_storel_epi64((__m128i *)d, r);
+        else
+          *d = _mm_cvtsi128_si32(r);
+     }
+}
+
+#undef MAP_SMOOTH_FETCH
+
+/* Nearest span multiplied by a single color (the MUL4_SYM case) */
+static void
+_map_span_nearest_sse3(DATA32 *d, int ww, const DATA32 *sp, int sw,
+                       FPc u, FPc v, FPc ud, FPc vd, DATA32 c1)
+{
+   const __m128i x255 = _mm_set1_epi16(0xff);
+   const __m128i c1v = _map_pair_sse3(c1, c1);
+
+   for (; ww > 1; ww -= 2, d += 2)
+     {
+        DATA32 a, b;
+        __m128i r;
+
+        a = sp[((v >> (FP + FPI)) * sw) + (u >> (FP + FPI))];
+        u += ud;
+        v += vd;
+        b = sp[((v >> (FP + FPI)) * sw) + (u >> (FP + FPI))];
+        u += ud;
+        v += vd;
+
+        r = _map_mul4_sym_sse3(c1v, _map_pair_sse3(a, b), x255);
+        _mm_storel_epi64((__m128i *)d, _mm_packus_epi16(r, r));
+     }
+   if (ww > 0)
+     {
+        DATA32 a = sp[((v >> (FP + FPI)) * sw) + (u >> (FP + FPI))];
+
+        *d = MUL4_SYM(c1, a);
+     }
+}
+
+#endif
@@ -723,6 +723,7 @@ evas_common_pipe_load(void *data, Eina_Thread t EINA_UNUSED)
 	{
            Evas_Text_Props *text_props;
            RGBA_Font_Int *fi;
+           Eina_List *task;
 
            LKL(text_task_mutex);
            fi = eina_list_data_get(text_task);
@@ -731,14 +732,17 @@ evas_common_pipe_load(void *data, Eina_Thread t EINA_UNUSED)
 
            if (fi)
              {
+                /* draw_prepare() takes the lock of fi itself */
                 LKL(fi->ft_mutex);
-                EINA_LIST_FREE(fi->task, text_props)
+                task = fi->task;
+                fi->task = NULL;
+                LKU(fi->ft_mutex);
+                EINA_LIST_FREE(task, text_props)
 		  {
                      evas_common_font_draw_prepare(text_props);
                      text_props->changed = EINA_FALSE;
 		     text_props->prepare = EINA_FALSE;
 		  }
-                LKU(fi->ft_mutex);
              }
 	}
 
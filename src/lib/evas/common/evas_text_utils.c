@@ -6,6 +6,318 @@
 
 #define PROPS_CHANGE(Props) Props->changed = EINA_TRUE;
 
+/* Runs longer than this are not worth keeping around */
+#define TEXT_PROPS_CACHE_RUN_MAX 256
+
+typedef struct _Text_Props_Cache_Key Text_Props_Cache_Key;
+typedef struct _Text_Props_Cache_Item Text_Props_Cache_Item;
+
+struct _Text_Props_Cache_Key
+{
+   const RGBA_Font_Int *fi;
+   const Eina_Unicode *text;
+   int len;
+   Evas_Script_Type script;
+   Evas_BiDi_Direction bidi_dir;
+   Evas_Text_Props_Mode mode;
+};
+
+struct _Text_Props_Cache_Item
+{
+   EINA_INLIST;
+   Text_Props_Cache_Key key; /* key.text points right after the item */
+   Evas_Text_Props_Info *info;
+   size_t glyphs_len;
+};
+
+/* Shaped runs, keyed by font instance, text and the props shaping depends
+ * on. Their infos are shared by every text props made from the same run,
+ * possibly in different threads, so the refcount of a cached info is only
+ * changed with the lock held. The most recently used run is first.
+ * The cache holds no reference, neither to the infos nor to their font
+ * instances: runs of an instance that is freed are dropped with it, and
+ * an info nobody uses waits in the cache until a hit or its eviction. */
+static LK(lock_text_props_cache);
+static Eina_Hash   *text_props_cache = NULL;
+static Eina_Inlist *text_props_cache_lru = NULL;
+static Evas_Common_Text_Props_Cache_Stats text_props_cache_stats;
+
+static unsigned int
+_text_props_cache_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof(Text_Props_Cache_Key);
+}
+
+static int
+_text_props_cache_key_cmp(const Text_Props_Cache_Key *k1,
+      int k1_length EINA_UNUSED, const Text_Props_Cache_Key *k2,
+      int k2_length EINA_UNUSED)
+{
+   if (k1->fi != k2->fi)
+     return (k1->fi < k2->fi) ? -1 : 1;
+   if (k1->len != k2->len) return k1->len - k2->len;
+   if (k1->script != k2->script) return k1->script - k2->script;
+   if (k1->bidi_dir != k2->bidi_dir) return k1->bidi_dir - k2->bidi_dir;
+   if (k1->mode != k2->mode) return k1->mode - k2->mode;
+   return memcmp(k1->text, k2->text, k1->len * sizeof(Eina_Unicode));
+}
+
+static int
+_text_props_cache_key_hash(const Text_Props_Cache_Key *key,
+      int key_length EINA_UNUSED)
+{
+   unsigned long long fi = (uintptr_t)key->fi;
+   int hash;
+
+   hash = eina_hash_superfast((const char *)key->text,
+                              key->len * sizeof(Eina_Unicode));
+   hash ^= eina_hash_int64(&fi, sizeof(fi));
+   hash ^= (key->script << 2) | (key->bidi_dir << 1) | key->mode;
+   return hash;
+}
+
+static inline void
+_text_props_info_ref(Evas_Text_Props_Info *info)
+{
+   if (info->cached)
+     {
+        LKL(lock_text_props_cache);
+        info->refcount++;
+        LKU(lock_text_props_cache);
+     }
+   else
+     info->refcount++;
+}
+
+/* Returns EINA_TRUE if that was the last reference held by props, the
+ * reference to the font instance of the info goes with it. The info itself
+ * is only to be freed, as told by free_info, if the cache doesn't keep it. */
+static inline Eina_Bool
+_text_props_info_unref(Evas_Text_Props_Info *info, Eina_Bool *free_info)
+{
+   Eina_Bool last;
+
+   if (info->cached)
+     {
+        LKL(lock_text_props_cache);
+        last = (--(info->refcount) == 0);
+        *free_info = (last && !info->in_cache);
+        LKU(lock_text_props_cache);
+     }
+   else
+     *free_info = last = (--(info->refcount) == 0);
+   return last;
+}
+
+static void
+_text_props_info_free(Evas_Text_Props_Info *info)
+{
+   if (info->glyph)
+     free(info->glyph);
+#ifdef OT_SUPPORT
+   if (info->ot)
+     free(info->ot);
+#endif
+   free(info);
+}
+
+/* Called with the lock held. The info is freed here if no props use it,
+ * else by the props dropping the last reference to it. */
+static void
+_text_props_cache_item_del(Text_Props_Cache_Item *item)
+{
+   text_props_cache_lru = eina_inlist_remove(text_props_cache_lru,
+                                             EINA_INLIST_GET(item));
+   eina_hash_del_by_key(text_props_cache, &item->key);
+   text_props_cache_stats.count--;
+   item->info->in_cache = EINA_FALSE;
+   if (item->info->refcount == 0)
+     _text_props_info_free(item->info);
+   free(item);
+}
+
+/* Called with the lock held */
+static void
+_text_props_cache_trim(void)
+{
+   while (text_props_cache_lru &&
+          (text_props_cache_stats.count > text_props_cache_stats.max))
+     {
+        Text_Props_Cache_Item *item;
+
+        item = EINA_INLIST_CONTAINER_GET(text_props_cache_lru->last,
+                                         Text_Props_Cache_Item);
+        _text_props_cache_item_del(item);
+        text_props_cache_stats.evicted++;
+     }
+}
+
+void
+evas_common_text_props_cache_init(void)
+{
+   const char *s;
+
+   LKI(lock_text_props_cache);
+   text_props_cache = eina_hash_new(_text_props_cache_key_length,
+         EINA_KEY_CMP(_text_props_cache_key_cmp),
+         EINA_KEY_HASH(_text_props_cache_key_hash),
+         NULL, 8);
+   memset(&text_props_cache_stats, 0, sizeof(text_props_cache_stats));
+   text_props_cache_stats.max = 1024;
+   s = getenv("EVAS_TEXT_PROPS_CACHE_SIZE");
+   if (s) text_props_cache_stats.max = atoi(s);
+}
+
+void
+evas_common_text_props_cache_shutdown(void)
+{
+   LKL(lock_text_props_cache);
+   text_props_cache_stats.max = 0;
+   _text_props_cache_trim();
+   LKU(lock_text_props_cache);
+   eina_hash_free(text_props_cache);
+   text_props_cache = NULL;
+   LKD(lock_text_props_cache);
+}
+
+/* Forget the runs shaped with a font instance that is being freed: it's not
+ * referenced anymore, so no props use them either. */
+void
+evas_common_text_props_cache_font_del(void *_fi)
+{
+   Text_Props_Cache_Item *item;
+   Eina_Inlist *l;
+
+   LKL(lock_text_props_cache);
+   EINA_INLIST_FOREACH_SAFE(text_props_cache_lru, l, item)
+     {
+        if (item->key.fi == _fi)
+          _text_props_cache_item_del(item);
+     }
+   LKU(lock_text_props_cache);
+}
+
+EAPI void
+evas_common_text_props_cache_size_set(int runs)
+{
+   LKL(lock_text_props_cache);
+   text_props_cache_stats.max = (runs > 0) ? runs : 0;
+   _text_props_cache_trim();
+   LKU(lock_text_props_cache);
+}
+
+EAPI int
+evas_common_text_props_cache_size_get(void)
+{
+   return text_props_cache_stats.max;
+}
+
+EAPI void
+evas_common_text_props_cache_stats_get(Evas_Common_Text_Props_Cache_Stats *st)
+{
+   if (!st) return;
+   LKL(lock_text_props_cache);
+   *st = text_props_cache_stats;
+   LKU(lock_text_props_cache);
+}
+
+/* Shaping depends on the context around the run in that case */
+static inline Eina_Bool
+_text_props_cache_usable(const Evas_Text_Props *text_props, int len,
+      Evas_Text_Props_Mode mode)
+{
+   /* Single chars are cheap, and textgrid keeps its own props for them */
+   if ((len < 2) || (len > TEXT_PROPS_CACHE_RUN_MAX)) return EINA_FALSE;
+#if !defined(OT_SUPPORT) && defined(BIDI_SUPPORT)
+   if ((mode == EVAS_TEXT_PROPS_MODE_SHAPE) &&
+       (text_props->bidi_dir == EVAS_BIDI_DIRECTION_RTL))
+     return EINA_FALSE;
+#else
+   (void) text_props;
+   (void) mode;
+#endif
+   return EINA_TRUE;
+}
+
+static inline void
+_text_props_cache_key_set(Text_Props_Cache_Key *key, const RGBA_Font_Int *fi,
+      const Eina_Unicode *text, const Evas_Text_Props *text_props, int len,
+      Evas_Text_Props_Mode mode)
+{
+   key->fi = fi;
+   key->text = text;
+   key->len = len;
+   key->script = text_props->script;
+   key->bidi_dir = text_props->bidi_dir;
+   key->mode = mode;
+}
+
+/* Share the info of an already shaped run, if there is one. Called with
+ * fi->ft_mutex held: an info no props used gets its font reference back. */
+static Eina_Bool
+_text_props_cache_find(RGBA_Font_Int *fi, const Eina_Unicode *text,
+      Evas_Text_Props *text_props, int len, Evas_Text_Props_Mode mode)
+{
+   Text_Props_Cache_Key key;
+   Text_Props_Cache_Item *item;
+   Eina_Bool unused;
+
+   _text_props_cache_key_set(&key, fi, text, text_props, len, mode);
+   LKL(lock_text_props_cache);
+   item = eina_hash_find(text_props_cache, &key);
+   if (!item)
+     {
+        text_props_cache_stats.misses++;
+        LKU(lock_text_props_cache);
+        return EINA_FALSE;
+     }
+   text_props_cache_lru = eina_inlist_promote(text_props_cache_lru,
+                                              EINA_INLIST_GET(item));
+   unused = (item->info->refcount++ == 0);
+   text_props_cache_stats.hits++;
+   LKU(lock_text_props_cache);
+
+   if (unused) fi->references++;
+   text_props->info = item->info;
+   text_props->len = item->glyphs_len;
+   return EINA_TRUE;
+}
+
+/* The info is complete and never changes from now on */
+static void
+_text_props_cache_add(const RGBA_Font_Int *fi, const Eina_Unicode *text,
+      Evas_Text_Props *text_props, int len, Evas_Text_Props_Mode mode)
+{
+   Text_Props_Cache_Item *item;
+   Eina_Unicode *copy;
+
+   if (text_props_cache_stats.max <= 0) return;
+   item = malloc(sizeof(Text_Props_Cache_Item) + (len * sizeof(Eina_Unicode)));
+   if (!item) return;
+   copy = (Eina_Unicode *)(item + 1);
+   memcpy(copy, text, len * sizeof(Eina_Unicode));
+   _text_props_cache_key_set(&item->key, fi, copy, text_props, len, mode);
+   item->info = text_props->info;
+   item->glyphs_len = text_props->len;
+
+   LKL(lock_text_props_cache);
+   /* Another thread may have shaped the same run meanwhile */
+   if (eina_hash_find(text_props_cache, &item->key))
+     {
+        LKU(lock_text_props_cache);
+        free(item);
+        return;
+     }
+   item->info->cached = EINA_TRUE;
+   item->info->in_cache = EINA_TRUE;
+   eina_hash_direct_add(text_props_cache, &item->key, item);
+   text_props_cache_lru = eina_inlist_prepend(text_props_cache_lru,
+                                              EINA_INLIST_GET(item));
+   text_props_cache_stats.count++;
+   _text_props_cache_trim();
+   LKU(lock_text_props_cache);
+}
+
 void
 evas_common_text_props_bidi_set(Evas_Text_Props *props,
       Evas_BiDi_Paragraph_Props *bidi_par_props, size_t start)
@@ -46,19 +358,20 @@ evas_common_text_props_content_ref(Evas_Text_Props *props)
    if (!props->info)
       return;
 
-   props->info->refcount++;
-   if (props->font_instance) 
-     ((RGBA_Font_Int *)props->font_instance)->references++;
+   /* The font instance is referenced by the info itself */
+   _text_props_info_ref(props->info);
 }
 
 void
 evas_common_text_props_content_nofree_unref(Evas_Text_Props *props)
 {
+   Eina_Bool free_info;
+
    /* No content in this case */
    if (!props->info)
       return;
 
-   if (--(props->info->refcount) == 0)
+   if (_text_props_info_unref(props->info, &free_info))
      {
         if (props->font_instance)
           {
@@ -69,13 +382,7 @@ evas_common_text_props_content_nofree_unref(Evas_Text_Props *props)
         evas_common_font_glyphs_unref(props->glyphs);
         props->glyphs = NULL;
 
-        if (props->info->glyph)
-          free(props->info->glyph);
-#ifdef OT_SUPPORT
-        if (props->info->ot)
-          free(props->info->ot);
-#endif
-        free(props->info);
+        if (free_info) _text_props_info_free(props->info);
         props->info = NULL;
      }
 }
@@ -83,6 +390,8 @@ evas_common_text_props_content_nofree_unref(Evas_Text_Props *props)
 void
 evas_common_text_props_content_unref(Evas_Text_Props *props)
 {
+   Eina_Bool free_info;
+
    /* No content in this case */
    if (!props->info)
       return;
@@ -90,7 +399,7 @@ evas_common_text_props_content_unref(Evas_Text_Props *props)
    if (props->glyphs) evas_common_font_glyphs_unref(props->glyphs);
    props->glyphs = NULL;
 
-   if (--(props->info->refcount) == 0)
+   if (_text_props_info_unref(props->info, &free_info))
      {
         if (props->font_instance)
           {
@@ -98,13 +407,7 @@ evas_common_text_props_content_unref(Evas_Text_Props *props)
              props->font_instance = NULL;
           }
 
-        if (props->info->glyph)
-          free(props->info->glyph);
-#ifdef OT_SUPPORT
-        if (props->info->ot)
-          free(props->info->ot);
-#endif
-        free(props->info);
+        if (free_info) _text_props_info_free(props->info);
         props->info = NULL;
      }
 }
@@ -364,14 +667,8 @@ _content_create_ot(RGBA_Font_Int *fi, const Eina_Unicode *text,
              is_replacement = EINA_TRUE;
           }
         idx = gl_itr->index;
-        LKL(fi->ft_mutex);
         fg = evas_common_font_int_cache_glyph_get(fi, idx);
-        if (!fg)
-          {
-             LKU(fi->ft_mutex);
-             continue;
-          }
-        LKU(fi->ft_mutex);
+        if (!fg) continue;
 
         gl_itr->x_bear = fg->x_bear;
         gl_itr->y_bear = fg->y_bear;
@@ -523,6 +820,7 @@ evas_common_text_props_content_create(void *_fi, const Eina_Unicode *text,
       size_t par_pos, int len, Evas_Text_Props_Mode mode)
 {
    RGBA_Font_Int *fi = (RGBA_Font_Int *) _fi;
+   Eina_Bool cache;
 
    if (text_props->info)
      {
@@ -533,28 +831,26 @@ evas_common_text_props_content_create(void *_fi, const Eina_Unicode *text,
         text_props->info = NULL;
         text_props->start = text_props->len = text_props->text_offset = 0;
      }
-   text_props->info = calloc(1, sizeof(Evas_Text_Props_Info));
 
-   if (text_props->font_instance != fi)
-     {
-        if (text_props->font_instance)
-          evas_common_font_int_unref(text_props->font_instance);
-        text_props->font_instance = fi;
-        fi->references++;
-     }
-   
+   text_props->font_instance = fi;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-        evas_common_font_source_reload(fi->src);
-        FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-        FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
 
    text_props->changed = EINA_TRUE;
+   text_props->text_len = len;
 
+   /* Text is also shaped off the main loop (textblock layout): the glyphs
+    * and kerning cached in fi are only used with its lock held. */
+   LKL(fi->ft_mutex);
+   cache = _text_props_cache_usable(text_props, len, mode);
+   if (cache && _text_props_cache_find(fi, text, text_props, len, mode))
+     {
+        LKU(fi->ft_mutex);
+        return EINA_TRUE;
+     }
+
+   /* Given back with the last props reference to the info */
+   fi->references++;
+   text_props->info = calloc(1, sizeof(Evas_Text_Props_Info));
 #ifdef OT_SUPPORT
    (void) par_props;
    (void) par_pos;
@@ -562,9 +858,10 @@ evas_common_text_props_content_create(void *_fi, const Eina_Unicode *text,
 #else
    _content_create_regular(fi, text, text_props, par_props, par_pos, len, mode);
 #endif
+   LKU(fi->ft_mutex);
 
-   text_props->text_len = len;
    text_props->info->refcount = 1;
+   if (cache) _text_props_cache_add(fi, text, text_props, len, mode);
    return EINA_TRUE;
 }
 
@@ -99,7 +99,21 @@ struct _Evas_Text_Props_Info
 {
    Evas_Font_Glyph_Info *glyph; // 8/4
    Evas_Font_OT_Info *ot; // 8/4
-   unsigned int refcount; // 4
+   unsigned int refcount; // 4, references held by props
+   Eina_Bool cached : 1; // shared through the shaping cache
+   Eina_Bool in_cache : 1; // still kept by it, changed with its lock held
+};
+
+typedef struct _Evas_Common_Text_Props_Cache_Stats Evas_Common_Text_Props_Cache_Stats;
+
+/* Counters of the shaping cache, see evas_common_text_props_content_create() */
+struct _Evas_Common_Text_Props_Cache_Stats
+{
+   unsigned int hits;
+   unsigned int misses;
+   unsigned int evicted;
+   int          count; /* runs held now */
+   int          max; /* runs it can hold */
 };
 
 struct _Evas_Font_Array_Data
@@ -159,6 +173,20 @@ evas_common_text_props_content_create(void *_fi, const Eina_Unicode *text,
       Evas_Text_Props *text_props, const Evas_BiDi_Paragraph_Props *par_props,
       size_t par_pos, int len, Evas_Text_Props_Mode mode);
 
+void
+evas_common_text_props_cache_init(void);
+void
+evas_common_text_props_cache_shutdown(void);
+void
+evas_common_text_props_cache_font_del(void *_fi);
+
+EAPI void
+evas_common_text_props_cache_size_set(int runs);
+EAPI int
+evas_common_text_props_cache_size_get(void);
+EAPI void
+evas_common_text_props_cache_stats_get(Evas_Common_Text_Props_Cache_Stats *st);
+
 void
 evas_common_text_props_content_copy_and_ref(Evas_Text_Props *dst,
       const Evas_Text_Props *src);
@@ -12,8 +12,11 @@ static unsigned int evas_thread_queue_cache_max = 0;
 
 static volatile int evas_thread_exited = 0;
 static Eina_Bool exit_thread = EINA_FALSE;
+static Eina_Bool evas_thread_started = EINA_FALSE;
 static int init_count = 0;
 
+static void *evas_thread_worker_func(void *data, Eina_Thread thread);
+
 static void
 evas_thread_queue_append(Evas_Thread_Command_Cb cb, void *data, Eina_Bool do_flush)
 {
@@ -21,6 +24,17 @@ evas_thread_queue_append(Evas_Thread_Command_Cb cb, void *data, Eina_Bool do_flu
 
    eina_lock_take(&evas_thread_queue_lock);
 
+   /* The render thread is spawned by the first command, not by evas_init(),
+    * so that it also exists in children forked after evas_init(). */
+   if (!evas_thread_started)
+     {
+        if (!eina_thread_create(&evas_thread_worker, EINA_THREAD_NORMAL, 0,
+                                evas_thread_worker_func, NULL))
+          CRI("Could not create draw thread");
+        else
+          evas_thread_started = EINA_TRUE;
+     }
+
    cmd = eina_inarray_grow(&evas_thread_queue, 1);
    if (cmd)
      {
@@ -117,6 +131,193 @@ out:
     return NULL;
 }
 
+/* Worker pool
+ *
+ * Some operations (filters, map drawing) split their work in independent
+ * slices of rows or columns. The pool runs those slices on a few worker
+ * threads, the calling thread taking its share of the work as well. Threads
+ * are only spawned on first use, so that programs that never split any work
+ * don't pay for them.
+ */
+
+#define EVAS_THREAD_WORKERS_MAX 16
+
+static struct
+{
+   Eina_Lock         lock;
+   Eina_Lock         busy;
+   Eina_Condition    work;
+   Eina_Condition    done;
+   Eina_Thread       threads[EVAS_THREAD_WORKERS_MAX];
+   int               count;
+   Eina_Bool         init : 1;
+   Eina_Bool         started : 1;
+   Eina_Bool         quit : 1;
+
+   /* current job, protected by lock */
+   Evas_Thread_Parallel_Cb cb;
+   void             *data;
+   int               total;
+   int               chunk;
+   int               next;
+   int               running;
+} _pool;
+
+/* Runs slices of the current job until there is nothing left to take.
+ * Called with the pool lock held. */
+static void
+_pool_job_process(void)
+{
+   while (_pool.cb && (_pool.next < _pool.total))
+     {
+        Evas_Thread_Parallel_Cb cb = _pool.cb;
+        void *data = _pool.data;
+        int start = _pool.next;
+        int end = MIN(start + _pool.chunk, _pool.total);
+
+        _pool.next = end;
+        _pool.running++;
+        eina_lock_release(&_pool.lock);
+
+        cb(data, start, end);
+
+        eina_lock_take(&_pool.lock);
+        if (!--_pool.running && (_pool.next >= _pool.total))
+          eina_condition_broadcast(&_pool.done);
+     }
+}
+
+static void *
+_pool_worker(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   eina_lock_take(&_pool.lock);
+   while (!_pool.quit)
+     {
+        if (!_pool.cb || (_pool.next >= _pool.total))
+          {
+             eina_condition_wait(&_pool.work);
+             continue;
+          }
+        _pool_job_process();
+     }
+   eina_lock_release(&_pool.lock);
+
+   return NULL;
+}
+
+static void
+_pool_start(void)
+{
+   const char *env;
+   int cpus, i;
+
+   _pool.started = EINA_TRUE;
+
+   // Number of threads working, the calling one included
+   env = getenv("EVAS_WORKER_THREADS");
+   if (env) cpus = atoi(env);
+   else cpus = eina_cpu_count();
+   if (cpus <= 1) return;
+
+   for (i = 0; (i < cpus - 1) && (i < EVAS_THREAD_WORKERS_MAX); i++)
+     {
+        if (!eina_thread_create(&_pool.threads[i], EINA_THREAD_NORMAL, -1,
+                                _pool_worker, NULL))
+          {
+             ERR("Could not create worker thread");
+             break;
+          }
+        _pool.count++;
+     }
+}
+
+void
+evas_thread_parallel_run(int count, int min_chunk,
+                         Evas_Thread_Parallel_Cb cb, void *data)
+{
+   int chunk;
+
+   EINA_SAFETY_ON_NULL_RETURN(cb);
+   if (count <= 0) return;
+   if (min_chunk < 1) min_chunk = 1;
+
+   /* Run inline when the job is small, or when another thread already
+    * uses the pool (the main loop and the render thread can both ask). */
+   if (!_pool.init || (count < 2 * min_chunk) ||
+       (eina_lock_take_try(&_pool.busy) != EINA_LOCK_SUCCEED))
+     {
+        cb(data, 0, count);
+        return;
+     }
+
+   eina_lock_take(&_pool.lock);
+   if (!_pool.started) _pool_start();
+   if (!_pool.count)
+     {
+        eina_lock_release(&_pool.lock);
+        eina_lock_release(&_pool.busy);
+        cb(data, 0, count);
+        return;
+     }
+
+   // A few slices per thread, for better load balancing
+   chunk = count / (4 * (_pool.count + 1));
+   if (chunk < min_chunk) chunk = min_chunk;
+
+   _pool.cb = cb;
+   _pool.data = data;
+   _pool.total = count;
+   _pool.chunk = chunk;
+   _pool.next = 0;
+   eina_condition_broadcast(&_pool.work);
+
+   _pool_job_process();
+   while (_pool.running)
+     eina_condition_wait(&_pool.done);
+
+   _pool.cb = NULL;
+   _pool.data = NULL;
+   eina_lock_release(&_pool.lock);
+   eina_lock_release(&_pool.busy);
+}
+
+static void
+_pool_init(void)
+{
+   if (_pool.init) return;
+
+   if (!eina_lock_new(&_pool.lock) || !eina_lock_new(&_pool.busy))
+     {
+        CRI("Could not create worker pool locks");
+        return;
+     }
+   eina_condition_new(&_pool.work, &_pool.lock);
+   eina_condition_new(&_pool.done, &_pool.lock);
+   _pool.init = EINA_TRUE;
+}
+
+static void
+_pool_shutdown(void)
+{
+   int i;
+
+   if (!_pool.init) return;
+
+   eina_lock_take(&_pool.lock);
+   _pool.quit = EINA_TRUE;
+   eina_condition_broadcast(&_pool.work);
+   eina_lock_release(&_pool.lock);
+
+   for (i = 0; i < _pool.count; i++)
+     eina_thread_join(_pool.threads[i]);
+
+   eina_condition_free(&_pool.work);
+   eina_condition_free(&_pool.done);
+   eina_lock_free(&_pool.lock);
+   eina_lock_free(&_pool.busy);
+   memset(&_pool, 0, sizeof(_pool));
+}
+
 void
 evas_thread_init(void)
 {
@@ -130,9 +331,8 @@ evas_thread_init(void)
       CRI("Could not create draw thread lock");
     if (!eina_condition_new(&evas_thread_queue_condition, &evas_thread_queue_lock))
       CRI("Could not create draw thread condition");
-    if (!eina_thread_create(&evas_thread_worker, EINA_THREAD_NORMAL, 0,
-          evas_thread_worker_func, NULL))
-      CRI("Could not create draw thread");
+
+    _pool_init();
 }
 
 void
@@ -143,17 +343,26 @@ evas_thread_shutdown(void)
     if (--init_count)
       return;
 
-    eina_lock_take(&evas_thread_queue_lock);
+    _pool_shutdown();
+
+    if (evas_thread_started)
+      {
+         eina_lock_take(&evas_thread_queue_lock);
+
+         exit_thread = EINA_TRUE;
+         eina_condition_signal(&evas_thread_queue_condition);
 
-    exit_thread = EINA_TRUE;
-    eina_condition_signal(&evas_thread_queue_condition);
+         eina_lock_release(&evas_thread_queue_lock);
 
-    eina_lock_release(&evas_thread_queue_lock);
+         while (!evas_thread_exited)
+           evas_async_events_process();
 
-    while (!evas_thread_exited)
-      evas_async_events_process();
+         eina_thread_join(evas_thread_worker);
+         evas_thread_started = EINA_FALSE;
+         evas_thread_exited = 0;
+         exit_thread = EINA_FALSE;
+      }
 
-    eina_thread_join(evas_thread_worker);
     eina_lock_free(&evas_thread_queue_lock);
     eina_condition_free(&evas_thread_queue_condition);
 
@@ -299,7 +299,44 @@ typedef struct _Font_Data Font_Data;
 typedef struct _Glyph_Data Glyph_Data;
 typedef struct _Shared_Array_Header Shared_Array_Header;
 typedef int string_t;
-#define SHMOBJECT unsigned int id; unsigned int refcount
+#define SHMOBJECT unsigned int id; unsigned int refcount; unsigned int seq
+
+/* Shared objects are published with a sequence lock, so that clients can
+ * read them straight from the shared index without asking the server.
+ * The server makes 'seq' odd while it rewrites an object and even again
+ * when done. A reader copies the object and keeps the copy only if 'seq'
+ * was even and did not change in the meantime.
+ */
+#define SHM_OBJECT_READ_RETRIES 64
+
+static inline void
+cserve2_shm_object_write_begin(unsigned int *seq)
+{
+   __atomic_store_n(seq, *seq + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void
+cserve2_shm_object_write_end(unsigned int *seq)
+{
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+   __atomic_store_n(seq, *seq + 1, __ATOMIC_RELAXED);
+}
+
+static inline unsigned int
+cserve2_shm_object_read_begin(const unsigned int *seq)
+{
+   unsigned int s = __atomic_load_n(seq, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   return s;
+}
+
+static inline Eina_Bool
+cserve2_shm_object_read_retry(const unsigned int *seq, unsigned int s)
+{
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   return (s & 1) || (__atomic_load_n(seq, __ATOMIC_RELAXED) != s);
+}
 
 struct _Shared_Array_Header {
    int32_t tag;
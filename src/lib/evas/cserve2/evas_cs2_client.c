@@ -72,6 +72,10 @@ static unsigned int _data_id = 0;
 static Eina_List *_requests = NULL;
 static Eina_Hash *_file_entries = NULL;
 
+// Lookups resolved from the shared index vs. blocking waits on the socket
+static unsigned int _shm_hits = 0;
+static unsigned int _round_trips = 0;
+
 // Shared index table
 static Index_Table _index;
 static const char *_shared_string_get(int id);
@@ -84,6 +88,7 @@ static const File_Data *_shared_image_entry_file_data_find(Image_Entry *ie);
 static const Image_Data *_shared_image_entry_image_data_find(Image_Entry *ie);
 static const Font_Data *_shared_font_entry_data_find(Font_Entry *fe);
 static Eina_Bool _shared_index_remap_check(Shared_Index *si, int elemsize);
+static Eina_Bool _shared_object_snapshot(const void *obj, void *copy, int elemsize);
 
 static Eina_Bool _server_dispatch_until(unsigned int rid);
 unsigned int _image_load_server_send(Image_Entry *ie);
@@ -507,7 +512,8 @@ evas_cserve2_shutdown(void)
    if ((--cserve2_init) > 0)
      return cserve2_init;
 
-   DBG("Disconnecting from cserve2.");
+   INF("Disconnecting from cserve2. Shared index hits: %u, round trips: %u",
+       _shm_hits, _round_trips);
    empty->base.type = CSERVE2_INDEX_LIST;
    _server_index_list_set((Msg_Base *) empty, sizeof(Msg_Index_List));
    _server_disconnect();
@@ -610,6 +616,7 @@ _server_dispatch_until(unsigned int rid)
    sigprocmask(0, NULL, &sigmask);
    sigaddset(&sigmask, SIGCHLD);
 
+   if (rid) _round_trips++;
    while (1)
      {
         rrid = _server_dispatch(&failed);
@@ -1295,6 +1302,7 @@ int
 evas_cserve2_image_load_wait(Image_Entry *ie)
 {
    const File_Data *fd;
+   File_Data fdc;
    Eina_Bool failed;
    unsigned int rrid, rid;
 
@@ -1311,18 +1319,20 @@ evas_cserve2_image_load_wait(Image_Entry *ie)
 
 #if USE_SHARED_INDEX
    fd = _shared_image_entry_file_data_find(ie);
-   if (fd && fd->valid)
+   if (fd && _shared_object_snapshot(fd, &fdc, sizeof(fdc)) &&
+       fdc.valid && !fdc.changed)
      {
         DBG("Bypassing socket wait (open_rid %d)", ie->open_rid);
-        ie->w = fd->w;
-        ie->h = fd->h;
-        ie->flags.alpha = fd->alpha;
-        ie->animated.loop_hint = fd->loop_hint;
-        ie->animated.loop_count = fd->loop_count;
-        ie->animated.frame_count = fd->frame_count;
-        ie->animated.animated = fd->animated;
-        ie->server_id = fd->id;
+        ie->w = fdc.w;
+        ie->h = fdc.h;
+        ie->flags.alpha = fdc.alpha;
+        ie->animated.loop_hint = fdc.loop_hint;
+        ie->animated.loop_count = fdc.loop_count;
+        ie->animated.frame_count = fdc.frame_count;
+        ie->animated.animated = fdc.animated;
+        ie->server_id = fdc.id;
         ie->open_rid = 0;
+        _shm_hits++;
      }
 #endif
 
@@ -1367,23 +1377,25 @@ int
 evas_cserve2_image_load_data_wait(Image_Entry *ie)
 {
    const Image_Data *idata;
+   Image_Data idc;
 
    if (!ie)
      return CSERVE2_GENERIC;
 
 #if USE_SHARED_INDEX
    idata = _shared_image_entry_image_data_find(ie);
-   if (idata && idata->valid)
+   if (idata && _shared_object_snapshot(idata, &idc, sizeof(idc)) &&
+       idc.valid && idc.shm_id)
      {
         // FIXME: Ugly copy & paste from _loaded_handle
         Data_Entry *dentry = ie->data2;
         RGBA_Image *im = (RGBA_Image *)ie;
         const char *shmpath;
 
-        shmpath = _shared_string_get(idata->shm_id);
+        shmpath = _shared_string_get(idc.shm_id);
         if (!shmpath) goto load_wait;
         DBG("Bypassing image load socket wait. Image found: %d in %s",
-            idata->id, shmpath);
+            idc.id, shmpath);
 
         dentry->shm.mmap_offset = 0;
         dentry->shm.use_offset = 0;
@@ -1403,11 +1415,12 @@ evas_cserve2_image_load_data_wait(Image_Entry *ie)
           }
 
         im->image.data = dentry->shm.data;
-        ie->flags.alpha_sparse = idata->alpha_sparse;
+        ie->flags.alpha_sparse = idc.alpha_sparse;
         ie->flags.loaded = EINA_TRUE;
         im->image.no_free = 1;
 
         ie->load_rid = 0;
+        _shm_hits++;
         return CSERVE2_NONE;
      }
 #endif
@@ -1501,6 +1514,7 @@ struct _Glyph_Map
    Shared_Buffer mempool;
    Eina_Clist glyphs;
    Eina_List *mempool_lru;
+   int scanned; // Glyph_Data entries already merged into the font hashes
 };
 
 struct _CS_Glyph_Out
@@ -1560,11 +1574,38 @@ _glyph_out_free(void *gl)
    free(glout);
 }
 
+typedef struct
+{
+   Font_Entry *fe;
+   Font_Hint_Flags hints;
+   unsigned int rid;
+} Glyph_Request_Data;
+
+static Eina_Bool _font_loaded_cb(void *data, const void *msg, int size);
+static Eina_Bool _glyph_request_cb(void *data, const void *msg, int size);
+
 static void
 _font_entry_free(Font_Entry *fe)
 {
+   Client_Request *cr;
+   Eina_List *l;
    int i;
 
+   /* The load wait may have been served by the shared index, so answers
+    * for this entry can still be on their way: they must not reach it. */
+   EINA_LIST_FOREACH(_requests, l, cr)
+     {
+        if ((cr->cb == _font_loaded_cb) && (cr->data == fe))
+          cr->cb = NULL;
+        else if ((cr->cb == _glyph_request_cb) &&
+                 (((Glyph_Request_Data *) cr->data)->fe == fe))
+          {
+             free(cr->data);
+             cr->cb = NULL;
+             cr->data = NULL;
+          }
+     }
+
    for (i = 0; i < 3; i++)
      if (fe->fash[i])
        fash_gl_free(fe->fash[i]);
@@ -1669,6 +1710,16 @@ evas_cserve2_font_load(const char *source, const char *name, int size, int dpi,
    return fe;
 }
 
+/* Another instance of the font of fe, the glyphs it asks for are kept
+ * apart by their hinting */
+Font_Entry *
+evas_cserve2_font_load_again(Font_Entry *fe)
+{
+   if (!fe) return NULL;
+   return evas_cserve2_font_load(fe->source, fe->name, fe->size, fe->dpi,
+                                 fe->wanted_rend);
+}
+
 int
 evas_cserve2_font_load_wait(Font_Entry *fe)
 {
@@ -1688,6 +1739,7 @@ evas_cserve2_font_load_wait(Font_Entry *fe)
         DBG("Bypassing socket wait (rid %d)", fe->rid);
         fe->failed = EINA_FALSE;
         fe->rid = 0;
+        _shm_hits++;
         return CSERVE2_NONE;
      }
 #endif
@@ -1721,13 +1773,6 @@ evas_cserve2_font_free(Font_Entry *fe)
    _font_entry_free(fe);
 }
 
-typedef struct
-{
-   Font_Entry *fe;
-   Font_Hint_Flags hints;
-   unsigned int rid;
-} Glyph_Request_Data;
-
 static Glyph_Map *
 _glyph_map_open(Font_Entry *fe, const char *indexpath, const char *datapath)
 {
@@ -1889,22 +1934,25 @@ _glyph_map_remap_check(Glyph_Map *map, const char *idxpath, const char *datapath
 
 #if USE_SHARED_INDEX
 static int
-_font_entry_glyph_map_rebuild_check(Font_Entry *fe, Font_Hint_Flags hints)
+_font_entry_glyph_map_rebuild_check(Font_Entry *fe)
 {
+   Glyph_Map *map;
    Eina_Bool changed = EINA_FALSE;
-   int cnt = 0;
+   int cnt = 0, end, k;
    const char *idxpath = NULL, *datapath = NULL;
 
    _string_index_refresh();
    if (!fe->map)
      {
         const Font_Data *fd;
+        Font_Data fdc;
 
         fd = _shared_font_entry_data_find(fe);
-        if (!fd) return -1;
+        if (!fd || !_shared_object_snapshot(fd, &fdc, sizeof(fdc)))
+          return -1;
 
-        idxpath = _shared_string_safe_get(fd->glyph_index_shm);
-        datapath = _shared_string_safe_get(fd->mempool_shm);
+        idxpath = _shared_string_safe_get(fdc.glyph_index_shm);
+        datapath = _shared_string_safe_get(fdc.mempool_shm);
         if (!idxpath || !datapath) return -1;
 
         fe->map =_glyph_map_open(fe, idxpath, datapath);
@@ -1913,57 +1961,82 @@ _font_entry_glyph_map_rebuild_check(Font_Entry *fe, Font_Hint_Flags hints)
         changed = EINA_TRUE;
      }
 
-   changed |= _glyph_map_remap_check(fe->map, idxpath, datapath);
-   if (changed && fe->map->index.data && fe->map->mempool.data)
+   map = fe->map;
+   changed |= _glyph_map_remap_check(map, idxpath, datapath);
+   if (!map->index.data || !map->index.header || !map->mempool.data)
+     return 0;
+
+   // Glyphs are only ever appended to the index, so after a remap we
+   // rescan everything but otherwise only look at the new entries.
+   if (changed) map->scanned = 0;
+   end = MIN(map->index.header->emptyidx, map->index.count);
+
+   for (k = map->scanned; k < end; k++)
      {
         CS_Glyph_Out *gl;
-        const Glyph_Data *gd;
-        int k, tot = 0;
-
-        DBG("Rebuilding font hash based on shared index...");
-        for (k = 0; k < fe->map->index.count; k++)
+        Glyph_Data gd;
+        Fash_Glyph2 *fash;
+
+        if (!_shared_object_snapshot(&map->index.entries.gldata[k],
+                                     &gd, sizeof(gd)))
+          break; // Being written, retry from here next time
+        if (!gd.id) continue; // Entry 0 is reserved by the server
+        if (!gd.refcount) continue;
+        if (!gd.mempool_id) break; // Allocated but not filled in yet
+        if (gd.hint > 2) continue;
+        if ((gd.offset < 0) ||
+            ((size_t) gd.offset + gd.size > (size_t) map->mempool.size))
+          break;
+
+        fash = fe->fash[gd.hint];
+        if (!fash)
           {
-             gd = &(fe->map->index.entries.gldata[k]);
-             if (!gd->id) break;
-             if (!gd->refcount) continue;
-             if (gd->hint != hints) continue;
+             fash = fash_gl_new(_glyph_out_free);
+             fe->fash[gd.hint] = fash;
+          }
 
-             tot++;
-             gl = fash_gl_find(fe->fash[hints], gd->index);
-             if (gl && gl->base.bitmap.buffer) continue;
+        gl = fash_gl_find(fash, gd.index);
+        if (gl && gl->map && gl->sb) continue;
 
-             if (!gl)
-               {
-                  gl = calloc(1, sizeof(*gl));
-                  gl->idx = gd->index;
-                  eina_clist_element_init(&gl->map_entry);
-                  eina_clist_element_init(&gl->used_list);
-                  fash_gl_add(fe->fash[hints], gl->idx, gl);
-               }
-             gl->map = fe->map;
-             gl->sb = &fe->map->mempool;
-             gl->offset = gd->offset;
-             gl->size = gd->size;
-             gl->hint = gd->hint;
-             gl->base.bitmap.rows = gd->rows;
-             gl->base.bitmap.width = gd->width;
-             gl->base.bitmap.pitch = gd->pitch;
-             gl->base.bitmap.buffer = NULL;
-             gl->base.rle = (unsigned char *)
-               fe->map->mempool.data + gl->offset;
-             gl->base.rle_size = gl->size;
-             gl->base.bitmap.rle_alloc = EINA_FALSE;
-             gl->idx = gd->index;
-             gl->rid = 0;
-
-             if (!eina_clist_element_is_linked(&gl->map_entry))
-               eina_clist_add_head(&fe->map->glyphs, &gl->map_entry);
-             fash_gl_add(fe->fash[hints], gd->index, gl);
-             cnt++;
-          }
-        if (cnt)
-          DBG("Added %d glyphs to the font hash (out of %d scanned)", cnt, tot);
+        if (!gl)
+          {
+             gl = calloc(1, sizeof(*gl));
+             gl->idx = gd.index;
+             eina_clist_element_init(&gl->map_entry);
+             eina_clist_element_init(&gl->used_list);
+             fash_gl_add(fash, gl->idx, gl);
+          }
+        else if (!gl->map && !gl->rid &&
+                 eina_clist_element_is_linked(&gl->map_entry))
+          {
+             // Still queued for a request, no need to send it anymore
+             eina_clist_remove(&gl->map_entry);
+             fe->glyphs_queue_count--;
+          }
+        gl->map = map;
+        gl->sb = &map->mempool;
+        gl->offset = gd.offset;
+        gl->size = gd.size;
+        gl->hint = gd.hint;
+        gl->base.bitmap.rows = gd.rows;
+        gl->base.bitmap.width = gd.width;
+        gl->base.bitmap.pitch = gd.pitch;
+        gl->base.bitmap.buffer = NULL;
+        gl->base.rle = (unsigned char *) map->mempool.data + gl->offset;
+        gl->base.rle_size = gl->size;
+        gl->base.bitmap.rle_alloc = EINA_FALSE;
+        gl->base.bitmap.no_free_glout = 1;
+        gl->idx = gd.index;
+        gl->rid = 0;
+
+        if (!eina_clist_element_is_linked(&gl->map_entry))
+          eina_clist_add_head(&map->glyphs, &gl->map_entry);
+        cnt++;
      }
+   map->scanned = k;
+
+   if (cnt)
+     DBG("Added %d glyphs to the font hash (scanned up to %d)", cnt, k);
 
    return cnt;
 }
@@ -2254,6 +2327,15 @@ evas_cserve2_font_glyph_request(Font_Entry *fe, unsigned int idx, Font_Hint_Flag
           }
      }
 
+#if USE_SHARED_INDEX
+   // Another client may already have loaded this glyph
+   if (!glyph && !fe->rid && (_font_entry_glyph_map_rebuild_check(fe) > 0))
+     {
+        glyph = fash_gl_find(fash, idx);
+        if (glyph) _shm_hits++;
+     }
+#endif
+
    if (!glyph)
      {
         glyph = calloc(1, sizeof(*glyph));
@@ -2384,7 +2466,7 @@ try_again:
 
 
 #if USE_SHARED_INDEX
-   _font_entry_glyph_map_rebuild_check(fe, hints);
+   _font_entry_glyph_map_rebuild_check(fe);
 #endif
 
    if (out->rid)
@@ -2685,6 +2767,27 @@ _shared_string_get(int id)
    return _shared_string_internal_get(id, EINA_FALSE);
 }
 
+static Eina_Bool
+_shared_object_snapshot(const void *obj, void *copy, int elemsize)
+{
+   const unsigned int *seq = &((const Shm_Object *) obj)->seq;
+   unsigned int s;
+   int tries;
+
+   for (tries = 0; tries < SHM_OBJECT_READ_RETRIES; tries++)
+     {
+        s = cserve2_shm_object_read_begin(seq);
+        if (s & 1) continue;
+        memcpy(copy, obj, elemsize);
+        if (!cserve2_shm_object_read_retry(seq, s))
+          return EINA_TRUE;
+     }
+
+   // The server is busy with this object, ask it over the socket instead
+   DBG("Object %u is being written, giving up", ((const Shm_Object *) obj)->id);
+   return EINA_FALSE;
+}
+
 #define SHARED_INDEX_CHECK(si, typ) \
    do { if (!_shared_index_remap_check(&(si), sizeof(typ))) { \
    CRI("Failed to remap index"); return NULL; } } while (0)
@@ -2740,6 +2843,11 @@ _shared_image_entry_file_data_find(Image_Entry *ie)
 
         fd = &(_index.files.entries.filedata[k]);
         if (!fd->id) break;
+        if (fd->seq & 1)
+          {
+             add_to_hash = EINA_FALSE;
+             continue;
+          }
         if (!fd->refcount) continue;
         if (fd->changed) continue;
 
@@ -3070,6 +3178,11 @@ _shared_image_entry_image_data_find(Image_Entry *ie)
         const Image_Data *id = &(_index.images.entries.idata[k]);
 
         if (!id->id) return NULL;
+        if (id->seq & 1)
+          {
+             add_to_hash = EINA_FALSE;
+             continue;
+          }
         if (!id->refcount) continue;
 
         if (add_to_hash)
@@ -3162,8 +3275,13 @@ _shared_font_entry_data_find(Font_Entry *fe)
      }
 
    // Find in hash
+   // Keep the id: freeing another entry of this font drops it from the hash
    fd = eina_hash_find(_index.fonts.entries_by_hkey, fe->hkey);
-   if (fd) return fd;
+   if (fd)
+     {
+        fe->font_data_id = fd->id;
+        return fd;
+     }
 
    // Find in shared index
    for (k = _index.fonts.last_entry_in_hash;
@@ -3174,6 +3292,11 @@ _shared_font_entry_data_find(Font_Entry *fe)
 
         cur = &(_index.fonts.entries.fontdata[k]);
         if (!cur->id) return NULL;
+        if (cur->seq & 1)
+          {
+             add_to_hash = EINA_FALSE;
+             continue;
+          }
         if (!cur->refcount) continue;
 
         name = _shared_string_safe_get(cur->name);
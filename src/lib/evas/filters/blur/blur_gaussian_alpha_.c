@@ -1,20 +1,23 @@
 /* @file blur_gaussian_alpha_.c
  * Should define the functions:
- * - _gaussian_blur_horiz_alpha_step
- * - _gaussian_blur_vert_alpha_step
+ * - _gaussian_blur_alpha_step
+ *
+ * The same function runs both passes: step is the distance between two
+ * consecutive samples (1 for rows, the image width for columns) and loopstep
+ * the distance between two consecutive rows (resp. columns).
  */
 
 /* Datatypes and MIN macro */
 #include "../evas_filter_private.h"
 
-#if !defined (FUNCTION_NAME) || !defined (STEP)
-# error Must define FUNCTION_NAME and STEP
+#if !defined (FUNCTION_NAME)
+# error Must define FUNCTION_NAME
 #endif
 
 static inline void
 FUNCTION_NAME(const DATA8* restrict srcdata, DATA8* restrict dstdata,
               const int radius, const int len,
-              const int loops, const int loopstep,
+              const int loops, const int loopstep, const int step,
               const int* restrict weights, const int pow2_divider)
 {
    int i, j, k, acc, divider;
@@ -31,12 +34,12 @@ FUNCTION_NAME(const DATA8* restrict srcdata, DATA8* restrict dstdata,
         dst = dstdata;
 
         // left
-        for (k = 0; k < left; k++, dst += STEP)
+        for (k = 0; k < left; k++, dst += step)
           {
              acc = 0;
              divider = 0;
              s = src;
-             for (j = 0; j <= k + radius; j++, s += STEP)
+             for (j = 0; j <= k + radius; j++, s += step)
                {
                   acc += (*s) * weights[j + radius - k];
                   divider += weights[j + radius - k];
@@ -46,22 +49,22 @@ FUNCTION_NAME(const DATA8* restrict srcdata, DATA8* restrict dstdata,
           }
 
         // middle
-        for (k = radius; k < (len - radius); k++, src += STEP, dst += STEP)
+        for (k = radius; k < (len - radius); k++, src += step, dst += step)
           {
              acc = 0;
              s = src;
-             for (j = 0; j < diameter; j++, s += STEP)
+             for (j = 0; j < diameter; j++, s += step)
                acc += (*s) * weights[j];
              *dst = acc >> pow2_divider;
           }
 
         // right
-        for (k = 0; k < right; k++, dst += STEP, src += STEP)
+        for (k = 0; k < right; k++, dst += step, src += step)
           {
              acc = 0;
              divider = 0;
              s = src;
-             for (j = 0; j < 2 * radius - k; j++, s += STEP)
+             for (j = 0; j < 2 * radius - k; j++, s += step)
                {
                   acc += (*s) * weights[j];
                   divider += weights[j];
@@ -81,4 +84,3 @@ error:
 }
 
 #undef FUNCTION_NAME
-#undef STEP
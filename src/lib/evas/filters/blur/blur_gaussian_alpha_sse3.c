@@ -0,0 +1,153 @@
+/* @file blur_gaussian_alpha_sse3.c
+ * Should define the functions:
+ * - _gaussian_blur_horiz_alpha_sse3
+ * - _gaussian_blur_vert_alpha_sse3
+ *
+ * Only SSE2 instructions are used, as this file is not built with -msse3.
+ */
+
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+
+#include <emmintrin.h>
+
+/* Border pixel: weighted average over the taps inside the image */
+static inline void
+_gaussian_alpha_edge_pixel(const DATA8* restrict s, DATA8* restrict dst,
+                           const int step, const int* restrict weights,
+                           const int count)
+{
+   int acc = 0, divider = 0, j;
+
+   for (j = 0; j < count; j++, s += step)
+     {
+        acc += (*s) * weights[j];
+        divider += weights[j];
+     }
+   if (!divider)
+     {
+        CRI("Avoided division by 0.");
+        return;
+     }
+   *dst = acc / divider;
+}
+
+/* Computes count consecutive pixels, tap j of pixel x being s[x + j * step].
+ * Same scheme as the RGBA version, with 16 pixels at once.
+ */
+static inline void
+_gaussian_alpha_span_sse3(const DATA8* restrict src, DATA8* restrict dst,
+                          const int count, const int step,
+                          const __m128i* restrict pairs, const int diameter,
+                          const int* restrict weights, const int pow2_divider)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i shift = _mm_cvtsi32_si128(pow2_divider);
+   int x, j;
+
+   for (x = 0; x + 16 <= count; x += 16)
+     {
+        __m128i acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+        const DATA8* restrict s = src + x;
+
+        for (j = 0; j < diameter; j += 2, s += 2 * step)
+          {
+             const __m128i w = pairs[j >> 1];
+             const __m128i a = _mm_loadu_si128((const __m128i *) s);
+             const __m128i b = (j + 1 < diameter) ?
+                _mm_loadu_si128((const __m128i *) (s + step)) : zero;
+             const __m128i lo = _mm_unpacklo_epi8(a, b);
+             const __m128i hi = _mm_unpackhi_epi8(a, b);
+
+             acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+             acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+             acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+             acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+          }
+
+        acc0 = _mm_srl_epi32(acc0, shift);
+        acc1 = _mm_srl_epi32(acc1, shift);
+        acc2 = _mm_srl_epi32(acc2, shift);
+        acc3 = _mm_srl_epi32(acc3, shift);
+        _mm_storeu_si128((__m128i *) (dst + x),
+                         _mm_packus_epi16(_mm_packs_epi32(acc0, acc1),
+                                          _mm_packs_epi32(acc2, acc3)));
+     }
+
+   // leftovers
+   for (; x < count; x++)
+     {
+        const DATA8* restrict s = src + x;
+        int acc = 0;
+
+        for (j = 0; j < diameter; j++, s += step)
+          acc += (*s) * weights[j];
+        dst[x] = acc >> pow2_divider;
+     }
+}
+
+/* Rows are independent. Requires len > 2 * radius. */
+static void
+_gaussian_blur_horiz_alpha_sse3(const DATA8* restrict src, DATA8* restrict dst,
+                                const int radius, const int len, const int loops,
+                                const int* restrict weights,
+                                const __m128i* restrict pairs,
+                                const int pow2_divider)
+{
+   const int diameter = 2 * radius + 1;
+   int i, k;
+
+   for (i = loops; i; --i, src += len, dst += len)
+     {
+        for (k = 0; k < radius; k++)
+          _gaussian_alpha_edge_pixel(src, dst + k, 1, weights + radius - k,
+                                     k + radius + 1);
+
+        _gaussian_alpha_span_sse3(src, dst + radius, len - 2 * radius, 1,
+                                  pairs, diameter, weights, pow2_divider);
+
+        for (k = 0; k < radius; k++)
+          _gaussian_alpha_edge_pixel(src + len - 2 * radius + k,
+                                     dst + len - radius + k, 1, weights,
+                                     2 * radius - k);
+     }
+}
+
+/* Computes the output rows [y1, y2), reading the source row by row (instead
+ * of column by column). Requires h > 2 * radius. */
+static void
+_gaussian_blur_vert_alpha_sse3(const DATA8* restrict src, DATA8* restrict dst,
+                               const int radius, const int w, const int h,
+                               const int y1, const int y2,
+                               const int* restrict weights,
+                               const __m128i* restrict pairs,
+                               const int pow2_divider)
+{
+   const int diameter = 2 * radius + 1;
+   int x, y;
+
+   for (y = y1; y < y2; y++)
+     {
+        DATA8* restrict d = dst + y * w;
+
+        if (y < radius)
+          {
+             for (x = 0; x < w; x++)
+               _gaussian_alpha_edge_pixel(src + x, d + x, w, weights + radius - y,
+                                          y + radius + 1);
+          }
+        else if (y >= h - radius)
+          {
+             const int k = y - (h - radius);
+             const DATA8* restrict s = src + (h - 2 * radius + k) * w;
+
+             for (x = 0; x < w; x++)
+               _gaussian_alpha_edge_pixel(s + x, d + x, w, weights,
+                                          2 * radius - k);
+          }
+        else
+          _gaussian_alpha_span_sse3(src + (y - radius) * w, d, w, w,
+                                    pairs, diameter, weights, pow2_divider);
+     }
+}
+
+#endif
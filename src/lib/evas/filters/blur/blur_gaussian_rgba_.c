@@ -1,19 +1,22 @@
 /* @file blur_gaussian_rgba_.c
  * Should define the functions:
- * - _gaussian_blur_horiz_rgba_step
- * - _gaussian_blur_vert_rgba_step
+ * - _gaussian_blur_rgba_step
+ *
+ * The same function runs both passes: step is the distance between two
+ * consecutive samples (1 for rows, the image width for columns) and loopstep
+ * the distance between two consecutive rows (resp. columns).
  */
 
 #include "../evas_filter_private.h"
 
-#if !defined (FUNCTION_NAME) || !defined (STEP)
-# error Must define FUNCTION_NAME and STEP
+#if !defined (FUNCTION_NAME)
+# error Must define FUNCTION_NAME
 #endif
 
 static inline void
 FUNCTION_NAME(const DATA32* restrict srcdata, DATA32* restrict dstdata,
               const int radius, const int len,
-              const int loops, const int loopstep,
+              const int loops, const int loopstep, const int step,
               const int* restrict weights, const int pow2_divider)
 {
    const int diameter = 2 * radius + 1;
@@ -29,12 +32,12 @@ FUNCTION_NAME(const DATA32* restrict srcdata, DATA32* restrict dstdata,
         dst = dstdata;
 
         // left
-        for (k = 0; k < left; k++, dst += STEP)
+        for (k = 0; k < left; k++, dst += step)
           {
              int acc[4] = {0};
              int divider = 0;
              const DATA32* restrict s = src;
-             for (j = 0; j <= k + radius; j++, s += STEP)
+             for (j = 0; j <= k + radius; j++, s += step)
                {
                   const int weightidx = j + radius - k;
                   acc[ALPHA] += A_VAL(s) * weights[weightidx];
@@ -51,11 +54,11 @@ FUNCTION_NAME(const DATA32* restrict srcdata, DATA32* restrict dstdata,
           }
 
         // middle
-        for (k = len - (2 * radius); k > 0; k--, src += STEP, dst += STEP)
+        for (k = len - (2 * radius); k > 0; k--, src += step, dst += step)
           {
              int acc[4] = {0};
              const DATA32* restrict s = src;
-             for (j = 0; j < diameter; j++, s += STEP)
+             for (j = 0; j < diameter; j++, s += step)
                {
                   acc[ALPHA] += A_VAL(s) * weights[j];
                   acc[RED]   += R_VAL(s) * weights[j];
@@ -69,12 +72,12 @@ FUNCTION_NAME(const DATA32* restrict srcdata, DATA32* restrict dstdata,
           }
 
         // right
-        for (k = 0; k < right; k++, dst += STEP, src += STEP)
+        for (k = 0; k < right; k++, dst += step, src += step)
           {
              int acc[4] = {0};
              int divider = 0;
              const DATA32* restrict s = src;
-             for (j = 0; j < 2 * radius - k; j++, s += STEP)
+             for (j = 0; j < 2 * radius - k; j++, s += step)
                {
                   acc[ALPHA] += A_VAL(s) * weights[j];
                   acc[RED]   += R_VAL(s) * weights[j];
@@ -100,4 +103,3 @@ error:
 }
 
 #undef FUNCTION_NAME
-#undef STEP
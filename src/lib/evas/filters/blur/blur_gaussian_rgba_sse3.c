@@ -0,0 +1,172 @@
+/* @file blur_gaussian_rgba_sse3.c
+ * Should define the functions:
+ * - _gaussian_blur_horiz_rgba_sse3
+ * - _gaussian_blur_vert_rgba_sse3
+ *
+ * Only SSE2 instructions are used, as this file is not built with -msse3.
+ */
+
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+
+#include <emmintrin.h>
+
+/* Border pixel: weighted average over the taps inside the image */
+static inline void
+_gaussian_rgba_edge_pixel(const DATA32* restrict s, DATA32* restrict dst,
+                          const int step, const int* restrict weights,
+                          const int count)
+{
+   int acc[4] = {0};
+   int divider = 0;
+   int j;
+
+   for (j = 0; j < count; j++, s += step)
+     {
+        acc[ALPHA] += A_VAL(s) * weights[j];
+        acc[RED]   += R_VAL(s) * weights[j];
+        acc[GREEN] += G_VAL(s) * weights[j];
+        acc[BLUE]  += B_VAL(s) * weights[j];
+        divider += weights[j];
+     }
+   if (!divider)
+     {
+        CRI("Avoided division by 0.");
+        return;
+     }
+   A_VAL(dst) = acc[ALPHA] / divider;
+   R_VAL(dst) = acc[RED]   / divider;
+   G_VAL(dst) = acc[GREEN] / divider;
+   B_VAL(dst) = acc[BLUE]  / divider;
+}
+
+/* Computes count consecutive pixels, tap j of pixel x being s[x + j * step].
+ * Four pixels are done at once. Taps are taken two by two: interleaving the
+ * bytes of both source vectors lets madd compute a * w[j] + b * w[j+1] per
+ * channel. The diameter is odd, so the last tap is paired with zeroes.
+ */
+static inline void
+_gaussian_rgba_span_sse3(const DATA32* restrict src, DATA32* restrict dst,
+                         const int count, const int step,
+                         const __m128i* restrict pairs, const int diameter,
+                         const int* restrict weights, const int pow2_divider)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i shift = _mm_cvtsi32_si128(pow2_divider);
+   int x, j;
+
+   for (x = 0; x + 4 <= count; x += 4)
+     {
+        __m128i acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+        const DATA32* restrict s = src + x;
+
+        for (j = 0; j < diameter; j += 2, s += 2 * step)
+          {
+             const __m128i w = pairs[j >> 1];
+             const __m128i a = _mm_loadu_si128((const __m128i *) s);
+             const __m128i b = (j + 1 < diameter) ?
+                _mm_loadu_si128((const __m128i *) (s + step)) : zero;
+             const __m128i lo = _mm_unpacklo_epi8(a, b);
+             const __m128i hi = _mm_unpackhi_epi8(a, b);
+
+             acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+             acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+             acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+             acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+          }
+
+        acc0 = _mm_srl_epi32(acc0, shift);
+        acc1 = _mm_srl_epi32(acc1, shift);
+        acc2 = _mm_srl_epi32(acc2, shift);
+        acc3 = _mm_srl_epi32(acc3, shift);
+        _mm_storeu_si128((__m128i *) (dst + x),
+                         _mm_packus_epi16(_mm_packs_epi32(acc0, acc1),
+                                          _mm_packs_epi32(acc2, acc3)));
+     }
+
+   // leftovers
+   for (; x < count; x++)
+     {
+        int acc[4] = {0};
+        const DATA32* restrict s = src + x;
+        DATA32* restrict d = dst + x;
+
+        for (j = 0; j < diameter; j++, s += step)
+          {
+             acc[ALPHA] += A_VAL(s) * weights[j];
+             acc[RED]   += R_VAL(s) * weights[j];
+             acc[GREEN] += G_VAL(s) * weights[j];
+             acc[BLUE]  += B_VAL(s) * weights[j];
+          }
+        A_VAL(d) = acc[ALPHA] >> pow2_divider;
+        R_VAL(d) = acc[RED]   >> pow2_divider;
+        G_VAL(d) = acc[GREEN] >> pow2_divider;
+        B_VAL(d) = acc[BLUE]  >> pow2_divider;
+     }
+}
+
+/* Rows are independent. Requires len > 2 * radius. */
+static void
+_gaussian_blur_horiz_rgba_sse3(const DATA32* restrict src, DATA32* restrict dst,
+                               const int radius, const int len, const int loops,
+                               const int* restrict weights,
+                               const __m128i* restrict pairs,
+                               const int pow2_divider)
+{
+   const int diameter = 2 * radius + 1;
+   int i, k;
+
+   for (i = loops; i; --i, src += len, dst += len)
+     {
+        for (k = 0; k < radius; k++)
+          _gaussian_rgba_edge_pixel(src, dst + k, 1, weights + radius - k,
+                                    k + radius + 1);
+
+        _gaussian_rgba_span_sse3(src, dst + radius, len - 2 * radius, 1,
+                                 pairs, diameter, weights, pow2_divider);
+
+        for (k = 0; k < radius; k++)
+          _gaussian_rgba_edge_pixel(src + len - 2 * radius + k,
+                                    dst + len - radius + k, 1, weights,
+                                    2 * radius - k);
+     }
+}
+
+/* Computes the output rows [y1, y2), reading the source row by row (instead
+ * of column by column). Requires h > 2 * radius. */
+static void
+_gaussian_blur_vert_rgba_sse3(const DATA32* restrict src, DATA32* restrict dst,
+                              const int radius, const int w, const int h,
+                              const int y1, const int y2,
+                              const int* restrict weights,
+                              const __m128i* restrict pairs,
+                              const int pow2_divider)
+{
+   const int diameter = 2 * radius + 1;
+   int x, y;
+
+   for (y = y1; y < y2; y++)
+     {
+        DATA32* restrict d = dst + y * w;
+
+        if (y < radius)
+          {
+             for (x = 0; x < w; x++)
+               _gaussian_rgba_edge_pixel(src + x, d + x, w, weights + radius - y,
+                                         y + radius + 1);
+          }
+        else if (y >= h - radius)
+          {
+             const int k = y - (h - radius);
+             const DATA32* restrict s = src + (h - 2 * radius + k) * w;
+
+             for (x = 0; x < w; x++)
+               _gaussian_rgba_edge_pixel(s + x, d + x, w, weights,
+                                         2 * radius - k);
+          }
+        else
+          _gaussian_rgba_span_sse3(src + (y - radius) * w, d, w, w,
+                                   pairs, diameter, weights, pow2_divider);
+     }
+}
+
+#endif
@@ -354,13 +354,137 @@ _rgba_image_alloc(Evas_Filter_Buffer const *fb, void *data)
    return image;
 }
 
+/* Scratch buffers are only used while their command runs, through
+ * evas_filter_buffer_scaled_get(), and the commands using them never run at
+ * the same time. So one buffer of each size is enough for the whole chain,
+ * unless a single command needs two of them. */
+static Evas_Filter_Buffer *
+_scratch_buffer_get(Evas_Filter_Context *ctx, Eina_List **used,
+                    unsigned w, unsigned h, Eina_Bool alpha_only)
+{
+   Evas_Filter_Buffer *fb;
+   Eina_List *li;
+
+   EINA_LIST_FOREACH(ctx->buffers, li, fb)
+     {
+        if (!fb->scratch || (fb->alpha_only != alpha_only)) continue;
+        if ((fb->w != (int) w) || (fb->h != (int) h)) continue;
+        if (eina_list_data_find(*used, fb)) continue;
+        goto found;
+     }
+
+   //DBG("Allocating temporary buffer of size %ux%u", w, h);
+   fb = evas_filter_buffer_alloc_new(ctx, w, h, alpha_only);
+   if (!fb) return NULL;
+   fb->transient = EINA_TRUE;
+   fb->scratch = EINA_TRUE;
+
+found:
+   *used = eina_list_append(*used, fb);
+   return fb;
+}
+
+typedef struct _Buffer_Lifetime Buffer_Lifetime;
+struct _Buffer_Lifetime
+{
+   Evas_Filter_Buffer *fb;
+   Evas_Filter_Buffer *owner; // owner of the backing, NULL if fb has its own
+   int first, last; // first and last commands using this buffer
+};
+
+static int
+_buffer_lifetime_cmp(const void *a, const void *b)
+{
+   const Buffer_Lifetime *la = a, *lb = b;
+
+   return la->first - lb->first;
+}
+
+static Eina_Bool
+_buffer_shareable(const Evas_Filter_Context *ctx, const Evas_Filter_Buffer *fb)
+{
+   if (fb->backing || fb->glimage || fb->source || fb->scratch)
+     return EINA_FALSE;
+   if ((fb->id == EVAS_FILTER_BUFFER_INPUT_ID) ||
+       (fb->id == EVAS_FILTER_BUFFER_OUTPUT_ID) ||
+       (fb->id == ctx->target.bufid))
+     return EINA_FALSE;
+   return (fb->w > 0) && (fb->h > 0);
+}
+
+/* Intermediate buffers that are never alive at the same time can use the
+ * same pixels. Walk them by order of first use, and give each one the backing
+ * of a dead buffer of the same size and type, if there is one. The buffers
+ * then sharing a backing get marked with backing_owner. */
+static void
+_buffers_share(Evas_Filter_Context *ctx)
+{
+   Evas_Filter_Command *cmd;
+   Evas_Filter_Buffer *fb;
+   Buffer_Lifetime *lt;
+   Eina_List *li;
+   int count, n = 0, i, j, k = 0;
+
+   count = eina_list_count(ctx->buffers);
+   if (count < 2) return;
+
+   lt = calloc(count, sizeof(Buffer_Lifetime));
+   if (!lt) return;
+
+   EINA_LIST_FOREACH(ctx->buffers, li, fb)
+     {
+        if (!_buffer_shareable(ctx, fb)) continue;
+        lt[n].fb = fb;
+        lt[n].first = -1;
+        n++;
+     }
+
+   EINA_INLIST_FOREACH(ctx->commands, cmd)
+     {
+        for (i = 0; i < n; i++)
+          {
+             fb = lt[i].fb;
+             if ((fb != cmd->input) && (fb != cmd->mask) && (fb != cmd->output))
+               continue;
+             if (lt[i].first < 0) lt[i].first = k;
+             lt[i].last = k;
+          }
+        k++;
+     }
+
+   qsort(lt, n, sizeof(Buffer_Lifetime), _buffer_lifetime_cmp);
+
+   for (i = 0; i < n; i++)
+     {
+        if (lt[i].first < 0) continue;
+        for (j = 0; j < i; j++)
+          {
+             // lt[j] has its own backing, possibly reused since
+             if (lt[j].owner || (lt[j].first < 0)) continue;
+             if (lt[j].last >= lt[i].first) continue;
+             if ((lt[j].fb->alpha_only != lt[i].fb->alpha_only) ||
+                 (lt[j].fb->w != lt[i].fb->w) || (lt[j].fb->h != lt[i].fb->h))
+               continue;
+
+             lt[i].owner = lt[j].fb;
+             lt[j].last = lt[i].last;
+             lt[i].fb->backing_owner = lt[j].fb;
+             DBG("Buffer %d reuses the backing of buffer %d",
+                 lt[i].fb->id, lt[j].fb->id);
+             break;
+          }
+     }
+
+   free(lt);
+}
+
 Eina_Bool
 evas_filter_context_buffers_allocate_all(Evas_Filter_Context *ctx,
                                          unsigned w, unsigned h)
 {
    Evas_Filter_Command *cmd;
    Evas_Filter_Buffer *fb;
-   Eina_List *li;
+   Eina_List *li, *used = NULL;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(ctx, EINA_FALSE);
    ctx->w = w;
@@ -409,10 +533,8 @@ evas_filter_context_buffers_allocate_all(Evas_Filter_Context *ctx,
                   if (fillmode & EVAS_FILTER_FILL_MODE_STRETCH_Y)
                     sh = h;
 
-                  //DBG("Allocating temporary buffer of size %ux%u", sw, sh);
-                  fb = evas_filter_buffer_alloc_new(ctx, sw, sh, in->alpha_only);
+                  fb = _scratch_buffer_get(ctx, &used, sw, sh, in->alpha_only);
                   if (!fb) goto alloc_fail;
-                  fb->transient = EINA_TRUE;
                }
           }
 
@@ -424,12 +546,12 @@ evas_filter_context_buffers_allocate_all(Evas_Filter_Context *ctx,
              if (in->w) sw = in->w;
              if (in->h) sh = in->h;
 
-             //DBG("Allocating temporary buffer of size %ux%u", sw, sh);
-             fb = evas_filter_buffer_alloc_new(ctx, sw, sh, in->alpha_only);
+             fb = _scratch_buffer_get(ctx, &used, sw, sh, in->alpha_only);
              if (!fb) goto alloc_fail;
-             fb->transient = EINA_TRUE;
           }
 
+        used = eina_list_free(used);
+
         out = cmd->output;
         if (!out->w && !out->h)
           {
@@ -438,6 +560,9 @@ evas_filter_context_buffers_allocate_all(Evas_Filter_Context *ctx,
           }
      }
 
+   if (!ctx->gl_engine)
+     _buffers_share(ctx);
+
    EINA_LIST_FOREACH(ctx->buffers, li, fb)
      {
         RGBA_Image *im;
@@ -458,6 +583,9 @@ evas_filter_context_buffers_allocate_all(Evas_Filter_Context *ctx,
         if (fb->glimage)
           continue;
 
+        if (fb->backing_owner)
+          continue;
+
         if (!fb->w && !fb->h)
           {
              ERR("Size of buffer %d should be known at this point. Is this a dangling buffer?", fb->id);
@@ -474,9 +602,18 @@ evas_filter_context_buffers_allocate_all(Evas_Filter_Context *ctx,
           evas_unref_queue_image_put(ctx->evas, &im->cache_entry);
      }
 
+   EINA_LIST_FOREACH(ctx->buffers, li, fb)
+     {
+        if (!fb->backing_owner || fb->backing) continue;
+        fb->backing = fb->backing_owner->backing;
+        fb->allocated = EINA_FALSE;
+        fb->clear = EINA_TRUE;
+     }
+
    return EINA_TRUE;
 
 alloc_fail:
+   eina_list_free(used);
    ERR("Buffer allocation failed! Context size: %dx%d", w, h);
    return EINA_FALSE;
 }
@@ -741,6 +878,18 @@ evas_filter_temporary_buffer_get(Evas_Filter_Context *ctx, int w, int h,
    Evas_Filter_Buffer *buf = NULL;
    Eina_List *l;
 
+   // While running, prefer scratch buffers: they hold no intermediate result
+   if (ctx->running)
+     EINA_LIST_FOREACH(ctx->buffers, l, buf)
+       {
+          if (buf->scratch && !buf->locked && (buf->alpha_only == alpha_only)
+              && (!w || (w == buf->w)) && (!h || (h == buf->h)))
+            {
+               buf->locked = EINA_TRUE;
+               return buf;
+            }
+       }
+
    EINA_LIST_FOREACH(ctx->buffers, l, buf)
      {
         if (buf->transient && !buf->locked && (buf->alpha_only == alpha_only))
@@ -1910,6 +2059,152 @@ _filter_command_run(Evas_Filter_Command *cmd)
    return func(cmd);
 }
 
+/* A buffer sharing the backing of a dead buffer must look brand new to its
+ * first user. Called before running cmd, from the thread running the chain. */
+static void
+_filter_command_buffers_prepare(Evas_Filter_Command *cmd)
+{
+   Evas_Filter_Buffer *fbs[3] = { cmd->input, cmd->mask, cmd->output };
+   RGBA_Image *im;
+   int k;
+
+   for (k = 0; k < 3; k++)
+     {
+        if (!fbs[k] || !fbs[k]->clear) continue;
+        fbs[k]->clear = EINA_FALSE;
+        im = fbs[k]->backing;
+        if (!im || !im->image.data) continue;
+        memset(im->image.data, 0, im->cache_entry.w * im->cache_entry.h
+               * (fbs[k]->alpha_only ? sizeof(DATA8) : sizeof(DATA32)));
+     }
+}
+
+/* Commands calling back into the engine (RGBA blending, masking) or using
+ * scratch buffers must run alone. */
+static Eina_Bool
+_filter_command_concurrent(const Evas_Filter_Command *cmd)
+{
+   if (cmd->draw.need_temp_buffer ||
+       (cmd->draw.fillmode & EVAS_FILTER_FILL_MODE_STRETCH_XY))
+     return EINA_FALSE;
+
+   switch (cmd->mode)
+     {
+      case EVAS_FILTER_MODE_BLEND:
+        return (cmd->input->alpha_only || cmd->output->alpha_only);
+      case EVAS_FILTER_MODE_MASK:
+        return EINA_FALSE;
+      default:
+        return EINA_TRUE;
+     }
+}
+
+/* Whether after must wait for before: read after write, write after write
+ * and write after read. Compares the backings, as buffers may share them. */
+static Eina_Bool
+_filter_command_depends(const Evas_Filter_Command *before,
+                        const Evas_Filter_Command *after)
+{
+   const RGBA_Image *out = before->output->backing;
+
+   if ((after->input->backing == out) || (after->output->backing == out) ||
+       (after->mask && (after->mask->backing == out)))
+     return EINA_TRUE;
+
+   if ((after->output->backing == before->input->backing) ||
+       (before->mask && (after->output->backing == before->mask->backing)))
+     return EINA_TRUE;
+
+   return EINA_FALSE;
+}
+
+typedef struct _Evas_Filter_Batch Evas_Filter_Batch;
+struct _Evas_Filter_Batch
+{
+   Evas_Filter_Command **cmds;
+   Eina_Bool *ok;
+};
+
+static void
+_filter_batch_run_cb(void *data, int start, int end)
+{
+   Evas_Filter_Batch *batch = data;
+   int i;
+
+   for (i = start; i < end; i++)
+     batch->ok[i] = _filter_command_run(batch->cmds[i]);
+}
+
+/* Runs the commands as a dependency graph. Each command is given a level
+ * higher than the levels of the commands it depends on, and the commands of a
+ * level run at the same time on the evas worker pool. */
+static Eina_Bool
+_filter_chain_parallel_run(Evas_Filter_Context *ctx)
+{
+   Evas_Filter_Command **cmds = NULL, *cmd;
+   Evas_Filter_Batch batch = { NULL, NULL };
+   int *levels = NULL;
+   int count, i, j, k, level, min_level = 0, max = -1;
+   Eina_Bool ok = EINA_FALSE;
+
+   count = eina_inlist_count(ctx->commands);
+   cmds = malloc(count * sizeof(Evas_Filter_Command *));
+   levels = malloc(count * sizeof(int));
+   batch.cmds = malloc(count * sizeof(Evas_Filter_Command *));
+   batch.ok = malloc(count * sizeof(Eina_Bool));
+   if (!cmds || !levels || !batch.cmds || !batch.ok) goto end;
+
+   i = 0;
+   EINA_INLIST_FOREACH(ctx->commands, cmd)
+     {
+        level = min_level;
+        for (j = 0; j < i; j++)
+          {
+             if ((levels[j] >= level) && _filter_command_depends(cmds[j], cmd))
+               level = levels[j] + 1;
+          }
+        if (!_filter_command_concurrent(cmd))
+          {
+             // Alone in its level, after all the previous commands
+             level = max + 1;
+             min_level = level + 1;
+          }
+        cmds[i] = cmd;
+        levels[i] = level;
+        if (level > max) max = level;
+        i++;
+     }
+
+   ok = EINA_TRUE;
+   for (level = 0; ok && (level <= max); level++)
+     {
+        k = 0;
+        for (i = 0; i < count; i++)
+          {
+             if (levels[i] != level) continue;
+             _filter_command_buffers_prepare(cmds[i]);
+             batch.cmds[k++] = cmds[i];
+          }
+
+        if (k == 1)
+          ok = _filter_command_run(batch.cmds[0]);
+        else if (k > 1)
+          {
+             DBG("Running %d filter commands in parallel", k);
+             evas_thread_parallel_run(k, 1, _filter_batch_run_cb, &batch);
+             for (i = 0; i < k; i++)
+               ok &= batch.ok[i];
+          }
+     }
+
+end:
+   free(cmds);
+   free(levels);
+   free(batch.cmds);
+   free(batch.ok);
+   return ok;
+}
+
 static Eina_Bool
 _filter_chain_run(Evas_Filter_Context *ctx)
 {
@@ -1920,15 +2215,28 @@ _filter_chain_run(Evas_Filter_Context *ctx)
    DEBUG_TIME_BEGIN();
 
    ctx->running = EINA_TRUE;
-   EINA_INLIST_FOREACH(ctx->commands, cmd)
+   if (ctx->async && !ctx->gl_engine)
      {
-        ok = _filter_command_run(cmd);
+        ok = _filter_chain_parallel_run(ctx);
         if (!ok)
           {
              ERR("Filter processing failed!");
              goto end;
           }
      }
+   else
+     {
+        EINA_INLIST_FOREACH(ctx->commands, cmd)
+          {
+             _filter_command_buffers_prepare(cmd);
+             ok = _filter_command_run(cmd);
+             if (!ok)
+               {
+                  ERR("Filter processing failed!");
+                  goto end;
+               }
+          }
+     }
 
    ok = _filter_target_render(ctx);
 
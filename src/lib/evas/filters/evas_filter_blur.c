@@ -338,76 +338,189 @@ _sin_blur_weights_get(int *weights, int *pow2_divider, int radius)
      *pow2_divider = nextpow2;
 }
 
-#define FUNCTION_NAME _gaussian_blur_horiz_alpha_step
-#define STEP 1
+#define FUNCTION_NAME _gaussian_blur_alpha_step
 #include "./blur/blur_gaussian_alpha_.c"
+#ifdef BUILD_SSE3
+#include "./blur/blur_gaussian_alpha_sse3.c"
+#endif
+
+#define FUNCTION_NAME _gaussian_blur_rgba_step
+#include "./blur/blur_gaussian_rgba_.c"
+#ifdef BUILD_SSE3
+#include "./blur/blur_gaussian_rgba_sse3.c"
+#endif
+
+#if defined(BUILD_SSE3) && defined(__SSE2__)
+# define GAUSSIAN_BLUR_SSE 1
+#endif
+
+// Minimum number of multiply-adds in a slice of work given to a thread
+#define GAUSSIAN_BLUR_SLICE_OPS (1 << 16)
+
+/* A gaussian blur pass is split in slices of rows (horizontal pass) or
+ * columns (vertical pass), run in parallel by the evas worker pool.
+ * The vectorized vertical pass reads the image row by row, so it is sliced
+ * in rows as well.
+ */
+typedef struct _Gaussian_Blur_Pass Gaussian_Blur_Pass;
+struct _Gaussian_Blur_Pass
+{
+   const void *src;
+   void       *dst;
+   const int  *weights;
+   const void *pairs; // weights as SSE vectors, NULL for the C version
+   int         radius;
+   int         pow2_div;
+   int         w, h;
+   Eina_Bool   vert : 1;
+};
 
 static void
-_gaussian_blur_horiz_alpha(const DATA8 *src, DATA8 *dst, int radius, int w, int h)
+_gaussian_blur_alpha_slice(void *data, int start, int end)
 {
-   int *weights;
-   int pow2_div = 0;
+   const Gaussian_Blur_Pass *p = data;
+   const DATA8 *src = p->src;
+   DATA8 *dst = p->dst;
 
-   weights = alloca((2 * radius + 1) * sizeof(int));
-   _sin_blur_weights_get(weights, &pow2_div, radius);
+#ifdef GAUSSIAN_BLUR_SSE
+   if (p->pairs)
+     {
+        if (!p->vert)
+          _gaussian_blur_horiz_alpha_sse3(src + start * p->w, dst + start * p->w,
+                                          p->radius, p->w, end - start,
+                                          p->weights, p->pairs, p->pow2_div);
+        else
+          _gaussian_blur_vert_alpha_sse3(src, dst, p->radius, p->w, p->h,
+                                         start, end,
+                                         p->weights, p->pairs, p->pow2_div);
+        return;
+     }
+#endif
 
-   DEBUG_TIME_BEGIN();
-   _gaussian_blur_horiz_alpha_step(src, dst, radius, w, h, w, weights, pow2_div);
-   DEBUG_TIME_END();
+   if (!p->vert)
+     _gaussian_blur_alpha_step(src + start * p->w, dst + start * p->w,
+                               p->radius, p->w, end - start, p->w, 1,
+                               p->weights, p->pow2_div);
+   else
+     _gaussian_blur_alpha_step(src + start, dst + start,
+                               p->radius, p->h, end - start, 1, p->w,
+                               p->weights, p->pow2_div);
 }
 
-// Step size is w (row by row), loops = w, so STEP = 'loops'
-#define FUNCTION_NAME _gaussian_blur_vert_alpha_step
-#define STEP loops
-#include "./blur/blur_gaussian_alpha_.c"
+static void
+_gaussian_blur_rgba_slice(void *data, int start, int end)
+{
+   const Gaussian_Blur_Pass *p = data;
+   const DATA32 *src = p->src;
+   DATA32 *dst = p->dst;
+
+#ifdef GAUSSIAN_BLUR_SSE
+   if (p->pairs)
+     {
+        if (!p->vert)
+          _gaussian_blur_horiz_rgba_sse3(src + start * p->w, dst + start * p->w,
+                                         p->radius, p->w, end - start,
+                                         p->weights, p->pairs, p->pow2_div);
+        else
+          _gaussian_blur_vert_rgba_sse3(src, dst, p->radius, p->w, p->h,
+                                        start, end,
+                                        p->weights, p->pairs, p->pow2_div);
+        return;
+     }
+#endif
+
+   if (!p->vert)
+     _gaussian_blur_rgba_step(src + start * p->w, dst + start * p->w,
+                              p->radius, p->w, end - start, p->w, 1,
+                              p->weights, p->pow2_div);
+   else
+     _gaussian_blur_rgba_step(src + start, dst + start,
+                              p->radius, p->h, end - start, 1, p->w,
+                              p->weights, p->pow2_div);
+}
 
 static void
-_gaussian_blur_vert_alpha(const DATA8 *src, DATA8 *dst, int radius, int w, int h)
+_gaussian_blur_pass_run(Gaussian_Blur_Pass *p, Evas_Thread_Parallel_Cb cb)
 {
-   int *weights;
-   int pow2_div = 0;
+   const int diameter = 2 * p->radius + 1;
+   int weights[diameter];
+   int len, count;
+#ifdef GAUSSIAN_BLUR_SSE
+   __m128i pairs[(diameter + 1) / 2];
+#endif
 
-   weights = alloca((2 * radius + 1) * sizeof(int));
-   _sin_blur_weights_get(weights, &pow2_div, radius);
+   _sin_blur_weights_get(weights, &p->pow2_div, p->radius);
+   p->weights = weights;
+   p->pairs = NULL;
+
+#ifdef GAUSSIAN_BLUR_SSE
+   // The weights fit in 16 bits, so two taps fit in one madd operand
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3) &&
+       ((p->vert ? p->h : p->w) > 2 * p->radius))
+     {
+        int k;
+
+        for (k = 0; k < diameter; k += 2)
+          {
+             const int next = (k + 1 < diameter) ? weights[k + 1] : 0;
+             pairs[k >> 1] = _mm_set1_epi32((next << 16) | weights[k]);
+          }
+        p->pairs = pairs;
+     }
+#endif
+
+   if (p->vert && !p->pairs)
+     {
+        len = p->h;
+        count = p->w;
+     }
+   else
+     {
+        len = p->w;
+        count = p->h;
+     }
+
+   evas_thread_parallel_run(count, 1 + GAUSSIAN_BLUR_SLICE_OPS / (len * diameter),
+                            cb, p);
+}
+
+static void
+_gaussian_blur_horiz_alpha(const DATA8 *src, DATA8 *dst, int radius, int w, int h)
+{
+   Gaussian_Blur_Pass p = { src, dst, NULL, NULL, radius, 0, w, h, EINA_FALSE };
 
    DEBUG_TIME_BEGIN();
-   _gaussian_blur_vert_alpha_step(src, dst, radius, h, w, 1, weights, pow2_div);
+   _gaussian_blur_pass_run(&p, _gaussian_blur_alpha_slice);
    DEBUG_TIME_END();
 }
 
-#define FUNCTION_NAME _gaussian_blur_horiz_rgba_step
-#define STEP 1
-#include "./blur/blur_gaussian_rgba_.c"
+static void
+_gaussian_blur_vert_alpha(const DATA8 *src, DATA8 *dst, int radius, int w, int h)
+{
+   Gaussian_Blur_Pass p = { src, dst, NULL, NULL, radius, 0, w, h, EINA_TRUE };
+
+   DEBUG_TIME_BEGIN();
+   _gaussian_blur_pass_run(&p, _gaussian_blur_alpha_slice);
+   DEBUG_TIME_END();
+}
 
 static void
 _gaussian_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
 {
-   int *weights;
-   int pow2_div = 0;
-
-   weights = alloca((2 * radius + 1) * sizeof(int));
-   _sin_blur_weights_get(weights, &pow2_div, radius);
+   Gaussian_Blur_Pass p = { src, dst, NULL, NULL, radius, 0, w, h, EINA_FALSE };
 
    DEBUG_TIME_BEGIN();
-   _gaussian_blur_horiz_rgba_step(src, dst, radius, w, h, w, weights, pow2_div);
+   _gaussian_blur_pass_run(&p, _gaussian_blur_rgba_slice);
    DEBUG_TIME_END();
 }
 
-#define FUNCTION_NAME _gaussian_blur_vert_rgba_step
-#define STEP loops
-#include "./blur/blur_gaussian_rgba_.c"
-
 static void
 _gaussian_blur_vert_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
 {
-   int *weights;
-   int pow2_div = 0;
-
-   weights = alloca((2 * radius + 1) * sizeof(int));
-   _sin_blur_weights_get(weights, &pow2_div, radius);
+   Gaussian_Blur_Pass p = { src, dst, NULL, NULL, radius, 0, w, h, EINA_TRUE };
 
    DEBUG_TIME_BEGIN();
-   _gaussian_blur_vert_rgba_step(src, dst, radius, h, w, 1, weights, pow2_div);
+   _gaussian_blur_pass_run(&p, _gaussian_blur_rgba_slice);
    DEBUG_TIME_END();
 }
 
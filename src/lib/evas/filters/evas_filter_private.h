@@ -209,6 +209,10 @@ struct _Evas_Filter_Buffer
    Eina_Bool stolen : 1;      // stolen by the client
    Eina_Bool delete_me : 1;   // request delete asap (after released by client)
    Eina_Bool dirty : 1;       // Marked as dirty as soon as a command writes to it
+   Eina_Bool scratch : 1;     // temporary buffer for a single command (stretch, mask)
+   Eina_Bool clear : 1;       // reused backing, needs clearing before first use
+
+   Evas_Filter_Buffer *backing_owner; // shares the backing of this buffer (dead by now)
 };
 
 enum _Evas_Filter_Interpolation_Mode
@@ -448,6 +448,7 @@ typedef void (*Evas_Engine_Thread_Task_Cb)(void *engine_data, Image_Entry *ie, v
 
 typedef void (*Evas_Thread_Command_Cb)(void *data);
 typedef struct _Evas_Thread_Command Evas_Thread_Command;
+typedef void (*Evas_Thread_Parallel_Cb)(void *data, int start, int end);
 
 struct _Evas_Thread_Command
 {
@@ -542,6 +543,7 @@ struct _Image_Entry_Flags
 
    Eina_Bool updated_data  : 1;
    Eina_Bool flipped       : 1;
+   Eina_Bool lru_headers   : 1;
 };
 
 struct _Image_Entry_Frame
@@ -557,6 +559,7 @@ struct _Evas_Cache_Target
   EINA_INLIST;
   const Eo *target;
   void *data;
+  Evas_Image_Preload_Priority priority;
 };
 
 struct _Image_Timestamp
@@ -598,6 +601,11 @@ struct _Image_Entry
 
    int                    references;
 
+   Evas_Cache_Image_Tag  *cache_tag;
+   int                    cache_usage; // bytes charged to the cache while inactive
+   unsigned int           lru_stamp;
+   int                    pins; // users asking to keep the pixels, each holds a reference
+
 #ifdef BUILD_PIPE_RENDER
    RGBA_Pipe             *pipe;
 #endif
@@ -1016,6 +1024,7 @@ struct _RGBA_Font_Glyph_Out
 
 struct _RGBA_Font_Glyph
 {
+   EINA_INLIST; /* glyph cache LRU, while no glyph array holds it */
    FT_UInt         index;
    Evas_Coord      width;
    Evas_Coord      x_bear;
@@ -1026,6 +1035,8 @@ struct _RGBA_Font_Glyph
    void           *ext_dat;
    void           (*ext_dat_free) (void *ext_dat);
    RGBA_Font_Int   *fi;
+   int              references; /* glyph arrays drawing it */
+   int              usage; /* rendered size counted in the glyph cache */
 };
 
 struct _RGBA_Gfx_Compositor
@@ -1301,6 +1312,7 @@ void              evas_thread_init(void);
 void              evas_thread_shutdown(void);
 EAPI void         evas_thread_cmd_enqueue(Evas_Thread_Command_Cb cb, void *data);
 EAPI void         evas_thread_queue_flush(Evas_Thread_Command_Cb cb, void *data);
+void              evas_thread_parallel_run(int count, int min_chunk, Evas_Thread_Parallel_Cb cb, void *data);
 
 typedef enum _Evas_Render_Mode
 {
@@ -66,6 +66,8 @@ typedef struct _Evas_3D_Node_Mesh             Evas_3D_Node_Mesh;
 typedef struct _Evas_3D_Object_Func           Evas_3D_Object_Func;
 typedef struct _Evas_3D_Pick_Data             Evas_3D_Pick_Data;
 typedef struct _Evas_3D_Interpolate_Vertex_Buffer Evas_3D_Interpolate_Vertex_Buffer;
+typedef struct _Evas_3D_Mesh_Bvh              Evas_3D_Mesh_Bvh;
+typedef struct _Evas_3D_Mesh_Bvh_Node         Evas_3D_Mesh_Bvh_Node;
 
 typedef struct _Evas_3D_Scene            Evas_3D_Scene_Data;
 typedef struct _Evas_3D_Node             Evas_3D_Node_Data;
@@ -325,6 +327,34 @@ struct _Evas_3D_Mesh_Frame
    Evas_3D_Vertex_Buffer   vertices[EVAS_3D_VERTEX_ATTRIB_COUNT];
 };
 
+struct _Evas_3D_Mesh_Bvh_Node
+{
+   Evas_Box3         box;
+   /* Leaf: first triangle and triangle count.
+    * Inner node: index of the right child (the left one follows the node),
+    * count is 0. */
+   int               first;
+   int               count;
+};
+
+/* Bounding volume hierarchy over the triangles of a mesh, in local space.
+ * Refitted when the vertices move, rebuilt when the topology changes. */
+struct _Evas_3D_Mesh_Bvh
+{
+   Evas_3D_Mesh_Bvh_Node *nodes;
+   int                    node_count;
+
+   unsigned int          *triangles; /* 3 vertex indices per triangle */
+   int                    triangle_count;
+
+   Evas_Vec3             *positions; /* at the frame the tree was fitted to */
+   int                    position_count;
+
+   int                    frame;
+   Eina_Bool              refit :1;
+   Eina_Bool              rebuild :1;
+};
+
 struct _Evas_3D_Mesh
 {
    Evas_3D_Shade_Mode      shade_mode;
@@ -358,6 +388,8 @@ struct _Evas_3D_Mesh
 
    double                  color_pick_key;
    Eina_Bool               color_pick_enabled :1;
+
+   Evas_3D_Mesh_Bvh       *bvh;
 };
 
 struct _Evas_3D_Texture
@@ -398,6 +430,10 @@ struct _Evas_3D_Scene_Public_Data
 
    Eina_Hash        *node_mesh_colors;
    Eina_Hash        *colors_node_mesh;
+
+   /* View frustum of the camera, computed on first use while collecting */
+   Evas_Vec4         frustum[6];
+   Eina_Bool         frustum_set :1;
 };
 
 struct _Evas_3D_Pick_Data
@@ -1062,6 +1098,7 @@ struct _Evas_Object_Protected_Data
    Eina_Bool                   child_has_map : 1;
    Eina_Bool                   eo_del_called : 1;
    Eina_Bool                   is_smart : 1;
+   Eina_Bool                   render_cache_valid : 1;
 };
 
 struct _Evas_Data_Node
@@ -1376,6 +1413,10 @@ struct _Evas_Func
    void  (*ector_begin)                  (void *data, void *context, void *surface, int x, int y, Eina_Bool do_async);
    void  (*ector_renderer_draw)          (void *data, void *context, void *surface, Ector_Renderer *r, Eina_Array *clips, Eina_Bool do_async);
    void  (*ector_end)                    (void *data, void *context, void *surface, Eina_Bool do_async);
+
+   Eina_Bool (*image_prescale)           (void *data, void *image, int smooth, int src_x, int src_y, int src_w, int src_h, int dst_w, int dst_h);
+   void  (*image_data_preload_priority_set) (void *data, void *image, const Eo *target, Evas_Image_Preload_Priority priority);
+   void  (*image_cache_hint_set)         (void *data, void *image, unsigned int tag, int pin); // pin: 1 takes a pin, -1 gives it back
 };
 
 struct _Evas_Image_Save_Func
@@ -1442,6 +1483,7 @@ Evas_Object *_evas_object_image_source_get(Evas_Object *obj);
 Eina_Bool _evas_object_image_preloading_get(const Evas_Object *obj);
 void _evas_object_image_preloading_set(Evas_Object *obj, Eina_Bool preloading);
 void _evas_object_image_preloading_check(Evas_Object *obj);
+Evas_Image_Preload_Priority _evas_object_image_preload_priority_get(const Evas_Object *obj);
 Evas_Object *_evas_object_image_video_parent_get(Evas_Object *obj);
 void _evas_object_image_video_overlay_show(Evas_Object *obj);
 void _evas_object_image_video_overlay_hide(Evas_Object *obj);
@@ -1463,6 +1505,9 @@ void evas_call_smarts_calculate(Evas *e);
 void evas_object_smart_bounding_box_update(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj);
 void evas_object_smart_need_bounding_box_update(Evas_Object *obj);
 Eina_Bool evas_object_smart_changed_get(Evas_Object *eo_obj);
+void evas_object_smart_render_cache_invalidate(Evas_Object_Protected_Data *obj);
+Eina_Bool evas_object_smart_render_cache_get(const Evas_Object *eo_obj, int validity, const Eina_Array **active_objects, const Eina_Array **render_objects, const Eina_Inarray **rect_del);
+void evas_object_smart_render_cache_set(Evas_Object *eo_obj, int validity, const Eina_Array *active_objects, unsigned int active_first, const Eina_Array *render_objects, unsigned int render_first);
 void *evas_mem_calloc(int size);
 void _evas_post_event_callback_call(Evas *e, Evas_Public_Data* e_pd);
 void _evas_post_event_callback_free(Evas *e);
@@ -1496,6 +1541,8 @@ int evas_object_intercept_call_clip_unset(Evas_Object *obj, Evas_Object_Protecte
 int evas_object_intercept_call_focus_set(Evas_Object *obj, Evas_Object_Protected_Data *pd, Eina_Bool focus);
 void evas_object_grabs_cleanup(Evas_Object *obj, Evas_Object_Protected_Data *pd);
 void evas_key_grab_free(Evas_Object *obj, Evas_Object_Protected_Data *pd, const char *keyname, Evas_Modifier_Mask modifiers, Evas_Modifier_Mask not_modifiers);
+void evas_font_dir_init(void);
+void evas_font_dir_shutdown(void);
 void evas_font_dir_cache_free(void);
 const char *evas_font_dir_cache_find(char *dir, char *font);
 Eina_List *evas_font_dir_available_list(const Evas* evas);
@@ -1680,6 +1727,7 @@ void evas_3d_light_node_del(Evas_3D_Light *light, Evas_3D_Node *node);
 void evas_3d_mesh_node_add(Evas_3D_Mesh *mesh, Evas_3D_Node *node);
 void evas_3d_mesh_node_del(Evas_3D_Mesh *mesh, Evas_3D_Node *node);
 void evas_3d_mesh_interpolate_vertex_buffer_get(Evas_3D_Mesh *mesh, int frame, Evas_3D_Vertex_Attrib attrib, Evas_3D_Vertex_Buffer *buffer0, Evas_3D_Vertex_Buffer *buffer1, Evas_Real *weight);
+const Evas_3D_Mesh_Bvh *evas_3d_mesh_bvh_get(Evas_3D_Mesh *mesh, int frame);
 void evas_3d_mesh_file_md2_set(Evas_3D_Mesh *mesh, const char *file);
 void evas_3d_mesh_save_obj(Evas_3D_Mesh *mesh, const char *file, Evas_3D_Mesh_Frame *f);
 void evas_3d_mesh_file_obj_set(Evas_3D_Mesh *mesh, const char *file);
@@ -1754,7 +1802,13 @@ Evas_Preload_Pthread *evas_preload_thread_run(void (*func_heavy)(void *data),
                                               void (*func_end)(void *data),
                                               void (*func_cancel)(void *data),
                                               const void *data);
+Evas_Preload_Pthread *evas_preload_thread_priority_run(Evas_Image_Preload_Priority priority,
+                                                       void (*func_heavy)(void *data),
+                                                       void (*func_end)(void *data),
+                                                       void (*func_cancel)(void *data),
+                                                       const void *data);
 Eina_Bool evas_preload_thread_cancel(Evas_Preload_Pthread *thread);
+Eina_Bool evas_preload_thread_priority_set(Evas_Preload_Pthread *thread, Evas_Image_Preload_Priority priority);
 
 void _evas_walk(Evas_Public_Data *e_pd);
 void _evas_unwalk(Evas_Public_Data *e_pd);
@@ -861,6 +861,36 @@ eng_image_data_preload_cancel(void *data EINA_UNUSED, void *image, const Eo *tar
    evas_cache_image_preload_cancel(&im->cache_entry, target);
 }
 
+static void
+eng_image_data_preload_priority_set(void *data EINA_UNUSED, void *image, const Eo *target,
+                                    Evas_Image_Preload_Priority priority)
+{
+   Evas_GL_Image *gim = image;
+   RGBA_Image *im;
+
+   if (!gim) return;
+   if (gim->native.data) return;
+   im = (RGBA_Image *)gim->im;
+   if (!im) return;
+   evas_cache_image_preload_priority_set(&im->cache_entry, target, priority);
+}
+
+static void
+eng_image_cache_hint_set(void *data EINA_UNUSED, void *image,
+                         unsigned int tag, int pin)
+{
+   Evas_GL_Image *gim = image;
+   RGBA_Image *im;
+
+   if (!gim) return;
+   if (gim->native.data) return;
+   im = (RGBA_Image *)gim->im;
+   if (!im) return;
+   evas_cache_image_tag_set(&im->cache_entry, tag);
+   if (pin > 0) evas_cache_image_pin(&im->cache_entry);
+   else if (pin < 0) evas_cache_image_unpin(&im->cache_entry);
+}
+
 static Eina_Bool
 eng_image_draw(void *data, void *context, void *surface, void *image, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y, int dst_w, int dst_h, int smooth, Eina_Bool do_async EINA_UNUSED)
 {
@@ -1391,6 +1421,8 @@ module_open(Evas_Module *em)
    ORD(image_data_put);
    ORD(image_data_preload_request);
    ORD(image_data_preload_cancel);
+   ORD(image_data_preload_priority_set);
+   ORD(image_cache_hint_set);
    ORD(image_alpha_set);
    ORD(image_alpha_get);
    ORD(image_border_set);
@@ -1404,6 +1436,8 @@ module_open(Evas_Module *em)
    //   ORD(image_native_get);
    
    ORD(font_draw);
+   /* the inherited software multi_font_draw can't draw to gl surfaces */
+   func.multi_font_draw = NULL;
    
    ORD(image_scale_hint_set);
    ORD(image_scale_hint_get);
@@ -1424,6 +1458,9 @@ module_open(Evas_Module *em)
 
    ORD(image_load_error_get);    
 
+   /* images are scaled by the GPU, there is no scale cache to fill */
+   func.image_prescale = NULL;
+
 #define LINK2GENERIC(sym) \
    glsym_##sym = dlsym(RTLD_DEFAULT, #sym);
 
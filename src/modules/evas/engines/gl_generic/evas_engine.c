@@ -988,6 +988,46 @@ eng_image_data_preload_cancel(void *data EINA_UNUSED, void *image, const Eo *tar
    evas_gl_preload_target_unregister(gim->tex, (Eo*) target);
 }
 
+static void
+eng_image_data_preload_priority_set(void *data EINA_UNUSED, void *image, const Eo *target,
+                                    Evas_Image_Preload_Priority priority)
+{
+   Evas_GL_Image *gim = image;
+   RGBA_Image *im;
+
+   if (!gim) return;
+   if (gim->native.data) return;
+   im = (RGBA_Image *)gim->im;
+   if (!im) return;
+
+#ifdef EVAS_CSERVE2
+   if (evas_cserve2_use_get() && evas_cache2_image_cached(&im->cache_entry))
+     return;
+#endif
+   evas_cache_image_preload_priority_set(&im->cache_entry, target, priority);
+}
+
+static void
+eng_image_cache_hint_set(void *data EINA_UNUSED, void *image,
+                         unsigned int tag, int pin)
+{
+   Evas_GL_Image *gim = image;
+   RGBA_Image *im;
+
+   if (!gim) return;
+   if (gim->native.data) return;
+   im = (RGBA_Image *)gim->im;
+   if (!im) return;
+
+#ifdef EVAS_CSERVE2
+   if (evas_cserve2_use_get() && evas_cache2_image_cached(&im->cache_entry))
+     return;
+#endif
+   evas_cache_image_tag_set(&im->cache_entry, tag);
+   if (pin > 0) evas_cache_image_pin(&im->cache_entry);
+   else if (pin < 0) evas_cache_image_unpin(&im->cache_entry);
+}
+
 static Eina_Bool
 eng_image_draw(void *data, void *context, void *surface, void *image, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y, int dst_w, int dst_h, int smooth, Eina_Bool do_async EINA_UNUSED)
 {
@@ -1322,45 +1362,71 @@ eng_image_stride_get(void *data EINA_UNUSED, void *image, int *stride)
      }
 }
 
-static Eina_Bool
-eng_font_draw(void *data, void *context, void *surface, Evas_Font_Set *font EINA_UNUSED, int x, int y, int w EINA_UNUSED, int h EINA_UNUSED, int ow EINA_UNUSED, int oh EINA_UNUSED, Evas_Text_Props *intl_props, Eina_Bool do_async EINA_UNUSED)
+static RGBA_Image *
+_font_draw_begin(Render_Engine_GL_Generic *re, void *context, void *surface)
 {
    Evas_Engine_GL_Context *gl_context;
-   Render_Engine_GL_Generic *re = data;
+   // FIXME: put im into context so we can free it
+   static RGBA_Image *im = NULL;
 
    re->window_use(re->software.ob);
    gl_context = re->window_gl_context_get(re->software.ob);
 
    evas_gl_common_context_target_surface_set(gl_context, surface);
    gl_context->dc = context;
-     {
-        // FIXME: put im into context so we can free it
-        static RGBA_Image *im = NULL;
-
-        if (!im)
-          im = (RGBA_Image *)evas_cache_image_empty(evas_common_image_cache_get());
-        im->cache_entry.w = gl_context->shared->w;
-        im->cache_entry.h = gl_context->shared->h;
-
-        evas_common_draw_context_font_ext_set(context,
-                                              gl_context,
-                                              evas_gl_font_texture_new,
-                                              evas_gl_font_texture_free,
-                                              evas_gl_font_texture_draw,
-                                              evas_gl_image_new_from_data,
-                                              evas_gl_image_free,
-                                              evas_gl_image_draw);
-        evas_common_font_draw_prepare(intl_props);
-        evas_common_font_draw(im, context, x, y, intl_props->glyphs);
-        evas_common_draw_context_font_ext_set(context,
-                                              NULL,
-                                              NULL,
-                                              NULL,
-                                              NULL,
-                                              NULL,
-                                              NULL,
-                                              NULL);
-     }
+
+   if (!im)
+     im = (RGBA_Image *)evas_cache_image_empty(evas_common_image_cache_get());
+   im->cache_entry.w = gl_context->shared->w;
+   im->cache_entry.h = gl_context->shared->h;
+
+   evas_common_draw_context_font_ext_set(context,
+                                         gl_context,
+                                         evas_gl_font_texture_new,
+                                         evas_gl_font_texture_free,
+                                         evas_gl_font_texture_draw,
+                                         evas_gl_image_new_from_data,
+                                         evas_gl_image_free,
+                                         evas_gl_image_draw);
+   return im;
+}
+
+static void
+_font_draw_end(void *context)
+{
+   evas_common_draw_context_font_ext_set(context,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL);
+}
+
+static Eina_Bool
+eng_font_draw(void *data, void *context, void *surface, Evas_Font_Set *font EINA_UNUSED, int x, int y, int w EINA_UNUSED, int h EINA_UNUSED, int ow EINA_UNUSED, int oh EINA_UNUSED, Evas_Text_Props *intl_props, Eina_Bool do_async EINA_UNUSED)
+{
+   RGBA_Image *im;
+
+   im = _font_draw_begin(data, context, surface);
+   evas_common_font_draw_prepare(intl_props);
+   evas_common_font_draw(im, context, x, y, intl_props->glyphs);
+   _font_draw_end(context);
+
+   return EINA_FALSE;
+}
+
+static Eina_Bool
+eng_multi_font_draw(void *data, void *context, void *surface, Evas_Font_Set *font EINA_UNUSED, int x, int y, int w EINA_UNUSED, int h EINA_UNUSED, int ow EINA_UNUSED, int oh EINA_UNUSED, Evas_Font_Array *texts, Eina_Bool do_async EINA_UNUSED)
+{
+   RGBA_Image *im;
+
+   if (!texts) return EINA_FALSE;
+
+   im = _font_draw_begin(data, context, surface);
+   evas_common_font_draw_multi(im, context, x, y, texts);
+   _font_draw_end(context);
 
    return EINA_FALSE;
 }
@@ -2520,6 +2586,8 @@ module_open(Evas_Module *em)
    ORD(image_data_put);
    ORD(image_data_preload_request);
    ORD(image_data_preload_cancel);
+   ORD(image_data_preload_priority_set);
+   ORD(image_cache_hint_set);
    ORD(image_alpha_set);
    ORD(image_alpha_get);
    ORD(image_orient_set);
@@ -2536,6 +2604,7 @@ module_open(Evas_Module *em)
    ORD(image_native_get);
 
    ORD(font_draw);
+   ORD(multi_font_draw);
 
    ORD(image_scale_hint_set);
    ORD(image_scale_hint_get);
@@ -2625,6 +2694,9 @@ module_open(Evas_Module *em)
    ORD(ector_renderer_draw);
    ORD(ector_end);
 
+   /* images are scaled by the GPU, there is no scale cache to fill */
+   func.image_prescale = NULL;
+
    /* now advertise out own api */
    em->functions = (void *)(&func);
    return 1;
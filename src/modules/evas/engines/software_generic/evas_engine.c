@@ -1727,6 +1727,40 @@ eng_image_data_preload_cancel(void *data EINA_UNUSED, void *image, const Eo *tar
    evas_cache_image_preload_cancel(&im->cache_entry, target);
 }
 
+static void
+eng_image_data_preload_priority_set(void *data EINA_UNUSED, void *image, const Eo *target,
+                                    Evas_Image_Preload_Priority priority)
+{
+   RGBA_Image *im = image;
+
+   if (!im) return;
+
+#ifdef EVAS_CSERVE2
+   if (evas_cserve2_use_get() && evas_cache2_image_cached(&im->cache_entry))
+     return;
+#endif
+
+   evas_cache_image_preload_priority_set(&im->cache_entry, target, priority);
+}
+
+static void
+eng_image_cache_hint_set(void *data EINA_UNUSED, void *image,
+                         unsigned int tag, int pin)
+{
+   RGBA_Image *im = image;
+
+   if (!im) return;
+
+#ifdef EVAS_CSERVE2
+   if (evas_cserve2_use_get() && evas_cache2_image_cached(&im->cache_entry))
+     return;
+#endif
+
+   evas_cache_image_tag_set(&im->cache_entry, tag);
+   if (pin > 0) evas_cache_image_pin(&im->cache_entry);
+   else if (pin < 0) evas_cache_image_unpin(&im->cache_entry);
+}
+
 static void
 _draw_thread_image_draw(void *data)
 {
@@ -2359,22 +2393,10 @@ static void
 _draw_thread_multi_font_draw(void *data)
 {
    Evas_Thread_Command_Multi_Font *mf = data;
-   Evas_Font_Array_Data           *itr;
 
-   EINA_INARRAY_FOREACH(mf->texts->array, itr)
-     {
-        unsigned int r, g, b, a;
-        int x = mf->x + itr->x, y = mf->y;
-
-        r = itr->color.r;
-        g = itr->color.g;
-        b = itr->color.b;
-        a = itr->color.a;
-
-        eng_context_color_set(NULL, &mf->context, r, g, b, a);
-        evas_common_font_draw(mf->surface, &mf->context, x, y, itr->glyphs);
-        evas_common_cpu_end_opt();
-     }
+   evas_common_font_draw_multi(mf->surface, &mf->context, mf->x, mf->y,
+                               mf->texts);
+   evas_common_cpu_end_opt();
 
    eina_mempool_free(_mp_command_multi_font, mf);
 }
@@ -2412,6 +2434,9 @@ eng_multi_font_draw(void *data EINA_UNUSED, void *context, void *surface, Evas_F
    if (do_async)
      return _multi_font_draw_thread_cmd(surface, context, x, y, texts);
 
+   evas_common_font_draw_multi(surface, context, x, y, texts);
+   evas_common_cpu_end_opt();
+
    return EINA_FALSE;
 }
 
@@ -2502,6 +2527,17 @@ eng_pixel_alpha_get(void *image, int x, int y, DATA8 *alpha, int src_region_x, i
    return EINA_TRUE;
 }
 
+static Eina_Bool
+eng_image_prescale(void *data EINA_UNUSED, void *image, int smooth,
+                   int src_x, int src_y, int src_w, int src_h,
+                   int dst_w, int dst_h)
+{
+   if (!image) return EINA_FALSE;
+   return evas_common_rgba_image_scalecache_prescale(image, smooth,
+                                                     src_x, src_y, src_w, src_h,
+                                                     dst_w, dst_h);
+}
+
 static void
 eng_image_cache_flush(void *data EINA_UNUSED)
 {
@@ -3929,7 +3965,10 @@ static Evas_Func func =
      eng_ector_get,
      eng_ector_begin,
      eng_ector_renderer_draw,
-     eng_ector_end
+     eng_ector_end,
+     eng_image_prescale,
+     eng_image_data_preload_priority_set,
+     eng_image_cache_hint_set
    /* FUTURE software generic calls go here */
 };
 
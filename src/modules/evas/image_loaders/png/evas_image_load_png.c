@@ -53,6 +53,27 @@ _evas_image_png_read(png_structp png_ptr, png_bytep out, png_size_t count)
    epi->position += count;
 }
 
+/* Copy w pixels of pack_offset bytes, taking one source pixel every step */
+static inline void
+_evas_image_png_row_copy(unsigned char *dst, const unsigned char *src,
+                         int w, int step, unsigned int pack_offset)
+{
+   int j, k;
+
+   if (step == 1)
+     {
+        memcpy(dst, src, w * pack_offset);
+        return;
+     }
+   for (j = 0; j < w; j++)
+     {
+        for (k = 0; k < (int)pack_offset; k++)
+          dst[k] = src[k];
+        dst += pack_offset;
+        src += step * pack_offset;
+     }
+}
+
 static void *
 evas_image_load_file_open_png(Eina_File *f, Eina_Stringshare *key EINA_UNUSED,
                               Evas_Image_Load_Opts *opts,
@@ -92,6 +113,8 @@ evas_image_load_file_head_png(void *loader_data,
    png_structp png_ptr = NULL;
    png_infop info_ptr = NULL;
    png_uint_32 w32, h32;
+   Eina_Rectangle region;
+   int scale;
    int bit_depth, color_type, interlace_type;
    char hasa;
    volatile Eina_Bool r = EINA_FALSE;
@@ -156,21 +179,13 @@ evas_image_load_file_head_png(void *loader_data,
 	  *error = EVAS_LOAD_ERROR_GENERIC;
 	goto close_file;
      }
-   if (opts->scale_down_by > 1)
+   if (!evas_loader_region_get(opts, w32, h32, &scale, &region))
      {
-        prop->w = (int) w32 / opts->scale_down_by;
-        prop->h = (int) h32 / opts->scale_down_by;
-        if ((prop->w < 1) || (prop->h < 1))
-          {
-             *error = EVAS_LOAD_ERROR_GENERIC;
-             goto close_file;
-          }
-     }
-   else
-     {
-        prop->w = (int) w32;
-        prop->h = (int) h32;
+        *error = EVAS_LOAD_ERROR_GENERIC;
+        goto close_file;
      }
+   prop->w = region.w;
+   prop->h = region.h;
    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS)) hasa = 1;
    switch (color_type)
      {
@@ -215,13 +230,15 @@ evas_image_load_file_data_png(void *loader_data,
    png_infop info_ptr = NULL;
    Evas_PNG_Info epi;
    png_uint_32 w32, h32;
+   Eina_Rectangle region;
    unsigned int pack_offset;
    int w, h;
    int bit_depth, color_type, interlace_type;
    volatile char hasa;
    char passes;
-   int i, j, p, k;
+   int i, p;
    volatile int scale_ratio = 1;
+   int scale;
    int image_w = 0, image_h = 0;
    volatile Eina_Bool r = EINA_FALSE;
 
@@ -281,18 +298,14 @@ evas_image_load_file_data_png(void *loader_data,
 		&interlace_type, NULL, NULL);
    image_w = w32;
    image_h = h32;
-   if (opts->scale_down_by > 1)
-     {
-        scale_ratio = opts->scale_down_by;
-        w32 /= scale_ratio;
-        h32 /= scale_ratio;
-     }
-   if (prop->w != w32 ||
-       prop->h != h32)
+   if ((!evas_loader_region_get(opts, w32, h32, &scale, &region)) ||
+       (prop->w != (unsigned int)region.w) ||
+       (prop->h != (unsigned int)region.h))
      {
 	*error = EVAS_LOAD_ERROR_GENERIC;
 	goto close_file;
      }
+   scale_ratio = scale;
 
    surface = pixels;
    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
@@ -321,8 +334,8 @@ evas_image_load_file_data_png(void *loader_data,
    /* pack all pixels to byte boundaries */
    png_set_packing(png_ptr);
 
-   w = w32;
-   h = h32;
+   w = region.w;
+   h = region.h;
 
    switch (prop->cspace)
      {
@@ -353,8 +366,8 @@ evas_image_load_file_data_png(void *loader_data,
 
    passes = png_set_interlace_handling(png_ptr);
    
-   /* we read image line by line if scale down was set */
-   if (scale_ratio == 1)
+   /* we read the whole image straight into the surface if we can */
+   if ((scale_ratio == 1) && (w == image_w) && (h == image_h))
      {
         for (p = 0; p < passes; p++)
           {
@@ -363,55 +376,61 @@ evas_image_load_file_data_png(void *loader_data,
           }
         png_read_end(png_ptr, info_ptr);
      }
-   else
+   /* else we stream the rows, keeping only the ones we need and stopping
+    * after the last one, so that neither a region nor a scaled down image
+    * needs a full size buffer */
+   else if (passes == 1)
      {
-        unsigned char *src_ptr, *dst_ptr;
+        unsigned char *dst_ptr = surface;
+        int first = region.y * scale_ratio;
+        int last = (region.y + h - 1) * scale_ratio;
+        int offset = region.x * scale_ratio * pack_offset;
 
-        dst_ptr = surface;
-        if (passes == 1)
+        tmp_line = (unsigned char *) alloca(image_w * pack_offset);
+        for (i = 0; i <= last; i++)
           {
-             tmp_line = (unsigned char *) alloca(image_w * pack_offset);
-             for (i = 0; i < h; i++)
+             if ((i < first) || ((i - first) % scale_ratio))
+               png_read_row(png_ptr, tmp_line, NULL);
+             else if ((scale_ratio == 1) && (w == image_w))
+               {
+                  png_read_row(png_ptr, dst_ptr, NULL);
+                  dst_ptr += w * pack_offset;
+               }
+             else
                {
                   png_read_row(png_ptr, tmp_line, NULL);
-                  src_ptr = tmp_line;
-                  for (j = 0; j < w; j++)
-                    {
-                       for (k = 0; k < (int)pack_offset; k++)
-                         dst_ptr[k] = src_ptr[k];
-                       dst_ptr += pack_offset;
-                       src_ptr += scale_ratio * pack_offset;
-                    }
-                  for (j = 0; j < (scale_ratio - 1); j++)
-                    png_read_row(png_ptr, tmp_line, NULL);
+                  _evas_image_png_row_copy(dst_ptr, tmp_line + offset,
+                                           w, scale_ratio, pack_offset);
+                  dst_ptr += w * pack_offset;
                }
           }
-        else
+     }
+   /* interlaced images are only complete after the last pass */
+   else
+     {
+        unsigned char *pixels2 = malloc(image_w * image_h * pack_offset);
+
+        if (!pixels2)
+          {
+             *error = EVAS_LOAD_ERROR_RESOURCE_ALLOCATION_FAILED;
+             goto close_file;
+          }
+        for (p = 0; p < passes; p++)
+          {
+             for (i = 0; i < image_h; i++)
+               png_read_row(png_ptr, pixels2 + (i * image_w * pack_offset), NULL);
+          }
+        for (i = 0; i < h; i++)
           {
-             unsigned char *pixels2 = malloc(image_w * image_h * pack_offset);
+             unsigned char *src_ptr;
 
-             if (pixels2)
-               {
-                  for (p = 0; p < passes; p++)
-                    {
-                       for (i = 0; i < image_h; i++)
-                         png_read_row(png_ptr, pixels2 + (i * image_w * pack_offset), NULL);
-                    }
-                  
-                  for (i = 0; i < h; i++)
-                    {
-                       src_ptr = pixels2 + (i * scale_ratio * image_w * pack_offset);
-                       for (j = 0; j < w; j++)
-                         {
-                            for (k = 0; k < (int)pack_offset; k++)
-                              dst_ptr[k] = src_ptr[k];
-                            src_ptr += scale_ratio * pack_offset;
-                            dst_ptr += pack_offset;
-                         }
-                    }
-                  free(pixels2);
-               }
+             src_ptr = pixels2 +
+               (((((region.y + i) * scale_ratio) * image_w) +
+                 (region.x * scale_ratio)) * pack_offset);
+             _evas_image_png_row_copy(surface + (i * w * pack_offset),
+                                      src_ptr, w, scale_ratio, pack_offset);
           }
+        free(pixels2);
      }
 
    prop->premul = EINA_TRUE;
@@ -435,7 +454,7 @@ static Evas_Image_Load_Func evas_image_load_png_func =
   evas_image_load_file_data_png,
   NULL,
   EINA_TRUE,
-  EINA_FALSE
+  EINA_TRUE
 };
 
 static int
@@ -39,6 +39,8 @@ evas_image_load_file_open_tgv(Eina_File *f, Eina_Stringshare *key EINA_UNUSED,
      }
 
    loader->image = image;
+   /* Macroblocks are independent, decode them on all the worker threads */
+   emile_image_parallel_set(image, evas_loader_parallel_run);
    if (opts && (opts->region.w > 0) && (opts->region.h > 0))
      {
         EINA_RECTANGLE_SET(&loader->region,
@@ -38,6 +38,7 @@ struct _Ector_Test_Case
 
 static const Ector_Test_Case etc[] = {
   { "init", ector_test_init },
+  { "software", ector_test_software },
   { NULL, NULL }
 };
 
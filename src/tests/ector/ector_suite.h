@@ -4,5 +4,6 @@
 #include <check.h>
 
 void ector_test_init(TCase *tc);
+void ector_test_software(TCase *tc);
 
 #endif
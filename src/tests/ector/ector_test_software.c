@@ -0,0 +1,255 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ector_suite.h"
+
+#include "Ector.h"
+#include "software/Ector_Software.h"
+
+#define W 128
+#define H 96
+
+typedef enum _Fill
+{
+   FILL_SOLID,
+   FILL_LINEAR,
+   FILL_RADIAL
+} Fill;
+
+/* Translucent shapes, some of them covering each other, over a background
+ * that is not black, so that both the fully covered spans and the blended
+ * edges go through the span functions. */
+static void
+_software_draw(unsigned int *pixels, Fill fill, Efl_Gfx_Gradient_Spread spread,
+               unsigned int mul_col)
+{
+   static const Efl_Gfx_Gradient_Stop stops[3] = {
+      { 0.0, 255, 0, 0, 255 },
+      { 0.5, 0, 128, 0, 128 },
+      { 1.0, 0, 0, 255, 255 }
+   };
+   Ector_Surface *surface;
+   Ector_Renderer *grad = NULL, *shape;
+   int i;
+
+   for (i = 0; i < W * H; i++)
+     pixels[i] = 0xff204060;
+
+   surface = eo_add(ECTOR_SOFTWARE_SURFACE_CLASS, NULL);
+   eo_do(surface,
+         ector_software_surface_set(pixels, W, H),
+         ector_surface_reference_point_set(0, 0));
+
+   if (fill == FILL_LINEAR)
+     {
+        eo_do(surface, grad = ector_surface_renderer_factory_new(ECTOR_RENDERER_GENERIC_GRADIENT_LINEAR_MIXIN));
+        eo_do(grad,
+              efl_gfx_gradient_linear_start_set(10, 5),
+              efl_gfx_gradient_linear_end_set(50, 35));
+     }
+   else if (fill == FILL_RADIAL)
+     {
+        eo_do(surface, grad = ector_surface_renderer_factory_new(ECTOR_RENDERER_GENERIC_GRADIENT_RADIAL_MIXIN));
+        eo_do(grad,
+              efl_gfx_gradient_radial_center_set(60, 50),
+              efl_gfx_gradient_radial_focal_set(50, 40),
+              efl_gfx_gradient_radial_radius_set(30));
+     }
+   if (grad)
+     eo_do(grad,
+           efl_gfx_gradient_stop_set(stops, 3),
+           efl_gfx_gradient_spread_set(spread));
+
+   for (i = 0; i < 5; i++)
+     {
+        eo_do(surface, shape = ector_surface_renderer_factory_new(ECTOR_RENDERER_GENERIC_SHAPE_MIXIN));
+        if (i & 1)
+          eo_do(shape, efl_gfx_shape_append_circle(20 + (i * 19), 45 + (i * 3), 31.5));
+        else
+          eo_do(shape, efl_gfx_shape_append_rect(3 + (i * 21), 7 + (i * 5), 70.3, 50.6, 9, 9));
+        if (grad)
+          eo_do(shape, ector_renderer_shape_fill_set(grad));
+        else
+          eo_do(shape, ector_renderer_color_set(40 * i, 160, 200 - (40 * i), 64 + (48 * i)));
+        eo_do(shape,
+              ector_renderer_prepare(),
+              ector_renderer_draw(ECTOR_ROP_BLEND, NULL, mul_col));
+        eo_del(shape);
+     }
+
+   if (grad) eo_del(grad);
+   eo_del(surface);
+}
+
+/* Largest difference between two channels of the same pixel */
+static int
+_software_diff(const unsigned int *a, const unsigned int *b, int *at)
+{
+   int i, c, d, max = 0;
+
+   for (i = 0; i < W * H; i++)
+     for (c = 0; c < 32; c += 8)
+       {
+          d = abs((int)((a[i] >> c) & 0xff) - (int)((b[i] >> c) & 0xff));
+          if (d > max)
+            {
+               max = d;
+               *at = i;
+            }
+       }
+   return max;
+}
+
+START_TEST(ector_software_sse2_c)
+{
+   static const struct {
+      Fill fill;
+      Efl_Gfx_Gradient_Spread spread;
+      unsigned int mul_col;
+      int tolerance;
+   } cases[] = {
+      { FILL_SOLID, EFL_GFX_GRADIENT_SPREAD_PAD, 0xffffffff, 0 },
+      { FILL_SOLID, EFL_GFX_GRADIENT_SPREAD_PAD, 0xc0a08060, 0 },
+      { FILL_LINEAR, EFL_GFX_GRADIENT_SPREAD_PAD, 0xffffffff, 0 },
+      { FILL_LINEAR, EFL_GFX_GRADIENT_SPREAD_REPEAT, 0xffffffff, 0 },
+      { FILL_LINEAR, EFL_GFX_GRADIENT_SPREAD_REFLECT, 0xc0a08060, 0 },
+      /* the sse2 radial fetch can land on the next entry of the color
+       * table, one step of the 1024 of the gradient */
+      { FILL_RADIAL, EFL_GFX_GRADIENT_SPREAD_PAD, 0xffffffff, 1 },
+      { FILL_RADIAL, EFL_GFX_GRADIENT_SPREAD_REPEAT, 0xffffffff, 1 },
+      { FILL_RADIAL, EFL_GFX_GRADIENT_SPREAD_REFLECT, 0xc0a08060, 1 }
+   };
+   unsigned int c_pixels[W * H], sse2_pixels[W * H];
+   unsigned int i;
+   int d, at = 0;
+
+   fail_if(ector_init() != 1);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(cases); i++)
+     {
+        /* the rasterizer picks its span functions when it is created */
+        setenv("ECTOR_CPU_NO_SSE2", "1", 1);
+        _software_draw(c_pixels, cases[i].fill, cases[i].spread, cases[i].mul_col);
+        unsetenv("ECTOR_CPU_NO_SSE2");
+        _software_draw(sse2_pixels, cases[i].fill, cases[i].spread, cases[i].mul_col);
+
+        d = _software_diff(sse2_pixels, c_pixels, &at);
+        ck_assert_msg(d <= cases[i].tolerance,
+                      "case %u: pixel %d,%d is %#x instead of %#x",
+                      i, at % W, at / W, sse2_pixels[at], c_pixels[at]);
+     }
+
+   ector_shutdown();
+}
+END_TEST
+
+#define SHAPES 240
+#define SHAPES_W 320
+#define SHAPES_H 240
+
+/* Prepares every shape before drawing any, so that their RLE is generated
+ * in a single queue, with ECTOR_WORKER_THREADS threads. There are enough of
+ * them, with wide enough strokes, for the threads spawned by that queue to
+ * take their share before the thread running it is done. Nothing is
+ * clipped, every shape lies within the surface. */
+static void
+_software_shapes_draw(unsigned int *pixels, const char *threads)
+{
+   Ector_Surface *surface;
+   Ector_Renderer *shapes[SHAPES];
+   int i;
+
+   setenv("ECTOR_WORKER_THREADS", threads, 1);
+   /* the worker threads are spawned by the first queue after init */
+   fail_if(ector_init() != 1);
+
+   for (i = 0; i < SHAPES_W * SHAPES_H; i++)
+     pixels[i] = 0xff204060;
+
+   surface = eo_add(ECTOR_SOFTWARE_SURFACE_CLASS, NULL);
+   eo_do(surface,
+         ector_software_surface_set(pixels, SHAPES_W, SHAPES_H),
+         ector_surface_reference_point_set(0, 0));
+
+   for (i = 0; i < SHAPES; i++)
+     {
+        double x = 50 + (i * 37) % (SHAPES_W - 160);
+        double y = 60 + (i * 23) % (SHAPES_H - 170);
+
+        eo_do(surface, shapes[i] = ector_surface_renderer_factory_new(ECTOR_RENDERER_GENERIC_SHAPE_MIXIN));
+        if (i % 3 == 0)
+          eo_do(shapes[i], efl_gfx_shape_append_circle(x + 30, y + 30, 10.5 + (i % 23)));
+        else if (i % 3 == 1)
+          eo_do(shapes[i], efl_gfx_shape_append_rect(x, y, 30.5 + (i % 41), 20.3 + (i % 17), i % 9, i % 7));
+        else
+          eo_do(shapes[i],
+                efl_gfx_shape_append_move_to(x, y),
+                efl_gfx_shape_append_cubic_to(x + 60, y + 9, x + 75, y - 30, x + 12, y + 60),
+                efl_gfx_shape_append_cubic_to(x + 20, y + 45, x - 15, y + 70, x + 40, y + 25),
+                efl_gfx_shape_append_line_to(x + 6, y + 45),
+                efl_gfx_shape_append_close());
+        eo_do(shapes[i],
+              ector_renderer_color_set((i * 4) % 64, (i * 7) % 96, 32, 96 + (i % 32)),
+              efl_gfx_shape_stroke_color_set(100 + (i % 100), (i * 3) % 128, 20, 200),
+              efl_gfx_shape_stroke_scale_set(1.0),
+              efl_gfx_shape_stroke_width_set(1.0 + (i % 13)),
+              efl_gfx_shape_stroke_cap_set(i % EFL_GFX_CAP_LAST),
+              efl_gfx_shape_stroke_join_set(i % EFL_GFX_JOIN_LAST),
+              ector_renderer_prepare());
+     }
+
+   for (i = 0; i < SHAPES; i++)
+     {
+        eo_do(shapes[i], ector_renderer_draw(ECTOR_ROP_BLEND, NULL, 0xffffffff));
+        eo_del(shapes[i]);
+     }
+
+   eo_del(surface);
+   ector_shutdown();
+   unsetenv("ECTOR_WORKER_THREADS");
+}
+
+START_TEST(ector_software_rle_threads)
+{
+   unsigned int *inline_pixels, *threaded_pixels;
+   int i;
+
+   inline_pixels = malloc(SHAPES_W * SHAPES_H * sizeof (unsigned int));
+   threaded_pixels = malloc(SHAPES_W * SHAPES_H * sizeof (unsigned int));
+   fail_if(!inline_pixels || !threaded_pixels);
+
+   /* the classes do not survive eo being shut down between the two draws,
+    * only the worker threads are restarted */
+   eo_init();
+
+   /* the shapes rasterized on worker threads must draw what they draw when
+    * the thread running the queue rasterizes them all */
+   _software_shapes_draw(inline_pixels, "1");
+   _software_shapes_draw(threaded_pixels, "4");
+   eo_shutdown();
+
+   for (i = 0; i < SHAPES_W * SHAPES_H; i++)
+     ck_assert_msg(threaded_pixels[i] == inline_pixels[i],
+                   "pixel %d,%d is %#x instead of %#x", i % SHAPES_W, i / SHAPES_W,
+                   threaded_pixels[i], inline_pixels[i]);
+
+   /* and they do draw something */
+   for (i = 0; (i < SHAPES_W * SHAPES_H) && (inline_pixels[i] == 0xff204060); i++)
+     ;
+   fail_if(i == SHAPES_W * SHAPES_H);
+
+   free(inline_pixels);
+   free(threaded_pixels);
+}
+END_TEST
+
+void
+ector_test_software(TCase *tc)
+{
+   tcase_add_test(tc, ector_software_sse2_c);
+   tcase_add_test(tc, ector_software_rle_threads);
+}
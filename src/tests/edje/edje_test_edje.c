@@ -4,6 +4,7 @@
 
 #include <unistd.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <Eina.h>
 #include <Edje.h>
@@ -151,6 +152,371 @@ START_TEST(edje_test_complex_layout)
 }
 END_TEST
 
+START_TEST(edje_test_layout_cache_text)
+{
+   static const char *texts[] = {
+      "x", "a much longer text", "xx", "x x x", "another text", "x"
+   };
+   int geom[EINA_C_ARRAY_LENGTH(texts)][4];
+   int x, y, w, h;
+   unsigned int i, pass, hits, hits2;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("layout_cache.edj"), "test_group"));
+   evas_object_resize(obj, 400, 100);
+
+   /* what the parts look like computed from scratch */
+   edje_layout_cache_set(EINA_FALSE);
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(texts); i++)
+     {
+        edje_object_part_text_set(obj, "text", texts[i]);
+        edje_object_calc_force(obj);
+        edje_object_part_geometry_get(obj, "text", NULL, NULL, &geom[i][2], NULL);
+        edje_object_part_geometry_get(obj, "after", &geom[i][0], &geom[i][1], NULL, NULL);
+     }
+   fail_if(geom[1][2] <= geom[0][2]);
+
+   /* strings come and go while the cache holds results keyed on them,
+    * the second pass is served from the cache */
+   edje_layout_cache_set(EINA_TRUE);
+   for (pass = 0; pass < 2; pass++)
+     {
+        edje_layout_cache_stats_get(&hits, NULL);
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(texts); i++)
+          {
+             edje_object_part_text_set(obj, "text", texts[i]);
+             edje_object_calc_force(obj);
+             edje_object_part_geometry_get(obj, "text", NULL, NULL, &w, NULL);
+             edje_object_part_geometry_get(obj, "after", &x, &y, NULL, &h);
+             ck_assert_int_eq(w, geom[i][2]);
+             ck_assert_int_eq(x, geom[i][0]);
+             ck_assert_int_eq(y, geom[i][1]);
+             ck_assert_int_eq(h, 100);
+          }
+        edje_layout_cache_stats_get(&hits2, NULL);
+        if (pass) fail_if(hits2 == hits);
+     }
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+static void
+_partial_recalc_check(Evas *evas, Evas_Object *obj, Evas_Object *ref)
+{
+   static const char *parts[] = {
+      "bg", "title", "underline", "badge", "track", "knob", "label", "other"
+   };
+   int x, y, w, h, rx, ry, rw, rh;
+   unsigned int i;
+
+   /* ref gets a full recalc, obj only what changed */
+   edje_object_calc_force(ref);
+   evas_smart_objects_calculate(evas);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(parts); i++)
+     {
+        edje_object_part_geometry_get(obj, parts[i], &x, &y, &w, &h);
+        edje_object_part_geometry_get(ref, parts[i], &rx, &ry, &rw, &rh);
+        ck_assert_msg((x == rx) && (y == ry) && (w == rw) && (h == rh),
+                      "%s is %d,%d %dx%d instead of %d,%d %dx%d", parts[i],
+                      x, y, w, h, rx, ry, rw, rh);
+     }
+}
+
+START_TEST(edje_test_partial_recalc)
+{
+   int x, y, w, w2;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj, *ref;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("partial_recalc.edj"), "test_group"));
+   evas_object_resize(obj, 400, 300);
+   ref = edje_object_add(evas);
+   fail_unless(edje_object_file_set(ref, test_layout_get("partial_recalc.edj"), "test_group"));
+   evas_object_resize(ref, 400, 300);
+   _partial_recalc_check(evas, obj, ref);
+   edje_object_part_geometry_get(obj, "underline", NULL, NULL, &w, NULL);
+
+   /* new text, its dependents follow */
+   edje_object_part_text_set(obj, "title", "a much longer title");
+   edje_object_part_text_set(ref, "title", "a much longer title");
+   _partial_recalc_check(evas, obj, ref);
+   edje_object_part_geometry_get(obj, "underline", NULL, NULL, &w2, NULL);
+   fail_if(w2 <= w);
+
+   /* new state */
+   edje_object_signal_emit(obj, "move", "");
+   edje_object_signal_emit(ref, "move", "");
+   edje_object_message_signal_process(obj);
+   edje_object_message_signal_process(ref);
+   _partial_recalc_check(evas, obj, ref);
+   edje_object_part_geometry_get(obj, "badge", &x, &y, NULL, NULL);
+   edje_object_part_geometry_get(obj, "underline", NULL, NULL, &w, NULL);
+   ck_assert_int_eq(x, 10 + w + 4);
+   ck_assert_int_eq(y, 20 + 32 - 16);
+
+   /* new drag value */
+   edje_object_part_drag_value_set(obj, "knob", 0.5, 0.0);
+   edje_object_part_drag_value_set(ref, "knob", 0.5, 0.0);
+   _partial_recalc_check(evas, obj, ref);
+   edje_object_part_geometry_get(obj, "label", &x, NULL, NULL, NULL);
+   ck_assert_int_eq(x, (400 - 20) / 2);
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+typedef struct _Signal_Counts Signal_Counts;
+struct _Signal_Counts
+{
+   int glob, prefix, list; /* none of these emissions has an 'a' */
+};
+
+static void
+_signal_program_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                   const char *emission, const char *source EINA_UNUSED)
+{
+   Signal_Counts *counts = data;
+
+   if (!strcmp(emission, "glob")) counts->glob++;
+   else if (!strcmp(emission, "prefix")) counts->prefix++;
+   else if (!strcmp(emission, "list")) counts->list++;
+}
+
+static void
+_signal_count_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                 const char *emission EINA_UNUSED, const char *source EINA_UNUSED)
+{
+   int *count = data;
+
+   (*count)++;
+}
+
+static void
+_signal_emit(Evas_Object *obj, const char *emission, const char *source)
+{
+   edje_object_signal_emit(obj, emission, source);
+   /* once for the signal, once for what its programs emit */
+   edje_object_message_signal_process(obj);
+   edje_object_message_signal_process(obj);
+}
+
+START_TEST(edje_test_signal_match)
+{
+   static const struct {
+      const char *emission, *source;
+      Signal_Counts expected;
+   } cases[] = {
+      { "aaa", "x", { 1, 0, 0 } },
+      { "state,on", "src", { 1, 1, 0 } },
+      { "state,on", "other", { 1, 0, 0 } },
+      { "stte,on", "src", { 0, 0, 0 } },
+      { "ax1", "y", { 1, 0, 1 } },
+      { "bxx", "y", { 0, 0, 1 } },
+      { "cx1", "y", { 0, 0, 0 } },
+      { "bx", "y", { 0, 0, 0 } },
+      { "", "", { 0, 0, 0 } }
+   };
+   Signal_Counts counts;
+   unsigned int i, pass;
+   int count;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("signals.edj"), "test_group"));
+   edje_object_signal_callback_add(obj, "*", "program", _signal_program_cb, &counts);
+   /* "load" and "edje,state,ltr" have an 'a' too */
+   edje_object_message_signal_process(obj);
+   edje_object_message_signal_process(obj);
+
+   /* programs, the second pass goes through the states built by the first */
+   for (pass = 0; pass < 2; pass++)
+     for (i = 0; i < EINA_C_ARRAY_LENGTH(cases); i++)
+       {
+          memset(&counts, 0, sizeof (counts));
+          _signal_emit(obj, cases[i].emission, cases[i].source);
+          ck_assert_msg(!memcmp(&counts, &cases[i].expected, sizeof (counts)),
+                        "\"%s\" from \"%s\" fired %d %d %d",
+                        cases[i].emission, cases[i].source,
+                        counts.glob, counts.prefix, counts.list);
+       }
+
+   /* callbacks, a pattern matching in several ways fires once */
+   count = 0;
+   edje_object_signal_callback_add(obj, "*a*", "cb", _signal_count_cb, &count);
+   _signal_emit(obj, "aaa", "cb");
+   ck_assert_int_eq(count, 1);
+   _signal_emit(obj, "banana", "cb");
+   ck_assert_int_eq(count, 2);
+   _signal_emit(obj, "xyz", "cb");
+   _signal_emit(obj, "aaa", "other");
+   ck_assert_int_eq(count, 2);
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+START_TEST(edje_test_signal_match_many)
+{
+   int counts[600] = { 0 };
+   char buf[32];
+   unsigned int i, pass;
+   int total;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("signals.edj"), "test_group"));
+
+   /* more distinct prefixes than the matcher keeps states for, those past
+    * the limit are matched the slow way */
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(counts); i++)
+     {
+        snprintf(buf, sizeof (buf), "sig%03u,*", i);
+        edje_object_signal_callback_add(obj, buf, "cb", _signal_count_cb, &counts[i]);
+     }
+
+   for (pass = 0; pass < 2; pass++)
+     for (i = 0; i < EINA_C_ARRAY_LENGTH(counts); i++)
+       {
+          snprintf(buf, sizeof (buf), "sig%03u,x", i);
+          _signal_emit(obj, buf, "cb");
+       }
+
+   for (i = 0, total = 0; i < EINA_C_ARRAY_LENGTH(counts); i++)
+     {
+        ck_assert_int_eq(counts[i], 2);
+        total += counts[i];
+     }
+   ck_assert_int_eq(total, 2 * EINA_C_ARRAY_LENGTH(counts));
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+typedef struct _Message_Log Message_Log;
+struct _Message_Log
+{
+   char buf[64];
+   Evas_Object *feed; /* gets "fed" when "feed" is delivered */
+};
+
+static void
+_message_log_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                const char *emission, const char *source EINA_UNUSED)
+{
+   Message_Log *log = data;
+
+   if (log->buf[0]) strcat(log->buf, " ");
+   strcat(log->buf, emission);
+   if ((log->feed) && (!strcmp(emission, "feed")))
+     edje_object_signal_emit(log->feed, "fed", "log");
+}
+
+static Evas_Object *
+_message_object_add(Evas *evas, Message_Log *log)
+{
+   Evas_Object *obj;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("test_layout.edj"), "test_group"));
+   /* drop what file_set emitted */
+   edje_object_message_signal_process(obj);
+   edje_object_signal_callback_add(obj, "*", "log", _message_log_cb, log);
+   return obj;
+}
+
+START_TEST(edje_test_message_order)
+{
+   Message_Log log;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *a, *b, *c;
+
+   memset(&log, 0, sizeof (log));
+   a = _message_object_add(evas, &log);
+   b = _message_object_add(evas, &log);
+   c = _message_object_add(evas, &log);
+
+   /* all objects, in the order the messages were sent */
+   edje_object_signal_emit(a, "a1", "log");
+   edje_object_signal_emit(b, "b1", "log");
+   edje_object_signal_emit(a, "a2", "log");
+   edje_object_signal_emit(c, "c1", "log");
+   edje_object_signal_emit(b, "b2", "log");
+   edje_message_signal_process();
+   ck_assert_str_eq(log.buf, "a1 b1 a2 c1 b2");
+
+   /* one object, the others keep their messages and their order */
+   log.buf[0] = 0;
+   edje_object_signal_emit(b, "b1", "log");
+   edje_object_signal_emit(a, "a1", "log");
+   edje_object_signal_emit(c, "c1", "log");
+   edje_object_signal_emit(a, "a2", "log");
+   edje_object_signal_emit(b, "b2", "log");
+   edje_object_message_signal_process(a);
+   ck_assert_str_eq(log.buf, "a1 a2");
+   edje_message_signal_process();
+   ck_assert_str_eq(log.buf, "a1 a2 b1 c1 b2");
+
+   /* deleting an object drops its messages only */
+   log.buf[0] = 0;
+   edje_object_signal_emit(a, "a1", "log");
+   edje_object_signal_emit(c, "c1", "log");
+   edje_object_signal_emit(b, "b1", "log");
+   evas_object_del(c);
+   edje_message_signal_process();
+   ck_assert_str_eq(log.buf, "a1 b1");
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+START_TEST(edje_test_message_feed)
+{
+   Message_Log log;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *a, *b;
+
+   memset(&log, 0, sizeof (log));
+   a = _message_object_add(evas, &log);
+   b = _message_object_add(evas, &log);
+
+   /* a message sent while processing goes after those already queued */
+   log.feed = b;
+   edje_object_signal_emit(a, "feed", "log");
+   edje_object_signal_emit(b, "b1", "log");
+   edje_message_signal_process();
+   ck_assert_str_eq(log.buf, "feed b1 fed");
+
+   /* and waits for the next run of the object */
+   log.buf[0] = 0;
+   edje_object_signal_emit(b, "b1", "log");
+   edje_object_signal_emit(b, "feed", "log");
+   edje_object_signal_emit(b, "b2", "log");
+   edje_object_message_signal_process(b);
+   ck_assert_str_eq(log.buf, "b1 feed b2");
+   edje_object_message_signal_process(b);
+   ck_assert_str_eq(log.buf, "b1 feed b2 fed");
+
+   /* an object feeding itself does not lock the run */
+   log.buf[0] = 0;
+   log.feed = a;
+   edje_object_signal_emit(a, "feed", "log");
+   edje_object_message_signal_process(a);
+   ck_assert_str_eq(log.buf, "feed");
+   log.feed = NULL;
+   edje_object_message_signal_process(a);
+   ck_assert_str_eq(log.buf, "feed fed");
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
 void edje_test_edje(TCase *tc)
 {    
    tcase_add_test(tc, edje_test_edje_init);
@@ -158,4 +524,10 @@ void edje_test_edje(TCase *tc)
    tcase_add_test(tc, edje_test_edje_load);
    tcase_add_test(tc, edje_test_simple_layout_geometry);
    tcase_add_test(tc, edje_test_complex_layout);
+   tcase_add_test(tc, edje_test_layout_cache_text);
+   tcase_add_test(tc, edje_test_partial_recalc);
+   tcase_add_test(tc, edje_test_signal_match);
+   tcase_add_test(tc, edje_test_signal_match_many);
+   tcase_add_test(tc, edje_test_message_order);
+   tcase_add_test(tc, edje_test_message_feed);
 }
@@ -22,6 +22,7 @@ static const Evas_Test_Case etc[] = {
   { "Object", evas_test_object },
   { "Object Textblock", evas_test_textblock },
   { "Object Text", evas_test_text },
+  { "Object Textgrid", evas_test_textgrid },
   { "Callbacks", evas_test_callbacks },
   { "Render Engines", evas_test_render_engines },
   { "Filters", evas_test_filters },
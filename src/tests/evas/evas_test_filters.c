@@ -7,6 +7,11 @@
 # include "config.h"
 #endif
 
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <unistd.h>
 #include <stdio.h>
 
 #include "evas_suite.h"
@@ -421,9 +426,292 @@ START_TEST(evas_filter_text_render_test)
 }
 END_TEST
 
+#define BLUR_W 240
+#define BLUR_H 100
+
+/* Odd widths, so the vectorized rows always end with a partial vector. The
+ * filter output is clipped to the object, which has to be larger than the
+ * blur diameter. */
+static const struct {
+   int w, h;
+} blur_sizes[] = { { 61, 45 }, { 97, 51 }, { 211, 83 } };
+static const int blur_radii[] = { 1, 3, 7, 20 };
+
+#define BLUR_CASES (2 * EINA_C_ARRAY_LENGTH(blur_sizes) * \
+                    EINA_C_ARRAY_LENGTH(blur_radii))
+
+/* Blurs the same random image in rgba and in alpha with every radius, in a
+ * child process with the cpu features named in noenv turned off, evas only
+ * looks them up once per process. */
+static void
+_filter_blur_cpu_render(const char **noenv, unsigned int *out)
+{
+   pid_t pid;
+   int status;
+
+   pid = fork();
+   fail_if(pid < 0);
+   if (!pid)
+     {
+        Ecore_Evas *ee;
+        Evas *e;
+        Evas_Object *o;
+        unsigned int *data, seed = 0x1234567;
+        unsigned int i, j, k;
+        char code[256];
+        int x, y;
+
+        for (; *noenv; noenv++)
+          setenv(*noenv, "1", 1);
+        evas_init();
+        ecore_evas_init();
+        ee = ecore_evas_buffer_new(BLUR_W, BLUR_H);
+        ecore_evas_show(ee);
+        ecore_evas_manual_render_set(ee, EINA_TRUE);
+        /* nothing below the image, so the blend ops only copy its pixels */
+        ecore_evas_alpha_set(ee, EINA_TRUE);
+        ecore_evas_transparent_set(ee, EINA_TRUE);
+        e = ecore_evas_get(ee);
+
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(blur_sizes); i++)
+          {
+             int w = blur_sizes[i].w, h = blur_sizes[i].h;
+
+             o = evas_object_image_filled_add(e);
+             evas_object_image_size_set(o, w, h);
+             evas_object_image_alpha_set(o, EINA_TRUE);
+             data = evas_object_image_data_get(o, EINA_TRUE);
+             for (y = 0; y < h; y++)
+               for (x = 0; x < w; x++)
+                 {
+                    int a, r, g, b;
+
+                    seed = (seed * 1103515245) + 12345;
+                    a = (seed >> 24) | 0x0f;
+                    r = ((seed >> 16) & 0xff) * a / 255;
+                    g = ((seed >> 8) & 0xff) * a / 255;
+                    b = (seed & 0xff) * a / 255;
+                    data[(y * w) + x] = (a << 24) | (r << 16) | (g << 8) | b;
+                 }
+             evas_object_image_data_set(o, data);
+             evas_object_geometry_set(o, 10, 10, w, h);
+             evas_object_show(o);
+
+             for (j = 0; j < EINA_C_ARRAY_LENGTH(blur_radii); j++)
+               for (k = 0; k < 2; k++)
+                 {
+                    int r = blur_radii[j];
+
+                    if (!k)
+                      snprintf(code, sizeof(code),
+                               "blur ({ rx = %d, ry = %d, type = 'gaussian' })",
+                               r, r);
+                    else
+                      snprintf(code, sizeof(code),
+                               "a = buffer ({ 'alpha' }) blend ({ dst = a }) "
+                               "blur ({ rx = %d, ry = %d, src = a, "
+                               "type = 'gaussian' })", r, r);
+                    eo_do(o, evas_obj_image_filter_program_set(code));
+
+                    ecore_evas_manual_render(ee);
+                    memcpy(out, ecore_evas_buffer_pixels_get(ee),
+                           BLUR_W * BLUR_H * 4);
+                    out += BLUR_W * BLUR_H;
+                 }
+             evas_object_del(o);
+          }
+
+        ecore_evas_free(ee);
+        ecore_evas_shutdown();
+        evas_shutdown();
+        _exit(0);
+     }
+   fail_if(waitpid(pid, &status, 0) != pid);
+   fail_if(!WIFEXITED(status) || WEXITSTATUS(status));
+}
+
+START_TEST(evas_filter_blur_gaussian_cpu)
+{
+   /* the mmx blend ops are not exact, only switch the sse2 blur off */
+   static const char *no_sse3[] = { "EVAS_CPU_NO_SSE3", NULL };
+   static const char *all[] = { NULL };
+   size_t size = BLUR_CASES * BLUR_W * BLUR_H * 4;
+   unsigned int *ref, *out;
+   unsigned int i;
+
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   out = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if((ref == MAP_FAILED) || (out == MAP_FAILED));
+
+   /* the sse2 gaussian passes must give what the c passes give */
+   _filter_blur_cpu_render(no_sse3, ref);
+   _filter_blur_cpu_render(all, out);
+   for (i = 0; i < size / 4; i++)
+     ck_assert_msg(out[i] == ref[i],
+                   "case %u: pixel %u,%u is %#x instead of %#x",
+                   i / (BLUR_W * BLUR_H), i % BLUR_W, (i / BLUR_W) % BLUR_H,
+                   out[i], ref[i]);
+
+   /* every radius draws something, and something else than the last one */
+   for (i = 0; i < BLUR_CASES; i++)
+     {
+        const unsigned int *pixels = ref + (i * BLUR_W * BLUR_H);
+        unsigned int k;
+
+        for (k = 0; (k < BLUR_W * BLUR_H) && !pixels[k]; k++)
+          ;
+        fail_if(k == BLUR_W * BLUR_H);
+        if ((i / 2) % EINA_C_ARRAY_LENGTH(blur_radii))
+          fail_if(!memcmp(pixels, pixels - (2 * BLUR_W * BLUR_H),
+                          BLUR_W * BLUR_H * 4));
+     }
+
+   munmap(ref, size);
+   munmap(out, size);
+}
+END_TEST
+
+/* Several alpha branches made from the input, running side by side. e and f
+ * are only used once b and c are dead, so they can take their backings, and
+ * e is only partly drawn. The second program keeps every buffer alive until
+ * the end, blending them with a transparent color, so nothing is shared. */
+#define PARALLEL_PROGRAM \
+   "a = buffer ({ 'alpha' }) b = buffer ({ 'alpha' }) " \
+   "c = buffer ({ 'alpha' }) d = buffer ({ 'alpha' }) " \
+   "e = buffer ({ 'alpha' }) f = buffer ({ 'alpha' }) " \
+   "blend ({ dst = a }) " \
+   "blur ({ 4, src = a, dst = b, type = 'gaussian' }) " \
+   "grow ({ 3, src = a, dst = c }) " \
+   "curve ({ '0:255 - 255:0', src = a, dst = d }) " \
+   "blend ({ src = b, color = '#f008' }) " \
+   "blend ({ src = c, color = '#0f08' }) " \
+   "blend ({ src = d, color = '#00f8' }) " \
+   "blend ({ src = d, dst = e, ox = 7, oy = 3 }) " \
+   "grow ({ -2, src = d, dst = f }) " \
+   "blend ({ src = e, color = '#ff08' }) " \
+   "blend ({ src = f, color = '#0ff8' }) "
+
+static const char *_parallel_programs[] = {
+   PARALLEL_PROGRAM,
+   PARALLEL_PROGRAM
+   "blend ({ src = a, color = '#0000' }) blend ({ src = b, color = '#0000' }) "
+   "blend ({ src = c, color = '#0000' }) blend ({ src = d, color = '#0000' })"
+};
+
+static void
+_filter_render_post_cb(void *data, Evas *e EINA_UNUSED,
+                       void *event_info EINA_UNUSED)
+{
+   Eina_Bool *done = data;
+
+   *done = EINA_TRUE;
+}
+
+/* Renders the program on an image of random pixels and copies the canvas */
+static void
+_filter_parallel_render(const char *code, Eina_Bool async, unsigned int *out)
+{
+   Ecore_Evas *ee;
+   Evas *e;
+   Evas_Object *o;
+   unsigned int *data, seed = 0x7654321;
+   struct pollfd pfd = { evas_async_events_fd_get(), POLLIN, 0 };
+   Eina_Bool done = EINA_FALSE;
+   int x, y;
+
+   ee = ecore_evas_buffer_new(BLUR_W, BLUR_H);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   ecore_evas_alpha_set(ee, EINA_TRUE);
+   ecore_evas_transparent_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   o = evas_object_image_filled_add(e);
+   evas_object_image_size_set(o, 181, 77);
+   evas_object_image_alpha_set(o, EINA_TRUE);
+   data = evas_object_image_data_get(o, EINA_TRUE);
+   for (y = 0; y < 77; y++)
+     for (x = 0; x < 181; x++)
+       {
+          int a;
+
+          seed = (seed * 1103515245) + 12345;
+          /* blobs, so that growing and blurring change something */
+          a = (((x / 9) ^ (y / 7)) & 1) ? (int)(seed >> 24) : 0;
+          data[(y * 181) + x] = (a << 24) | (a << 16) | ((a / 2) << 8) | (a / 3);
+       }
+   evas_object_image_data_set(o, data);
+   evas_object_geometry_set(o, 20, 10, 181, 77);
+   evas_object_show(o);
+   eo_do(o, evas_obj_image_filter_program_set(code));
+
+   if (async)
+     {
+        /* the filter runs on the render thread, with its commands spread on
+         * the worker pool */
+        evas_event_callback_add(e, EVAS_CALLBACK_RENDER_POST,
+                                _filter_render_post_cb, &done);
+        fail_if(!evas_render_async(e));
+        while (!done)
+          {
+             fail_if(poll(&pfd, 1, 10000) != 1);
+             evas_async_events_process();
+          }
+        evas_event_callback_del(e, EVAS_CALLBACK_RENDER_POST,
+                                _filter_render_post_cb);
+     }
+   else
+     ecore_evas_manual_render(ee);
+   memcpy(out, ecore_evas_buffer_pixels_get(ee), BLUR_W * BLUR_H * 4);
+
+   evas_object_del(o);
+   ecore_evas_free(ee);
+}
+
+START_TEST(evas_filter_parallel_chain)
+{
+   static const struct {
+      unsigned int program;
+      Eina_Bool async;
+   } runs[] = { { 0, EINA_FALSE }, { 1, EINA_TRUE }, { 0, EINA_TRUE } };
+   unsigned int *ref, *out;
+   unsigned int i, j;
+
+   evas_init();
+   ecore_evas_init();
+
+   ref = calloc(BLUR_W * BLUR_H, 4);
+   out = calloc(BLUR_W * BLUR_H, 4);
+   fail_if(!ref || !out);
+
+   /* running the commands level by level on several threads must give what
+    * running them one after the other gives, and so must sharing buffers */
+   _filter_parallel_render(_parallel_programs[1], EINA_FALSE, ref);
+   for (j = 0; j < EINA_C_ARRAY_LENGTH(runs); j++)
+     {
+        _filter_parallel_render(_parallel_programs[runs[j].program],
+                                runs[j].async, out);
+        for (i = 0; i < BLUR_W * BLUR_H; i++)
+          ck_assert_msg(out[i] == ref[i],
+                        "run %u: pixel %u,%u is %#x instead of %#x",
+                        j, i % BLUR_W, i / BLUR_W, out[i], ref[i]);
+     }
+   for (i = 0; (i < BLUR_W * BLUR_H) && !ref[i]; i++)
+     ;
+   fail_if(i == BLUR_W * BLUR_H);
+
+   free(ref);
+   free(out);
+   ecore_evas_shutdown();
+   evas_shutdown();
+}
+END_TEST
+
 void evas_test_filters(TCase *tc)
 {
    tcase_add_test(tc, evas_filter_parser);
    tcase_add_test(tc, evas_filter_text_padding_test);
    tcase_add_test(tc, evas_filter_text_render_test);
+   tcase_add_test(tc, evas_filter_blur_gaussian_cpu);
+   tcase_add_test(tc, evas_filter_parallel_chain);
 }
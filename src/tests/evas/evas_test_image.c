@@ -4,11 +4,17 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #include <stdio.h>
 
+#include <Emile.h>
+
+#include "../../lib/evas/include/evas_common_private.h"
 #include "evas_suite.h"
 #include "Evas.h"
+#include "Ecore_Evas.h"
 #include "evas_tests_helpers.h"
 
 #define TESTS_IMG_DIR TESTS_SRC_DIR"/images"
@@ -398,6 +404,139 @@ START_TEST(evas_object_image_tgv_loader_data)
 }
 END_TEST
 
+#define TGV_THREADS_MAX 16
+
+/* The slices of the tgv decode given to the evas worker pool, and the
+ * threads that ran them */
+static struct {
+   void (*cb)(void *data, int start, int end);
+   void *data;
+   Eina_Lock lock;
+   Eina_Thread threads[TGV_THREADS_MAX];
+   int count;
+} _tgv_slices;
+
+static void
+_tgv_slice_run(void *data EINA_UNUSED, int start, int end)
+{
+   Eina_Thread self = eina_thread_self();
+   int i;
+
+   eina_lock_take(&_tgv_slices.lock);
+   for (i = 0; i < _tgv_slices.count; i++)
+     if (eina_thread_equal(_tgv_slices.threads[i], self)) break;
+   if ((i == _tgv_slices.count) && (i < TGV_THREADS_MAX))
+     _tgv_slices.threads[_tgv_slices.count++] = self;
+   eina_lock_release(&_tgv_slices.lock);
+
+   _tgv_slices.cb(_tgv_slices.data, start, end);
+}
+
+static void
+_tgv_parallel_run(int count, int min_chunk,
+                  void (*cb)(void *data, int start, int end), void *data)
+{
+   _tgv_slices.cb = cb;
+   _tgv_slices.data = data;
+   evas_loader_parallel_run(count, min_chunk, _tgv_slice_run, NULL);
+}
+
+/* Decodes the region of file to argb, on the evas worker pool if parallel,
+ * else on this thread only. The whole image when region is NULL. */
+static unsigned int *
+_tgv_decode(const char *file, const Eina_Rectangle *region, Eina_Bool parallel,
+            unsigned int *w, unsigned int *h)
+{
+   Emile_Image_Load_Opts opts;
+   Emile_Image_Property prop;
+   Emile_Image_Load_Error error;
+   Emile_Image *image;
+   Eina_File *f;
+   unsigned int *pixels;
+
+   f = eina_file_open(file, EINA_FALSE);
+   fail_if(!f);
+   memset(&opts, 0, sizeof (opts));
+   if (region) opts.region = *region;
+   image = emile_image_tgv_file_open(f, region ? &opts : NULL, NULL, &error);
+   fail_if(!image);
+   if (parallel) emile_image_parallel_set(image, _tgv_parallel_run);
+
+   memset(&prop, 0, sizeof (prop));
+   fail_if(!emile_image_head(image, &prop, sizeof (prop), &error));
+   /* the head gives the image size, the caller asks for the region */
+   if (region)
+     {
+        prop.w = region->w;
+        prop.h = region->h;
+     }
+   prop.cspace = EMILE_COLORSPACE_ARGB8888;
+   pixels = malloc(prop.w * prop.h * sizeof (unsigned int));
+   fail_if(!pixels);
+   fail_if(!emile_image_data(image, &prop, sizeof (prop), pixels, &error));
+   *w = prop.w;
+   *h = prop.h;
+
+   emile_image_close(image);
+   eina_file_close(f);
+   return pixels;
+}
+
+/* The macroblocks of a large tgv decoded by several threads, or only those
+ * in a region, give the pixels the whole image decoded by one thread has. */
+START_TEST(evas_object_image_tgv_parallel)
+{
+   const char *file = TESTS_IMG_DIR "/Light-50.tgv";
+   Eina_Rectangle regions[] = {
+     { 1, 1, 37, 29 },
+     { 130, 67, 301, 213 },
+     { 957, 5, 611, 1270 },
+     { 1843, 1227, 77, 53 }
+   };
+   unsigned int *ref, *out;
+   unsigned int w, h, rw, rh, i, j, y;
+
+   /* the pool is sized once, by the first job */
+   setenv("EVAS_WORKER_THREADS", "4", 1);
+   evas_init();
+   eina_lock_new(&_tgv_slices.lock);
+
+   ref = _tgv_decode(file, NULL, EINA_FALSE, &w, &h);
+   ck_assert_int_eq(w, 1920);
+   ck_assert_int_eq(h, 1280);
+
+   _tgv_slices.count = 0;
+   out = _tgv_decode(file, NULL, EINA_TRUE, &rw, &rh);
+   _ck_assert_int(_tgv_slices.count, >, 1);
+   fail_if((rw != w) || (rh != h));
+   for (i = 0; i < w * h; i++)
+     ck_assert_msg(out[i] == ref[i], "pixel %u,%u is %#x instead of %#x",
+                   i % w, i / w, out[i], ref[i]);
+   free(out);
+
+   /* regions starting anywhere, up to the bottom right corner */
+   for (j = 0; j < 2; j++)
+     for (i = 0; i < EINA_C_ARRAY_LENGTH(regions); i++)
+       {
+          const Eina_Rectangle *r = &regions[i];
+
+          out = _tgv_decode(file, r, j, &rw, &rh);
+          ck_assert_int_eq(rw, r->w);
+          ck_assert_int_eq(rh, r->h);
+          for (y = 0; y < rh; y++)
+            ck_assert_msg(!memcmp(out + (y * rw), ref + ((r->y + y) * w) + r->x,
+                                  rw * sizeof (unsigned int)),
+                          "region %u (parallel %u): row %u differs", i, j, y);
+          free(out);
+       }
+
+   free(ref);
+   eina_lock_free(&_tgv_slices.lock);
+   evas_shutdown();
+   unsetenv("EVAS_WORKER_THREADS");
+}
+END_TEST
+
 START_TEST(evas_object_image_all_loader_data)
 {
    Evas *e = _setup_evas();
@@ -467,6 +606,112 @@ START_TEST(evas_object_image_all_loader_data)
 }
 END_TEST
 
+START_TEST(evas_object_image_region_load)
+{
+   static const char *files[] = {
+     "Pic4.png", /* rgb */
+     "Pic4-png.png", /* palette */
+     "Pic4-xpm.png", /* rgba */
+     "Pic4-wbmp.png", /* 1 bit grey */
+     "bg_gray.png"
+   };
+   static const struct {
+      int x, y, w, h, scale;
+   } cases[] = {
+      { 0, 0, 0, 0, 1 },
+      { 0, 0, 0, 0, 2 },
+      { 0, 0, 0, 0, 3 },
+      { 32, 17, 100, 60, 1 },
+      { 33, 17, 101, 61, 1 },
+      { 10, 11, 40, 30, 2 },
+      { 5, 9, 31, 17, 3 },
+      { 250, 300, 500, 500, 1 }, /* clipped */
+      { 100, 120, 500, 500, 2 }
+   };
+   Evas *e = _setup_evas();
+   Evas_Object *ref, *obj;
+   Eina_Strbuf *str;
+   unsigned int i, j;
+
+   str = eina_strbuf_new();
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(files); i++)
+     {
+        const uint32_t *r_d, *d;
+        int r_w, r_h, w, h, x, y;
+
+        eina_strbuf_reset(str);
+        eina_strbuf_append_printf(str, "%s/%s", TESTS_IMG_DIR, files[i]);
+
+        ref = evas_object_image_add(e);
+        evas_object_image_file_set(ref, eina_strbuf_string_get(str), NULL);
+        fail_if(evas_object_image_load_error_get(ref) != EVAS_LOAD_ERROR_NONE);
+        evas_object_image_size_get(ref, &r_w, &r_h);
+        r_d = evas_object_image_data_get(ref, EINA_FALSE);
+        fail_if(!r_d);
+
+        for (j = 0; j < EINA_C_ARRAY_LENGTH(cases); j++)
+          {
+             int ew, eh, sw, sh;
+
+             obj = evas_object_image_add(e);
+             if (cases[j].scale > 1)
+               evas_object_image_load_scale_down_set(obj, cases[j].scale);
+             if (cases[j].w > 0)
+               evas_object_image_load_region_set(obj, cases[j].x, cases[j].y,
+                                                 cases[j].w, cases[j].h);
+             evas_object_image_file_set(obj, eina_strbuf_string_get(str), NULL);
+             fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE,
+                     "%s case %u failed to load", files[i], j);
+
+             /* the region is in the scaled down image and clipped to it */
+             sw = r_w / cases[j].scale;
+             sh = r_h / cases[j].scale;
+             ew = sw;
+             eh = sh;
+             if (cases[j].w > 0)
+               {
+                  ew = MIN(cases[j].w, sw - cases[j].x);
+                  eh = MIN(cases[j].h, sh - cases[j].y);
+               }
+             evas_object_image_size_get(obj, &w, &h);
+             ck_assert_msg((w == ew) && (h == eh),
+                           "%s case %u is %dx%d instead of %dx%d",
+                           files[i], j, w, h, ew, eh);
+
+             /* and every pixel is the top left one of its scale x scale
+              * block in the full image */
+             d = evas_object_image_data_get(obj, EINA_FALSE);
+             fail_if(!d);
+             for (y = 0; y < h; y++)
+               for (x = 0; x < w; x++)
+                 {
+                    uint32_t expected;
+
+                    expected = r_d[((cases[j].y + y) * cases[j].scale * r_w) +
+                                   ((cases[j].x + x) * cases[j].scale)];
+                    ck_assert_msg(d[(y * w) + x] == expected,
+                                  "%s case %u: pixel %d,%d is %#x instead of %#x",
+                                  files[i], j, x, y, d[(y * w) + x], expected);
+                 }
+             evas_object_del(obj);
+          }
+
+        /* nothing left once clipped */
+        obj = evas_object_image_add(e);
+        evas_object_image_load_region_set(obj, r_w, 0, 10, 10);
+        evas_object_image_file_set(obj, eina_strbuf_string_get(str), NULL);
+        fail_if(evas_object_image_load_error_get(obj) == EVAS_LOAD_ERROR_NONE);
+        evas_object_del(obj);
+
+        evas_object_del(ref);
+     }
+   eina_strbuf_free(str);
+
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
 const char *buggy[] = {
   "BMP301K"
 };
@@ -528,16 +773,768 @@ START_TEST(evas_object_image_buggy)
 }
 END_TEST
 
+#ifdef BUILD_ENGINE_BUFFER
+#define MAP_W 160
+#define MAP_H 160
+#define MAP_CASES 12
+/* Enough for the maps to be drawn in bands, see MAP_BAND_PIXELS */
+#define MAP_BANDS_SCALE 3
+
+/* Draws the test maps in a child process with the cpu features named in
+ * noenv turned off, evas only looks them up once per process. So is the
+ * number of threads drawing large maps, when given. The canvas and the
+ * maps are scale times larger than MAP_W x MAP_H. */
+static void
+_map_cpu_render(const char **noenv, const char *threads, int scale,
+                unsigned int *out)
+{
+   pid_t pid;
+   int status;
+
+   pid = fork();
+   fail_if(pid < 0);
+   if (!pid)
+     {
+        Ecore_Evas *ee;
+        Evas *e;
+        Evas_Object *bg, *o;
+        Evas_Map *m;
+        unsigned int *data;
+        int i, x, y;
+
+        for (; *noenv; noenv++)
+          setenv(*noenv, "1", 1);
+        if (threads) setenv("EVAS_WORKER_THREADS", threads, 1);
+        evas_init();
+        ecore_evas_init();
+        ee = ecore_evas_buffer_new(MAP_W * scale, MAP_H * scale);
+        ecore_evas_show(ee);
+        ecore_evas_manual_render_set(ee, EINA_TRUE);
+        e = ecore_evas_get(ee);
+
+        bg = evas_object_rectangle_add(e);
+        evas_object_geometry_set(bg, 0, 0, MAP_W * scale, MAP_H * scale);
+        evas_object_color_set(bg, 20, 40, 60, 255);
+        evas_object_show(bg);
+
+        /* premultiplied pattern with every level of alpha */
+        o = evas_object_image_filled_add(e);
+        evas_object_image_size_set(o, 64, 64);
+        evas_object_image_alpha_set(o, EINA_TRUE);
+        data = evas_object_image_data_get(o, EINA_TRUE);
+        for (y = 0; y < 64; y++)
+          for (x = 0; x < 64; x++)
+            {
+               int a = (x * 4) | (y & 3);
+               int r = ((x ^ y) * 4) & 0xff, g = (y * 4) & 0xff, b = 255 - g;
+
+               data[(y * 64) + x] = (a << 24) | (((r * a) / 255) << 16) |
+                 (((g * a) / 255) << 8) | ((b * a) / 255);
+            }
+        evas_object_image_data_set(o, data);
+        evas_object_geometry_set(o, 20 * scale, 30 * scale, 120 * scale, 90 * scale);
+        evas_object_show(o);
+
+        for (i = 0; i < MAP_CASES; i++)
+          {
+             m = evas_map_new(4);
+             evas_map_util_points_populate_from_object(m, o);
+             evas_map_util_rotate(m, 17.0 + (i * 29), 80 * scale, 75 * scale);
+             evas_map_util_zoom(m, 1.1, 0.8, 80 * scale, 75 * scale);
+             evas_map_smooth_set(m, i & 1);
+             evas_map_alpha_set(m, EINA_TRUE);
+             /* the color goes to the points, the object color would be
+              * applied by the blend ops instead of the map spans */
+             if ((i >> 2) == 1)
+               evas_map_util_points_color_set(m, 200, 150, 100, 200);
+             else if ((i >> 2) == 2)
+               {
+                  evas_map_point_color_set(m, 0, 255, 0, 0, 255);
+                  evas_map_point_color_set(m, 1, 0, 200, 0, 200);
+                  evas_map_point_color_set(m, 2, 0, 0, 128, 128);
+                  evas_map_point_color_set(m, 3, 255, 255, 255, 255);
+               }
+             evas_object_anti_alias_set(o, !!(i & 2));
+             evas_object_map_set(o, m);
+             evas_object_map_enable_set(o, EINA_TRUE);
+             evas_map_free(m);
+
+             ecore_evas_manual_render(ee);
+             memcpy(out + (i * MAP_W * MAP_H * scale * scale),
+                    ecore_evas_buffer_pixels_get(ee),
+                    MAP_W * MAP_H * scale * scale * 4);
+          }
+
+        ecore_evas_free(ee);
+        ecore_evas_shutdown();
+        evas_shutdown();
+        _exit(0);
+     }
+   fail_if(waitpid(pid, &status, 0) != pid);
+   fail_if(!WIFEXITED(status) || WEXITSTATUS(status));
+}
+
+START_TEST(evas_object_image_map_cpu)
+{
+   static const char *c_only[] = {
+     "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE",
+     "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_NEON", NULL
+   };
+   static const char *no_sse3[] = { "EVAS_CPU_NO_SSE3", NULL };
+   static const char *all[] = { NULL };
+   const char **simd[] = { no_sse3, all };
+   size_t size = MAP_CASES * MAP_W * MAP_H * 4;
+   unsigned int *ref, *out;
+   unsigned int i, j;
+
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   out = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if((ref == MAP_FAILED) || (out == MAP_FAILED));
+
+   /* the mmx and sse spans must draw what the c spans draw */
+   _map_cpu_render(c_only, NULL, 1, ref);
+   for (j = 0; j < EINA_C_ARRAY_LENGTH(simd); j++)
+     {
+        _map_cpu_render(simd[j], NULL, 1, out);
+        for (i = 0; i < MAP_CASES * MAP_W * MAP_H; i++)
+          ck_assert_msg(out[i] == ref[i],
+                        "set %u, case %u: pixel %u,%u is %#x instead of %#x",
+                        j, i / (MAP_W * MAP_H), i % MAP_W, (i / MAP_W) % MAP_H,
+                        out[i], ref[i]);
+     }
+
+   munmap(ref, size);
+   munmap(out, size);
+}
+END_TEST
+
+START_TEST(evas_object_image_map_bands)
+{
+   static const char *all[] = { NULL };
+   const unsigned int w = MAP_W * MAP_BANDS_SCALE, h = MAP_H * MAP_BANDS_SCALE;
+   size_t size = MAP_CASES * w * h * 4;
+   unsigned int *ref, *out;
+   unsigned int i;
+
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   out = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if((ref == MAP_FAILED) || (out == MAP_FAILED));
+
+   /* maps drawn in bands of rows by several threads must draw what a
+    * single thread draws in one go */
+   _map_cpu_render(all, "1", MAP_BANDS_SCALE, ref);
+   _map_cpu_render(all, "4", MAP_BANDS_SCALE, out);
+   for (i = 0; i < MAP_CASES * w * h; i++)
+     ck_assert_msg(out[i] == ref[i],
+                   "case %u: pixel %u,%u is %#x instead of %#x",
+                   i / (w * h), i % w, (i / w) % h, out[i], ref[i]);
+
+   /* with something drawn in each case */
+   for (i = 0; i < MAP_CASES; i++)
+     fail_if(ref[(i * w * h) + ((h / 2) * w) + (w / 2)] == ref[i * w * h]);
+
+   munmap(ref, size);
+   munmap(out, size);
+}
+END_TEST
+#endif
+
+/* yuy2 and nv12 sizes are not multiples of the 8 pixels done at once by the
+ * sse2 rows, the last one is big enough to be converted in slices. Tiled
+ * nv12 is made of 64x32 macroblocks, with an odd count of macroblock rows
+ * in the second one. */
+static const struct {
+   int w, h;
+} yuv_sizes[] = {
+   { 2, 2 }, { 6, 4 }, { 14, 6 }, { 17, 4 }, { 33, 10 }, { 64, 32 }, { 650, 240 }
+}, yuv_tiled_sizes[] = {
+   { 64, 32 }, { 128, 96 }, { 192, 64 }
+};
+
+#define YUV_SRC_SIZE (1024 * 1024)
+
+static size_t
+_yuv_cpu_out_size(void)
+{
+   size_t size = 0;
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(yuv_sizes); i++)
+     size += 2 * yuv_sizes[i].w * yuv_sizes[i].h;
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(yuv_tiled_sizes); i++)
+     size += yuv_tiled_sizes[i].w * yuv_tiled_sizes[i].h;
+   return size * 4;
+}
+
+/* Converts the same random frames in every format in a child process with
+ * the cpu features named in noenv turned off, and copies the pixels to out. */
+static void
+_yuv_cpu_convert(const char **noenv, unsigned int *out)
+{
+   pid_t pid;
+   int status;
+
+   pid = fork();
+   fail_if(pid < 0);
+   if (!pid)
+     {
+        unsigned char *src, *rows[1024];
+        unsigned int *dst, seed = 0x1234567;
+        unsigned int i;
+        int j;
+
+        for (; *noenv; noenv++)
+          setenv(*noenv, "1", 1);
+        evas_init();
+        /* done by the engines otherwise */
+        evas_common_cpu_init();
+
+        src = malloc(YUV_SRC_SIZE);
+        /* odd widths write one pixel past the end of the rows */
+        dst = malloc((650 * 241 * 4) + 64);
+        if (!src || !dst) _exit(1);
+        for (j = 0; j < YUV_SRC_SIZE; j++)
+          {
+             seed = (seed * 1103515245) + 12345;
+             src[j] = seed >> 16;
+          }
+
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(yuv_sizes); i++)
+          {
+             int w = yuv_sizes[i].w, h = yuv_sizes[i].h;
+             int stride = (w + 1) & ~0x1;
+
+             /* packed y0 u y1 v rows */
+             for (j = 0; j < h; j++)
+               rows[j] = src + (j * stride * 2);
+             evas_common_convert_yuv_422_601_rgba(rows, (DATA8 *)dst, w, h);
+             memcpy(out, dst, w * h * 4);
+             out += w * h;
+
+             /* luma rows, then half height rows of interleaved u v */
+             for (j = 0; j < h; j++)
+               rows[j] = src + (j * stride);
+             for (j = 0; j < h / 2; j++)
+               rows[h + j] = src + (h * stride) + (j * stride);
+             evas_common_convert_yuv_420_601_rgba(rows, (DATA8 *)dst, w, h);
+             memcpy(out, dst, w * h * 4);
+             out += w * h;
+          }
+
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(yuv_tiled_sizes); i++)
+          {
+             int w = yuv_tiled_sizes[i].w, h = yuv_tiled_sizes[i].h;
+             /* a pair of macroblock rows per pointer, luma then chroma */
+             int span = (w / 64) * 2 * 64 * 32;
+
+             for (j = 0; j <= h / 32; j++)
+               rows[j] = src + (j * span * 2);
+             evas_common_convert_yuv_420T_601_rgba(rows, (DATA8 *)dst, w, h);
+             memcpy(out, dst, w * h * 4);
+             out += w * h;
+          }
+
+        free(src);
+        free(dst);
+        evas_shutdown();
+        _exit(0);
+     }
+   fail_if(waitpid(pid, &status, 0) != pid);
+   fail_if(!WIFEXITED(status) || WEXITSTATUS(status));
+}
+
+START_TEST(evas_object_image_yuv_cpu)
+{
+   static const char *c_only[] = {
+     "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE",
+     "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_NEON", NULL
+   };
+   static const char *all[] = { NULL };
+   size_t size = _yuv_cpu_out_size();
+   unsigned int *ref, *out;
+   unsigned int i;
+
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   out = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if((ref == MAP_FAILED) || (out == MAP_FAILED));
+
+   /* the sse2 yuy2, nv12 and tiled nv12 converters must give what the c
+    * ones give */
+   _yuv_cpu_convert(c_only, ref);
+   _yuv_cpu_convert(all, out);
+   for (i = 0; i < size / 4; i++)
+     ck_assert_msg(out[i] == ref[i], "pixel %u is %#x instead of %#x",
+                   i, out[i], ref[i]);
+
+   munmap(ref, size);
+   munmap(out, size);
+}
+END_TEST
+
+START_TEST(evas_object_image_prescale_queue)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *obj;
+   int w, h;
+
+   obj = evas_object_image_filled_add(e);
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+   evas_object_image_size_get(obj, &w, &h);
+   fail_if(w <= 1 || h <= 1);
+
+   /* the data is not decoded for it */
+   fail_if(evas_object_image_prescale(obj, w / 2, h / 2));
+   fail_if(!evas_object_image_data_get(obj, EINA_FALSE));
+
+   fail_if(evas_object_image_prescale(obj, 0, h / 2));
+   fail_if(evas_object_image_prescale(obj, w, h));
+   fail_if(!evas_object_image_prescale(obj, w / 2, h / 2));
+   /* already queued */
+   fail_if(!evas_object_image_prescale(obj, w / 2, h / 2));
+
+   evas_object_image_border_set(obj, 1, 1, 1, 1);
+   fail_if(evas_object_image_prescale(obj, w / 3, h / 3));
+
+   evas_object_del(obj);
+
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
+START_TEST(evas_object_image_prescale_stats)
+{
+   unsigned int hits, misses, populated, prescaled, size;
+   unsigned int hits2, misses2, populated2, prescaled2, size2;
+   Ecore_Evas *ee;
+   Evas *e;
+   Evas_Object *obj;
+   int w, h, tries = 0;
+
+   evas_init();
+   ecore_evas_init();
+   ee = ecore_evas_buffer_new(500, 500);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   obj = evas_object_image_filled_add(e);
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+   evas_object_image_size_get(obj, &w, &h);
+   evas_object_resize(obj, w / 2, h / 2);
+   evas_object_show(obj);
+   fail_if(!evas_object_image_data_get(obj, EINA_FALSE));
+
+   evas_image_scale_cache_stats_get(e, NULL, NULL, NULL, &prescaled, NULL,
+                                    &size);
+   fail_if(!evas_object_image_prescale(obj, w / 2, h / 2));
+   do
+     {
+        usleep(1000);
+        evas_async_events_process();
+        evas_image_scale_cache_stats_get(e, &hits, &misses, &populated,
+                                         &prescaled2, NULL, &size2);
+     }
+   while ((prescaled2 == prescaled) && (++tries < 5000));
+   ck_assert_int_eq(prescaled2, prescaled + 1);
+   fail_if(size2 <= size);
+
+   /* the first draw at that size is served from the cache */
+   ecore_evas_manual_render(ee);
+   evas_image_scale_cache_stats_get(e, &hits2, &misses2, &populated2,
+                                    NULL, NULL, NULL);
+   ck_assert_int_eq(hits2, hits + 1);
+   ck_assert_int_eq(misses2, misses);
+   ck_assert_int_eq(populated2, populated);
+
+   /* while a size nobody asked for is scaled from the original */
+   evas_object_resize(obj, w / 3, h / 3);
+   ecore_evas_manual_render(ee);
+   evas_image_scale_cache_stats_get(e, &hits, &misses, NULL, NULL, NULL,
+                                    NULL);
+   ck_assert_int_eq(hits, hits2);
+   ck_assert_int_eq(misses, misses2 + 1);
+
+   evas_object_del(obj);
+
+   ecore_evas_free(ee);
+   ecore_evas_shutdown();
+   evas_shutdown();
+}
+END_TEST
+
+static Eina_Bool
+_cached_image_find_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED,
+                      void *data, void *fdata)
+{
+   Image_Entry *ie = data, **found = fdata;
+
+   if ((!ie->file) || (strcmp(ie->file, (*found)->file))) return EINA_TRUE;
+   if (ie->load_opts.w != (*found)->load_opts.w) return EINA_TRUE;
+   *found = ie;
+   return EINA_FALSE;
+}
+
+/* The entry of a file loaded at the given width, 0 when it has no load size */
+static Image_Entry *
+_cached_image_sized_find(const char *file, unsigned int w)
+{
+   Evas_Cache_Image *cache = evas_common_image_cache_get();
+   Image_Entry key = { .file = file, .load_opts.w = w }, *found = &key;
+
+   eina_hash_foreach(cache->activ, _cached_image_find_cb, &found);
+   if (found == &key)
+     eina_hash_foreach(cache->inactiv, _cached_image_find_cb, &found);
+   return (found == &key) ? NULL : found;
+}
+
+static Image_Entry *
+_cached_image_find(const char *file)
+{
+   return _cached_image_sized_find(file, 0);
+}
+
+typedef struct _Preload_Order Preload_Order;
+struct _Preload_Order
+{
+   char served[16];
+   int count;
+   int preloaded;
+};
+
+static void
+_preload_order_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
+                  void *event_info EINA_UNUSED)
+{
+   Preload_Order *order = data;
+   char name = (char)(uintptr_t)evas_object_data_get(obj, "name");
+
+   order->preloaded++;
+   if ((name) && (order->count < (int)sizeof(order->served) - 1))
+     order->served[order->count++] = name;
+}
+
+static void
+_preload_order_wait(Preload_Order *order, int preloaded)
+{
+   int tries = 0;
+
+   while ((order->preloaded < preloaded) && (++tries < 5000))
+     {
+        usleep(1000);
+        evas_async_events_process();
+     }
+}
+
+START_TEST(evas_object_image_preload_priority)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *obj, *objs[8], **blockers;
+   Image_Entry **entries;
+   Preload_Order order = { "", 0, 0 };
+   int i, threads;
+
+   obj = evas_object_image_add(e);
+   fail_if(evas_object_image_preload_priority_get(obj) != EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+
+   evas_object_image_preload_priority_set(obj, EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE);
+   fail_if(evas_object_image_preload_priority_get(obj) != EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE);
+
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+   evas_object_image_preload(obj, EINA_FALSE);
+
+   /* raising a pending preload, then cancelling it */
+   evas_object_image_preload_priority_set(obj, EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+   fail_if(evas_object_image_preload_priority_get(obj) != EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+   evas_object_image_preload(obj, EINA_TRUE);
+
+   /* out of range values are ignored */
+   evas_object_image_preload_priority_set(obj, EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE + 1);
+   fail_if(evas_object_image_preload_priority_get(obj) != EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+
+   evas_object_del(obj);
+
+   /* Every preload thread but one is held on an image of its own, so the
+    * queued preloads are served one at a time: the visible ones first,
+    * then the speculative ones, each queue in the order it was filled.
+    * Each object loads at its own size, to get an entry of its own. */
+   threads = eina_cpu_count();
+   blockers = calloc(threads, sizeof (Evas_Object *));
+   entries = calloc(threads, sizeof (Image_Entry *));
+   fail_if(!blockers || !entries);
+   for (i = 0; i < threads; i++)
+     {
+        blockers[i] = evas_object_image_add(e);
+        evas_object_image_load_size_set(blockers[i], 1 + i, 1 + i);
+        evas_object_image_file_set(blockers[i], TESTS_IMG_DIR"/Pic1.png", NULL);
+        entries[i] = _cached_image_sized_find(TESTS_IMG_DIR"/Pic1.png", 1 + i);
+        fail_if(!entries[i]);
+        SLKL(entries[i]->lock);
+        evas_object_event_callback_add(blockers[i], EVAS_CALLBACK_IMAGE_PRELOADED,
+                                       _preload_order_cb, &order);
+        evas_object_image_preload(blockers[i], EINA_FALSE);
+     }
+
+   for (i = 0; i < 8; i++)
+     {
+        objs[i] = evas_object_image_add(e);
+        evas_object_data_set(objs[i], "name",
+                             (void *)(uintptr_t)((i < 4) ? 'a' + i : 'A' + i - 4));
+        evas_object_image_preload_priority_set(objs[i], (i < 4) ?
+                                               EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE :
+                                               EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+        evas_object_image_load_size_set(objs[i], 100 + i, 100 + i);
+        evas_object_image_file_set(objs[i], TESTS_IMG_DIR"/Pic1.png", NULL);
+        fail_if(evas_object_image_load_error_get(objs[i]) != EVAS_LOAD_ERROR_NONE);
+        evas_object_event_callback_add(objs[i], EVAS_CALLBACK_IMAGE_PRELOADED,
+                                       _preload_order_cb, &order);
+        evas_object_image_preload(objs[i], EINA_FALSE);
+     }
+
+   /* a queued preload moves to the end of its new queue */
+   evas_object_image_preload_priority_set(objs[1], EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE);
+   evas_object_image_preload_priority_set(objs[6], EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE);
+
+   SLKU(entries[0]->lock);
+   _preload_order_wait(&order, 9);
+   for (i = 1; i < threads; i++)
+     SLKU(entries[i]->lock);
+   _preload_order_wait(&order, 8 + threads);
+
+   ck_assert_int_eq(order.preloaded, 8 + threads);
+   ck_assert_str_eq(order.served, "ABDbacdC");
+
+   for (i = 0; i < 8; i++)
+     evas_object_del(objs[i]);
+   for (i = 0; i < threads; i++)
+     evas_object_del(blockers[i]);
+   free(blockers);
+   free(entries);
+
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
+START_TEST(evas_object_image_cache_budget)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *obj;
+   unsigned int hits, misses, evictions;
+   unsigned int hits2, misses2, evictions2;
+
+   evas_image_cache_tag_limit_set(e, 1, 0);
+   fail_if(evas_image_cache_tag_limit_get(e, 1) != 0);
+   fail_if(evas_image_cache_tag_limit_get(e, 2) != -1);
+
+   evas_image_cache_stats_get(e, &hits, &misses, &evictions, NULL, NULL);
+
+   /* tag 1 has no room, its images go as soon as they are unused */
+   obj = evas_object_image_add(e);
+   evas_object_image_cache_tag_set(obj, 1);
+   fail_if(evas_object_image_cache_tag_get(obj) != 1);
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+   evas_object_del(obj);
+
+   evas_image_cache_stats_get(e, &hits2, &misses2, &evictions2, NULL, NULL);
+   fail_if(misses2 != misses + 1);
+   fail_if(evictions2 != evictions + 1);
+
+   evas_image_cache_tag_limit_set(e, 1, -1);
+
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
+START_TEST(evas_object_image_cache_pin)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *obj, *obj2;
+   Image_Entry *ie;
+   unsigned int evictions, evictions2, demotions, demotions2;
+   int size;
+
+   evas_image_cache_tag_limit_set(e, 1, 0);
+   evas_image_cache_stats_get(e, NULL, NULL, &evictions, NULL, NULL);
+
+   /* each object holds its own pin */
+   obj = evas_object_image_add(e);
+   evas_object_image_cache_tag_set(obj, 1);
+   evas_object_image_cache_pinned_set(obj, EINA_TRUE);
+   fail_if(!evas_object_image_cache_pinned_get(obj));
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+
+   obj2 = evas_object_image_add(e);
+   evas_object_image_cache_tag_set(obj2, 1);
+   evas_object_image_file_set(obj2, TESTS_IMG_DIR"/Pic1.png", NULL);
+   evas_object_image_cache_pinned_set(obj2, EINA_TRUE);
+
+   ie = _cached_image_find(TESTS_IMG_DIR"/Pic1.png");
+   fail_if(!ie);
+   ck_assert_int_eq(ie->pins, 2);
+
+   /* and gives it back when deleted */
+   evas_object_del(obj);
+   ck_assert_int_eq(ie->pins, 1);
+
+   /* or when loading another file, the image is then cached as usual */
+   evas_object_image_file_set(obj2, TESTS_IMG_DIR"/Pic4.png", NULL);
+   fail_if(_cached_image_find(TESTS_IMG_DIR"/Pic1.png"));
+   evas_image_cache_stats_get(e, NULL, NULL, &evictions2, NULL, NULL);
+   fail_if(evictions2 != evictions + 1);
+
+   ie = _cached_image_find(TESTS_IMG_DIR"/Pic4.png");
+   fail_if(!ie);
+   ck_assert_int_eq(ie->pins, 1);
+
+   /* or when unset */
+   evas_object_image_cache_pinned_set(obj2, EINA_FALSE);
+   ck_assert_int_eq(ie->pins, 0);
+   evas_object_del(obj2);
+   evas_image_cache_stats_get(e, NULL, NULL, &evictions, &demotions, NULL);
+   fail_if(evictions != evictions2 + 1);
+
+   /* a header stays in its own lru whatever its tag */
+   size = evas_image_cache_get(e);
+   evas_image_cache_set(e, 4 * 1024 * 1024);
+   evas_image_cache_headers_set(e, 1024 * 1024);
+   obj = evas_object_image_add(e);
+   evas_object_image_cache_tag_set(obj, 1);
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   evas_object_del(obj);
+   evas_image_cache_stats_get(e, NULL, NULL, NULL, &demotions2, NULL);
+   fail_if(demotions2 != demotions + 1);
+
+   ie = _cached_image_find(TESTS_IMG_DIR"/Pic1.png");
+   fail_if(!ie);
+   fail_if(!ie->flags.lru_headers);
+   evas_cache_image_tag_set(ie, 0);
+   fail_if(!ie->flags.lru_headers);
+   fail_if(ie->cache_tag->lru == EINA_INLIST_GET(ie));
+   evas_cache_image_flush(ie->cache);
+
+   evas_image_cache_headers_set(e, 0);
+   fail_if(_cached_image_find(TESTS_IMG_DIR"/Pic1.png"));
+   evas_image_cache_set(e, size);
+   evas_image_cache_tag_limit_set(e, 1, -1);
+
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
+START_TEST(evas_object_image_cache_headers)
+{
+   Evas *e = _setup_evas();
+   Evas_Object *obj;
+   Evas_Cache_Image *cache;
+   Image_Entry *ie;
+   unsigned int hits, misses, evictions, demotions;
+   unsigned int hits2, misses2, evictions2, demotions2;
+   int size, header, w, h, stride;
+   const void *data;
+   void *orig;
+
+   /* start from an empty inactive cache */
+   size = evas_image_cache_get(e);
+   evas_image_cache_set(e, 0);
+   evas_image_cache_set(e, 4 * 1024 * 1024);
+   evas_image_cache_headers_set(e, 1024 * 1024);
+   evas_image_cache_tag_limit_set(e, 1, 0);
+
+   obj = evas_object_image_add(e);
+   evas_object_image_cache_tag_set(obj, 1);
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+   evas_object_image_size_get(obj, &w, &h);
+   stride = evas_object_image_stride_get(obj);
+   data = evas_object_image_data_get(obj, EINA_FALSE);
+   fail_if(!data);
+   orig = malloc(stride * h);
+   memcpy(orig, data, stride * h);
+
+   /* going over the tag budget only drops the pixels */
+   evas_image_cache_stats_get(e, &hits, &misses, NULL, &demotions, NULL);
+   evas_object_del(obj);
+   evas_image_cache_stats_get(e, NULL, NULL, NULL, &demotions2, NULL);
+   fail_if(demotions2 != demotions + 1);
+
+   ie = _cached_image_find(TESTS_IMG_DIR"/Pic1.png");
+   fail_if(!ie);
+   fail_if(!ie->flags.lru_headers);
+   fail_if(ie->flags.loaded);
+   cache = ie->cache;
+   header = ie->cache_usage;
+   fail_if(header <= 0);
+
+   /* a new request is served by the header, the pixels are loaded again */
+   obj = evas_object_image_add(e);
+   evas_object_image_cache_tag_set(obj, 1);
+   evas_object_image_file_set(obj, TESTS_IMG_DIR"/Pic1.png", NULL);
+   fail_if(evas_object_image_load_error_get(obj) != EVAS_LOAD_ERROR_NONE);
+   evas_image_cache_stats_get(e, &hits2, &misses2, NULL, NULL, NULL);
+   fail_if(hits2 != hits + 1);
+   fail_if(misses2 != misses);
+   fail_if(_cached_image_find(TESTS_IMG_DIR"/Pic1.png") != ie);
+   fail_if(ie->flags.lru_headers);
+
+   data = evas_object_image_data_get(obj, EINA_FALSE);
+   fail_if(!data);
+   fail_if(evas_object_image_stride_get(obj) != stride);
+   fail_if(memcmp(orig, data, stride * h));
+   free(orig);
+
+   /* a header demoted by the global limit still has to fit in the
+    * headers budget */
+   evas_image_cache_tag_limit_set(e, 1, -1);
+   evas_object_del(obj);
+   fail_if(ie->flags.lru_headers);
+   evas_image_cache_headers_set(e, header - 1);
+   evas_image_cache_stats_get(e, NULL, NULL, &evictions, &demotions, NULL);
+   evas_image_cache_set(e, cache->usage - 1);
+   evas_image_cache_stats_get(e, NULL, NULL, &evictions2, &demotions2, NULL);
+   fail_if(demotions2 != demotions + 1);
+   fail_if(evictions2 != evictions + 1);
+   fail_if(_cached_image_find(TESTS_IMG_DIR"/Pic1.png"));
+   fail_if(cache->lru_headers);
+
+   evas_image_cache_headers_set(e, 0);
+   evas_image_cache_set(e, size);
+
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
 void evas_test_image_object(TCase *tc)
 {
    tcase_add_test(tc, evas_object_image_loader);
    tcase_add_test(tc, evas_object_image_loader_orientation);
    tcase_add_test(tc, evas_object_image_orient);
+#ifdef BUILD_ENGINE_BUFFER
+   tcase_add_test(tc, evas_object_image_map_cpu);
+   tcase_add_test(tc, evas_object_image_map_bands);
+#endif
+   tcase_add_test(tc, evas_object_image_yuv_cpu);
 #if BUILD_LOADER_TGV && BUILD_LOADER_PNG
    tcase_add_test(tc, evas_object_image_tgv_loader_data);
 #endif
+   tcase_add_test(tc, evas_object_image_tgv_parallel);
 #if BUILD_LOADER_PNG
    tcase_add_test(tc, evas_object_image_all_loader_data);
+   tcase_add_test(tc, evas_object_image_region_load);
    tcase_add_test(tc, evas_object_image_buggy);
+   tcase_add_test(tc, evas_object_image_prescale_queue);
+   tcase_add_test(tc, evas_object_image_prescale_stats);
+   tcase_add_test(tc, evas_object_image_preload_priority);
+   tcase_add_test(tc, evas_object_image_cache_budget);
+   tcase_add_test(tc, evas_object_image_cache_pin);
+   tcase_add_test(tc, evas_object_image_cache_headers);
 #endif
 }
@@ -4,6 +4,8 @@
 
 #include <unistd.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 
 #include "../../lib/evas/include/evas_common_private.h"
 #include "../../lib/evas/include/evas_private.h"
@@ -130,7 +132,370 @@ START_TEST(evas_object_mesh_loader_saver)
 }
 END_TEST
 
+#define PICK_SIZE 64
+#define PICK_FRAME_LAST 10
+#define PICK_TRIANGLES 300
+#define PICK_GRID_W 16
+#define PICK_GRID_H 12
+
+static Evas_3D_Mesh_Frame *
+_pick_frame_get(Evas_3D_Mesh_Data *pd, int frame)
+{
+   Eina_List *l;
+   Evas_3D_Mesh_Frame *f;
+
+   EINA_LIST_FOREACH(pd->frames, l, f)
+     {
+        if (f->frame == frame)
+          return f;
+     }
+
+   return NULL;
+}
+
+/* Position of a vertex at the given frame, interpolated between the two key
+ * frames the way the mesh does it. */
+static void
+_pick_position_get(Evas_3D_Mesh_Data *pd, int frame, int index, Evas_Vec3 *out)
+{
+   const float *p0, *p1;
+   Evas_Real w;
+
+   p0 = (const float *)_pick_frame_get(pd, 0)->vertices[EVAS_3D_VERTEX_POSITION].data + (index * 3);
+   p1 = (const float *)_pick_frame_get(pd, PICK_FRAME_LAST)->vertices[EVAS_3D_VERTEX_POSITION].data + (index * 3);
+
+   if (frame == 0)
+     evas_vec3_set(out, p0[0], p0[1], p0[2]);
+   else if (frame == PICK_FRAME_LAST)
+     evas_vec3_set(out, p1[0], p1[1], p1[2]);
+   else
+     {
+        w = (PICK_FRAME_LAST - frame) / (Evas_Real)PICK_FRAME_LAST;
+        evas_vec3_set(out,
+                      p0[0] * w + p1[0] * (1.0 - w),
+                      p0[1] * w + p1[1] * (1.0 - w),
+                      p0[2] * w + p1[2] * (1.0 - w));
+     }
+}
+
+/* Picks by testing every triangle of the mesh, as picking did before the
+ * meshes had a bounding volume hierarchy. */
+static Eina_Bool
+_pick_brute_force(Evas_3D_Node *camera_node, Evas_3D_Node *node,
+                  Evas_3D_Mesh *mesh, int frame, Evas_Real x, Evas_Real y,
+                  Evas_Real *s, Evas_Real *t)
+{
+   Evas_3D_Node_Data *pd_camera_node, *pd_node;
+   Evas_3D_Camera_Data *pd_camera;
+   Evas_3D_Mesh_Data *pd;
+   Evas_Mat4 vp, mvp;
+   Evas_Ray3 ray;
+   Evas_Real z = 1.0, hit_u = 0.0, hit_v = 0.0;
+   unsigned int idx[3], hit[3] = { 0, 0, 0 };
+   const float *tex;
+   int i, k, count;
+   Eina_Bool picked = EINA_FALSE;
+
+   pd_camera_node = eo_data_scope_get(camera_node, EVAS_3D_NODE_CLASS);
+   pd_camera = eo_data_scope_get(pd_camera_node->data.camera.camera, EVAS_3D_CAMERA_CLASS);
+   pd_node = eo_data_scope_get(node, EVAS_3D_NODE_CLASS);
+   pd = eo_data_scope_get(mesh, EVAS_3D_MESH_CLASS);
+
+   evas_mat4_multiply(&vp, &pd_camera->projection,
+                      &pd_camera_node->data.camera.matrix_world_to_eye);
+   evas_mat4_multiply(&mvp, &vp, &pd_node->data.mesh.matrix_local_to_world);
+   evas_ray3_init(&ray, ((x * 2.0) / PICK_SIZE) - 1.0,
+                  (((PICK_SIZE - y - 1) * 2.0) / PICK_SIZE) - 1.0, &mvp);
+
+   count = pd->indices ? pd->index_count : pd->vertex_count;
+   if (pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES)
+     count /= 3;
+   else
+     count -= 2;
+
+   for (i = 0; i < count; i++)
+     {
+        Evas_Vec3 p0, p1, p2, e1, e2, tvec, pvec, qvec;
+        Evas_Real det, inv_det, u, v, d;
+
+        for (k = 0; k < 3; k++)
+          {
+             idx[k] = (pd->assembly == EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES) ?
+               (i * 3) + k : i + k;
+             if (pd->indices)
+               idx[k] = ((unsigned short *)pd->indices)[idx[k]];
+          }
+        _pick_position_get(pd, frame, idx[0], &p0);
+        _pick_position_get(pd, frame, idx[1], &p1);
+        _pick_position_get(pd, frame, idx[2], &p2);
+
+        evas_vec3_subtract(&e1, &p1, &p0);
+        evas_vec3_subtract(&e2, &p2, &p0);
+        evas_vec3_cross_product(&pvec, &ray.dir, &e2);
+        det = evas_vec3_dot_product(&e1, &pvec);
+        if (det > -0.0000001 && det < 0.0000001)
+          continue;
+        inv_det = 1.0 / det;
+
+        evas_vec3_subtract(&tvec, &ray.org, &p0);
+        u = evas_vec3_dot_product(&tvec, &pvec) * inv_det;
+        if (u < 0.0 || u > 1.0)
+          continue;
+
+        evas_vec3_cross_product(&qvec, &tvec, &e1);
+        v = evas_vec3_dot_product(&ray.dir, &qvec) * inv_det;
+        if (v < 0.0 || u + v > 1.0)
+          continue;
+
+        d = evas_vec3_dot_product(&e2, &qvec) * inv_det;
+        if (d >= 0.0 && d <= 1.0 && (!picked || d < z))
+          {
+             picked = EINA_TRUE;
+             z = d;
+             hit_u = u;
+             hit_v = v;
+             memcpy(hit, idx, sizeof (hit));
+          }
+     }
+
+   if (!picked)
+     return EINA_FALSE;
+
+   tex = _pick_frame_get(pd, 0)->vertices[EVAS_3D_VERTEX_TEXCOORD].data;
+   *s = tex[hit[0] * 2] * (1 - hit_u - hit_v) +
+     tex[hit[1] * 2] * hit_u + tex[hit[2] * 2] * hit_v;
+   *t = tex[(hit[0] * 2) + 1] * (1 - hit_u - hit_v) +
+     tex[(hit[1] * 2) + 1] * hit_u + tex[(hit[2] * 2) + 1] * hit_v;
+   return EINA_TRUE;
+}
+
+/* Every pixel of the scene picks the same point, or nothing, through the
+ * scene as by brute force. */
+static void
+_pick_compare(Evas_3D_Scene *scene, Evas_3D_Node *camera_node,
+              Evas_3D_Node *node, Evas_3D_Mesh *mesh, int frame)
+{
+   Evas_3D_Node *picked_node;
+   Evas_3D_Mesh *picked_mesh;
+   Evas_Real s, t, bs, bt;
+   Eina_Bool picked, brute;
+   int x, y, hits = 0;
+
+   eo_do(node, evas_3d_node_mesh_frame_set(mesh, frame));
+
+   for (y = 0; y < PICK_SIZE; y++)
+     for (x = 0; x < PICK_SIZE; x++)
+       {
+          picked_node = NULL;
+          picked_mesh = NULL;
+          eo_do(scene,
+                picked = evas_3d_scene_pick(x + 0.5, y + 0.5, &picked_node,
+                                            &picked_mesh, &s, &t));
+          brute = _pick_brute_force(camera_node, node, mesh, frame,
+                                    x + 0.5, y + 0.5, &bs, &bt);
+          ck_assert_msg(picked == brute,
+                        "frame %d: pick at %d,%d is %d instead of %d",
+                        frame, x, y, picked, brute);
+          if (!picked) continue;
+
+          fail_if(picked_node != node);
+          fail_if(picked_mesh != mesh);
+          ck_assert_msg((fabs(s - bs) < 0.000001) && (fabs(t - bt) < 0.000001),
+                        "frame %d: pick at %d,%d is %f,%f instead of %f,%f",
+                        frame, x, y, s, t, bs, bt);
+          hits++;
+       }
+
+   /* the mesh covers a part of the scene only */
+   fail_if(hits == 0);
+   fail_if(hits == PICK_SIZE * PICK_SIZE);
+}
+
+/* Small random triangles at frame 0, stretched and sheared at the last frame */
+static void
+_pick_soup_frame_set(Evas_3D_Mesh *mesh, int frame, float stretch)
+{
+   float pos[PICK_TRIANGLES * 9];
+   float tex[PICK_TRIANGLES * 6];
+   int i, k;
+
+   srand(42);
+   for (i = 0; i < PICK_TRIANGLES; i++)
+     {
+        float cx = 3.0 * rand() / RAND_MAX - 1.5;
+        float cy = 3.0 * rand() / RAND_MAX - 1.5;
+        float cz = 3.0 * rand() / RAND_MAX - 1.5;
+
+        for (k = 0; k < 3; k++)
+          {
+             float *p = pos + (i * 9) + (k * 3);
+             float *tc = tex + (i * 6) + (k * 2);
+
+             p[0] = cx + 0.8 * rand() / RAND_MAX - 0.4;
+             p[1] = cy + 0.8 * rand() / RAND_MAX - 0.4;
+             p[2] = cz + 0.8 * rand() / RAND_MAX - 0.4;
+             p[0] = p[0] * stretch + 0.3 * (stretch - 1.0) * p[2];
+             p[1] = p[1] - 0.2 * (stretch - 1.0) * p[0];
+             tc[0] = (float)rand() / RAND_MAX;
+             tc[1] = (float)rand() / RAND_MAX;
+          }
+     }
+
+   eo_do(mesh,
+         evas_3d_mesh_frame_vertex_data_copy_set(frame, EVAS_3D_VERTEX_POSITION,
+                                                 3 * sizeof(float), pos),
+         evas_3d_mesh_frame_vertex_data_copy_set(frame, EVAS_3D_VERTEX_TEXCOORD,
+                                                 2 * sizeof(float), tex));
+}
+
+/* A bumpy sheet, its rows joined by degenerate triangles */
+static void
+_pick_strip_frame_set(Evas_3D_Mesh *mesh, int frame, float bumps)
+{
+   float pos[PICK_GRID_W * PICK_GRID_H * 3];
+   float tex[PICK_GRID_W * PICK_GRID_H * 2];
+   int i, j;
+
+   for (j = 0; j < PICK_GRID_H; j++)
+     for (i = 0; i < PICK_GRID_W; i++)
+       {
+          float *p = pos + (((j * PICK_GRID_W) + i) * 3);
+          float *tc = tex + (((j * PICK_GRID_W) + i) * 2);
+
+          p[0] = 4.0 * i / (PICK_GRID_W - 1) - 2.0;
+          p[1] = 3.0 * j / (PICK_GRID_H - 1) - 1.5;
+          p[2] = bumps * sinf(i * 0.9) * cosf(j * 1.3);
+          tc[0] = (float)i / (PICK_GRID_W - 1);
+          tc[1] = (float)j / (PICK_GRID_H - 1);
+       }
+
+   eo_do(mesh,
+         evas_3d_mesh_frame_vertex_data_copy_set(frame, EVAS_3D_VERTEX_POSITION,
+                                                 3 * sizeof(float), pos),
+         evas_3d_mesh_frame_vertex_data_copy_set(frame, EVAS_3D_VERTEX_TEXCOORD,
+                                                 2 * sizeof(float), tex));
+}
+
+static Evas_3D_Mesh *
+_pick_strip_add(Evas *e)
+{
+   Evas_3D_Mesh *mesh;
+   unsigned short indices[(PICK_GRID_H - 1) * (PICK_GRID_W * 2 + 2)];
+   int i, j, n = 0;
+
+   for (j = 0; j < PICK_GRID_H - 1; j++)
+     {
+        if (j > 0)
+          indices[n++] = j * PICK_GRID_W;
+        for (i = 0; i < PICK_GRID_W; i++)
+          {
+             indices[n++] = (j * PICK_GRID_W) + i;
+             indices[n++] = ((j + 1) * PICK_GRID_W) + i;
+          }
+        if (j < PICK_GRID_H - 2)
+          indices[n++] = ((j + 1) * PICK_GRID_W) + PICK_GRID_W - 1;
+     }
+
+   mesh = eo_add(EVAS_3D_MESH_CLASS, e);
+   eo_do(mesh,
+         evas_3d_mesh_vertex_count_set(PICK_GRID_W * PICK_GRID_H),
+         evas_3d_mesh_frame_add(0),
+         evas_3d_mesh_frame_add(PICK_FRAME_LAST));
+   _pick_strip_frame_set(mesh, 0, 0.3);
+   _pick_strip_frame_set(mesh, PICK_FRAME_LAST, 1.2);
+   eo_do(mesh,
+         evas_3d_mesh_index_data_copy_set(EVAS_3D_INDEX_FORMAT_UNSIGNED_SHORT,
+                                          n, indices),
+         evas_3d_mesh_vertex_assembly_set(EVAS_3D_VERTEX_ASSEMBLY_TRIANGLE_STRIP));
+
+   return mesh;
+}
+
+static Evas_3D_Mesh *
+_pick_soup_add(Evas *e)
+{
+   Evas_3D_Mesh *mesh;
+
+   mesh = eo_add(EVAS_3D_MESH_CLASS, e);
+   eo_do(mesh,
+         evas_3d_mesh_vertex_count_set(PICK_TRIANGLES * 3),
+         evas_3d_mesh_frame_add(0),
+         evas_3d_mesh_frame_add(PICK_FRAME_LAST));
+   _pick_soup_frame_set(mesh, 0, 1.0);
+   _pick_soup_frame_set(mesh, PICK_FRAME_LAST, 1.4);
+   eo_do(mesh,
+         evas_3d_mesh_vertex_assembly_set(EVAS_3D_VERTEX_ASSEMBLY_TRIANGLES));
+
+   return mesh;
+}
+
+START_TEST(evas_object_mesh_pick)
+{
+   Evas *e = _setup_evas();
+   Evas_3D_Scene *scene;
+   Evas_3D_Node *root, *camera_node, *node;
+   Evas_3D_Camera *camera;
+   Evas_3D_Mesh *mesh;
+   int i;
+
+   scene = eo_add(EVAS_3D_SCENE_CLASS, e);
+   root = eo_add(EVAS_3D_NODE_CLASS, e,
+                 evas_3d_node_constructor(EVAS_3D_NODE_TYPE_NODE));
+
+   camera = eo_add(EVAS_3D_CAMERA_CLASS, e);
+   eo_do(camera,
+         evas_3d_camera_projection_perspective_set(45.0, 1.0, 1.0, 100.0));
+   camera_node = eo_add(EVAS_3D_NODE_CLASS, e,
+                        evas_3d_node_constructor(EVAS_3D_NODE_TYPE_CAMERA));
+   eo_do(camera_node,
+         evas_3d_node_camera_set(camera),
+         evas_3d_node_position_set(0.0, 0.0, 7.0),
+         evas_3d_node_look_at_set(EVAS_3D_SPACE_PARENT, 0.0, 0.0, 0.0,
+                                  EVAS_3D_SPACE_PARENT, 0.0, 1.0, 0.0));
+   eo_do(root, evas_3d_node_member_add(camera_node));
+
+   eo_do(scene,
+         evas_3d_scene_root_node_set(root),
+         evas_3d_scene_camera_node_set(camera_node),
+         evas_3d_scene_size_set(PICK_SIZE, PICK_SIZE));
+
+   for (i = 0; i < 2; i++)
+     {
+        mesh = i ? _pick_strip_add(e) : _pick_soup_add(e);
+        node = eo_add(EVAS_3D_NODE_CLASS, e,
+                      evas_3d_node_constructor(EVAS_3D_NODE_TYPE_MESH));
+        eo_do(node,
+              evas_3d_node_mesh_add(mesh),
+              evas_3d_node_position_set(0.3, -0.2, 0.0),
+              evas_3d_node_orientation_angle_axis_set(35.0, 1.0, 0.5, 0.0));
+        eo_do(root, evas_3d_node_member_add(node));
+
+        /* key frames, and a frame in between that only refits the tree */
+        _pick_compare(scene, camera_node, node, mesh, 0);
+        _pick_compare(scene, camera_node, node, mesh, PICK_FRAME_LAST / 2);
+        _pick_compare(scene, camera_node, node, mesh, PICK_FRAME_LAST);
+
+        /* vertices moved after the tree was built */
+        if (i)
+          _pick_strip_frame_set(mesh, PICK_FRAME_LAST, -0.8);
+        else
+          _pick_soup_frame_set(mesh, PICK_FRAME_LAST, 0.7);
+        _pick_compare(scene, camera_node, node, mesh, PICK_FRAME_LAST);
+        _pick_compare(scene, camera_node, node, mesh, 3);
+
+        eo_do(root, evas_3d_node_member_del(node));
+        eo_del(node);
+        eo_del(mesh);
+     }
+
+   /* the scene, its nodes and the camera go with the canvas */
+   evas_free(e);
+   evas_shutdown();
+}
+END_TEST
+
 void evas_test_mesh(TCase *tc)
 {
    tcase_add_test(tc, evas_object_mesh_loader_saver);
+   tcase_add_test(tc, evas_object_mesh_pick);
 }
@@ -3,9 +3,15 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "../../lib/evas/include/evas_common_private.h"
+#include "../../lib/evas/include/evas_private.h"
+#include "../../lib/evas/canvas/evas_vg_private.h"
 #include "evas_suite.h"
 #include "Evas.h"
+#include "Ecore_Evas.h"
 #include "evas_tests_helpers.h"
 
 START_TEST(evas_object_various)
@@ -30,7 +36,308 @@ START_TEST(evas_object_various)
 }
 END_TEST
 
+#define SCENE_W 400
+#define SCENE_H 200
+#define SCENE_STEPS 11
+
+typedef struct _Scene Scene;
+struct _Scene
+{
+   Ecore_Evas *ee;
+   Evas_Object *box[4];
+   Evas_Object *rect[4][4];
+   Evas_Object *top, *cover, *clip;
+};
+
+static Evas_Smart *
+_container_smart_get(void)
+{
+   static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION("evas_test_container");
+   static Evas_Smart *smart = NULL;
+
+   if (!smart)
+     {
+        evas_object_smart_clipped_smart_set(&sc);
+        smart = evas_smart_class_new(&sc);
+     }
+   return smart;
+}
+
+static Evas_Object *
+_container_add(Evas *e, int x, int y)
+{
+   Evas_Object *o;
+
+   o = evas_object_smart_add(e, _container_smart_get());
+   evas_object_move(o, x, y);
+   evas_object_resize(o, 100, SCENE_H);
+   evas_object_show(o);
+   return o;
+}
+
+/* Four clipped containers of rectangles on a background, one of them
+ * clipped from the outside, under a container holding an opaque cover. */
+static void
+_scene_new(Scene *sc)
+{
+   Evas_Object *bg;
+   Evas *e;
+   int b, r;
+
+   sc->ee = ecore_evas_buffer_new(SCENE_W, SCENE_H);
+   ecore_evas_show(sc->ee);
+   ecore_evas_manual_render_set(sc->ee, EINA_TRUE);
+   e = ecore_evas_get(sc->ee);
+
+   /* the buffer is not cleared where nothing is drawn */
+   bg = evas_object_rectangle_add(e);
+   evas_object_resize(bg, SCENE_W, SCENE_H);
+   evas_object_show(bg);
+
+   for (b = 0; b < 4; b++)
+     {
+        sc->box[b] = _container_add(e, b * 100, 0);
+        for (r = 0; r < 4; r++)
+          {
+             Evas_Object *o = evas_object_rectangle_add(e);
+
+             evas_object_color_set(o, b * 60, r * 60, 100, 255);
+             evas_object_move(o, b * 100 + r * 20, r * 40);
+             evas_object_resize(o, 40, 40);
+             evas_object_smart_member_add(o, sc->box[b]);
+             evas_object_show(o);
+             sc->rect[b][r] = o;
+          }
+     }
+
+   sc->clip = evas_object_rectangle_add(e);
+   evas_object_resize(sc->clip, SCENE_W, 100);
+   evas_object_clip_set(sc->box[0], sc->clip);
+   evas_object_show(sc->clip);
+
+   sc->top = _container_add(e, 0, 0);
+   sc->cover = evas_object_rectangle_add(e);
+   evas_object_color_set(sc->cover, 255, 255, 255, 255);
+   evas_object_move(sc->cover, 0, 150);
+   evas_object_resize(sc->cover, SCENE_W, 50);
+   evas_object_smart_member_add(sc->cover, sc->top);
+   evas_object_show(sc->cover);
+}
+
+static void
+_scene_step(Scene *sc, int step)
+{
+   switch (step)
+     {
+      case 1: evas_object_color_set(sc->rect[1][2], 10, 200, 10, 255); break;
+      case 2: evas_object_hide(sc->rect[2][1]); break;
+      case 3: evas_object_move(sc->box[3], 300, 30); break;
+      case 4: evas_object_show(sc->rect[2][1]); break;
+      case 5: evas_object_raise(sc->rect[0][0]); break;
+      case 6: evas_object_move(sc->clip, 0, 50); break;
+      case 7: evas_object_hide(sc->cover); break;
+      case 8: evas_object_del(sc->rect[1][0]); break;
+      case 9: evas_object_color_set(sc->clip, 128, 128, 128, 128); break;
+      case 10:
+         {
+            Evas_Map *m = evas_map_new(4);
+
+            evas_map_util_points_populate_from_object(m, sc->box[2]);
+            evas_map_util_zoom(m, 0.5, 0.5, 250, 100);
+            evas_object_map_set(sc->box[2], m);
+            evas_object_map_enable_set(sc->box[2], EINA_TRUE);
+            evas_map_free(m);
+            break;
+         }
+      case 11: evas_object_map_enable_set(sc->box[2], EINA_FALSE); break;
+     }
+}
+
+START_TEST(evas_object_smart_render_cache)
+{
+   Scene sc, ref;
+   int step, i, j;
+
+   evas_init();
+   ecore_evas_init();
+
+   /* sc is rendered after every change, so that unchanged containers are
+    * drawn from the phase 1 cache of the previous frames, and must look
+    * the same as a canvas rendered once in the same state */
+   _scene_new(&sc);
+   ecore_evas_manual_render(sc.ee);
+   for (step = 0; step <= SCENE_STEPS; step++)
+     {
+        _scene_step(&sc, step);
+        /* twice: a frame where nothing changes must not differ either */
+        for (i = 0; i < 2; i++)
+          {
+             ecore_evas_manual_render(sc.ee);
+
+             _scene_new(&ref);
+             for (j = 0; j <= step; j++)
+               _scene_step(&ref, j);
+             ecore_evas_manual_render(ref.ee);
+
+             fail_if(memcmp(ecore_evas_buffer_pixels_get(sc.ee),
+                            ecore_evas_buffer_pixels_get(ref.ee),
+                            SCENE_W * SCENE_H * 4),
+                     "render differs at step %i", step);
+             ecore_evas_free(ref.ee);
+          }
+     }
+   ecore_evas_free(sc.ee);
+
+   ecore_evas_shutdown();
+   evas_shutdown();
+}
+END_TEST
+
+#define VG_W 300
+#define VG_H 200
+
+static Evas_Object *
+_vg_add(Evas *e, int x, int y, int w, int h)
+{
+   Evas_Object *vg;
+   Efl_VG *root, *shape;
+
+   vg = evas_object_vg_add(e);
+   evas_object_geometry_set(vg, x, y, w, h);
+   /* the color multiplies each node when drawing directly, and the cached
+    * copy as a whole otherwise */
+   evas_object_color_set(vg, 150, 100, 50, 200);
+   evas_object_show(vg);
+
+   root = evas_object_vg_root_node_get(vg);
+   shape = eo_add(EFL_VG_SHAPE_CLASS, root);
+   evas_vg_shape_shape_append_move_to(shape, 10, 10);
+   evas_vg_shape_shape_append_cubic_to(shape, 120, 90, 110, 0, 130, 40);
+   evas_vg_shape_shape_append_line_to(shape, 20, 110);
+   evas_vg_shape_shape_append_close(shape);
+   evas_vg_node_color_set(shape, 200, 0, 100, 200);
+   evas_vg_shape_stroke_width_set(shape, 3.0);
+   evas_vg_shape_stroke_color_set(shape, 0, 60, 120, 120);
+
+   shape = eo_add(EFL_VG_SHAPE_CLASS, root);
+   evas_vg_shape_shape_append_move_to(shape, 60, 20);
+   evas_vg_shape_shape_append_line_to(shape, 140, 60);
+   evas_vg_shape_shape_append_line_to(shape, 50, 100);
+   evas_vg_shape_shape_append_close(shape);
+   evas_vg_node_color_set(shape, 0, 128, 0, 128);
+
+   return vg;
+}
+
+static void *
+_vg_cached(Evas_Object *vg)
+{
+   Evas_VG_Data *vd = eo_data_scope_get(vg, EVAS_VG_CLASS);
+
+   return vd->cache.surface;
+}
+
+/* Renders the whole canvas again, and checks it against ref if asked to or
+ * copies it there otherwise. Ector loses a few levels when it blends the
+ * edges of the shapes straight onto the canvas, unlike the cached copy
+ * which evas blends, so the pixels are compared with a small tolerance. */
+#define VG_TOLERANCE 8
+
+static void
+_vg_render_check(Ecore_Evas *ee, unsigned int *ref, Eina_Bool check,
+                 const char *what)
+{
+   const unsigned int *px;
+   int i, c, d;
+
+   evas_damage_rectangle_add(ecore_evas_get(ee), 0, 0, VG_W, VG_H);
+   ecore_evas_manual_render(ee);
+   px = ecore_evas_buffer_pixels_get(ee);
+   if (!check)
+     {
+        memcpy(ref, px, VG_W * VG_H * 4);
+        return;
+     }
+   for (i = 0; i < VG_W * VG_H; i++)
+     for (c = 0; c < 32; c += 8)
+       {
+          d = (int)((px[i] >> c) & 0xff) - (int)((ref[i] >> c) & 0xff);
+          ck_assert_msg(abs(d) <= VG_TOLERANCE,
+                        "%s: pixel %i,%i is %#x instead of %#x", what,
+                        i % VG_W, i / VG_W, px[i], ref[i]);
+       }
+}
+
+START_TEST(evas_object_vg_render_cache)
+{
+   unsigned int *ref1, *ref2, *ref3;
+   Ecore_Evas *ee;
+   Evas_Object *bg, *a, *b;
+   Evas *e;
+
+   /* cairo may not be there */
+   setenv("ECTOR_BACKEND", "freetype", 1);
+   evas_init();
+   ecore_evas_init();
+   ee = ecore_evas_buffer_new(VG_W, VG_H);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+   ref1 = malloc(VG_W * VG_H * 4);
+   ref2 = malloc(VG_W * VG_H * 4);
+   ref3 = malloc(VG_W * VG_H * 4);
+
+   bg = evas_object_rectangle_add(e);
+   evas_object_geometry_set(bg, 0, 0, VG_W, VG_H);
+   evas_object_color_set(bg, 240, 230, 220, 255);
+   evas_object_show(bg);
+
+   /* a changed tree is drawn directly, then cached on the next frame */
+   a = _vg_add(e, 20, 30, 160, 120);
+   _vg_render_check(ee, ref1, EINA_FALSE, NULL);
+   fail_if(_vg_cached(a) != NULL);
+   _vg_render_check(ee, ref1, EINA_TRUE, "a");
+   fail_if(_vg_cached(a) == NULL);
+
+   /* b needs the whole budget, taken by a in part */
+   b = _vg_add(e, 0, 0, 2048, 2048);
+   evas_object_stack_above(b, bg);
+   _vg_render_check(ee, ref2, EINA_FALSE, NULL);
+   _vg_render_check(ee, ref2, EINA_TRUE, "a and b");
+   fail_if(_vg_cached(a) == NULL);
+   fail_if(_vg_cached(b) != NULL);
+
+   /* hiding a gives its share back */
+   evas_object_hide(a);
+   _vg_render_check(ee, ref3, EINA_FALSE, NULL);
+   fail_if(_vg_cached(a) != NULL);
+   _vg_render_check(ee, ref3, EINA_TRUE, "b");
+   fail_if(_vg_cached(b) == NULL);
+
+   /* which b now keeps, so a is drawn directly again */
+   evas_object_show(a);
+   _vg_render_check(ee, ref2, EINA_TRUE, "a and b again");
+   fail_if(_vg_cached(a) != NULL);
+   fail_if(_vg_cached(b) == NULL);
+
+   /* until b is hidden too */
+   evas_object_hide(b);
+   _vg_render_check(ee, ref1, EINA_TRUE, "a again");
+   _vg_render_check(ee, ref1, EINA_TRUE, "a again");
+   fail_if(_vg_cached(a) == NULL);
+
+   free(ref1);
+   free(ref2);
+   free(ref3);
+   ecore_evas_free(ee);
+   ecore_evas_shutdown();
+   evas_shutdown();
+}
+END_TEST
+
 void evas_test_object(TCase *tc)
 {
    tcase_add_test(tc, evas_object_various);
+   tcase_add_test(tc, evas_object_smart_render_cache);
+   tcase_add_test(tc, evas_object_vg_render_cache);
 }
@@ -5,6 +5,7 @@
 
 #include <stdio.h>
 
+#include "../../lib/evas/include/evas_common_private.h"
 #include "evas_suite.h"
 #include "Evas.h"
 #include "evas_tests_helpers.h"
@@ -579,6 +580,215 @@ START_TEST(evas_text_bidi)
 END_TEST
 #endif
 
+static void
+_shaped_run_props_create(RGBA_Font_Int *fi, const Eina_Unicode *text, int len,
+                         Evas_Text_Props *props)
+{
+   props->bidi_dir = EVAS_BIDI_DIRECTION_LTR;
+   props->script = EVAS_SCRIPT_LATIN;
+   fail_if(!evas_common_text_props_content_create(fi, text, props, NULL, 0,
+                                                  len, EVAS_TEXT_PROPS_MODE_SHAPE));
+}
+
+/* A run shaped again is a cache hit, sharing the glyphs shaping it from
+ * scratch gives. The cache holds no reference to the font instance. */
+START_TEST(evas_text_shaped_run_cache)
+{
+   START_TEXT_TEST();
+   Evas_Common_Text_Props_Cache_Stats st0, st1;
+   Evas_Text_Props first, hit, direct;
+   Evas_Text_Props_Info *info;
+   RGBA_Font *fn;
+   RGBA_Font_Int *fi;
+   Eina_Unicode *text;
+   int len, size, refs;
+   size_t i;
+
+   /* The instance the object uses, it's cached under this name */
+   evas_object_text_font_set(to, "DejaVuSans", 14);
+   evas_object_text_text_set(to, "A");
+   fn = evas_common_font_load(TEST_FONT_SOURCE "/DejaVuSans", 14,
+                              FONT_REND_REGULAR);
+   fail_if(!fn);
+   fi = fn->fonts->data;
+   text = eina_unicode_utf8_to_unicode("Shaped twice", &len);
+   size = evas_common_text_props_cache_size_get();
+   fail_if(size <= 0);
+   memset(&first, 0, sizeof(first));
+   memset(&hit, 0, sizeof(hit));
+   memset(&direct, 0, sizeof(direct));
+
+   /* shaped from scratch, with the cache off */
+   evas_common_text_props_cache_size_set(0);
+   _shaped_run_props_create(fi, text, len, &direct);
+   evas_common_text_props_cache_size_set(size);
+
+   refs = fi->references;
+   evas_common_text_props_cache_stats_get(&st0);
+   _shaped_run_props_create(fi, text, len, &first);
+   _shaped_run_props_create(fi, text, len, &hit);
+   evas_common_text_props_cache_stats_get(&st1);
+   ck_assert_int_eq(st1.misses, st0.misses + 1);
+   ck_assert_int_eq(st1.hits, st0.hits + 1);
+   fail_if(hit.info != first.info);
+   /* the shared info holds the only new one */
+   ck_assert_int_eq(fi->references, refs + 1);
+
+   fail_if(direct.info == hit.info);
+   ck_assert_int_eq(direct.len, hit.len);
+   ck_assert_int_eq(direct.start, hit.start);
+   for (i = 0; i < hit.len; i++)
+     {
+        const Evas_Font_Glyph_Info *g1 = hit.info->glyph + hit.start + i;
+        const Evas_Font_Glyph_Info *g2 = direct.info->glyph + direct.start + i;
+
+        ck_assert_int_eq(g1->index, g2->index);
+        ck_assert_int_eq(g1->pen_after, g2->pen_after);
+        ck_assert_int_eq(g1->x_bear, g2->x_bear);
+        ck_assert_int_eq(g1->y_bear, g2->y_bear);
+        ck_assert_int_eq(g1->width, g2->width);
+#ifdef OT_SUPPORT
+        ck_assert_int_eq(hit.info->ot[hit.start + i].source_cluster,
+                         direct.info->ot[direct.start + i].source_cluster);
+        ck_assert_int_eq(hit.info->ot[hit.start + i].x_offset,
+                         direct.info->ot[direct.start + i].x_offset);
+        ck_assert_int_eq(hit.info->ot[hit.start + i].y_offset,
+                         direct.info->ot[direct.start + i].y_offset);
+#endif
+     }
+
+   /* Once no props use the run, its font reference is given back though
+    * the cache keeps the run: emptied props hold a reference each. */
+   info = hit.info;
+   _shaped_run_props_create(fi, text, 0, &first);
+   _shaped_run_props_create(fi, text, 0, &hit);
+   ck_assert_int_eq(fi->references, refs + 2);
+
+   /* and it's taken again by the next hit */
+   evas_common_text_props_cache_stats_get(&st0);
+   _shaped_run_props_create(fi, text, len, &hit);
+   evas_common_text_props_cache_stats_get(&st1);
+   ck_assert_int_eq(st1.hits, st0.hits + 1);
+   ck_assert_int_eq(st1.misses, st0.misses);
+   fail_if(hit.info != info);
+   ck_assert_int_eq(fi->references, refs + 2);
+
+   free(text);
+   evas_common_font_free(fn);
+   END_TEXT_TEST();
+}
+END_TEST
+
+#define GLYPHS 8
+
+/* The glyph the props of one character draw, a cache hit once drawn */
+static RGBA_Font_Glyph *
+_glyph_cache_get(RGBA_Font_Int *fi, const Evas_Text_Props *props)
+{
+   return evas_common_font_int_cache_glyph_get(fi, props->info->glyph[props->start].index);
+}
+
+/* Unused glyphs are freed oldest unused first once over budget, and those
+ * are rendered again the same when needed again. */
+START_TEST(evas_text_glyph_cache)
+{
+   START_TEXT_TEST();
+   static const int release[GLYPHS] = { 3, 0, 6, 1, 7, 2, 5, 4 };
+   Evas_Common_Glyph_Cache_Stats st0, st1;
+   Evas_Text_Props props[GLYPHS];
+   RGBA_Font_Glyph *fg[GLYPHS];
+   RGBA_Font_Glyph_Out out[GLYPHS];
+   unsigned char *rle[GLYPHS];
+   int usage[GLYPHS];
+   Eina_Unicode text[GLYPHS][2];
+   RGBA_Font *fn;
+   RGBA_Font_Int *fi;
+   int size, evicted, i;
+
+   /* an instance no other test uses, cached under this name by the object */
+   evas_object_text_font_set(to, "DejaVuSans", 37);
+   fn = evas_common_font_load(TEST_FONT_SOURCE "/DejaVuSans", 37,
+                              FONT_REND_REGULAR);
+   fail_if(!fn);
+   fi = fn->fonts->data;
+   size = evas_common_font_glyph_cache_get();
+
+   /* every glyph is loaded once, and referenced while props draw it */
+   evas_common_font_glyph_cache_stats_get(&st0);
+   for (i = 0; i < GLYPHS; i++)
+     {
+        text[i][0] = 'A' + (i * 3);
+        text[i][1] = 0;
+        memset(&props[i], 0, sizeof(props[i]));
+        _shaped_run_props_create(fi, text[i], 1, &props[i]);
+        evas_common_font_draw_prepare(&props[i]);
+        fail_if(!props[i].glyphs);
+        ck_assert_int_eq(eina_inarray_count(props[i].glyphs->array), 1);
+
+        fg[i] = _glyph_cache_get(fi, &props[i]);
+        fail_if(!fg[i]->glyph_out);
+        fail_if(!fg[i]->glyph_out->rle);
+        out[i] = *fg[i]->glyph_out;
+        rle[i] = malloc(out[i].rle_size);
+        memcpy(rle[i], out[i].rle, out[i].rle_size);
+        usage[i] = fg[i]->usage;
+        fail_if(usage[i] <= 0);
+     }
+   evas_common_font_glyph_cache_stats_get(&st1);
+   ck_assert_int_eq(st1.misses, st0.misses + GLYPHS);
+   _ck_assert_int(st1.hits, >=, st0.hits + GLYPHS);
+
+   /* referenced glyphs stay whatever the budget */
+   evas_common_font_glyph_cache_set(0);
+   evas_common_font_glyph_cache_stats_get(&st0);
+   ck_assert_int_eq(st0.evicted, st1.evicted);
+
+   /* given back in that order, the first three go over budget */
+   for (i = 0; i < GLYPHS; i++)
+     _shaped_run_props_create(fi, text[release[i]], 0, &props[release[i]]);
+   evas_common_font_glyph_cache_set(size);
+   evas_common_font_glyph_cache_stats_get(&st0);
+   evicted = usage[release[0]] + usage[release[1]] + usage[release[2]];
+   evas_common_font_glyph_cache_set(st0.usage - evicted);
+   evas_common_font_glyph_cache_stats_get(&st1);
+   ck_assert_int_eq(st1.evicted, st0.evicted + 3);
+   ck_assert_int_eq(st1.usage, st0.usage - evicted);
+   evas_common_font_glyph_cache_set(size);
+
+   for (i = 0; i < GLYPHS; i++)
+     {
+        const RGBA_Font_Glyph_Out *o;
+        Eina_Bool gone;
+        RGBA_Font_Glyph *g;
+
+        gone = ((i == release[0]) || (i == release[1]) || (i == release[2]));
+        evas_common_font_glyph_cache_stats_get(&st0);
+        _shaped_run_props_create(fi, text[i], 1, &props[i]);
+        evas_common_font_draw_prepare(&props[i]);
+        evas_common_font_glyph_cache_stats_get(&st1);
+        ck_assert_int_eq(st1.misses, st0.misses + (gone ? 1 : 0));
+
+        g = _glyph_cache_get(fi, &props[i]);
+        if (!gone) fail_if(g != fg[i]);
+        o = g->glyph_out;
+        ck_assert_int_eq(g->usage, usage[i]);
+        ck_assert_int_eq(o->bitmap.width, out[i].bitmap.width);
+        ck_assert_int_eq(o->bitmap.rows, out[i].bitmap.rows);
+        ck_assert_int_eq(o->bitmap.pitch, out[i].bitmap.pitch);
+        ck_assert_int_eq(o->rle_size, out[i].rle_size);
+        fail_if(memcmp(o->rle, rle[i], out[i].rle_size));
+     }
+
+   for (i = 0; i < GLYPHS; i++)
+     {
+        _shaped_run_props_create(fi, text[i], 0, &props[i]);
+        free(rle[i]);
+     }
+   evas_common_font_free(fn);
+   END_TEXT_TEST();
+}
+END_TEST
+
 void evas_test_text(TCase *tc)
 {
    tcase_add_test(tc, evas_text_simple);
@@ -592,4 +802,6 @@ void evas_test_text(TCase *tc)
 #endif
 
    tcase_add_test(tc, evas_text_unrelated);
+   tcase_add_test(tc, evas_text_shaped_run_cache);
+   tcase_add_test(tc, evas_text_glyph_cache);
 }
@@ -3291,6 +3291,230 @@ START_TEST(evas_textblock_delete)
 }
 END_TEST;
 
+/* Compare the layout of tb, which was laid out again after each edit,
+ * with the one of a new object laid out from scratch with the same content */
+static void
+_tb_layout_compare(Evas_Object *tb, Evas_Textblock_Style *st, int edit)
+{
+   Evas_Object *stb;
+   Evas_Textblock_Cursor *c1, *c2;
+   const Evas_Object_Textblock_Node_Format *f1, *f2;
+   Evas_Coord w, h, sw, sh;
+   Evas_Coord x, y, lw, lh, sx, sy, slw, slh;
+   Eina_Bool r1, r2;
+   int line;
+
+   stb = evas_object_textblock_add(evas_object_evas_get(tb));
+   evas_object_textblock_legacy_newline_set(stb, EINA_FALSE);
+   evas_object_textblock_style_set(stb, st);
+   evas_object_textblock_text_markup_set(stb,
+         evas_object_textblock_text_markup_get(tb));
+   evas_object_geometry_get(tb, NULL, NULL, &w, &h);
+   evas_object_resize(stb, w, h);
+
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   evas_object_textblock_size_formatted_get(stb, &sw, &sh);
+   fail_if((w != sw) || (h != sh),
+         "edit %d: formatted size %dx%d, expected %dx%d", edit, w, h, sw, sh);
+
+   for (line = 0; ; line++)
+     {
+        r1 = evas_object_textblock_line_number_geometry_get(tb, line,
+              &x, &y, &lw, &lh);
+        r2 = evas_object_textblock_line_number_geometry_get(stb, line,
+              &sx, &sy, &slw, &slh);
+        fail_if(r1 != r2, "edit %d: line %d missing", edit, line);
+        if (!r1) break;
+        fail_if((x != sx) || (y != sy) || (lw != slw) || (lh != slh),
+              "edit %d: line %d at %d,%d %dx%d, expected %d,%d %dx%d",
+              edit, line, x, y, lw, lh, sx, sy, slw, slh);
+     }
+
+   c1 = evas_object_textblock_cursor_new(tb);
+   c2 = evas_object_textblock_cursor_new(stb);
+   f1 = evas_textblock_node_format_first_get(tb);
+   f2 = evas_textblock_node_format_first_get(stb);
+   while (f1 && f2)
+     {
+        evas_textblock_cursor_at_format_set(c1, f1);
+        evas_textblock_cursor_at_format_set(c2, f2);
+        evas_textblock_cursor_geometry_get(c1, &x, &y, &lw, &lh,
+              NULL, EVAS_TEXTBLOCK_CURSOR_BEFORE);
+        evas_textblock_cursor_geometry_get(c2, &sx, &sy, &slw, &slh,
+              NULL, EVAS_TEXTBLOCK_CURSOR_BEFORE);
+        fail_if((x != sx) || (y != sy) || (lw != slw) || (lh != slh),
+              "edit %d: format at %d,%d %dx%d, expected %d,%d %dx%d",
+              edit, x, y, lw, lh, sx, sy, slw, slh);
+        f1 = evas_textblock_node_format_next_get(f1);
+        f2 = evas_textblock_node_format_next_get(f2);
+     }
+   fail_if(f1 || f2);
+
+   evas_textblock_cursor_free(c1);
+   evas_textblock_cursor_free(c2);
+   evas_object_del(stb);
+}
+
+START_TEST(evas_textblock_incremental_layout)
+{
+   START_TB_TEST();
+   Eina_Strbuf *buf;
+   int i, edit;
+
+   evas_textblock_style_set(st, "DEFAULT='" TEST_FONT " font_size=10 "
+         "color=#000 wrap=word'" "b='+ font_weight=bold'");
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < 30; i++)
+      eina_strbuf_append_printf(buf, "%sParagraph %d of some <b>wrapping</b> text",
+            i ? "<ps/>" : "", i);
+   evas_object_textblock_text_markup_set(tb, eina_strbuf_string_get(buf));
+   evas_object_resize(tb, 100, 1000);
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+
+   /* Each edit only touches a range of paragraphs, so the layout that
+    * follows it only goes through that range. */
+   for (edit = 0; edit < 8; edit++)
+     {
+        switch (edit)
+          {
+           case 0: /* a paragraph in the middle gets more lines */
+              evas_textblock_cursor_paragraph_first(cur);
+              for (i = 0; i < 15; i++) evas_textblock_cursor_paragraph_next(cur);
+              evas_textblock_cursor_text_prepend(cur, "more words that wrap ");
+              break;
+           case 1: /* and some less */
+              evas_textblock_cursor_pos_set(cur, 0);
+              for (i = 0; i < 5; i++) evas_textblock_cursor_char_delete(cur);
+              evas_textblock_cursor_paragraph_first(cur);
+              for (i = 0; i < 15; i++) evas_textblock_cursor_paragraph_next(cur);
+              for (i = 0; i < 21; i++) evas_textblock_cursor_char_delete(cur);
+              break;
+           case 2: /* a paragraph is split */
+              evas_textblock_cursor_paragraph_first(cur);
+              for (i = 0; i < 20; i++) evas_textblock_cursor_paragraph_next(cur);
+              evas_textblock_cursor_pos_set(cur,
+                    evas_textblock_cursor_pos_get(cur) + 4);
+              evas_object_textblock_text_markup_prepend(cur, "<ps/>");
+              break;
+           case 3: /* and merged back */
+              evas_textblock_cursor_paragraph_first(cur);
+              for (i = 0; i < 20; i++) evas_textblock_cursor_paragraph_next(cur);
+              evas_textblock_cursor_paragraph_char_last(cur);
+              evas_textblock_cursor_char_next(cur);
+              evas_textblock_cursor_char_delete(cur);
+              break;
+           case 4: /* a format is added */
+              evas_textblock_cursor_paragraph_first(cur);
+              for (i = 0; i < 7; i++) evas_textblock_cursor_paragraph_next(cur);
+              evas_object_textblock_text_markup_prepend(cur,
+                    "<font_size=20>big</font_size> ");
+              break;
+           case 5: /* the last paragraph changes */
+              evas_textblock_cursor_paragraph_last(cur);
+              evas_textblock_cursor_text_prepend(cur, "last ");
+              break;
+           case 6: /* and the first one */
+              evas_textblock_cursor_paragraph_first(cur);
+              evas_textblock_cursor_text_prepend(cur, "first ");
+              break;
+           case 7: /* a paragraph is added at the end */
+              evas_textblock_cursor_paragraph_last(cur);
+              evas_textblock_cursor_paragraph_char_last(cur);
+              evas_textblock_cursor_char_next(cur);
+              evas_object_textblock_text_markup_prepend(cur, "<ps/>end");
+              break;
+          }
+        _tb_layout_compare(tb, st, edit);
+     }
+
+   eina_strbuf_free(buf);
+   END_TB_TEST();
+}
+END_TEST
+
+START_TEST(evas_textblock_async_layout)
+{
+   START_TB_TEST();
+   Evas_Coord w, h, aw, ah;
+   Evas_Coord x, y, lw, lh, ax, ay, alw, alh;
+   Evas_Textblock_Cursor *scur;
+   Evas_Object *stb;
+   Eina_Strbuf *buf;
+   int i;
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < 200; i++)
+      eina_strbuf_append_printf(buf, "%sLine %d of some <b>wrapping</b> text",
+            i ? "<ps/>" : "", i);
+
+   /* The same content, laid out in place. */
+   stb = evas_object_textblock_add(evas);
+   evas_object_textblock_style_set(stb, st);
+   evas_object_textblock_text_markup_set(stb, eina_strbuf_string_get(buf));
+   evas_object_resize(stb, 100, 1000);
+   evas_object_textblock_size_formatted_get(stb, &w, &h);
+
+   fail_if(evas_object_textblock_async_layout_get(tb));
+   evas_object_textblock_async_layout_set(tb, EINA_TRUE);
+   fail_if(!evas_object_textblock_async_layout_get(tb));
+   evas_object_textblock_text_markup_set(tb, eina_strbuf_string_get(buf));
+   evas_object_resize(tb, 100, 1000);
+
+   /* Starts the layout, doesn't wait for it. */
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+   evas_object_textblock_layout_wait(tb);
+   fail_if(evas_object_textblock_layout_pending_get(tb));
+   evas_object_textblock_size_formatted_get(tb, &aw, &ah);
+   ck_assert_int_eq(aw, w);
+   ck_assert_int_eq(ah, h);
+
+   /* Geometry queries wait for the pending layout. */
+   evas_object_resize(stb, 150, 1000);
+   evas_object_resize(tb, 150, 1000);
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+   fail_if(!evas_object_textblock_line_number_geometry_get(stb, 150,
+            &x, &y, &lw, &lh));
+   fail_if(!evas_object_textblock_line_number_geometry_get(tb, 150,
+            &ax, &ay, &alw, &alh));
+   fail_if(evas_object_textblock_layout_pending_get(tb));
+   fail_if((x != ax) || (y != ay) || (lw != alw) || (lh != alh));
+
+   /* Editing while a layout is pending. */
+   evas_object_resize(stb, 120, 1000);
+   evas_object_resize(tb, 120, 1000);
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+   scur = evas_object_textblock_cursor_new(stb);
+   evas_textblock_cursor_paragraph_first(scur);
+   evas_textblock_cursor_text_prepend(scur, "Edited ");
+   evas_textblock_cursor_free(scur);
+   evas_textblock_cursor_paragraph_first(cur);
+   evas_textblock_cursor_text_prepend(cur, "Edited ");
+   evas_object_textblock_layout_wait(tb);
+   evas_object_textblock_size_formatted_get(stb, &w, &h);
+   evas_object_textblock_size_formatted_get(tb, &aw, &ah);
+   ck_assert_int_eq(aw, w);
+   ck_assert_int_eq(ah, h);
+
+   /* Replacing the content and deleting the object while pending. */
+   evas_object_resize(tb, 130, 1000);
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+   evas_object_textblock_text_markup_set(tb, "Short");
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+   evas_object_textblock_layout_wait(tb);
+   fail_if(!evas_object_textblock_line_number_geometry_get(tb, 0,
+            NULL, NULL, NULL, NULL));
+   fail_if(evas_object_textblock_line_number_geometry_get(tb, 1,
+            NULL, NULL, NULL, NULL));
+   evas_object_textblock_text_markup_set(tb, eina_strbuf_string_get(buf));
+   evas_object_textblock_size_formatted_get(tb, NULL, NULL);
+
+   evas_object_del(stb);
+   eina_strbuf_free(buf);
+   END_TB_TEST();
+}
+END_TEST
+
 void evas_test_textblock(TCase *tc)
 {
    tcase_add_test(tc, evas_textblock_simple);
@@ -3312,5 +3536,7 @@ void evas_test_textblock(TCase *tc)
    tcase_add_test(tc, evas_textblock_wrapping);
    tcase_add_test(tc, evas_textblock_items);
    tcase_add_test(tc, evas_textblock_delete);
+   tcase_add_test(tc, evas_textblock_incremental_layout);
+   tcase_add_test(tc, evas_textblock_async_layout);
 }
 
@@ -0,0 +1,226 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "evas_suite.h"
+#include "Evas.h"
+#include "Ecore_Evas.h"
+#include "evas_tests_helpers.h"
+
+#define TEST_FONT_NAME "DejaVuSansMono"
+
+#define COLS 12
+#define ROWS 8
+
+/* every row gets a letter of its own, its line number tells the colors */
+static void
+_row_write(Evas_Object *o, int y, int line)
+{
+   Evas_Textgrid_Cell *cells;
+   int i;
+
+   cells = evas_object_textgrid_cellrow_get(o, y);
+   for (i = 0; i < COLS; i++)
+     {
+        memset(&cells[i], 0, sizeof (cells[i]));
+        cells[i].codepoint = (i % 3) ? 'A' + line : 0;
+        cells[i].fg = 1 + (line % 7);
+        cells[i].bg = (i < 4) ? 1 + ((line + 3) % 7) : 0;
+        cells[i].underline = !(line % 3);
+     }
+   evas_object_textgrid_cellrow_set(o, y, cells);
+}
+
+static void
+_rows_check(Evas_Object *o, const char *expected)
+{
+   Evas_Textgrid_Cell *cells;
+   int y;
+
+   for (y = 0; y < ROWS; y++)
+     {
+        cells = evas_object_textgrid_cellrow_get(o, y);
+        ck_assert_msg(cells[1].codepoint == (Eina_Unicode)expected[y],
+                      "row %d holds '%c' instead of '%c'",
+                      y, cells[1].codepoint, expected[y]);
+        ck_assert_int_eq(cells[2].codepoint, cells[1].codepoint);
+        ck_assert_int_eq(cells[0].codepoint, 0);
+     }
+}
+
+static Evas_Object *
+_textgrid_add(Evas *e)
+{
+   Evas_Object *o;
+   int i, cw, ch;
+
+   o = evas_object_textgrid_add(e);
+   evas_object_textgrid_font_set(o, TEST_FONT_NAME, 10);
+   evas_object_textgrid_size_set(o, COLS, ROWS);
+   for (i = 0; i < 8; i++)
+     evas_object_textgrid_palette_set(o, EVAS_TEXTGRID_PALETTE_STANDARD, i,
+                                      (i & 1) ? 255 : 0, (i & 2) ? 255 : 0,
+                                      (i & 4) ? 255 : 0, 255);
+   evas_object_textgrid_cell_size_get(o, &cw, &ch);
+   evas_object_geometry_set(o, 0, 0, cw * COLS, ch * ROWS);
+   for (i = 0; i < ROWS; i++)
+     _row_write(o, i, i);
+   evas_object_textgrid_update_add(o, 0, 0, COLS, ROWS);
+   evas_object_show(o);
+   return o;
+}
+
+START_TEST(evas_textgrid_rows_scroll)
+{
+   Evas *evas;
+   Evas_Object *o;
+
+   evas = EVAS_TEST_INIT_EVAS();
+   o = _textgrid_add(evas);
+   _rows_check(o, "ABCDEFGH");
+
+   /* the rows pushed out of the band come back on the other side */
+   evas_object_textgrid_rows_scroll(o, 0, ROWS, -1);
+   _rows_check(o, "BCDEFGHA");
+   evas_object_textgrid_rows_scroll(o, 0, ROWS, 1);
+   _rows_check(o, "ABCDEFGH");
+
+   /* rows outside of the band do not move */
+   evas_object_textgrid_rows_scroll(o, 2, 4, -1);
+   _rows_check(o, "ABDEFCGH");
+   evas_object_textgrid_rows_scroll(o, 2, 4, 3);
+   _rows_check(o, "ABEFCDGH");
+   evas_object_textgrid_rows_scroll(o, 2, 4, -3);
+   _rows_check(o, "ABDEFCGH");
+   evas_object_textgrid_rows_scroll(o, 2, 4, 1);
+   _rows_check(o, "ABCDEFGH");
+
+   /* the band is clipped to the grid */
+   evas_object_textgrid_rows_scroll(o, -2, 5, -1);
+   _rows_check(o, "BCADEFGH");
+   evas_object_textgrid_rows_scroll(o, 6, 10, 1);
+   _rows_check(o, "BCADEFHG");
+
+   /* nothing to rotate */
+   evas_object_textgrid_rows_scroll(o, 0, ROWS, 0);
+   evas_object_textgrid_rows_scroll(o, 0, ROWS, ROWS);
+   evas_object_textgrid_rows_scroll(o, 2, 3, -3);
+   evas_object_textgrid_rows_scroll(o, ROWS, 2, 1);
+   evas_object_textgrid_rows_scroll(o, 0, 0, 1);
+   _rows_check(o, "BCADEFHG");
+
+   evas_object_del(o);
+   evas_free(evas);
+   evas_shutdown();
+}
+END_TEST
+
+#ifdef BUILD_ENGINE_BUFFER
+static unsigned int *
+_render(Ecore_Evas *ee, int w, int h)
+{
+   unsigned int *data;
+
+   ecore_evas_manual_render(ee);
+   data = malloc(w * h * 4);
+   memcpy(data, ecore_evas_buffer_pixels_get(ee), w * h * 4);
+   return data;
+}
+
+START_TEST(evas_textgrid_rows_scroll_render)
+{
+   static const struct {
+      int y, h, dy;
+   } scrolls[] = {
+      { 0, ROWS, -1 },
+      { 0, ROWS, -3 },
+      { 2, 4, 1 },
+      { 1, 6, -2 },
+      { 0, ROWS, 2 }
+   };
+   Ecore_Evas *ee;
+   Evas *e;
+   Evas_Object *o, *ref;
+   unsigned int *data, *refdata;
+   int lines[ROWS];
+   int i, k, y, n, w, h, cw, ch, line;
+
+   evas_init();
+   ecore_evas_init();
+   ee = ecore_evas_buffer_new(1, 1);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   o = _textgrid_add(e);
+   evas_object_textgrid_cell_size_get(o, &cw, &ch);
+   fail_if((cw <= 0) || (ch <= 0));
+   w = cw * COLS;
+   h = ch * ROWS;
+   ecore_evas_resize(ee, w, h);
+   for (y = 0; y < ROWS; y++)
+     lines[y] = y;
+   data = _render(ee, w, h);
+   free(data);
+
+   /* the rows that only moved must be drawn at their new offset, as a grid
+    * written from scratch with the same content is */
+   line = ROWS;
+   for (i = 0; i < (int)EINA_C_ARRAY_LENGTH(scrolls); i++)
+     {
+        int band[ROWS];
+
+        evas_object_textgrid_rows_scroll(o, scrolls[i].y, scrolls[i].h,
+                                         scrolls[i].dy);
+        n = abs(scrolls[i].dy);
+        for (k = 0; k < scrolls[i].h; k++)
+          band[k] = lines[scrolls[i].y +
+                          ((k - scrolls[i].dy + scrolls[i].h) % scrolls[i].h)];
+        for (k = 0; k < scrolls[i].h; k++)
+          lines[scrolls[i].y + k] = band[k];
+        /* the rows that scrolled in get new lines */
+        for (k = 0; k < n; k++)
+          {
+             y = (scrolls[i].dy < 0) ?
+               scrolls[i].y + scrolls[i].h - n + k : scrolls[i].y + k;
+             lines[y] = line++ % 26;
+             _row_write(o, y, lines[y]);
+          }
+        data = _render(ee, w, h);
+
+        evas_object_hide(o);
+        ref = _textgrid_add(e);
+        for (y = 0; y < ROWS; y++)
+          _row_write(ref, y, lines[y]);
+        refdata = _render(ee, w, h);
+        evas_object_del(ref);
+        evas_object_show(o);
+
+        for (k = 0; k < w * h; k++)
+          if (data[k] != refdata[k]) break;
+        ck_assert_msg(k == w * h,
+                      "scroll %d: pixel %d,%d is %#x instead of %#x",
+                      i, k % w, k / w, data[k % (w * h)], refdata[k % (w * h)]);
+        free(data);
+        free(refdata);
+     }
+
+   evas_object_del(o);
+   ecore_evas_free(ee);
+   ecore_evas_shutdown();
+   evas_shutdown();
+}
+END_TEST
+#endif
+
+void evas_test_textgrid(TCase *tc)
+{
+   tcase_add_test(tc, evas_textgrid_rows_scroll);
+#ifdef BUILD_ENGINE_BUFFER
+   tcase_add_test(tc, evas_textgrid_rows_scroll_render);
+#endif
+}